@@ -29,6 +29,8 @@ struct UpdateStatistics final {
   std::atomic<std::chrono::steady_clock::time_point>
       last_successful_update_start_time{{}};
   std::atomic<std::chrono::milliseconds> last_update_duration{{}};
+  std::atomic<std::chrono::milliseconds> last_update_fetch_duration{{}};
+  std::atomic<std::chrono::milliseconds> last_update_parse_duration{{}};
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -83,6 +85,18 @@ class UpdateStatisticsScope final {
   /// @param add the number of non-valid items newly received
   void IncreaseDocumentsParseFailures(std::size_t add);
 
+  /// @brief Report the time spent on the stages of the `Update`
+  /// @param fetch time spent on receiving the data from the data source
+  /// @param parse time spent on parsing the data and filling the cache, the
+  /// time accumulated with AddParseDuration is added to it
+  void SetStageDurations(std::chrono::milliseconds fetch,
+                         std::chrono::milliseconds parse);
+
+  /// @brief Account the time spent on parsing the data in helper tasks of the
+  /// `Update`, the sum over all the tasks is reported
+  /// @note This method can be called concurrently, before SetStageDurations
+  void AddParseDuration(std::chrono::steady_clock::duration duration);
+
  private:
   void DoFinish(impl::UpdateState new_state);
 
@@ -90,6 +104,7 @@ class UpdateStatisticsScope final {
   impl::UpdateStatistics& update_stats_;
   impl::UpdateState state_{impl::UpdateState::kNotFinished};
   const std::chrono::steady_clock::time_point update_start_time_;
+  std::atomic<std::chrono::steady_clock::rep> helper_parse_duration_{0};
 };
 
 }  // namespace cache
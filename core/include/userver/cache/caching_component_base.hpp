@@ -160,6 +160,19 @@ class CachingComponentBase : public LoggableComponentBase,
 
   void Clear();
 
+  /// @brief Returns the data to be filled by an update of the given type:
+  /// a copy of the current cache contents for UpdateType::kIncremental and
+  /// an empty `T` otherwise.
+  ///
+  /// @throws cache::EmptyCacheError on an incremental update of an empty
+  /// cache, unless MayReturnNull() returns true
+  ///
+  /// The copy is O(1) if `T` is a persistent container, e.g.
+  /// utils::PersistentHashMap, and the following modifications copy only the
+  /// changed parts of it. Prefer such containers for big caches with
+  /// frequent incremental updates.
+  std::unique_ptr<T> GetDataForUpdate(cache::UpdateType type) const;
+
   /// Whether Get() is expected to return nullptr.
   /// If MayReturnNull() returns false, Get() throws an exception instead of
   /// returning nullptr.
@@ -291,6 +304,16 @@ void CachingComponentBase<T>::Clear() {
   cache_.Assign(std::make_unique<const T>());
 }
 
+template <typename T>
+std::unique_ptr<T> CachingComponentBase<T>::GetDataForUpdate(
+    cache::UpdateType type) const {
+  if (type == cache::UpdateType::kIncremental) {
+    const auto ptr = Get();
+    if (ptr) return std::make_unique<T>(*ptr);
+  }
+  return std::make_unique<T>();
+}
+
 template <typename T>
 bool CachingComponentBase<T>::MayReturnNull() const {
   return false;
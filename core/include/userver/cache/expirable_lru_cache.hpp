@@ -73,6 +73,11 @@ class ExpirableLruCache final {
   ExpirableLruCache(size_t ways, size_t way_size, const Hash& hash = Hash(),
                     const Equal& equal = Equal());
 
+  /// @param policy is the eviction policy of the ways, see
+  /// cache::EvictionPolicy
+  ExpirableLruCache(size_t ways, size_t way_size, EvictionPolicy policy,
+                    const Hash& hash = Hash(), const Equal& equal = Equal());
+
   ~ExpirableLruCache();
 
   /// For the description of `way_size`,
@@ -172,7 +177,13 @@ class ExpirableLruCache final {
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
     size_t ways, size_t way_size, const Hash& hash, const Equal& equal)
-    : lru_(ways, way_size, hash, equal),
+    : ExpirableLruCache(ways, way_size, EvictionPolicy::kLru, hash, equal) {}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
+    size_t ways, size_t way_size, EvictionPolicy policy, const Hash& hash,
+    const Equal& equal)
+    : lru_(ways, way_size, policy, hash, equal),
       mutex_set_{ways, way_size, hash, equal} {}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
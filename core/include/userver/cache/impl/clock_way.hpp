@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/persistent_hash_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// A way of NWayLRU with the CLOCK eviction policy.
+///
+/// The keyset lives in a persistent map under rcu::Variable, so a lookup is
+/// a hazard pointer read and a relaxed store of the `referenced` flag. Only
+/// the modifications take the rcu::Variable writer mutex, which also guards
+/// the clock queue.
+template <typename T, typename U, typename Hash, typename Equal>
+class ClockWay final {
+ public:
+  ClockWay(const Hash& hash, const Equal& equal)
+      : map_(rcu::DestructionType::kSync, hash, equal) {}
+
+  ClockWay(ClockWay&&) = delete;
+  ClockWay& operator=(ClockWay&&) = delete;
+
+  template <typename Validator>
+  std::optional<U> Get(const T& key, Validator validator) {
+    std::shared_ptr<Entry> invalid_entry;
+    {
+      auto snapshot = map_.Read();
+      const auto it = snapshot->find(key);
+      if (it == snapshot->end()) return std::nullopt;
+
+      const auto& entry = *it->second;
+      // Avoid bouncing the cache line of a hot entry
+      if (!entry.referenced.load(std::memory_order_relaxed)) {
+        entry.referenced.store(true, std::memory_order_relaxed);
+      }
+      if (validator(entry.value)) return entry.value;
+      invalid_entry = it->second;
+    }
+
+    auto txn = map_.StartWrite();
+    const auto it = txn->find(key);
+    // The entry might have been replaced by a concurrent Put
+    if (it != txn->end() && it->second == invalid_entry) {
+      Remove(*txn, key);
+      txn.Commit();
+    }
+    return std::nullopt;
+  }
+
+  void Put(const T& key, U value) {
+    auto entry = std::make_shared<Entry>(key, std::move(value));
+
+    auto txn = map_.StartWrite();
+    const auto it = txn->find(key);
+    if (it != txn->end()) {
+      entry->referenced.store(
+          it->second->referenced.load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+      MarkRemoved(*it->second);
+    }
+    txn->insert_or_assign(key, entry);
+    queue_.push_back(std::move(entry));
+
+    Shrink(*txn);
+    txn.Commit();
+  }
+
+  void Erase(const T& key) {
+    {
+      auto snapshot = map_.Read();
+      if (!snapshot->contains(key)) return;
+    }
+
+    auto txn = map_.StartWrite();
+    if (!txn->contains(key)) return;
+    Remove(*txn, key);
+    txn.Commit();
+  }
+
+  void Clear() {
+    auto txn = map_.StartWrite();
+    txn->clear();
+    queue_.clear();
+    removed_in_queue_ = 0;
+    txn.Commit();
+  }
+
+  void SetMaxSize(std::size_t max_size) {
+    auto txn = map_.StartWrite();
+    max_size_ = std::max<std::size_t>(max_size, 1);
+    Shrink(*txn);
+    txn.Commit();
+  }
+
+  std::size_t GetSize() const {
+    auto snapshot = map_.Read();
+    return snapshot->size();
+  }
+
+  /// Calls Function(const T&, const U&) for all items of a snapshot
+  template <typename Function>
+  void VisitAll(Function&& func) const {
+    const auto snapshot = map_.ReadCopy();
+    for (const auto& [key, entry] : snapshot) func(key, entry->value);
+  }
+
+ private:
+  struct Entry final {
+    Entry(const T& key, U value) : key(key), value(std::move(value)) {}
+
+    const T key;
+    const U value;
+    mutable std::atomic<bool> referenced{false};
+    // Guarded by the writer mutex
+    bool is_removed{false};
+  };
+
+  using Map = utils::PersistentHashMap<T, std::shared_ptr<Entry>, Hash, Equal>;
+
+  void Remove(Map& map, const T& key) {
+    const auto it = map.find(key);
+    MarkRemoved(*it->second);
+    map.erase(key);
+  }
+
+  void MarkRemoved(Entry& entry) {
+    entry.is_removed = true;
+    ++removed_in_queue_;
+
+    // Removed entries are skipped lazily, drop them once they dominate
+    if (removed_in_queue_ > queue_.size() / 2) {
+      queue_.erase(std::remove_if(queue_.begin(), queue_.end(),
+                                  [](const auto& entry) {
+                                    return entry->is_removed;
+                                  }),
+                   queue_.end());
+      removed_in_queue_ = 0;
+    }
+  }
+
+  void Shrink(Map& map) {
+    while (map.size() > max_size_) {
+      auto entry = std::move(queue_.front());
+      queue_.pop_front();
+
+      if (entry->is_removed) {
+        --removed_in_queue_;
+      } else if (entry->referenced.load(std::memory_order_relaxed)) {
+        // Second chance
+        entry->referenced.store(false, std::memory_order_relaxed);
+        queue_.push_back(std::move(entry));
+      } else {
+        map.erase(entry->key);
+      }
+    }
+  }
+
+  rcu::Variable<Map> map_;
+  // Insertion order of the entries, including the removed ones
+  std::deque<std::shared_ptr<Entry>> queue_;
+  std::size_t removed_in_queue_{0};
+  std::size_t max_size_{1};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -57,6 +57,7 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// ---- | ----------- | -------------
 /// size | max amount of items to store in cache | --
 /// ways | number of ways for associative cache | --
+/// policy | eviction policy of the cache ways, `lru`, `clock` or `tinylfu` (see cache::EvictionPolicy); `clock` does not lock on cache hits, `tinylfu` has a better hit rate on skewed workloads | lru
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
 ///
@@ -129,7 +130,8 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
       name_(components::GetCurrentComponentName(config)),
       static_config_(config),
       cache_(std::make_shared<Cache>(static_config_.ways,
-                                     static_config_.GetWaySize())) {
+                                     static_config_.GetWaySize(),
+                                     static_config_.policy)) {
   if (impl::IsDumpSupportEnabled(config)) {
     dumper_ = std::make_shared<dump::Dumper>(
         config, context, static_cast<dump::DumpableEntity&>(*this));
@@ -5,6 +5,7 @@
 #include <optional>
 #include <unordered_map>
 
+#include <userver/cache/eviction_policy.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -35,6 +36,9 @@ struct LruCacheConfig final {
 LruCacheConfig Parse(const formats::json::Value& value,
                      formats::parse::To<LruCacheConfig>);
 
+EvictionPolicy Parse(const yaml_config::YamlConfig& config,
+                     formats::parse::To<EvictionPolicy>);
+
 struct LruCacheConfigStatic final {
   explicit LruCacheConfigStatic(const yaml_config::YamlConfig& config);
   explicit LruCacheConfigStatic(const components::ComponentConfig& config);
@@ -43,6 +47,7 @@ struct LruCacheConfigStatic final {
 
   LruCacheConfig config;
   std::size_t ways;
+  EvictionPolicy policy;
   bool use_dynamic_config;
 };
 
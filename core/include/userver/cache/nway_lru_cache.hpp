@@ -1,9 +1,14 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <optional>
+#include <utility>
+#include <variant>
 #include <vector>
 
+#include <userver/cache/eviction_policy.hpp>
+#include <userver/cache/impl/clock_way.hpp>
 #include <userver/cache/lru_map.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/operations.hpp>
@@ -34,6 +39,13 @@ class NWayLRU final {
   NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(),
           const Equal& equal = Equal());
 
+  /// @param policy is the eviction policy of the ways, see
+  /// cache::EvictionPolicy. With EvictionPolicy::kClock the read path takes
+  /// no locks, EvictionPolicy::kTinyLfu improves the hit rate on skewed
+  /// workloads.
+  NWayLRU(size_t ways, size_t way_size, EvictionPolicy policy,
+          const Hash& hash = Hash(), const Equal& equal = Equal());
+
   void Put(const T& key, U value);
 
   template <typename Validator>
@@ -67,14 +79,49 @@ class NWayLRU final {
   void SetDumper(std::shared_ptr<dump::Dumper> dumper);
 
  private:
+  using ClockWay = impl::ClockWay<T, U, Hash, Equal>;
+
+  using LruWay = LruMap<T, U, Hash, Equal, EvictionPolicy::kLru>;
+  using TinyLfuWay = LruMap<T, U, Hash, Equal, EvictionPolicy::kTinyLfu>;
+
   struct Way {
-    Way(Way&& other) noexcept : cache(std::move(other.cache)) {}
+    Way(Way&& other) noexcept
+        : cache(std::move(other.cache)), clock(std::move(other.clock)) {}
 
     // max_size is not used, will be reset by Resize() in NWayLRU::NWayLRU
-    Way(const Hash& hash, const Equal& equal) : cache(1, hash, equal) {}
+    Way(EvictionPolicy policy, const Hash& hash, const Equal& equal)
+        : cache(MakeCache(policy, hash, equal)),
+          clock(policy == EvictionPolicy::kClock
+                    ? std::make_unique<ClockWay>(hash, equal)
+                    : nullptr) {}
+
+    /// Calls func(cache) with the cache of the way, `mutex` must be locked
+    template <typename Function>
+    decltype(auto) Visit(Function&& func) {
+      return std::visit(std::forward<Function>(func), cache);
+    }
+
+    template <typename Function>
+    decltype(auto) Visit(Function&& func) const {
+      return std::visit(std::forward<Function>(func), cache);
+    }
 
     mutable engine::Mutex mutex;
-    LruMap<T, U, Hash, Equal> cache;
+    std::variant<LruWay, TinyLfuWay> cache;
+    // Used instead of `mutex` and `cache` for EvictionPolicy::kClock
+    std::unique_ptr<ClockWay> clock;
+
+   private:
+    static std::variant<LruWay, TinyLfuWay> MakeCache(EvictionPolicy policy,
+                                                      const Hash& hash,
+                                                      const Equal& equal) {
+      if (policy == EvictionPolicy::kTinyLfu) {
+        return std::variant<LruWay, TinyLfuWay>{
+            std::in_place_type<TinyLfuWay>, 1, hash, equal};
+      }
+      return std::variant<LruWay, TinyLfuWay>{std::in_place_type<LruWay>, 1,
+                                              hash, equal};
+    }
   };
 
   Way& GetWay(const T& key);
@@ -89,20 +136,28 @@ class NWayLRU final {
 template <typename T, typename U, typename Hash, typename Eq>
 NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
                                  const Eq& equal)
+    : NWayLRU(ways, way_size, EvictionPolicy::kLru, hash, equal) {}
+
+template <typename T, typename U, typename Hash, typename Eq>
+NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size,
+                                 EvictionPolicy policy, const Hash& hash,
+                                 const Eq& equal)
     : caches_(), hash_fn_(hash) {
   caches_.reserve(ways);
-  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
+  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(policy, hash, equal);
   if (ways == 0) throw std::logic_error("Ways must be positive");
 
-  for (auto& way : caches_) way.cache.SetMaxSize(way_size);
+  UpdateWaySize(way_size);
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
   auto& way = GetWay(key);
-  {
+  if (way.clock) {
+    way.clock->Put(key, std::move(value));
+  } else {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Put(key, std::move(value));
+    way.Visit([&](auto& cache) { cache.Put(key, std::move(value)); });
   }
   NotifyDumper();
 }
@@ -112,23 +167,29 @@ template <typename Validator>
 std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
                                               Validator validator) {
   auto& way = GetWay(key);
+  if (way.clock) return way.clock->Get(key, validator);
+
   std::unique_lock<engine::Mutex> lock(way.mutex);
-  auto* value = way.cache.Get(key);
+  return way.Visit([&](auto& cache) -> std::optional<U> {
+    auto* value = cache.Get(key);
 
-  if (value) {
-    if (validator(*value)) return *value;
-    way.cache.Erase(key);
-  }
+    if (value) {
+      if (validator(*value)) return *value;
+      cache.Erase(key);
+    }
 
-  return std::nullopt;
+    return std::nullopt;
+  });
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
   auto& way = GetWay(key);
-  {
+  if (way.clock) {
+    way.clock->Erase(key);
+  } else {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Erase(key);
+    way.Visit([&key](auto& cache) { cache.Erase(key); });
   }
   NotifyDumper();
 }
@@ -136,15 +197,25 @@ void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
 template <typename T, typename U, typename Hash, typename Eq>
 U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
   auto& way = GetWay(key);
+  if (way.clock) {
+    auto value = way.clock->Get(key, [](const U&) { return true; });
+    return value ? std::move(*value) : default_value;
+  }
+
   std::unique_lock<engine::Mutex> lock(way.mutex);
-  return way.cache.GetOr(key, default_value);
+  return way.Visit(
+      [&](auto& cache) { return cache.GetOr(key, default_value); });
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Invalidate() {
   for (auto& way : caches_) {
+    if (way.clock) {
+      way.clock->Clear();
+      continue;
+    }
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Clear();
+    way.Visit([](auto& cache) { cache.Clear(); });
   }
   NotifyDumper();
 }
@@ -153,8 +224,12 @@ template <typename T, typename U, typename Hash, typename Eq>
 template <typename Function>
 void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
   for (const auto& way : caches_) {
+    if (way.clock) {
+      way.clock->VisitAll(func);
+      continue;
+    }
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.VisitAll(func);
+    way.Visit([&func](const auto& cache) { cache.VisitAll(func); });
   }
 }
 
@@ -162,8 +237,12 @@ template <typename T, typename U, typename Hash, typename Eq>
 size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
   size_t size{0};
   for (const auto& way : caches_) {
+    if (way.clock) {
+      size += way.clock->GetSize();
+      continue;
+    }
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    size += way.cache.GetSize();
+    size += way.Visit([](const auto& cache) { return cache.GetSize(); });
   }
   return size;
 }
@@ -171,8 +250,12 @@ size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
   for (auto& way : caches_) {
+    if (way.clock) {
+      way.clock->SetMaxSize(way_size);
+      continue;
+    }
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.SetMaxSize(way_size);
+    way.Visit([way_size](auto& cache) { cache.SetMaxSize(way_size); });
   }
 }
 
@@ -194,13 +277,29 @@ void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
   writer.Write(caches_.size());
 
   for (const Way& way : caches_) {
+    if (way.clock) {
+      std::vector<std::pair<T, U>> items;
+      way.clock->VisitAll([&items](const T& key, const U& value) {
+        items.emplace_back(key, value);
+      });
+
+      writer.Write(items.size());
+      for (const auto& [key, value] : items) {
+        writer.Write(key);
+        writer.Write(value);
+      }
+      continue;
+    }
+
     std::unique_lock<engine::Mutex> lock(way.mutex);
 
-    writer.Write(way.cache.GetSize());
+    way.Visit([&writer](const auto& cache) {
+      writer.Write(cache.GetSize());
 
-    way.cache.VisitAll([&writer](const T& key, const U& value) {
-      writer.Write(key);
-      writer.Write(value);
+      cache.VisitAll([&writer](const T& key, const U& value) {
+        writer.Write(key);
+        writer.Write(value);
+      });
     });
   }
 }
@@ -46,6 +46,7 @@ class ThreadPool;
 namespace clients::http {
 namespace impl {
 class EasyWrapper;
+class EndpointBalancer;
 }  // namespace impl
 
 struct TestsuiteConfig;
@@ -136,6 +137,10 @@ class Client final {
 
   size_t FindMultiIndex(const curl::multi*) const;
 
+  // Rebinds the easy and its request statistics to the multi that serves the
+  // host of its URL if host affinity is enabled
+  void BindToHostMulti(curl::easy& easy, RequestStats& stats);
+
   // Functions for EasyWrapper that must be noexcept, as they are called from
   // the EasyWrapper destructor.
   friend class impl::EasyWrapper;
@@ -149,6 +154,9 @@ class Client final {
 
   const DeadlinePropagationConfig deadline_propagation_config_;
   CancellationPolicy cancellation_policy_;
+  const bool host_affinity_;
+  // nullptr if client side balancing is disabled
+  std::unique_ptr<impl::EndpointBalancer> endpoint_balancer_;
 
   std::shared_ptr<DestinationStatistics> destination_statistics_;
   std::unique_ptr<engine::ev::ThreadPool> thread_pool_;
@@ -38,6 +38,8 @@ namespace components {
 /// thread-name-prefix | set OS thread name to this value | ''
 /// threads | number of threads to process low level HTTP related IO system calls | 8
 /// defer-events | whether to defer events execution to a periodic timer; might affect timings a bit, might boost performance, use with care | false
+/// host-affinity | perform all the requests to the same scheme, host and port on the same IO thread to reuse its warm keepalive connections; the connection pool of a single IO thread is `HTTP_CLIENT_CONNECTION_POOL_SIZE / threads`, so do not enable it for clients with a few very hot upstreams | false
+/// client-side-balancing | spread the requests between all the addresses of the host, preferring the fastest and the least loaded ones and temporarily skipping the ones that fail; works only with `dns_resolver: async` | false
 /// fs-task-processor | task processor to run blocking HTTP related calls, like DNS resolving or hosts reading | -
 /// destination-metrics-auto-max-size | set max number of automatically created destination metrics | 100
 /// user-agent | User-Agent HTTP header to show on all requests, result of utils::GetUserverIdentifier() if empty | empty
@@ -36,6 +36,8 @@ struct ClientSettings final {
   std::string thread_name_prefix{};
   size_t io_threads{8};
   bool defer_events{false};
+  bool host_affinity{false};
+  bool client_side_balancing{false};
   DeadlinePropagationConfig deadline_propagation{};
   const tracing::TracingManagerBase* tracing_manager{nullptr};
   const server::http::HeadersPropagator* headers_propagator{nullptr};
@@ -0,0 +1,89 @@
+#pragma once
+
+/// @file userver/clients/http/hedged_request.hpp
+/// @brief Hedged HTTP requests
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include <userver/clients/http/request.hpp>
+#include <userver/clients/http/response.hpp>
+#include <userver/utils/function_ref.hpp>
+#include <userver/utils/retry_budget.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+class Writer;
+}  // namespace utils::statistics
+
+namespace clients::http {
+
+/// Settings of clients::http::PerformHedged
+struct HedgingSettings final {
+  /// If no response arrived within the delay after the last attempt was
+  /// started, another attempt (hedge) is sent. A good value is about the p95
+  /// of the upstream response time.
+  std::chrono::milliseconds delay{50};
+
+  /// Maximum number of attempts, including the original one
+  std::size_t max_attempts{2};
+};
+
+/// @brief Limits the share of hedges sent to a destination, like
+/// utils::RetryBudget limits retries, and gathers the hedging statistics.
+///
+/// Each request earns `token_ratio` tokens and each hedge spends one, hedges
+/// are not sent while less than half of `max_tokens` is left. With the
+/// default settings at most about 10% of requests get a hedge in a long run.
+///
+/// Use a separate budget for each destination. Thread-safe.
+class HedgingBudget final {
+ public:
+  HedgingBudget();
+  explicit HedgingBudget(const utils::RetryBudgetSettings& settings);
+
+  /// Not thread-safe relative other SetSettings method calls.
+  void SetSettings(const utils::RetryBudgetSettings& settings);
+
+  /// @cond
+  // For internal use by PerformHedged
+  void AccountRequest() noexcept;
+  bool TryStartHedge() noexcept;
+  void AccountHedgeWon() noexcept;
+  /// @endcond
+
+ private:
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const HedgingBudget& budget);
+
+  utils::RetryBudget budget_;
+  utils::statistics::RateCounter requests_;
+  utils::statistics::RateCounter hedges_sent_;
+  utils::statistics::RateCounter hedges_won_;
+  utils::statistics::RateCounter hedges_throttled_;
+};
+
+/// @brief Performs a hedged request: starts the request returned by
+/// `factory`, and while none of the started requests has responded starts
+/// a new one every `settings.delay`, as long as `settings.max_attempts` and
+/// the `budget` allow.
+///
+/// Returns the first response that is not a 5xx, the other attempts are
+/// cancelled. If all the attempts failed, returns the last 5xx response or
+/// rethrows the last exception.
+///
+/// The factory should return a new clients::http::Request to the same
+/// destination on each call. Retries of each attempt are configured by the
+/// factory as usual via clients::http::Request::retry.
+///
+/// @snippet clients/http/hedged_request_test.cpp  Sample hedged request
+std::shared_ptr<Response> PerformHedged(utils::function_ref<Request()> factory,
+                                        const HedgingSettings& settings,
+                                        HedgingBudget& budget);
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
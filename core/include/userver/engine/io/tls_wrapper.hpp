@@ -3,6 +3,9 @@
 /// @file userver/engine/io/tls_wrapper.hpp
 /// @brief TLS socket wrappers
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -17,6 +20,56 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 
+/// @brief Server side TLS context that is shared between connections.
+///
+/// Holds the certificate, the private key and the TLS session state, so that
+/// clients may resume their sessions with an abbreviated handshake either via
+/// the server side session cache or via session tickets.
+///
+/// Thread safe.
+class TlsServerContext final {
+ public:
+  struct Settings {
+    crypto::Certificate cert;
+    crypto::PrivateKey key;
+    std::vector<crypto::Certificate> cert_authorities;
+    /// ALPN protocols in the order of server preference
+    std::vector<std::string> alpn_protocols;
+    /// Whether to issue session tickets for stateless session resumption
+    bool session_tickets{true};
+    /// Max number of sessions in the server side session cache, 0 disables
+    /// the cache
+    std::size_t session_cache_size{20480};
+  };
+
+  explicit TlsServerContext(const Settings& settings);
+  ~TlsServerContext();
+
+  TlsServerContext(const TlsServerContext&) = delete;
+  TlsServerContext& operator=(const TlsServerContext&) = delete;
+
+  struct HandshakeStats {
+    std::uint64_t full{0};
+    std::uint64_t resumed{0};
+  };
+
+  /// @brief Replaces the settings for newly accepted connections.
+  ///
+  /// Session ticket keys are preserved, so the tickets issued before the
+  /// reload remain valid. The session cache starts empty.
+  void Reload(const Settings& settings);
+
+  /// @returns the number of full and abbreviated (resumed) handshakes of the
+  /// connections accepted with this context
+  HandshakeStats GetHandshakeStats() const;
+
+ private:
+  friend class TlsWrapper;
+
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 /// Class for TLS communications over a Socket.
 ///
 /// Not thread safe. E.g. you MAY NOT read and write concurrently from multiple
@@ -31,11 +84,29 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
                                    const std::string& server_name,
                                    Deadline deadline);
 
-  /// Starts a TLS server on an opened socket
+  /// Starts a TLS client on an opened socket and offers the server to resume
+  /// the session obtained via GetSessionData() of a previous connection. The
+  /// handshake is a full one if the server declines the session.
+  static TlsWrapper StartTlsClient(Socket&& socket,
+                                   const std::string& server_name,
+                                   const std::string& session_data,
+                                   Deadline deadline);
+
+  /// Starts a TLS server on an opened socket.
+  ///
+  /// If `alpn_protocols` is not empty, the first of them (in the order of
+  /// server preference) that is supported by the client is negotiated via
+  /// ALPN, see GetAlpnProtocol().
   static TlsWrapper StartTlsServer(
       Socket&& socket, const crypto::Certificate& cert,
       const crypto::PrivateKey& key, Deadline deadline,
-      const std::vector<crypto::Certificate>& cert_authorities = {});
+      const std::vector<crypto::Certificate>& cert_authorities = {},
+      const std::vector<std::string>& alpn_protocols = {});
+
+  /// Starts a TLS server on an opened socket using a shared context.
+  static TlsWrapper StartTlsServer(Socket&& socket,
+                                   const TlsServerContext& context,
+                                   Deadline deadline);
 
   ~TlsWrapper() override;
 
@@ -96,6 +167,20 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
 
   int GetRawFd();
 
+  /// @returns the application protocol negotiated via ALPN, or an empty string
+  /// if none was negotiated.
+  std::string GetAlpnProtocol() const;
+
+  /// @returns whether the TLS session was resumed, i.e. the handshake was
+  /// an abbreviated one.
+  bool IsSessionReused() const;
+
+  /// @returns serialized TLS session that may be resumed by a new client
+  /// connection, or an empty string if the session is not resumable.
+  /// @note With TLS 1.3 the session is available only after some data is
+  /// received from the server.
+  std::string GetSessionData() const;
+
  private:
   explicit TlsWrapper(Socket&&);
 
@@ -47,8 +47,9 @@ namespace components {
 /// ---- | ----------- | -------------
 /// file_path | path to the log file | -
 /// level | log verbosity | info
-/// format | log output format, either `tskv` or `ltsv` | tskv
+/// format | log output format, either `tskv`, `ltsv` or `binary`; `binary` is the cheapest to write, convert it to TSKV with `binary-log-decoder` from `tools/` | tskv
 /// flush_level | messages of this and higher levels get flushed to the file immediately | warning
+/// compression | compression of the log file: `none` or `gzip`, the latter writes the records as a separate gzip member at most once a second or every 1MB, so the file is readable with `zcat` while being written | none
 /// message_queue_size | the size of internal message queue, must be a power of 2 | 65536
 /// overflow_behavior | message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue | discard
 /// testsuite-capture | if exists, setups additional TCP log sink for testing purposes | {}
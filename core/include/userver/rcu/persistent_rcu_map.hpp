@@ -0,0 +1,350 @@
+#pragma once
+
+/// @file userver/rcu/persistent_rcu_map.hpp
+/// @brief @copybrief rcu::PersistentRcuMap
+
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include <userver/rcu/rcu.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/persistent_hash_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace rcu {
+
+/// @brief Forward iterator for the rcu::PersistentRcuMap
+///
+/// Holds an O(1) snapshot of the map, so it does not prevent the
+/// reclamation of the newer versions of the map.
+///
+/// Use member functions of rcu::PersistentRcuMap to retrieve the iterator.
+template <typename Key, typename Value, typename IterValue,
+          typename RcuMapTraits>
+class PersistentRcuMapIterator final {
+  using MapType =
+      utils::PersistentHashMap<Key, std::shared_ptr<Value>,
+                               typename RcuMapTraits::Hash,
+                               typename RcuMapTraits::KeyEqual>;
+
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using difference_type = ptrdiff_t;
+  using value_type = std::pair<Key, std::shared_ptr<IterValue>>;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  PersistentRcuMapIterator() = default;
+
+  PersistentRcuMapIterator operator++(int) {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  PersistentRcuMapIterator& operator++() {
+    ++it_;
+    UpdateCurrent();
+    return *this;
+  }
+
+  reference operator*() const { return current_; }
+  pointer operator->() const { return &current_; }
+
+  bool operator==(const PersistentRcuMapIterator& rhs) const {
+    return it_ == rhs.it_;
+  }
+  bool operator!=(const PersistentRcuMapIterator& rhs) const {
+    return !(*this == rhs);
+  }
+
+  /// @cond
+  /// For internal use only
+  explicit PersistentRcuMapIterator(MapType&& snapshot)
+      : snapshot_(std::move(snapshot)), it_(snapshot_.begin()) {
+    UpdateCurrent();
+  }
+  /// @endcond
+
+ private:
+  void UpdateCurrent() {
+    if (it_ != snapshot_.end()) current_ = *it_;
+  }
+
+  MapType snapshot_;
+  typename MapType::const_iterator it_;
+  value_type current_;
+};
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief Map-like structure allowing RCU keyset updates without copying
+/// the whole map.
+///
+/// Has the same interface as rcu::RcuMap, but the keyset is stored in
+/// a utils::PersistentHashMap under rcu::Variable. A keyset change (e.g.
+/// insert or erase) copies only O(log(size)) trie nodes instead of the whole
+/// map, and starting an iteration or taking a snapshot is O(1).
+///
+/// Prefer it over rcu::RcuMap for big maps with a frequently changing set of
+/// keys. rcu::RcuMap is faster for lookups and iteration of rarely changing
+/// maps.
+///
+/// Only keyset changes are thread-safe in scope of this class. Keyset
+/// changes are serialized on `RcuMapTraits::MutexType`.
+/// @note No synchronization is provided for value access, it must be
+/// implemented by Value when necessary.
+///
+/// ## Example usage:
+///
+/// @snippet rcu/persistent_rcu_map_test.cpp  Sample rcu::PersistentRcuMap usage
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+template <typename Key, typename Value, typename RcuMapTraits>
+class PersistentRcuMap final {
+  using RcuTraits = typename impl::RcuTraitsFromRcuMapTraits<RcuMapTraits>;
+
+ public:
+  static_assert(!std::is_reference_v<Key>);
+  static_assert(!std::is_reference_v<Value>);
+  static_assert(!std::is_const_v<Key>);
+
+  template <typename ValuePtrType>
+  struct InsertReturnTypeImpl;
+
+  using Hash = typename RcuMapTraits::Hash;
+  using KeyEqual = typename RcuMapTraits::KeyEqual;
+  using MutexType = typename RcuMapTraits::MutexType;
+  using ValuePtr = std::shared_ptr<Value>;
+  using Iterator = PersistentRcuMapIterator<Key, Value, Value, RcuMapTraits>;
+  using ConstValuePtr = std::shared_ptr<const Value>;
+  using ConstIterator =
+      PersistentRcuMapIterator<Key, Value, const Value, RcuMapTraits>;
+  using RawMap = utils::PersistentHashMap<Key, ValuePtr, Hash, KeyEqual>;
+  using Snapshot = std::unordered_map<Key, ConstValuePtr, Hash, KeyEqual>;
+  using InsertReturnType = InsertReturnTypeImpl<ValuePtr>;
+
+  PersistentRcuMap() = default;
+
+  PersistentRcuMap(const PersistentRcuMap&) = delete;
+  PersistentRcuMap(PersistentRcuMap&&) = delete;
+  PersistentRcuMap& operator=(const PersistentRcuMap&) = delete;
+  PersistentRcuMap& operator=(PersistentRcuMap&&) = delete;
+
+  /// Returns an estimated size of the map at some point in time
+  size_t SizeApprox() const {
+    auto ptr = rcu_.Read();
+    return ptr->size();
+  }
+
+  /// @name Iteration support
+  /// @details Keyset is fixed at the start of the iteration and is not affected
+  /// by concurrent changes.
+  /// @{
+  ConstIterator begin() const { return ConstIterator{rcu_.ReadCopy()}; }
+  ConstIterator end() const { return {}; }
+  Iterator begin() { return Iterator{rcu_.ReadCopy()}; }
+  Iterator end() { return {}; }
+  /// @}
+
+  /// @brief Returns a readonly value pointer by its key if exists
+  /// @throws MissingKeyException if the key is not present
+  const ConstValuePtr operator[](const Key&) const;
+
+  /// @brief Returns a modifiable value pointer by key if exists or
+  /// default-creates one
+  const ValuePtr operator[](const Key&);
+
+  /// @brief Inserts a new element into the container if there is no element
+  /// with the key in the container.
+  /// Returns a pair consisting of a pointer to the inserted element, or the
+  /// already-existing element if no insertion happened, and a bool denoting
+  /// whether the insertion took place.
+  InsertReturnType Insert(const Key& key, ValuePtr value);
+
+  /// @brief Inserts a new element into the container constructed in-place with
+  /// the given args if there is no element with the key in the container.
+  /// @see Insert
+  template <typename... Args>
+  InsertReturnType Emplace(const Key& key, Args&&... args);
+
+  /// @brief If a key equivalent to `key` already exists in the container, does
+  /// nothing. Otherwise, behaves like `Emplace`, but constructs the value
+  /// under the writer's lock.
+  template <typename... Args>
+  InsertReturnType TryEmplace(const Key& key, Args&&... args);
+
+  /// @brief If a key equivalent to `key` already exists in the container,
+  /// replaces the associated value. Otherwise, inserts a new pair into the map.
+  template <typename RawKey>
+  void InsertOrAssign(RawKey&& key, ValuePtr value);
+
+  /// @brief Returns a readonly value pointer by its key or an empty pointer
+  const ConstValuePtr Get(const Key&) const;
+
+  /// @brief Returns a modifiable value pointer by key or an empty pointer
+  const ValuePtr Get(const Key&);
+
+  /// @brief Removes a key from the map
+  /// @returns whether the key was present
+  bool Erase(const Key&);
+
+  /// @brief Removes a key from the map returning its value
+  /// @returns a value if the key was present, empty pointer otherwise
+  ValuePtr Pop(const Key&);
+
+  /// Resets the map to an empty state
+  void Clear() { rcu_.Assign({}); }
+
+  /// Replace current data by data from `new_map`.
+  void Assign(RawMap new_map) { rcu_.Assign(std::move(new_map)); }
+
+  /// @brief Starts a transaction, used to perform a series of arbitrary changes
+  /// to the map.
+  /// @details The map is copied in O(1). Don't forget to `Commit` to apply
+  /// the changes.
+  rcu::WritablePtr<RawMap, RcuTraits> StartWrite() {
+    return rcu_.StartWrite();
+  }
+
+  /// @brief Returns a readonly copy of the map
+  /// @note Equivalent to `{begin(), end()}` construct, preferable
+  /// for long-running operations.
+  Snapshot GetSnapshot() const { return {begin(), end()}; }
+
+ private:
+  template <typename ValueFactory>
+  InsertReturnType DoInsert(const Key& key, ValueFactory&& factory);
+
+  rcu::Variable<RawMap, RcuTraits> rcu_;
+};
+
+template <typename K, typename V, typename RcuMapTraits>
+template <typename ValuePtrType>
+struct PersistentRcuMap<K, V, RcuMapTraits>::InsertReturnTypeImpl {
+  ValuePtrType value;
+  bool inserted;
+};
+
+template <typename K, typename V, typename RcuMapTraits>
+// Protects from assignment to map[key]
+// NOLINTNEXTLINE(readability-const-return-type)
+const typename PersistentRcuMap<K, V, RcuMapTraits>::ConstValuePtr
+PersistentRcuMap<K, V, RcuMapTraits>::operator[](const K& key) const {
+  if (auto value = Get(key)) {
+    return value;
+  }
+  throw MissingKeyException("Key ") << key << " is missing";
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+// Protects from assignment to map[key]
+// NOLINTNEXTLINE(readability-const-return-type)
+const typename PersistentRcuMap<K, V, RcuMapTraits>::ValuePtr
+PersistentRcuMap<K, V, RcuMapTraits>::operator[](const K& key) {
+  if (auto value = Get(key)) return value;
+  return DoInsert(key, [] { return std::make_shared<V>(); }).value;
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+typename PersistentRcuMap<K, V, RcuMapTraits>::InsertReturnType
+PersistentRcuMap<K, V, RcuMapTraits>::Insert(const K& key, ValuePtr value) {
+  InsertReturnType result{Get(key), false};
+  if (result.value) return result;
+
+  return DoInsert(key, [&value] { return std::move(value); });
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+template <typename... Args>
+typename PersistentRcuMap<K, V, RcuMapTraits>::InsertReturnType
+PersistentRcuMap<K, V, RcuMapTraits>::Emplace(const K& key, Args&&... args) {
+  InsertReturnType result{Get(key), false};
+  if (result.value) return result;
+
+  auto value = std::make_shared<V>(std::forward<Args>(args)...);
+  return DoInsert(key, [&value] { return std::move(value); });
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+template <typename... Args>
+typename PersistentRcuMap<K, V, RcuMapTraits>::InsertReturnType
+PersistentRcuMap<K, V, RcuMapTraits>::TryEmplace(const K& key, Args&&... args) {
+  InsertReturnType result{Get(key), false};
+  if (result.value) return result;
+
+  return DoInsert(key, [&] {
+    return std::make_shared<V>(std::forward<Args>(args)...);
+  });
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+template <typename ValueFactory>
+typename PersistentRcuMap<K, V, RcuMapTraits>::InsertReturnType
+PersistentRcuMap<K, V, RcuMapTraits>::DoInsert(const K& key,
+                                               ValueFactory&& factory) {
+  auto txn = rcu_.StartWrite();
+  const auto it = txn->find(key);
+  if (it != txn->end()) return {it->second, false};
+
+  InsertReturnType result{factory(), true};
+  txn->insert_or_assign(key, result.value);
+  txn.Commit();
+  return result;
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+template <typename RawKey>
+void PersistentRcuMap<K, V, RcuMapTraits>::InsertOrAssign(RawKey&& key,
+                                                          ValuePtr value) {
+  auto txn = rcu_.StartWrite();
+  txn->insert_or_assign(std::forward<RawKey>(key), std::move(value));
+  txn.Commit();
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+// Protects from assignment to map[key]
+// NOLINTNEXTLINE(readability-const-return-type)
+const typename PersistentRcuMap<K, V, RcuMapTraits>::ConstValuePtr
+PersistentRcuMap<K, V, RcuMapTraits>::Get(const K& key) const {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  return const_cast<PersistentRcuMap<K, V, RcuMapTraits>*>(this)->Get(key);
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+// Protects from assignment to map[key]
+// NOLINTNEXTLINE(readability-const-return-type)
+const typename PersistentRcuMap<K, V, RcuMapTraits>::ValuePtr
+PersistentRcuMap<K, V, RcuMapTraits>::Get(const K& key) {
+  auto snapshot = rcu_.Read();
+  const auto it = snapshot->find(key);
+  if (it == snapshot->end()) return {};
+  return it->second;
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+bool PersistentRcuMap<K, V, RcuMapTraits>::Erase(const K& key) {
+  return Pop(key) != nullptr;
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+typename PersistentRcuMap<K, V, RcuMapTraits>::ValuePtr
+PersistentRcuMap<K, V, RcuMapTraits>::Pop(const K& key) {
+  if (!Get(key)) return {};
+
+  auto txn = rcu_.StartWrite();
+  const auto it = txn->find(key);
+  if (it == txn->end()) return {};
+
+  auto value = it->second;
+  txn->erase(key);
+  txn.Commit();
+  return value;
+}
+
+}  // namespace rcu
+
+USERVER_NAMESPACE_END
@@ -95,6 +95,7 @@ class RcuMapIterator final {
 /// Values are stored in `shared_ptr`s and are not copied during keyset change.
 /// The map itself is implemented as rcu::Variable, so every keyset change
 /// (e.g. insert or erase) triggers the whole map copying.
+/// Use rcu::PersistentRcuMap for big maps with a frequently changing keyset.
 /// @note No synchronization is provided for value access, it must be
 /// implemented by Value when necessary.
 ///
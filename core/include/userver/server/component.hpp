@@ -6,6 +6,7 @@
 #include <memory>
 
 #include <userver/components/loggable_component_base.hpp>
+#include <userver/concurrent/async_event_source.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/server/server.hpp>
 #include <userver/utils/statistics/entry.hpp>
@@ -63,9 +64,11 @@ namespace components {
 /// task_processor | task processor to process incoming requests | -
 /// backlog | max count of new connections pending acceptance | 1024
 /// tls.ca | paths to TLS CAs for client authentication | -
-/// tls.cert | path to TLS server certificate | -
+/// tls.cert | path to TLS server certificate; the certificate, the private key and the CAs are reread on secdist updates if the periodic secdist update is enabled | -
 /// tls.private-key | path to TLS server certificate private key | -
 /// tls.private-key-passphrase-name | passphrase name located in secdist's "passphrases" section | -
+/// tls.session-tickets | whether to issue TLS session tickets for stateless session resumption | true
+/// tls.session-cache-size | max number of TLS sessions in the server side session cache, 0 disables the cache | 20480
 /// handler-defaults.max_url_size | max path/URL size or empty to not limit | 8192
 /// handler-defaults.max_request_size | max size of the whole request | 1024 * 1024
 /// handler-defaults.max_headers_size | max request headers size | 65536
@@ -77,7 +80,11 @@ namespace components {
 /// connection.requests_queue_size_threshold | drop requests from handlers that allow throttling if there's more pending requests than allowed by this value | 100
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
 /// connection.stream_close_check_delay | delay in microseconds of the start of stream close check routine; do not set if not sure what it is doing | 20ms
-/// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
+/// connection.max_pipelined_requests | how many pipelined HTTP/1.1 requests from a single connection are processed concurrently, responses are still sent in order | 1
+/// connection.http2.enabled | whether to serve HTTP/2 with prior knowledge on plain connections and via ALPN on TLS connections | false
+/// connection.http2.max_concurrent_streams | max count of concurrently processed streams of a single HTTP/2 connection | 100
+/// connection.http2.initial_window_size | initial HTTP/2 flow control window size of a stream in bytes | 65535
+/// shards | how many sockets are bound to the same port with SO_REUSEPORT, each one with its own accept task; the kernel spreads incoming connections between them. Unix sockets always use a single one | number of event threads
 /// middleware-pipeline-builder | name of a component to build a server-wide middleware pipeline | default-server-middleware-pipeline-builder
 ///
 /// @see @ref scripts/docs/en/userver/http_server.md
@@ -110,10 +117,12 @@ class Server final : public LoggableComponentBase {
 
  private:
   void WriteStatistics(utils::statistics::Writer& writer);
+  void OnSecdistUpdate(const storages::secdist::SecdistConfig& secdist);
 
   std::unique_ptr<server::Server> server_;
   utils::statistics::Entry server_statistics_holder_;
   utils::statistics::Entry handler_statistics_holder_;
+  concurrent::AsyncEventSubscriberScope secdist_subscriber_;
 };
 
 template <>
@@ -4,6 +4,7 @@
 /// @brief @copybrief server::http::HttpResponse
 
 #include <chrono>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -13,6 +14,7 @@
 #include <userver/http/header_map.hpp>
 #include <userver/server/http/http_response_cookie.hpp>
 #include <userver/server/request/response_base.hpp>
+#include <userver/utils/function_ref.hpp>
 #include <userver/utils/impl/projecting_view.hpp>
 #include <userver/utils/str_icase.hpp>
 
@@ -123,6 +125,25 @@ class HttpResponse final : public request::ResponseBase {
   /// @cond
   // TODO: server internals. remove from public interface
   void SendResponse(engine::io::RwBase& socket) override;
+
+  // HTTP/2 framing is done by the server, the response only provides the
+  // fields of its header block and the parts of its streamed body.
+  using Http2HeaderVisitor =
+      utils::function_ref<void(std::string_view name, std::string_view value)>;
+  void VisitHttp2Headers(Http2HeaderVisitor visitor);
+  bool PopBodyPart(std::string& body_part);
+  void SetHttp2Sent(std::size_t bytes_sent);
+
+  // Applies a content coding to the parts of a streamed body
+  class StreamBodyEncoder {
+   public:
+    virtual ~StreamBodyEncoder() = default;
+
+    virtual std::string Encode(std::string_view body_part) = 0;
+    // Returns the encoded data that follows the last body part
+    virtual std::string Finish() = 0;
+  };
+  void SetStreamBodyEncoder(std::unique_ptr<StreamBodyEncoder> encoder);
   /// @endcond
 
   void SetStatusServiceUnavailable() override {
@@ -161,6 +182,7 @@ class HttpResponse final : public request::ResponseBase {
       engine::SingleConsumerEvent::NoAutoReset()};
   std::optional<Queue::Consumer> body_stream_;
   std::optional<Queue::Producer> body_stream_producer_;
+  std::unique_ptr<StreamBodyEncoder> body_stream_encoder_;
 };
 
 void SetThrottleReason(http::HttpResponse& http_response,
@@ -57,6 +57,10 @@ class Server final : public congestion_control::Limitee,
 
   void Stop();
 
+  /// Rereads the TLS certificates and private keys of the listeners for the
+  /// new connections
+  void ReloadTls(const storages::secdist::SecdistConfig& secdist);
+
   RequestsView& GetRequestsView();
 
   void SetLimit(std::optional<size_t> new_limit) override;
@@ -46,6 +46,12 @@ void CombineStatistics(const impl::UpdateStatistics& a,
                b.last_successful_update_start_time.load());
   result.last_update_duration =
       std::max(a.last_update_duration.load(), b.last_update_duration.load());
+  result.last_update_fetch_duration =
+      std::max(a.last_update_fetch_duration.load(),
+               b.last_update_fetch_duration.load());
+  result.last_update_parse_duration =
+      std::max(a.last_update_parse_duration.load(),
+               b.last_update_parse_duration.load());
 }
 
 }  // namespace
@@ -74,6 +80,10 @@ void DumpMetric(utils::statistics::Writer& writer,
         std::chrono::duration_cast<std::chrono::milliseconds>(
             stats.last_update_duration.load())
             .count();
+    age["last-update-fetch-duration-ms"] =
+        stats.last_update_fetch_duration.load().count();
+    age["last-update-parse-duration-ms"] =
+        stats.last_update_parse_duration.load().count();
   }
 }
 
@@ -137,6 +147,21 @@ void UpdateStatisticsScope::IncreaseDocumentsParseFailures(std::size_t add) {
   update_stats_.documents_parse_failures += add;
 }
 
+void UpdateStatisticsScope::SetStageDurations(
+    std::chrono::milliseconds fetch, std::chrono::milliseconds parse) {
+  update_stats_.last_update_fetch_duration = fetch;
+  update_stats_.last_update_parse_duration =
+      parse + std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::duration{
+                      helper_parse_duration_.load()});
+}
+
+void UpdateStatisticsScope::AddParseDuration(
+    std::chrono::steady_clock::duration duration) {
+  helper_parse_duration_.fetch_add(duration.count(),
+                                   std::memory_order_relaxed);
+}
+
 void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
   UASSERT(new_state != impl::UpdateState::kNotFinished);
   // TODO Some production caches call Finish multiple times. We should fix those
@@ -53,6 +53,14 @@ properties:
     ways:
         type: integer
         description: number of ways for associative cache
+    policy:
+        type: string
+        description: eviction policy of the cache ways
+        defaultDescription: lru
+        enum:
+          - lru
+          - clock
+          - tinylfu
     lifetime:
         type: string
         description: TTL for cache entries (0 is unlimited)
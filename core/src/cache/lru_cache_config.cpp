@@ -6,6 +6,7 @@
 #include <userver/dump/config.hpp>
 #include <userver/dynamic_config/value.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/trivial_map.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,11 +15,19 @@ namespace cache {
 namespace {
 
 constexpr std::string_view kWays = "ways";
+constexpr std::string_view kPolicy = "policy";
 constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
 
+constexpr utils::TrivialBiMap kEvictionPolicyMap([](auto selector) {
+  return selector()
+      .Case(EvictionPolicy::kLru, "lru")
+      .Case(EvictionPolicy::kClock, "clock")
+      .Case(EvictionPolicy::kTinyLfu, "tinylfu");
+});
+
 }  // namespace
 
 using dump::impl::ParseMs;
@@ -54,10 +63,16 @@ LruCacheConfig Parse(const formats::json::Value& value,
   return LruCacheConfig{value};
 }
 
+EvictionPolicy Parse(const yaml_config::YamlConfig& config,
+                     formats::parse::To<EvictionPolicy>) {
+  return utils::ParseFromValueString(config, kEvictionPolicyMap);
+}
+
 LruCacheConfigStatic::LruCacheConfigStatic(
     const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
+      policy(config[kPolicy].As<EvictionPolicy>(EvictionPolicy::kLru)),
       use_dynamic_config(config["config-settings"].As<bool>(true)) {
   if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
 }
@@ -0,0 +1,72 @@
+#include <userver/cache/nway_lru_cache.hpp>
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <utils/impl/parallelize_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Cache = cache::NWayLRU<std::uint64_t, std::uint64_t>;
+
+constexpr std::size_t kWays = 16;
+constexpr std::uint64_t kElementsCount = 10'000;
+
+// Read-mostly load: the keys are always in the cache, one get in 100 is
+// followed by a put
+void NWayGetHit(benchmark::State& state, cache::EvictionPolicy policy) {
+  engine::RunStandalone(state.range(0), [&] {
+    Cache cache(kWays, kElementsCount / kWays * 2, policy);
+    for (std::uint64_t i = 0; i < kElementsCount; ++i) cache.Put(i, i);
+
+    RunParallelBenchmark(state, [&cache](auto& range) {
+      std::uint64_t i = 0;
+      for ([[maybe_unused]] auto _ : range) {
+        const auto key = (i * 7919) % kElementsCount;
+        benchmark::DoNotOptimize(cache.Get(key));
+        if (++i % 100 == 0) cache.Put(key, i);
+      }
+    });
+  });
+}
+
+// Miss-heavy load: every get misses and puts a new key, evicting another one
+void NWayPutEvict(benchmark::State& state, cache::EvictionPolicy policy) {
+  engine::RunStandalone([&] {
+    Cache cache(kWays, kElementsCount / kWays, policy);
+
+    std::uint64_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      if (!cache.Get(i)) cache.Put(i, i);
+      ++i;
+    }
+  });
+}
+
+}  // namespace
+
+void nway_lru_get_hit(benchmark::State& state) {
+  NWayGetHit(state, cache::EvictionPolicy::kLru);
+}
+BENCHMARK(nway_lru_get_hit)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+void nway_clock_get_hit(benchmark::State& state) {
+  NWayGetHit(state, cache::EvictionPolicy::kClock);
+}
+BENCHMARK(nway_clock_get_hit)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+void nway_lru_put_evict(benchmark::State& state) {
+  NWayPutEvict(state, cache::EvictionPolicy::kLru);
+}
+BENCHMARK(nway_lru_put_evict);
+
+void nway_clock_put_evict(benchmark::State& state) {
+  NWayPutEvict(state, cache::EvictionPolicy::kClock);
+}
+BENCHMARK(nway_clock_put_evict);
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,12 @@
 #include <userver/utest/utest.hpp>
 
+#include <array>
+#include <atomic>
+#include <vector>
+
 #include <userver/cache/nway_lru_cache.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -64,4 +70,107 @@ UTEST(NWayLRU, HashCombine) {
   }
 }
 
+UTEST(NWayLRU, ClockSet) {
+  Cache cache(1, 2, cache::EvictionPolicy::kClock);
+  EXPECT_EQ(0, cache.GetSize());
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  EXPECT_EQ(2, cache.GetSize());
+
+  // 1 gets a second chance, 2 is evicted
+  EXPECT_EQ(1, cache.Get(1));
+  cache.Put(3, 3);
+  EXPECT_EQ(2, cache.GetSize());
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_FALSE(cache.Get(2).has_value());
+  EXPECT_EQ(3, cache.Get(3));
+
+  cache.Put(3, 4);
+  EXPECT_EQ(4, cache.GetOr(3, 0));
+  EXPECT_EQ(0, cache.GetOr(2, 0));
+  EXPECT_EQ(2, cache.GetSize());
+}
+
+UTEST(NWayLRU, ClockInvalidate) {
+  Cache cache(2, 10, cache::EvictionPolicy::kClock);
+  for (int i = 0; i < 10; ++i) cache.Put(i, i);
+  EXPECT_EQ(10, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(1, [](int) { return false; }).has_value());
+  cache.InvalidateByKey(2);
+  EXPECT_FALSE(cache.Get(1).has_value());
+  EXPECT_FALSE(cache.Get(2).has_value());
+  EXPECT_EQ(8, cache.GetSize());
+
+  int sum = 0;
+  cache.VisitAll([&sum](int key, int value) {
+    EXPECT_EQ(key, value);
+    sum += value;
+  });
+  EXPECT_EQ(sum, 45 - 1 - 2);
+
+  cache.UpdateWaySize(1);
+  EXPECT_LE(cache.GetSize(), 2);
+
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST(NWayLRU, ClockOverwriteDoesNotGrow) {
+  Cache cache(1, 2, cache::EvictionPolicy::kClock);
+  for (int i = 0; i < 1000; ++i) {
+    cache.Put(i % 2, i);
+    cache.InvalidateByKey(i % 2);
+    cache.Put(i % 2, i);
+  }
+  EXPECT_EQ(2, cache.GetSize());
+  EXPECT_EQ(998, cache.Get(0));
+  EXPECT_EQ(999, cache.Get(1));
+}
+
+UTEST(NWayLRU, TinyLfuSet) {
+  Cache cache(1, 10, cache::EvictionPolicy::kTinyLfu);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(2, cache.GetOr(2, -1));
+  EXPECT_EQ(-1, cache.GetOr(3, -1));
+  EXPECT_EQ(std::nullopt, cache.Get(1, [](int) { return false; }));
+  EXPECT_EQ(1, cache.GetSize());
+
+  for (int i = 0; i < 100; ++i) cache.Put(i, i);
+  EXPECT_EQ(10, cache.GetSize());
+
+  cache.UpdateWaySize(5);
+  EXPECT_EQ(5, cache.GetSize());
+
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST_MT(NWayLRU, ClockConcurrentAccess, 4) {
+  Cache cache(4, 64, cache::EvictionPolicy::kClock);
+  std::atomic<bool> stop{false};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < 4; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&cache, &stop, i] {
+      for (int key = 0; !stop; key = (key + 1) % 1000) {
+        if (i % 2) {
+          cache.Put(key, key);
+        } else if (const auto value = cache.Get(key)) {
+          ASSERT_EQ(*value, key);
+        }
+      }
+    }));
+  }
+
+  engine::SleepFor(std::chrono::milliseconds{50});
+  stop = true;
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_LE(cache.GetSize(), 4 * 64);
+}
+
 USERVER_NAMESPACE_END
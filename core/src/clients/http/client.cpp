@@ -2,7 +2,9 @@
 
 #include <chrono>
 #include <cstdlib>
+#include <functional>
 #include <limits>
+#include <string_view>
 
 #include <moodycamel/concurrentqueue.h>
 
@@ -15,6 +17,7 @@
 
 #include <clients/http/destination_statistics.hpp>
 #include <clients/http/easy_wrapper.hpp>
+#include <clients/http/endpoint_balancer.hpp>
 #include <clients/http/statistics.hpp>
 #include <clients/http/testsuite.hpp>
 #include <crypto/openssl.hpp>
@@ -43,6 +46,16 @@ const tracing::TracingManagerBase* GetTracingManager(
   return settings.tracing_manager;
 }
 
+// "scheme://user@host:port/path?query" -> "scheme://user@host:port"
+std::string_view GetOrigin(std::string_view url) {
+  constexpr std::string_view kSchemeSeparator = "://";
+  const auto scheme_pos = url.find(kSchemeSeparator);
+  const auto authority_pos = (scheme_pos == std::string_view::npos)
+                                 ? 0
+                                 : scheme_pos + kSchemeSeparator.size();
+  return url.substr(0, url.find_first_of("/?#", authority_pos));
+}
+
 }  // namespace
 
 Client::Client(ClientSettings settings,
@@ -50,6 +63,10 @@ Client::Client(ClientSettings settings,
                impl::PluginPipeline&& plugin_pipeline)
     : deadline_propagation_config_(settings.deadline_propagation),
       cancellation_policy_(settings.cancellation_policy),
+      host_affinity_(settings.host_affinity),
+      endpoint_balancer_(settings.client_side_balancing
+                             ? std::make_unique<impl::EndpointBalancer>()
+                             : nullptr),
       destination_statistics_(std::make_shared<DestinationStatistics>()),
       statistics_(settings.io_threads),
       fs_task_processor_(fs_task_processor),
@@ -85,7 +102,12 @@ Client::Client(ClientSettings settings,
 
   easy_reinit_task_.Start("http_easy_reinit",
                           utils::PeriodicTask::Settings(kEasyReinitPeriod),
-                          [this] { ReinitEasy(); });
+                          [this] {
+                            ReinitEasy();
+                            if (endpoint_balancer_) {
+                              endpoint_balancer_->RemoveIdle();
+                            }
+                          });
 
   SetConfig({});
 }
@@ -217,6 +239,17 @@ size_t Client::FindMultiIndex(const curl::multi* multi) const {
   throw std::logic_error("Unknown multi");
 }
 
+void Client::BindToHostMulti(curl::easy& easy, RequestStats& stats) {
+  if (!host_affinity_) return;
+
+  // Each multi has its own connection cache, requests to the same host from
+  // different multis would open separate connections
+  const auto origin = GetOrigin(easy.get_original_url());
+  const auto index = std::hash<std::string_view>{}(origin) % multis_.size();
+  easy.SetMulti(*multis_[index]);
+  stats.Rebind(statistics_[index]);
+}
+
 PoolStatistics Client::GetPoolStatistics() const {
   PoolStatistics stats;
   stats.multi.reserve(multis_.size());
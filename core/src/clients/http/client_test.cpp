@@ -7,9 +7,12 @@
 #include <boost/algorithm/string/trim.hpp>
 
 #include <clients/http/client_utils_test.hpp>
+#include <clients/http/endpoint_balancer.hpp>
+#include <clients/http/statistics.hpp>
 #include <clients/http/testsuite.hpp>
 #include <engine/task/task_processor.hpp>
 #include <userver/clients/dns/resolver.hpp>
+#include <userver/clients/http/config.hpp>
 #include <userver/clients/http/connect_to.hpp>
 #include <userver/clients/http/request_tracing_editor.hpp>
 #include <userver/clients/http/streamed_response.hpp>
@@ -23,6 +26,7 @@
 #include <userver/fs/blocking/write.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/tracing/manager.hpp>
 #include <userver/tracing/tracing.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/userver_info.hpp>
@@ -428,10 +432,10 @@ constexpr auto kTestHosts = R"(
 )";
 
 struct ResolverWrapper {
-  ResolverWrapper()
-      : hosts_file{[] {
+  explicit ResolverWrapper(std::string_view hosts = kTestHosts)
+      : hosts_file{[hosts] {
           auto file = fs::blocking::TempFile::Create();
-          fs::blocking::RewriteFileContents(file.GetPath(), kTestHosts);
+          fs::blocking::RewriteFileContents(file.GetPath(), hosts);
           return file;
         }()},
         fs_task_processor{
@@ -1657,4 +1661,96 @@ UTEST(HttpClient, DigestAuth) {
   }
 }
 
+UTEST(HttpClient, HostAffinityReusesConnections) {
+  constexpr std::size_t kRequests = 10;
+  const utest::SimpleServer http_server{[](const HttpRequest&) {
+    return HttpResponse{"HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n",
+                        HttpResponse::kWriteAndContinue};
+  }};
+
+  const tracing::GenericTracingManager tracing_manager{
+      tracing::Format::kYandexTaxi, tracing::Format::kYandexTaxi};
+  clients::http::ClientSettings settings;
+  settings.io_threads = 4;
+  settings.host_affinity = true;
+  settings.tracing_manager = &tracing_manager;
+  clients::http::Client http_client{
+      std::move(settings), engine::current_task::GetTaskProcessor(),
+      std::vector<utils::NotNull<clients::http::Plugin*>>{}};
+
+  for (std::size_t i = 0; i < kRequests; ++i) {
+    const auto res = http_client.CreateRequest()
+                         .get(http_server.GetBaseUrl())
+                         .retry(1)
+                         .http_version(clients::http::HttpVersion::k11)
+                         .timeout(kTimeout)
+                         .perform();
+    EXPECT_EQ(res->status_code(), 200);
+  }
+
+  // All the requests were performed and accounted on the same multi
+  const auto pool_stats = http_client.GetPoolStatistics();
+  std::size_t used_multis = 0;
+  for (const auto& stats : pool_stats.multi) {
+    const auto ok_count =
+        stats.error_count[static_cast<std::size_t>(
+            clients::http::Statistics::ErrorGroup::kOk)];
+    if (stats.multi.socket_open == utils::statistics::Rate{0}) {
+      EXPECT_EQ(stats.multi.socket_reused, utils::statistics::Rate{0});
+      EXPECT_EQ(ok_count, utils::statistics::Rate{0});
+      continue;
+    }
+
+    ++used_multis;
+    EXPECT_EQ(stats.multi.socket_open, utils::statistics::Rate{1});
+    EXPECT_EQ(stats.multi.socket_reused,
+              utils::statistics::Rate{kRequests - 1});
+    EXPECT_EQ(ok_count, utils::statistics::Rate{kRequests});
+  }
+  EXPECT_EQ(used_multis, 1u);
+}
+
+UTEST(HttpClient, ClientSideBalancingRetriesOtherEndpoint) {
+  constexpr std::size_t kRequests = 20;
+  // Nothing listens on 127.0.0.2, the connections to it are refused
+  constexpr std::string_view kBalancedHosts = R"(
+127.0.0.2 localhost
+127.0.0.1 localhost
+)";
+  const utest::SimpleServer http_server{[](const HttpRequest&) {
+    return HttpResponse{"HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n",
+                        HttpResponse::kWriteAndContinue};
+  }};
+
+  ResolverWrapper resolver_wrapper{kBalancedHosts};
+  const tracing::GenericTracingManager tracing_manager{
+      tracing::Format::kYandexTaxi, tracing::Format::kYandexTaxi};
+  clients::http::ClientSettings settings;
+  settings.client_side_balancing = true;
+  settings.tracing_manager = &tracing_manager;
+  clients::http::Client http_client{
+      std::move(settings), resolver_wrapper.fs_task_processor,
+      std::vector<utils::NotNull<clients::http::Plugin*>>{}};
+  http_client.SetDnsResolver(&resolver_wrapper.resolver);
+
+  const auto url = "http://localhost:" + std::to_string(http_server.GetPort());
+  std::size_t retries = 0;
+  for (std::size_t i = 0; i < kRequests; ++i) {
+    // Every request succeeds, as a retry never goes to the endpoint the
+    // previous attempt has failed on
+    const auto res = http_client.CreateRequest()
+                         .get(url)
+                         .retry(2)
+                         .http_version(clients::http::HttpVersion::k11)
+                         .timeout(kTimeout)
+                         .perform();
+    EXPECT_EQ(res->status_code(), 200);
+    retries += res->GetStats().retries_count;
+  }
+
+  // Each failed attempt is accounted, so the refusing endpoint gets ejected
+  EXPECT_LE(retries,
+            clients::http::impl::EndpointBalancer::kFailuresToEject);
+}
+
 USERVER_NAMESPACE_END
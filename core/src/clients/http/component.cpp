@@ -207,6 +207,14 @@ properties:
         type: boolean
         description: whether to defer events execution to a periodic timer; might affect timings a bit, might boost performance, use with care
         defaultDescription: false
+    host-affinity:
+        type: boolean
+        description: perform all the requests to the same scheme, host and port on the same IO thread to reuse its warm keepalive connections
+        defaultDescription: false
+    client-side-balancing:
+        type: boolean
+        description: spread the requests between all the addresses of the host, preferring the fastest and the least loaded ones and skipping the failing ones; works only with the async dns_resolver
+        defaultDescription: false
     fs-task-processor:
         type: string
         description: task processor to run blocking HTTP related calls, like DNS resolving or hosts reading
@@ -54,6 +54,10 @@ ClientSettings Parse(const yaml_config::YamlConfig& value,
       value["thread-name-prefix"].As<std::string>(result.thread_name_prefix);
   result.io_threads = value["threads"].As<size_t>(result.io_threads);
   result.defer_events = value["defer-events"].As<bool>(result.defer_events);
+  result.host_affinity =
+      value["host-affinity"].As<bool>(result.host_affinity);
+  result.client_side_balancing = value["client-side-balancing"].As<bool>(
+      result.client_side_balancing);
   result.deadline_propagation = ParseDeadlinePropagationConfig(value);
   return result;
 }
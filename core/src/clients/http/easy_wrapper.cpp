@@ -25,6 +25,14 @@ curl::easy& EasyWrapper::Easy() { return *easy_; }
 
 const curl::easy& EasyWrapper::Easy() const { return *easy_; }
 
+void EasyWrapper::BindToHostMulti(RequestStats& stats) {
+  client_.BindToHostMulti(*easy_, stats);
+}
+
+EndpointBalancer* EasyWrapper::GetEndpointBalancer() noexcept {
+  return client_.endpoint_balancer_.get();
+}
+
 }  // namespace clients::http::impl
 
 USERVER_NAMESPACE_END
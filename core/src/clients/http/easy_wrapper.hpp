@@ -8,10 +8,13 @@ USERVER_NAMESPACE_BEGIN
 
 namespace clients::http {
 class Client;
+class RequestStats;
 }  // namespace clients::http
 
 namespace clients::http::impl {
 
+class EndpointBalancer;
+
 class EasyWrapper final {
  public:
   EasyWrapper(std::shared_ptr<curl::easy>&& easy, Client& client);
@@ -26,6 +29,13 @@ class EasyWrapper final {
   curl::easy& Easy();
   const curl::easy& Easy() const;
 
+  /// Moves the easy and the request statistics to the multi chosen by the
+  /// client for the URL host, must be called before the request is performed
+  void BindToHostMulti(RequestStats& stats);
+
+  /// Returns nullptr if the client side balancing is disabled
+  EndpointBalancer* GetEndpointBalancer() noexcept;
+
  private:
   std::shared_ptr<curl::easy> easy_;
   Client& client_;
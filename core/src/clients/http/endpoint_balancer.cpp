@@ -0,0 +1,156 @@
+#include <clients/http/endpoint_balancer.hpp>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::impl {
+
+namespace {
+
+// Weight of a new sample is 1 / kEwmaDivisor
+constexpr std::int64_t kEwmaDivisor = 5;
+
+std::int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+bool IsEjected(const EndpointBalancer::EndpointStats& endpoint,
+               std::int64_t now_us) {
+  return endpoint.ejected_until_us.load(std::memory_order_relaxed) > now_us;
+}
+
+double GetCost(const EndpointBalancer::EndpointStats& endpoint) {
+  // Endpoints without a response yet are cheap, so they are tried quickly
+  const auto latency = endpoint.ewma_latency_us.load(std::memory_order_relaxed);
+  const auto in_flight = endpoint.in_flight.load(std::memory_order_relaxed);
+  return static_cast<double>(latency + 1) * static_cast<double>(in_flight + 1);
+}
+
+}  // namespace
+
+EndpointBalancer::Lease::Lease(std::shared_ptr<EndpointStats> endpoint)
+    : endpoint_(std::move(endpoint)), start_(std::chrono::steady_clock::now()) {
+  endpoint_->in_flight.fetch_add(1, std::memory_order_relaxed);
+}
+
+EndpointBalancer::Lease& EndpointBalancer::Lease::operator=(
+    Lease&& other) noexcept {
+  if (this == &other) return *this;
+  if (endpoint_) endpoint_->in_flight.fetch_sub(1, std::memory_order_relaxed);
+  endpoint_ = std::move(other.endpoint_);
+  start_ = other.start_;
+  return *this;
+}
+
+EndpointBalancer::Lease::~Lease() {
+  if (endpoint_) endpoint_->in_flight.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void EndpointBalancer::Lease::Release() noexcept {
+  if (!endpoint_) return;
+  endpoint_->in_flight.fetch_sub(1, std::memory_order_relaxed);
+  endpoint_.reset();
+}
+
+void EndpointBalancer::Lease::Finish(bool failed) noexcept {
+  if (!endpoint_) return;
+  auto endpoint = std::move(endpoint_);
+  endpoint->in_flight.fetch_sub(1, std::memory_order_relaxed);
+
+  if (failed) {
+    const auto failures =
+        endpoint->consecutive_failures.fetch_add(1, std::memory_order_relaxed) +
+        1;
+    if (failures >= kFailuresToEject) {
+      endpoint->consecutive_failures.store(0, std::memory_order_relaxed);
+      endpoint->ejected_until_us.store(
+          NowUs() + std::chrono::microseconds{kEjectionTime}.count(),
+          std::memory_order_relaxed);
+    }
+    return;
+  }
+
+  endpoint->consecutive_failures.store(0, std::memory_order_relaxed);
+
+  const std::int64_t sample =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start_)
+          .count();
+  auto ewma = endpoint->ewma_latency_us.load(std::memory_order_relaxed);
+  while (!endpoint->ewma_latency_us.compare_exchange_weak(
+      ewma, ewma == 0 ? sample : ewma + (sample - ewma) / kEwmaDivisor,
+      std::memory_order_relaxed)) {
+  }
+}
+
+EndpointBalancer::Endpoints EndpointBalancer::GetEndpoints(
+    const std::vector<std::string>& endpoints) {
+  Endpoints stats;
+  stats.reserve(endpoints.size());
+  for (const auto& endpoint : endpoints) {
+    auto endpoint_stats = endpoints_.Get(endpoint);
+    if (!endpoint_stats) endpoint_stats = endpoints_[endpoint];
+    stats.push_back(std::move(endpoint_stats));
+  }
+  return stats;
+}
+
+EndpointBalancer::Choice EndpointBalancer::Choose(
+    const Endpoints& endpoints, std::optional<std::size_t> excluded) {
+  UASSERT(!endpoints.empty());
+  const auto now_us = NowUs();
+
+  std::vector<std::size_t> candidates;
+  candidates.reserve(endpoints.size());
+  for (std::size_t i = 0; i < endpoints.size(); ++i) {
+    if (i != excluded && !IsEjected(*endpoints[i], now_us)) {
+      candidates.push_back(i);
+    }
+  }
+
+  // All the endpoints are ejected, better try any of them than none
+  if (candidates.empty()) {
+    for (std::size_t i = 0; i < endpoints.size(); ++i) {
+      if (i != excluded || endpoints.size() == 1) candidates.push_back(i);
+    }
+  }
+
+  auto chosen = candidates[utils::RandRange(candidates.size())];
+  if (candidates.size() > 1) {
+    auto other = candidates[utils::RandRange(candidates.size() - 1)];
+    if (other == chosen) other = candidates.back();
+    if (GetCost(*endpoints[other]) < GetCost(*endpoints[chosen])) {
+      chosen = other;
+    }
+  }
+
+  endpoints[chosen]->last_used_us.store(now_us, std::memory_order_relaxed);
+  return {chosen, Lease{endpoints[chosen]}};
+}
+
+EndpointBalancer::Choice EndpointBalancer::Choose(
+    const std::vector<std::string>& endpoints) {
+  return Choose(GetEndpoints(endpoints));
+}
+
+void EndpointBalancer::RemoveIdle() {
+  const auto idle_since_us =
+      NowUs() - std::chrono::microseconds{kIdleTime}.count();
+
+  std::vector<std::string> idle;
+  for (const auto& [endpoint, stats] : endpoints_) {
+    if (stats->last_used_us.load(std::memory_order_relaxed) < idle_since_us &&
+        stats->in_flight.load(std::memory_order_relaxed) == 0) {
+      idle.push_back(endpoint);
+    }
+  }
+  for (const auto& endpoint : idle) endpoints_.Erase(endpoint);
+}
+
+}  // namespace clients::http::impl
+
+USERVER_NAMESPACE_END
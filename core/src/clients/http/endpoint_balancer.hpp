@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/rcu/rcu_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::impl {
+
+/// Client side balancing between the resolved addresses of a host.
+///
+/// The endpoint is chosen by the power of two choices: of two random
+/// endpoints the one with the lower cost wins, the cost being the EWMA of
+/// the response time multiplied by the number of requests in flight. An
+/// endpoint that failed several requests in a row is not chosen for a while.
+class EndpointBalancer final {
+ public:
+  struct EndpointStats final {
+    std::atomic<std::int64_t> in_flight{0};
+    std::atomic<std::int64_t> ewma_latency_us{0};
+    std::atomic<std::uint32_t> consecutive_failures{0};
+    // steady_clock time since epoch in microseconds
+    std::atomic<std::int64_t> ejected_until_us{0};
+    std::atomic<std::int64_t> last_used_us{0};
+  };
+
+  /// A request in flight to the chosen endpoint
+  class Lease final {
+   public:
+    Lease() = default;
+    Lease(Lease&&) noexcept = default;
+    Lease& operator=(Lease&&) noexcept;
+    ~Lease();
+
+    /// Accounts the response time, or the failure, of the request
+    void Finish(bool failed) noexcept;
+
+    /// Ends the request without accounting it, e.g. if it was cancelled
+    void Release() noexcept;
+
+   private:
+    friend class EndpointBalancer;
+    explicit Lease(std::shared_ptr<EndpointStats> endpoint);
+
+    std::shared_ptr<EndpointStats> endpoint_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  struct Choice final {
+    std::size_t index{0};
+    Lease lease;
+  };
+
+  using Endpoints = std::vector<std::shared_ptr<EndpointStats>>;
+
+  /// Returns the statistics of the endpoints in the same order, the missing
+  /// ones are created
+  /// @param endpoints "address:port" strings
+  Endpoints GetEndpoints(const std::vector<std::string>& endpoints);
+
+  /// Chooses one of the endpoints. Does not touch the balancer itself, so
+  /// can be called outside of coroutines, e.g. for retries.
+  /// @param endpoints must not be empty
+  /// @param excluded endpoint that is not chosen if there are others, e.g.
+  /// the one the previous attempt of the request has failed on
+  static Choice Choose(const Endpoints& endpoints,
+                       std::optional<std::size_t> excluded = {});
+
+  /// @overload
+  Choice Choose(const std::vector<std::string>& endpoints);
+
+  /// Drops the statistics of the endpoints that were not chosen for a while
+  void RemoveIdle();
+
+  static constexpr std::uint32_t kFailuresToEject = 5;
+  static constexpr std::chrono::seconds kEjectionTime{10};
+  static constexpr std::chrono::minutes kIdleTime{10};
+
+ private:
+  rcu::RcuMap<std::string, EndpointStats> endpoints_;
+};
+
+}  // namespace clients::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,97 @@
+#include <clients/http/endpoint_balancer.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using EndpointBalancer = clients::http::impl::EndpointBalancer;
+
+const std::vector<std::string> kEndpoints{"127.0.0.1:80", "127.0.0.2:80"};
+
+}  // namespace
+
+UTEST(HttpClientEndpointBalancer, PrefersLessLoaded) {
+  EndpointBalancer balancer;
+
+  // Keep a request in flight on the first endpoint
+  auto busy = balancer.Choose({kEndpoints[0]});
+
+  for (int i = 0; i < 100; ++i) {
+    auto choice = balancer.Choose(kEndpoints);
+    EXPECT_EQ(choice.index, 1u);
+    choice.lease.Finish(false);
+  }
+}
+
+UTEST(HttpClientEndpointBalancer, PrefersFaster) {
+  EndpointBalancer balancer;
+
+  auto slow = balancer.Choose({kEndpoints[0]});
+  engine::SleepFor(std::chrono::milliseconds{10});
+  slow.lease.Finish(false);
+
+  balancer.Choose({kEndpoints[1]}).lease.Finish(false);
+
+  for (int i = 0; i < 100; ++i) {
+    auto choice = balancer.Choose(kEndpoints);
+    EXPECT_EQ(choice.index, 1u);
+    choice.lease.Finish(false);
+  }
+}
+
+UTEST(HttpClientEndpointBalancer, EjectsFailing) {
+  EndpointBalancer balancer;
+
+  for (std::uint32_t i = 0; i < EndpointBalancer::kFailuresToEject; ++i) {
+    balancer.Choose({kEndpoints[0]}).lease.Finish(true);
+  }
+
+  // Even though the ejected endpoint is the least loaded one
+  std::vector<EndpointBalancer::Choice> in_flight;
+  for (int i = 0; i < 10; ++i) {
+    in_flight.push_back(balancer.Choose(kEndpoints));
+    EXPECT_EQ(in_flight.back().index, 1u);
+  }
+
+  // If all the endpoints are ejected, one of them is used anyway
+  EXPECT_EQ(balancer.Choose({kEndpoints[0]}).index, 0u);
+}
+
+UTEST(HttpClientEndpointBalancer, ReleaseIsNotAccounted) {
+  EndpointBalancer balancer;
+
+  // Cancelled requests do not eject the endpoint
+  for (std::uint32_t i = 0; i < EndpointBalancer::kFailuresToEject; ++i) {
+    balancer.Choose({kEndpoints[0]}).lease.Release();
+  }
+
+  auto busy = balancer.Choose({kEndpoints[1]});
+  for (int i = 0; i < 100; ++i) {
+    auto choice = balancer.Choose(kEndpoints);
+    EXPECT_EQ(choice.index, 0u);
+    choice.lease.Finish(false);
+  }
+}
+
+UTEST(HttpClientEndpointBalancer, ExcludesPreviousEndpoint) {
+  EndpointBalancer balancer;
+  const auto endpoints = balancer.GetEndpoints(kEndpoints);
+
+  // Even though the excluded endpoint is the least loaded one
+  auto busy = EndpointBalancer::Choose(endpoints, 0);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(EndpointBalancer::Choose(endpoints, 0).index, 1u);
+  }
+
+  // A single endpoint is used even if excluded
+  const auto single = balancer.GetEndpoints({kEndpoints[0]});
+  EXPECT_EQ(EndpointBalancer::Choose(single, 0).index, 0u);
+}
+
+USERVER_NAMESPACE_END
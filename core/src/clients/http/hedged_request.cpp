@@ -0,0 +1,136 @@
+#include <userver/clients/http/hedged_request.hpp>
+
+#include <exception>
+#include <optional>
+#include <vector>
+
+#include <userver/clients/http/response_future.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/wait_any.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace {
+
+utils::RetryBudgetSettings MakeDefaultBudgetSettings() {
+  utils::RetryBudgetSettings settings;
+  settings.max_tokens = 20;
+  settings.token_ratio = 0.1f;
+  return settings;
+}
+
+bool IsServerError(const Response& response) {
+  return static_cast<int>(response.status_code()) >= 500;
+}
+
+}  // namespace
+
+HedgingBudget::HedgingBudget() : HedgingBudget(MakeDefaultBudgetSettings()) {}
+
+HedgingBudget::HedgingBudget(const utils::RetryBudgetSettings& settings)
+    : budget_(settings) {}
+
+void HedgingBudget::SetSettings(const utils::RetryBudgetSettings& settings) {
+  budget_.SetSettings(settings);
+}
+
+void HedgingBudget::AccountRequest() noexcept {
+  budget_.AccountOk();
+  ++requests_;
+}
+
+bool HedgingBudget::TryStartHedge() noexcept {
+  if (!budget_.CanRetry()) {
+    ++hedges_throttled_;
+    return false;
+  }
+
+  budget_.AccountFail();
+  ++hedges_sent_;
+  return true;
+}
+
+void HedgingBudget::AccountHedgeWon() noexcept { ++hedges_won_; }
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const HedgingBudget& budget) {
+  writer["requests"] = budget.requests_;
+  writer["hedges"]["sent"] = budget.hedges_sent_;
+  writer["hedges"]["won"] = budget.hedges_won_;
+  writer["hedges"]["throttled"] = budget.hedges_throttled_;
+  writer["budget"] = budget.budget_;
+}
+
+std::shared_ptr<Response> PerformHedged(utils::function_ref<Request()> factory,
+                                        const HedgingSettings& settings,
+                                        HedgingBudget& budget) {
+  UINVARIANT(settings.max_attempts > 0, "At least one attempt is required");
+  budget.AccountRequest();
+
+  // The original attempt is the first one started, `attempts` and
+  // `is_hedge` are kept in sync
+  std::vector<ResponseFuture> attempts;
+  std::vector<bool> is_hedge;
+  attempts.reserve(settings.max_attempts);
+  is_hedge.reserve(settings.max_attempts);
+
+  attempts.push_back(factory().async_perform());
+  is_hedge.push_back(false);
+  std::size_t started = 1;
+  auto next_hedge = engine::Deadline::FromDuration(settings.delay);
+
+  std::shared_ptr<Response> last_response;
+  std::exception_ptr last_exception;
+
+  while (!attempts.empty()) {
+    const bool may_hedge = started < settings.max_attempts;
+    const auto index = engine::WaitAnyUntil(
+        may_hedge ? next_hedge : engine::Deadline{}, attempts);
+
+    if (!index) {
+      // Throws the appropriate exception on cancellation
+      if (engine::current_task::ShouldCancel()) return attempts.front().Get();
+
+      if (may_hedge && budget.TryStartHedge()) {
+        attempts.push_back(factory().async_perform());
+        is_hedge.push_back(true);
+        ++started;
+        next_hedge = engine::Deadline::FromDuration(settings.delay);
+      } else {
+        started = settings.max_attempts;
+      }
+      continue;
+    }
+
+    auto attempt = std::move(attempts[*index]);
+    const bool was_hedge = is_hedge[*index];
+    attempts.erase(attempts.begin() + *index);
+    is_hedge.erase(is_hedge.begin() + *index);
+
+    try {
+      auto response = attempt.Get();
+      if (!IsServerError(*response)) {
+        if (was_hedge) budget.AccountHedgeWon();
+        for (auto& other : attempts) other.Cancel();
+        return response;
+      }
+      last_response = std::move(response);
+      last_exception = nullptr;
+    } catch (const std::exception&) {
+      last_response = nullptr;
+      last_exception = std::current_exception();
+    }
+  }
+
+  if (last_exception) std::rethrow_exception(last_exception);
+  return last_response;
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,167 @@
+#include <userver/clients/http/hedged_request.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/simple_server.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using HttpResponse = utest::SimpleServer::Response;
+using HttpRequest = utest::SimpleServer::Request;
+
+constexpr std::chrono::seconds kTimeout{10};
+constexpr std::chrono::milliseconds kSlowResponse{1000};
+
+// Requests respond with their number in the body, each one after the delay
+// given for its number, the ones without a delay respond right away
+class DelayedCallback final {
+ public:
+  explicit DelayedCallback(std::vector<std::chrono::milliseconds> delays)
+      : delays_(std::move(delays)) {}
+
+  HttpResponse operator()(const HttpRequest&) const {
+    const auto number = counter_->fetch_add(1);
+    if (number < delays_.size()) engine::SleepFor(delays_[number]);
+
+    const auto body = std::to_string(number);
+    return {"HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: " +
+                std::to_string(body.size()) + "\r\n\r\n" + body,
+            HttpResponse::kWriteAndClose};
+  }
+
+  std::size_t GetRequestsCount() const { return counter_->load(); }
+
+ private:
+  std::vector<std::chrono::milliseconds> delays_;
+  std::shared_ptr<std::atomic<std::size_t>> counter_ =
+      std::make_shared<std::atomic<std::size_t>>(0);
+};
+
+struct HedgingStats final {
+  std::uint64_t requests{0};
+  std::uint64_t sent{0};
+  std::uint64_t won{0};
+  std::uint64_t throttled{0};
+};
+
+HedgingStats GetStats(const clients::http::HedgingBudget& budget) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "hedging",
+      [&budget](utils::statistics::Writer& writer) { writer = budget; });
+  const utils::statistics::Snapshot snapshot{storage, "hedging"};
+  return {
+      snapshot.SingleMetric("requests").AsRate().value,
+      snapshot.SingleMetric("hedges.sent").AsRate().value,
+      snapshot.SingleMetric("hedges.won").AsRate().value,
+      snapshot.SingleMetric("hedges.throttled").AsRate().value,
+  };
+}
+
+}  // namespace
+
+UTEST(HttpClient, HedgedRequest) {
+  const DelayedCallback callback{{kSlowResponse}};
+  const utest::SimpleServer http_server{callback};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  /// [Sample hedged request]
+  clients::http::HedgingSettings settings;
+  settings.delay = std::chrono::milliseconds{50};
+  settings.max_attempts = 2;
+
+  // Usually the budget is shared by all the requests to the destination
+  clients::http::HedgingBudget budget;
+
+  const auto response = clients::http::PerformHedged(
+      [&] {
+        return http_client_ptr->CreateRequest()
+            .get(http_server.GetBaseUrl())
+            .retry(1)
+            .timeout(kTimeout);
+      },
+      settings, budget);
+  /// [Sample hedged request]
+
+  EXPECT_EQ(response->status_code(), clients::http::Status::OK);
+  EXPECT_EQ(response->body(), "1");
+  EXPECT_EQ(callback.GetRequestsCount(), 2);
+
+  const auto stats = GetStats(budget);
+  EXPECT_EQ(stats.requests, 1);
+  EXPECT_EQ(stats.sent, 1);
+  EXPECT_EQ(stats.won, 1);
+  EXPECT_EQ(stats.throttled, 0);
+}
+
+UTEST(HttpClient, HedgedRequestLost) {
+  // The original request responds after the hedge is sent, but before it
+  const DelayedCallback callback{
+      {std::chrono::milliseconds{100}, kSlowResponse}};
+  const utest::SimpleServer http_server{callback};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  clients::http::HedgingBudget budget;
+  const auto response = clients::http::PerformHedged(
+      [&] {
+        return http_client_ptr->CreateRequest()
+            .get(http_server.GetBaseUrl())
+            .timeout(kTimeout);
+      },
+      {std::chrono::milliseconds{10}, 2}, budget);
+
+  EXPECT_EQ(response->body(), "0");
+  EXPECT_EQ(callback.GetRequestsCount(), 2);
+
+  const auto stats = GetStats(budget);
+  EXPECT_EQ(stats.requests, 1);
+  EXPECT_EQ(stats.sent, 1);
+  EXPECT_EQ(stats.won, 0);
+  EXPECT_EQ(stats.throttled, 0);
+}
+
+UTEST(HttpClient, HedgedRequestBudget) {
+  const DelayedCallback callback{{kSlowResponse}};
+  const utest::SimpleServer http_server{callback};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  // Spend all the tokens
+  utils::RetryBudgetSettings budget_settings;
+  budget_settings.max_tokens = 1;
+  budget_settings.token_ratio = 0.1f;
+  clients::http::HedgingBudget budget{budget_settings};
+  ASSERT_TRUE(budget.TryStartHedge());
+  const auto stats_before = GetStats(budget);
+
+  const auto response = clients::http::PerformHedged(
+      [&] {
+        return http_client_ptr->CreateRequest()
+            .get(http_server.GetBaseUrl())
+            .timeout(kTimeout);
+      },
+      {std::chrono::milliseconds{10}, 3}, budget);
+
+  EXPECT_EQ(response->body(), "0");
+  EXPECT_EQ(callback.GetRequestsCount(), 1);
+
+  // The hedge is throttled once, no more hedges are tried afterwards
+  const auto stats = GetStats(budget);
+  EXPECT_EQ(stats.requests, stats_before.requests + 1);
+  EXPECT_EQ(stats.sent, stats_before.sent);
+  EXPECT_EQ(stats.won, 0);
+  EXPECT_EQ(stats.throttled, 1);
+}
+
+USERVER_NAMESPACE_END
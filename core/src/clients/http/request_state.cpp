@@ -344,6 +344,7 @@ void RequestState::connect_to(const ConnectTo& connect_to) {
   curl::native::curl_slist* ptr = connect_to.GetUnderlying();
   if (ptr) {
     easy().set_connect_to(ptr);
+    user_connect_to_ = true;
   }
 }
 
@@ -474,8 +475,12 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
 
   holder->AccountResponse(err);
   const auto sockets = easy.get_num_connects();
-  holder->WithRequestStats(
-      [sockets](RequestStats& stats) { stats.AccountOpenSockets(sockets); });
+  // No new connections, but got a response: a keepalive one was reused
+  const bool reused = sockets == 0 && static_cast<int>(status_code) != 0;
+  holder->WithRequestStats([sockets, reused](RequestStats& stats) {
+    stats.AccountOpenSockets(sockets);
+    if (reused) stats.AccountReusedConnection();
+  });
 
   span.AddTag(tracing::kAttempts, holder->retry_.current);
   if (holder->deadline_propagation_config_.update_header) {
@@ -546,6 +551,9 @@ void RequestState::on_retry(std::shared_ptr<RequestState> holder,
               << tracing::impl::LogSpanAsLastNonCoro{
                      holder->span_storage_->Get()};
 
+  holder->AccountEndpointResponse(
+      err, static_cast<Status>(holder->easy().get_response_code()));
+
   // We do not need to retry:
   // - if we got result and HTTP code is good
   // - if we used all attempts
@@ -669,6 +677,7 @@ engine::Future<std::shared_ptr<Response>> RequestState::async_perform(
 
   StartNewSpan(location);
   ResetDataForNewRequest();
+  easy_.BindToHostMulti(stats_);
 
   auto& span = span_storage_->Get();
   span.AddTag("stream_api", 0);
@@ -693,6 +702,7 @@ engine::Future<void> RequestState::async_perform_stream(
 
   StartNewSpan(location);
   ResetDataForNewRequest();
+  easy_.BindToHostMulti(stats_);
 
   auto& span = span_storage_->Get();
   span.AddTag("stream_api", 1);
@@ -730,6 +740,7 @@ void RequestState::perform_request(curl::easy::handler_type handler) {
                          handler = std::move(handler)]() mutable {
       try {
         ResolveTargetAddress(*resolver_);
+        ChooseEndpoint();
         easy().async_perform(std::move(handler));
       } catch (const clients::dns::ResolverException& ex) {
         // TODO: should retry - TAXICOMMON-4932
@@ -745,6 +756,7 @@ void RequestState::perform_request(curl::easy::handler_type handler) {
       }
     }).Detach();
   } else {
+    ChooseEndpoint();
     easy().async_perform(std::move(handler));
   }
 }
@@ -1045,6 +1057,9 @@ void RequestState::WithRequestStats(const Func& func) {
 }
 
 void RequestState::ResolveTargetAddress(clients::dns::Resolver& resolver) {
+  balanced_endpoints_.clear();
+  balanced_connect_to_values_.clear();
+
   const auto deadline = engine::Deadline::FromDuration(remote_timeout_);
 
   const MaybeOwnedUrl target{proxy_url_, easy()};
@@ -1058,8 +1073,57 @@ void RequestState::ResolveTargetAddress(clients::dns::Resolver& resolver) {
       addrs | boost::adaptors::transformed(
                   [](const auto& addr) { return addr.PrimaryAddressString(); });
 
-  easy().add_resolve(hostname, target.Get().GetPortPtr().get(),
+  const std::string port = target.Get().GetPortPtr().get();
+  easy().add_resolve(hostname, port,
                      fmt::to_string(fmt::join(addr_strings, ",")));
+
+  auto* balancer = easy_.GetEndpointBalancer();
+  if (!balancer || user_connect_to_ || addrs.empty()) return;
+
+  std::vector<std::string> endpoints;
+  endpoints.reserve(addrs.size());
+  for (const auto& addr : addrs) {
+    auto address = addr.PrimaryAddressString();
+    if (addr.Domain() == engine::io::AddrDomain::kInet6) {
+      address = fmt::format("[{}]", address);
+    }
+    endpoints.push_back(fmt::format("{}:{}", address, port));
+  }
+
+  balanced_endpoints_ = balancer->GetEndpoints(endpoints);
+  balanced_connect_to_values_.reserve(endpoints.size());
+  for (const auto& endpoint : endpoints) {
+    balanced_connect_to_values_.push_back(
+        fmt::format("{}:{}:{}", hostname, port, endpoint));
+  }
+}
+
+void RequestState::ChooseEndpoint() {
+  if (balanced_endpoints_.empty()) return;
+
+  // A retry goes to another endpoint if there is one
+  std::optional<std::size_t> excluded;
+  if (retry_.current > 1) excluded = balanced_endpoint_;
+
+  auto choice = impl::EndpointBalancer::Choose(balanced_endpoints_, excluded);
+  balanced_endpoint_ = choice.index;
+  endpoint_lease_ = std::move(choice.lease);
+  // The connections are reused per CURLOPT_CONNECT_TO target, so keepalive
+  // connections to different addresses of the host are not mixed up
+  balanced_connect_to_.reset();
+  balanced_connect_to_.emplace(balanced_connect_to_values_[choice.index]);
+  easy().set_connect_to(balanced_connect_to_->GetUnderlying());
+}
+
+void RequestState::AccountEndpointResponse(std::error_code err,
+                                           Status status_code) {
+  // A cancelled attempt, e.g. a hedged request that lost the race, says
+  // nothing about the endpoint
+  if (is_cancelled_) {
+    endpoint_lease_.Release();
+    return;
+  }
+  endpoint_lease_.Finish(err || static_cast<int>(status_code) >= 500);
 }
 
 void RequestState::SetTracingManager(const tracing::TracingManagerBase& m) {
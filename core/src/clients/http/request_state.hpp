@@ -9,6 +9,7 @@
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/clients/http/config.hpp>
+#include <userver/clients/http/connect_to.hpp>
 #include <userver/clients/http/error.hpp>
 #include <userver/clients/http/form.hpp>
 #include <userver/clients/http/plugin.hpp>
@@ -29,6 +30,7 @@
 
 #include <clients/http/destination_statistics.hpp>
 #include <clients/http/easy_wrapper.hpp>
+#include <clients/http/endpoint_balancer.hpp>
 #include <clients/http/testsuite.hpp>
 #include <crypto/helpers.hpp>
 #include <engine/ev/watcher/timer_watcher.hpp>
@@ -39,7 +41,6 @@ USERVER_NAMESPACE_BEGIN
 namespace clients::http {
 
 class StreamedResponse;
-class ConnectTo;
 
 class RequestState : public std::enable_shared_from_this<RequestState> {
  public:
@@ -183,9 +184,20 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   void WithRequestStats(const Func& func);
 
   void ResolveTargetAddress(clients::dns::Resolver& resolver);
+  void ChooseEndpoint();
+  void AccountEndpointResponse(std::error_code err, Status status_code);
 
   /// curl handler wrapper
   impl::EasyWrapper easy_;
+  /// resolved endpoints of the client side balancing and their connect_to
+  /// values, a new endpoint is chosen for each attempt
+  impl::EndpointBalancer::Endpoints balanced_endpoints_;
+  std::vector<std::string> balanced_connect_to_values_;
+  std::size_t balanced_endpoint_{0};
+  /// connect_to chosen by the client side balancing, must outlive the request
+  std::optional<ConnectTo> balanced_connect_to_;
+  impl::EndpointBalancer::Lease endpoint_lease_;
+  bool user_connect_to_{false};
   RequestStats stats_;
   std::shared_ptr<RequestStats> dest_req_stats_;
   CancellationPolicy cancellation_policy_{CancellationPolicy::kCancel};
@@ -30,6 +30,9 @@ class RequestStats final {
   RequestStats(RequestStats&&) noexcept;
   RequestStats& operator=(RequestStats&&) = delete;
 
+  /// Moves the request to the statistics of another multi
+  void Rebind(Statistics& stats) noexcept;
+
   void Start();
   void FinishOk(int code, unsigned int attempts) noexcept;
   void FinishEc(std::error_code ec, unsigned int attempts) noexcept;
@@ -38,6 +41,9 @@ class RequestStats final {
 
   void AccountOpenSockets(size_t sockets) noexcept;
 
+  /// Request got its response over an already open keepalive connection
+  void AccountReusedConnection() noexcept;
+
   void AccountTimeoutUpdatedByDeadline() noexcept;
   void AccountCancelledByDeadline() noexcept;
 
@@ -50,12 +56,14 @@ class RequestStats final {
 
 struct MultiStats {
   utils::statistics::Rate socket_open;
+  utils::statistics::Rate socket_reused;
   utils::statistics::Rate socket_close;
   utils::statistics::Rate socket_ratelimit;
   double current_load{0};
 
   MultiStats& operator+=(const MultiStats& other) {
     socket_open += other.socket_open;
+    socket_reused += other.socket_reused;
     socket_close += other.socket_close;
     socket_ratelimit += other.socket_ratelimit;
     current_load += other.current_load;
@@ -105,6 +113,7 @@ class Statistics {
   std::array<utils::statistics::RateCounter, kErrorGroupCount> error_count_;
   utils::statistics::RateCounter retries_;
   utils::statistics::RateCounter socket_open_{0};
+  utils::statistics::RateCounter socket_reused_{0};
   utils::statistics::RateCounter timeout_updated_by_deadline_;
   utils::statistics::RateCounter cancelled_by_deadline_;
   utils::statistics::HttpCodes reply_status_;
@@ -1,15 +1,26 @@
 #include <compression/gzip.hpp>
 
+#include <algorithm>
+#include <limits>
+
+#include <zlib.h>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 
+#include <userver/utils/assert.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace compression::gzip {
 
 namespace {
 constexpr auto kDecompressBufferSize = 1024;
-}
+constexpr std::size_t kMinCompressBufferSize = 64;
+
+// 16 is added to the max window bits to produce a gzip header and trailer
+constexpr int kGzipWindowBits = MAX_WBITS + 16;
+constexpr int kMemLevel = 8;
+}  // namespace
 
 std::string Decompress(std::string_view compressed, size_t max_size) {
   std::string decompressed;
@@ -38,6 +49,67 @@ std::string Decompress(std::string_view compressed, size_t max_size) {
   return decompressed;
 }
 
+std::string Compress(std::string_view data, int level) {
+  return Compressor{level}.Finish(data);
+}
+
+Compressor::Compressor(int level) : stream_(std::make_unique<z_stream>()) {
+  if (level < Z_BEST_SPEED || level > Z_BEST_COMPRESSION) {
+    throw CompressionError("Invalid gzip compression level " +
+                           std::to_string(level));
+  }
+  if (deflateInit2(stream_.get(), level, Z_DEFLATED, kGzipWindowBits,
+                   kMemLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw CompressionError("failed to initialize gzip compressor");
+  }
+}
+
+Compressor::~Compressor() {
+  if (stream_) deflateEnd(stream_.get());
+}
+
+std::string Compressor::Compress(std::string_view data) {
+  return Deflate(data, Z_SYNC_FLUSH);
+}
+
+std::string Compressor::Finish(std::string_view data) {
+  auto result = Deflate(data, Z_FINISH);
+  deflateEnd(stream_.get());
+  stream_.reset();
+  return result;
+}
+
+std::string Compressor::Deflate(std::string_view data, int flush) {
+  UINVARIANT(stream_, "gzip compressor is used after Finish()");
+  UINVARIANT(data.size() <= std::numeric_limits<uInt>::max(),
+             "Too much data to compress at once");
+
+  stream_->next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream_->avail_in = data.size();
+
+  std::string compressed;
+  const auto bound = deflateBound(stream_.get(), data.size());
+  int ret = Z_OK;
+  do {
+    const auto offset = compressed.size();
+    compressed.resize(
+        offset + std::max<std::size_t>(bound - std::min(bound, offset),
+                                       kMinCompressBufferSize));
+    stream_->next_out = reinterpret_cast<Bytef*>(compressed.data() + offset);
+    stream_->avail_out = compressed.size() - offset;
+
+    ret = deflate(stream_.get(), flush);
+    if (ret == Z_STREAM_ERROR) {
+      throw CompressionError("failed to gzip data");
+    }
+    compressed.resize(compressed.size() - stream_->avail_out);
+  } while (stream_->avail_out == 0 ||
+           (flush == Z_FINISH && ret != Z_STREAM_END));
+
+  return compressed;
+}
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
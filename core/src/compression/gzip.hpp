@@ -1,17 +1,53 @@
 #pragma once
 
+#include <memory>
+#include <string>
 #include <string_view>
 
 #include <compression/error.hpp>
 
+struct z_stream_s;
+
 USERVER_NAMESPACE_BEGIN
 
 namespace compression::gzip {
 
+/// Default compression level, a good balance of speed and ratio
+inline constexpr int kDefaultLevel = 6;
+
 /// Decompresses the string.
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
 
+/// Compresses the string with the level in [1, 9] range.
+/// @throws CompressionError
+std::string Compress(std::string_view data, int level = kDefaultLevel);
+
+/// Streaming compressor, the output of each Compress() call may be
+/// decompressed as soon as it is received.
+class Compressor final {
+ public:
+  explicit Compressor(int level = kDefaultLevel);
+  ~Compressor();
+
+  Compressor(Compressor&&) = delete;
+  Compressor& operator=(Compressor&&) = delete;
+
+  /// Compresses a part of the data and flushes the output.
+  /// @throws CompressionError
+  std::string Compress(std::string_view data);
+
+  /// Compresses the remaining data and finishes the stream, the compressor
+  /// cannot be used afterwards.
+  /// @throws CompressionError
+  std::string Finish(std::string_view data = {});
+
+ private:
+  std::string Deflate(std::string_view data, int flush);
+
+  std::unique_ptr<z_stream_s> stream_;
+};
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,59 @@
+#include <compression/gzip.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kMaxSize = 1024 * 1024;
+
+std::string MakeData() {
+  std::string data;
+  for (int i = 0; i < 1000; ++i) {
+    data += "{\"id\":" + std::to_string(i) + ",\"name\":\"item\"},";
+  }
+  return data;
+}
+
+}  // namespace
+
+TEST(Gzip, CompressDecompress) {
+  const auto data = MakeData();
+
+  const auto compressed = compression::gzip::Compress(data);
+  EXPECT_LT(compressed.size(), data.size());
+  EXPECT_EQ(compression::gzip::Decompress(compressed, kMaxSize), data);
+
+  EXPECT_EQ(compression::gzip::Decompress(compression::gzip::Compress({}),
+                                          kMaxSize),
+            "");
+}
+
+TEST(Gzip, InvalidLevel) {
+  EXPECT_THROW(compression::gzip::Compress("data", 0),
+               compression::CompressionError);
+  EXPECT_THROW(compression::gzip::Compress("data", 10),
+               compression::CompressionError);
+}
+
+TEST(Gzip, StreamingCompressor) {
+  const auto data = MakeData();
+
+  compression::gzip::Compressor compressor{1};
+  std::string compressed;
+  for (std::size_t pos = 0; pos < data.size(); pos += 1000) {
+    const auto part = compressor.Compress(data.substr(pos, 1000));
+    // Every part is flushed
+    EXPECT_FALSE(part.empty());
+    compressed += part;
+  }
+  compressed += compressor.Finish();
+
+  EXPECT_LT(compressed.size(), data.size());
+  EXPECT_EQ(compression::gzip::Decompress(compressed, kMaxSize), data);
+}
+
+USERVER_NAMESPACE_END
@@ -214,6 +214,9 @@ class easy final : public std::enable_shared_from_this<easy> {
 
   const multi* GetMulti() const { return multi_; }
 
+  // Must not be called while the easy is being performed
+  void SetMulti(multi& multi_handle);
+
   inline native::CURL* native_handle() { return handle_; }
   engine::ev::ThreadControl& GetThreadControl();
 
@@ -1,8 +1,13 @@
 #include <userver/engine/io/tls_wrapper.hpp>
 
+#include <array>
+#include <atomic>
 #include <boost/stacktrace/stacktrace.hpp>
 #include <exception>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <fmt/format.h>
 #include <openssl/bio.h>
@@ -13,6 +18,7 @@
 #include <engine/io/fd_control.hpp>
 #include <userver/engine/io/exception.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/rcu/rcu.hpp>
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -30,6 +36,13 @@ struct SslDeleter {
 };
 using Ssl = std::unique_ptr<SSL, SslDeleter>;
 
+struct SslSessionDeleter {
+  void operator()(SSL_SESSION* session) const noexcept {
+    SSL_SESSION_free(session);
+  }
+};
+using SslSession = std::unique_ptr<SSL_SESSION, SslSessionDeleter>;
+
 struct BioDeleter {
   void operator()(BIO* bio) const noexcept { BIO_free_all(bio); }
 };
@@ -226,6 +239,136 @@ SslCtx MakeSslCtx() {
   return ssl_ctx;
 }
 
+// The ALPN protocols in wire format are owned by the SSL_CTX, so that the
+// selection callback works for any SSL object created from that context.
+int GetAlpnProtocolsIndex() {
+  static const int kIndex = SSL_CTX_get_ex_new_index(
+      0, nullptr, nullptr, nullptr,
+      [](void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+        delete static_cast<std::string*>(ptr);
+      });
+  return kIndex;
+}
+
+int SelectAlpnProtocol(SSL* ssl, const unsigned char** out,
+                       unsigned char* outlen, const unsigned char* in,
+                       unsigned int inlen, void*) noexcept {
+  const auto* protocols = static_cast<const std::string*>(SSL_CTX_get_ex_data(
+      SSL_get_SSL_CTX(ssl), GetAlpnProtocolsIndex()));
+  if (!protocols) return SSL_TLSEXT_ERR_NOACK;
+
+  unsigned char* selected = nullptr;
+  // Server preference order
+  if (OPENSSL_NPN_NEGOTIATED !=
+      SSL_select_next_proto(
+          &selected, outlen,
+          reinterpret_cast<const unsigned char*>(protocols->data()),
+          protocols->size(), in, inlen)) {
+    return SSL_TLSEXT_ERR_NOACK;
+  }
+  *out = selected;
+  return SSL_TLSEXT_ERR_OK;
+}
+
+void SetAlpnProtocols(SSL_CTX* ssl_ctx,
+                      const std::vector<std::string>& alpn_protocols) {
+  auto wire_protocols = std::make_unique<std::string>();
+  for (const auto& protocol : alpn_protocols) {
+    if (protocol.empty() || protocol.size() > 255) {
+      throw TlsException(
+          fmt::format("Invalid ALPN protocol name '{}'", protocol));
+    }
+    wire_protocols->push_back(static_cast<char>(protocol.size()));
+    wire_protocols->append(protocol);
+  }
+
+  if (1 != SSL_CTX_set_ex_data(ssl_ctx, GetAlpnProtocolsIndex(),
+                               wire_protocols.get())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_set_ex_data"));
+  }
+  wire_protocols.release();
+  SSL_CTX_set_alpn_select_cb(ssl_ctx, &SelectAlpnProtocol, nullptr);
+}
+
+SslCtx MakeServerSslCtx(const TlsServerContext::Settings& settings) {
+  auto ssl_ctx = MakeSslCtx();
+
+  if (!settings.alpn_protocols.empty()) {
+    SetAlpnProtocols(ssl_ctx.get(), settings.alpn_protocols);
+  }
+
+  if (!settings.cert_authorities.empty()) {
+    auto* store = SSL_CTX_get_cert_store(ssl_ctx.get());
+    for (const auto& ca : settings.cert_authorities) {
+      if (1 != X509_STORE_add_cert(store, ca.GetNative())) {
+        throw TlsException(crypto::FormatSslError(
+            "Failed to set up server TLS wrapper: X509_STORE_add_cert"));
+      }
+    }
+    SSL_CTX_set_verify(ssl_ctx.get(),
+                       SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
+                       nullptr);
+    LOG_INFO() << "Client SSL cert will be verified";
+  } else {
+    LOG_INFO() << "Client SSL cert will not be verified";
+  }
+
+  if (1 != SSL_CTX_use_certificate(ssl_ctx.get(), settings.cert.GetNative())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_use_certificate"));
+  }
+
+  if (1 != SSL_CTX_use_PrivateKey(ssl_ctx.get(), settings.key.GetNative())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
+  }
+
+  // Sessions are not resumed with a mismatching id context, and resumption
+  // with client cert verification fails if it is not set at all
+  static constexpr std::string_view kSessionIdContext = "userver";
+  if (1 != SSL_CTX_set_session_id_context(
+               ssl_ctx.get(),
+               reinterpret_cast<const unsigned char*>(kSessionIdContext.data()),
+               kSessionIdContext.size())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_set_session_id_context"));
+  }
+
+  if (settings.session_cache_size) {
+    SSL_CTX_set_session_cache_mode(ssl_ctx.get(), SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(ssl_ctx.get(), settings.session_cache_size);
+  } else {
+    SSL_CTX_set_session_cache_mode(ssl_ctx.get(), SSL_SESS_CACHE_OFF);
+  }
+
+  if (!settings.session_tickets) {
+    SSL_CTX_set_options(ssl_ctx.get(), SSL_OP_NO_TICKET);
+  }
+
+  return ssl_ctx;
+}
+
+// Copies the session ticket encryption keys to a new context, so that tickets
+// issued with the old one may still be used for resumption
+void CopySessionTicketKeys(SSL_CTX* from, SSL_CTX* to) {
+#if OPENSSL_VERSION_NUMBER >= 0x010100000L
+  constexpr std::size_t kTicketKeysSize = 80;
+#else
+  constexpr std::size_t kTicketKeysSize = 48;
+#endif
+  std::array<unsigned char, kTicketKeysSize> keys{};
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  if (1 != SSL_CTX_get_tlsext_ticket_keys(from, keys.data(), keys.size()) ||
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+      1 != SSL_CTX_set_tlsext_ticket_keys(to, keys.data(), keys.size())) {
+    LOG_WARNING() << crypto::FormatSslError(
+        "Failed to preserve TLS session ticket keys, previously issued "
+        "tickets are invalidated");
+  }
+  OPENSSL_cleanse(keys.data(), keys.size());
+}
+
 enum InterruptAction {
   kPass,
   kFail,
@@ -233,6 +376,34 @@ enum InterruptAction {
 
 }  // namespace
 
+class TlsServerContext::Impl {
+ public:
+  explicit Impl(const Settings& settings)
+      : ssl_ctx(rcu::DestructionType::kSync, MakeServerSslCtx(settings)) {}
+
+  rcu::Variable<SslCtx> ssl_ctx;
+  std::atomic<std::uint64_t> full_handshakes{0};
+  std::atomic<std::uint64_t> resumed_handshakes{0};
+};
+
+TlsServerContext::TlsServerContext(const Settings& settings)
+    : impl_(std::make_unique<Impl>(settings)) {}
+
+TlsServerContext::~TlsServerContext() = default;
+
+void TlsServerContext::Reload(const Settings& settings) {
+  auto ssl_ctx = MakeServerSslCtx(settings);
+  {
+    const auto old_ssl_ctx = impl_->ssl_ctx.Read();
+    CopySessionTicketKeys(old_ssl_ctx->get(), ssl_ctx.get());
+  }
+  impl_->ssl_ctx.Assign(std::move(ssl_ctx));
+}
+
+TlsServerContext::HandshakeStats TlsServerContext::GetHandshakeStats() const {
+  return {impl_->full_handshakes.load(), impl_->resumed_handshakes.load()};
+}
+
 class TlsWrapper::ReadContextAccessor final
     : public engine::impl::ContextAccessor {
  public:
@@ -269,7 +440,7 @@ class TlsWrapper::Impl {
     SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
   }
 
-  void SetUp(SslCtx&& ssl_ctx) {
+  void SetUp(SSL_CTX* ssl_ctx) {
     Bio socket_bio{BIO_new(GetSocketBioMethod())};
     if (!socket_bio) {
       throw TlsException(
@@ -279,7 +450,8 @@ class TlsWrapper::Impl {
     SyncBioData(socket_bio.get(), nullptr);
     BIO_set_init(socket_bio.get(), 1);
 
-    ssl.reset(SSL_new(ssl_ctx.get()));
+    // SSL holds a reference to the context
+    ssl.reset(SSL_new(ssl_ctx));
     if (!ssl) {
       throw TlsException(
           crypto::FormatSslError("Failed to set up TLS wrapper: SSL_new"));
@@ -427,6 +599,13 @@ TlsWrapper::TlsWrapper(Socket&& socket) : impl_(std::move(socket)) {
 TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
                                       const std::string& server_name,
                                       Deadline deadline) {
+  return StartTlsClient(std::move(socket), server_name, {}, deadline);
+}
+
+TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
+                                      const std::string& server_name,
+                                      const std::string& session_data,
+                                      Deadline deadline) {
   auto ssl_ctx = MakeSslCtx();
 
   if (!server_name.empty()) {
@@ -444,7 +623,7 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
   }
 
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
+  wrapper.impl_->SetUp(ssl_ctx.get());
   if (!server_name.empty()) {
     // cast in openssl1.0 macro expansion
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
@@ -454,6 +633,18 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
           "Failed to set up client TLS wrapper: SSL_set_tlsext_host_name"));
     }
   }
+  if (!session_data.empty()) {
+    const auto* data =
+        reinterpret_cast<const unsigned char*>(session_data.data());
+    const auto size = static_cast<long>(session_data.size());
+    SslSession session{d2i_SSL_SESSION(nullptr, &data, size)};
+    // A broken session is not fatal, the handshake is just a full one
+    if (!session || 1 != SSL_set_session(wrapper.impl_->ssl.get(),
+                                         session.get())) {
+      LOG_LIMITED_WARNING() << crypto::FormatSslError(
+          "Failed to set up TLS session for resumption");
+    }
+  }
 
   wrapper.impl_->bio_data.current_deadline = deadline;
 
@@ -473,37 +664,29 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
 TlsWrapper TlsWrapper::StartTlsServer(
     Socket&& socket, const crypto::Certificate& cert,
     const crypto::PrivateKey& key, Deadline deadline,
-    const std::vector<crypto::Certificate>& cert_authorities) {
-  auto ssl_ctx = MakeSslCtx();
-
-  if (!cert_authorities.empty()) {
-    auto* store = SSL_CTX_get_cert_store(ssl_ctx.get());
-    for (const auto& ca : cert_authorities) {
-      if (1 != X509_STORE_add_cert(store, ca.GetNative())) {
-        throw TlsException(crypto::FormatSslError(
-            "Failed to set up server TLS wrapper: X509_STORE_add_cert"));
-      }
-    }
-    SSL_CTX_set_verify(ssl_ctx.get(),
-                       SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
-                       nullptr);
-    LOG_INFO() << "Client SSL cert will be verified";
-  } else {
-    LOG_INFO() << "Client SSL cert will not be verified";
-  }
-
-  if (1 != SSL_CTX_use_certificate(ssl_ctx.get(), cert.GetNative())) {
-    throw TlsException(crypto::FormatSslError(
-        "Failed to set up server TLS wrapper: SSL_CTX_use_certificate"));
-  }
-
-  if (1 != SSL_CTX_use_PrivateKey(ssl_ctx.get(), key.GetNative())) {
-    throw TlsException(crypto::FormatSslError(
-        "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
-  }
+    const std::vector<crypto::Certificate>& cert_authorities,
+    const std::vector<std::string>& alpn_protocols) {
+  TlsServerContext::Settings settings;
+  settings.cert = cert;
+  settings.key = key;
+  settings.cert_authorities = cert_authorities;
+  settings.alpn_protocols = alpn_protocols;
+  // The context is not reused, so there is nothing to resume
+  settings.session_tickets = false;
+  settings.session_cache_size = 0;
+
+  return StartTlsServer(std::move(socket), TlsServerContext{settings},
+                        deadline);
+}
 
+TlsWrapper TlsWrapper::StartTlsServer(Socket&& socket,
+                                      const TlsServerContext& context,
+                                      Deadline deadline) {
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
+  {
+    const auto ssl_ctx = context.impl_->ssl_ctx.Read();
+    wrapper.impl_->SetUp(ssl_ctx->get());
+  }
   wrapper.impl_->bio_data.current_deadline = deadline;
 
   auto ret = SSL_accept(wrapper.impl_->ssl.get());
@@ -518,6 +701,11 @@ TlsWrapper TlsWrapper::StartTlsServer(
   }
 
   UASSERT(wrapper.impl_->ssl);
+  if (wrapper.IsSessionReused()) {
+    ++context.impl_->resumed_handshakes;
+  } else {
+    ++context.impl_->full_handshakes;
+  }
   return wrapper;
 }
 
@@ -618,6 +806,36 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
 
 int TlsWrapper::GetRawFd() { return impl_->bio_data.socket.Fd(); }
 
+std::string TlsWrapper::GetAlpnProtocol() const {
+  if (!impl_->ssl) return {};
+
+  const unsigned char* protocol = nullptr;
+  unsigned int length = 0;
+  SSL_get0_alpn_selected(impl_->ssl.get(), &protocol, &length);
+  if (!protocol) return {};
+  return std::string(reinterpret_cast<const char*>(protocol), length);
+}
+
+bool TlsWrapper::IsSessionReused() const {
+  return impl_->ssl && SSL_session_reused(impl_->ssl.get()) == 1;
+}
+
+std::string TlsWrapper::GetSessionData() const {
+  if (!impl_->ssl) return {};
+  auto* session = SSL_get_session(impl_->ssl.get());
+#if OPENSSL_VERSION_NUMBER >= 0x010101000L
+  if (!session || 1 != SSL_SESSION_is_resumable(session)) return {};
+#else
+  if (!session) return {};
+#endif
+  const auto size = i2d_SSL_SESSION(session, nullptr);
+  if (size <= 0) return {};
+  std::string data(size, '\0');
+  auto* out = reinterpret_cast<unsigned char*>(data.data());
+  i2d_SSL_SESSION(session, &out);
+  return data;
+}
+
 }  // namespace engine::io
 
 USERVER_NAMESPACE_END
@@ -572,4 +572,90 @@ UTEST(TlsWrapper, PeerDisconnect) {
   server_task.Get();
 }
 
+UTEST_MT(TlsWrapper, SharedServerContext, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  io::TlsServerContext::Settings settings;
+  settings.cert = crypto::Certificate::LoadFromString(cert);
+  settings.key = crypto::PrivateKey::LoadFromString(key);
+  io::TlsServerContext context{settings};
+
+  TcpListener tcp_listener;
+  for (int i = 0; i < 3; ++i) {
+    if (i == 2) {
+      settings.cert = crypto::Certificate::LoadFromString(other_cert);
+      settings.key = crypto::PrivateKey::LoadFromString(other_key);
+      context.Reload(settings);
+    }
+
+    auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+    auto server_task = engine::AsyncNoSpan(
+        [test_deadline, &context](auto&& server) {
+          auto tls_server = io::TlsWrapper::StartTlsServer(
+              std::forward<decltype(server)>(server), context, test_deadline);
+          EXPECT_FALSE(tls_server.IsSessionReused());
+          EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+        },
+        std::move(server));
+
+    auto tls_client =
+        io::TlsWrapper::StartTlsClient(std::move(client), {}, test_deadline);
+    char c = 0;
+    EXPECT_EQ(1, tls_client.RecvSome(&c, 1, test_deadline));
+    EXPECT_EQ('1', c);
+    UEXPECT_NO_THROW(server_task.Get());
+  }
+}
+
+UTEST_MT(TlsWrapper, SessionResumption, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  for (const bool session_tickets : {true, false}) {
+    io::TlsServerContext::Settings settings;
+    settings.cert = crypto::Certificate::LoadFromString(cert);
+    settings.key = crypto::PrivateKey::LoadFromString(key);
+    settings.session_tickets = session_tickets;
+    io::TlsServerContext context{settings};
+
+    TcpListener tcp_listener;
+    std::string session_data;
+    const auto connect = [&](bool expect_resumed) {
+      auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+      auto server_task = engine::AsyncNoSpan(
+          [test_deadline, &context, expect_resumed](auto&& server) {
+            auto tls_server = io::TlsWrapper::StartTlsServer(
+                std::forward<decltype(server)>(server), context,
+                test_deadline);
+            EXPECT_EQ(expect_resumed, tls_server.IsSessionReused());
+            EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+          },
+          std::move(server));
+
+      auto tls_client = io::TlsWrapper::StartTlsClient(
+          std::move(client), {}, session_data, test_deadline);
+      char c = 0;
+      // TLS 1.3 session tickets arrive along with the data
+      EXPECT_EQ(1, tls_client.RecvSome(&c, 1, test_deadline));
+      EXPECT_EQ(expect_resumed, tls_client.IsSessionReused());
+      session_data = tls_client.GetSessionData();
+      EXPECT_FALSE(session_data.empty());
+      UEXPECT_NO_THROW(server_task.Get());
+    };
+
+    connect(false);
+    connect(true);
+
+    settings.cert = crypto::Certificate::LoadFromString(other_cert);
+    settings.key = crypto::PrivateKey::LoadFromString(other_key);
+    context.Reload(settings);
+
+    // Ticket keys survive the reload, the session cache does not
+    connect(session_tickets);
+
+    const auto stats = context.GetHandshakeStats();
+    EXPECT_EQ(session_tickets ? 1 : 2, stats.full);
+    EXPECT_EQ(session_tickets ? 2 : 1, stats.resumed);
+  }
+}
+
 USERVER_NAMESPACE_END
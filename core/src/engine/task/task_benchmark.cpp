@@ -2,8 +2,11 @@
 
 #include <atomic>
 #include <thread>
+#include <vector>
 
 #include <engine/impl/standalone.hpp>
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/sleep.hpp>
@@ -14,6 +17,61 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace {
+
+void RunWithTaskQueue(engine::TaskQueueType queue_type,
+                      std::size_t worker_threads,
+                      utils::function_ref<void()> payload) {
+  engine::TaskProcessorConfig config;
+  config.name = "benchmark";
+  config.thread_name = "bench-worker";
+  config.worker_threads = worker_threads;
+  config.task_processor_queue = queue_type;
+
+  engine::TaskProcessor task_processor{
+      std::move(config), engine::impl::MakeTaskProcessorPools({})};
+  engine::impl::RunOnTaskProcessorSync(task_processor, payload);
+}
+
+template <engine::TaskQueueType QueueType>
+void engine_task_spawn_and_wait(benchmark::State& state) {
+  RunWithTaskQueue(QueueType, state.range(0), [&] {
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(state.range(0) * 2);
+
+    for ([[maybe_unused]] auto _ : state) {
+      for (std::int64_t i = 0; i < state.range(0) * 2; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([] {
+          engine::AsyncNoSpan([] {}).Get();
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+      tasks.clear();
+    }
+  });
+}
+
+template <engine::TaskQueueType QueueType>
+void engine_task_yield_queue_type(benchmark::State& state) {
+  RunWithTaskQueue(QueueType, state.range(0), [&] {
+    std::atomic<std::uint64_t> total_yields{0};
+
+    RunParallelBenchmark(state, [&](auto& range) {
+      std::uint64_t yields_performed = 0;
+      for ([[maybe_unused]] auto _ : range) {
+        engine::Yield();
+        ++yields_performed;
+      }
+      total_yields += yields_performed;
+    });
+
+    state.counters["yields"] =
+        benchmark::Counter(total_yields, benchmark::Counter::kIsRate);
+  });
+}
+
+}  // namespace
+
 void engine_task_create(benchmark::State& state) {
   // We use 2 threads to ensure that detached tasks are deallocated,
   // otherwise this benchmark OOMs after some time.
@@ -102,6 +160,36 @@ BENCHMARK(engine_task_yield_multiple_task_processors)
     ->RangeMultiplier(2)
     ->Range(1, 32);
 
+void engine_task_spawn_global_queue(benchmark::State& state) {
+  engine_task_spawn_and_wait<engine::TaskQueueType::kGlobalTaskQueue>(state);
+}
+BENCHMARK(engine_task_spawn_global_queue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
+
+void engine_task_spawn_work_stealing_queue(benchmark::State& state) {
+  engine_task_spawn_and_wait<engine::TaskQueueType::kWorkStealingTaskQueue>(
+      state);
+}
+BENCHMARK(engine_task_spawn_work_stealing_queue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
+
+void engine_task_yield_global_queue(benchmark::State& state) {
+  engine_task_yield_queue_type<engine::TaskQueueType::kGlobalTaskQueue>(state);
+}
+BENCHMARK(engine_task_yield_global_queue)->RangeMultiplier(2)->Range(1, 32);
+
+void engine_task_yield_work_stealing_queue(benchmark::State& state) {
+  engine_task_yield_queue_type<engine::TaskQueueType::kWorkStealingTaskQueue>(
+      state);
+}
+BENCHMARK(engine_task_yield_work_stealing_queue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+
 void thread_yield(benchmark::State& state) {
   for ([[maybe_unused]] auto _ : state) std::this_thread::yield();
 }
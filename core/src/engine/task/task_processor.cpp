@@ -45,6 +45,19 @@ std::vector<std::function<void()>>& ThreadStartedHooks() {
   return thread_started_hooks;
 }
 
+std::variant<TaskQueue, WorkStealingTaskQueue> MakeTaskQueue(
+    const TaskProcessorConfig& config) {
+  using Queue = std::variant<TaskQueue, WorkStealingTaskQueue>;
+  switch (config.task_processor_queue) {
+    case TaskQueueType::kGlobalTaskQueue:
+      return Queue{std::in_place_type<TaskQueue>, config};
+    case TaskQueueType::kWorkStealingTaskQueue:
+      return Queue{std::in_place_type<WorkStealingTaskQueue>, config};
+  }
+
+  UINVARIANT(false, "Unexpected value of TaskQueueType");
+}
+
 void EmitMagicNanosleep() {
   // If we're ptrace'd (e.g. by strace), the magic syscall tells a tracer
   // that all startup stuff of the current thread is done.
@@ -68,7 +81,7 @@ void TaskProcessorThreadStartedHook() {
 TaskProcessor::TaskProcessor(TaskProcessorConfig config,
                              std::shared_ptr<impl::TaskProcessorPools> pools)
     : task_counter_(config.worker_threads),
-      task_queue_(config),
+      task_queue_(MakeTaskQueue(config)),
       config_(std::move(config)),
       pools_(std::move(pools)) {
   utils::impl::FinishStaticRegistration();
@@ -105,7 +118,7 @@ void TaskProcessor::Cleanup() noexcept {
   // Some tasks may be bound but not scheduled yet
   task_counter_.WaitForExhaustion();
 
-  task_queue_.StopProcessing();
+  std::visit([](auto& queue) { queue.StopProcessing(); }, task_queue_);
 
   for (auto& w : workers_) {
     w.join();
@@ -136,13 +149,19 @@ void TaskProcessor::Schedule(impl::TaskContext* context) {
 
   SetTaskQueueWaitTimepoint(context);
 
-  task_queue_.Push(context);
+  std::visit([context](auto& queue) { queue.Push(context); }, task_queue_);
 }
 
 void TaskProcessor::Adopt(impl::TaskContext& context) {
   detached_contexts_->Add(context);
 }
 
+size_t TaskProcessor::GetTaskQueueSize() const {
+  return std::visit(
+      [](const auto& queue) { return queue.GetSizeApproximate(); },
+      task_queue_);
+}
+
 ev::ThreadPool& TaskProcessor::EventThreadPool() {
   return pools_->EventThreadPool();
 }
@@ -248,8 +267,13 @@ void TaskProcessor::PrepareWorkerThread(std::size_t index) noexcept {
 }
 
 void TaskProcessor::ProcessTasks() noexcept {
+  std::visit([this](auto& queue) { ProcessTasks(queue); }, task_queue_);
+}
+
+template <typename Queue>
+void TaskProcessor::ProcessTasks(Queue& task_queue) noexcept {
   while (true) {
-    auto context = task_queue_.PopBlocking();
+    auto context = task_queue.PopBlocking();
     if (!context) break;
 
     GetTaskCounter().AccountTaskSwitchSlow();
@@ -5,6 +5,7 @@
 #include <functional>
 #include <memory>
 #include <thread>
+#include <variant>
 #include <vector>
 
 #include <boost/smart_ptr/intrusive_ptr.hpp>
@@ -13,6 +14,7 @@
 #include <engine/task/task_counter.hpp>
 #include <engine/task/task_processor_config.hpp>
 #include <engine/task/task_queue.hpp>
+#include <engine/task/work_stealing_task_queue.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
@@ -57,7 +59,7 @@ class TaskProcessor final {
 
   const impl::TaskCounter& GetTaskCounter() const { return task_counter_; }
 
-  size_t GetTaskQueueSize() const { return task_queue_.GetSizeApproximate(); }
+  size_t GetTaskQueueSize() const;
 
   size_t GetWorkerCount() const { return workers_.size(); }
 
@@ -84,6 +86,9 @@ class TaskProcessor final {
 
   void ProcessTasks() noexcept;
 
+  template <typename Queue>
+  void ProcessTasks(Queue& task_queue) noexcept;
+
   void CheckWaitTime(impl::TaskContext& context);
 
   void SetTaskQueueWaitTimeOverloaded(bool new_value) noexcept;
@@ -95,7 +100,7 @@ class TaskProcessor final {
       detached_contexts_{impl::DetachedTasksSyncBlock::StopMode::kCancel};
   concurrent::impl::InterferenceShield<std::atomic<bool>>
       task_queue_wait_time_overloaded_{false};
-  TaskQueue task_queue_;
+  std::variant<TaskQueue, WorkStealingTaskQueue> task_queue_;
 
   const TaskProcessorConfig config_;
   const std::shared_ptr<impl::TaskProcessorPools> pools_;
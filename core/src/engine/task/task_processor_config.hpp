@@ -21,6 +21,14 @@ enum class OsScheduling {
 OsScheduling Parse(const yaml_config::YamlConfig& value,
                    formats::parse::To<OsScheduling>);
 
+enum class TaskQueueType {
+  kGlobalTaskQueue,
+  kWorkStealingTaskQueue,
+};
+
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>);
+
 struct TaskProcessorConfig {
   std::string name;
 
@@ -29,6 +37,7 @@ struct TaskProcessorConfig {
   std::string thread_name;
   OsScheduling os_scheduling{OsScheduling::kNormal};
   int spinning_iterations{10000};
+  TaskQueueType task_processor_queue{TaskQueueType::kGlobalTaskQueue};
 
   std::size_t task_trace_every{1000};
   std::size_t task_trace_max_csw{0};
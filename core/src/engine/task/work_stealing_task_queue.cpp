@@ -0,0 +1,345 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <algorithm>
+#include <array>
+
+#include <moodycamel/lightweightsemaphore.h>
+
+#include <engine/task/task_context.hpp>
+#include <userver/compiler/impl/tls.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace {
+
+// Every Nth pop checks the global queue first, so that tasks scheduled from
+// outside of the TaskProcessor are not starved by the local ones.
+constexpr std::size_t kGlobalQueueCheckInterval = 61;
+
+// Limits the number of consecutive pops from the LIFO slot, so that a pair
+// of tasks waking each other up does not starve the local queue.
+constexpr std::size_t kMaxLifoPopsInRow = 3;
+
+constexpr std::size_t kMaxStealBatch = 32;
+
+constexpr std::size_t kSemaphoreInitialCount = 0;
+
+// Sleeping is preceded by our own spinning in Search(), so the semaphore
+// itself should go to sleep right away.
+constexpr int kSemaphoreSpinningIterations = 0;
+
+}  // namespace
+
+struct alignas(concurrent::impl::kDestructiveInterferenceSize)
+    WorkStealingTaskQueue::Consumer final {
+  Consumer(WorkStealingTaskQueue& owner, std::size_t index)
+      : owner(owner),
+        index(index),
+        local_producer(local_queue),
+        global_token(owner.global_queue_) {}
+
+  WorkStealingTaskQueue& owner;
+  const std::size_t index;
+
+  // Written only by the owning thread, read and stolen from by any thread.
+  moodycamel::ConcurrentQueue<impl::TaskContext*> local_queue;
+  moodycamel::ProducerToken local_producer;
+  std::atomic<impl::TaskContext*> lifo_slot{nullptr};
+
+  moodycamel::LightweightSemaphore wakeup{kSemaphoreInitialCount,
+                                          kSemaphoreSpinningIterations};
+
+  // Accessed only by the owning thread
+  moodycamel::ConsumerToken global_token;
+  std::size_t pops_count{0};
+  std::size_t lifo_pops_in_row{0};
+  std::array<impl::TaskContext*, kMaxStealBatch> steal_buffer{};
+};
+
+namespace {
+
+// Current thread handles only a single TaskProcessor, so it's safe to store
+// the consumer of the current thread in a thread-local variable.
+thread_local void* local_consumer = nullptr;
+
+}  // namespace
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(const TaskProcessorConfig& config)
+    : spinning_iterations_(
+          std::max(static_cast<std::size_t>(
+                       std::max(config.spinning_iterations, 0)),
+                   config.worker_threads)),
+      consumers_count_(config.worker_threads) {
+  UINVARIANT(consumers_count_ > 0,
+             "WorkStealingTaskQueue requires at least one worker");
+  consumers_.reserve(consumers_count_);
+  for (std::size_t i = 0; i < consumers_count_; ++i) {
+    consumers_.push_back(std::make_unique<Consumer>(*this, i));
+  }
+  sleepers_.reserve(consumers_count_);
+}
+
+WorkStealingTaskQueue::~WorkStealingTaskQueue() = default;
+
+void WorkStealingTaskQueue::Push(
+    boost::intrusive_ptr<impl::TaskContext>&& context) {
+  UASSERT(context);
+  auto* const raw_context = context.detach();
+
+  auto* const consumer = GetLocalConsumer();
+  if (!consumer) {
+    PushGlobal(raw_context);
+  } else if (current_task::GetCurrentTaskContextUnchecked()) {
+    PushLocal(*consumer, raw_context);
+  } else {
+    // A task that reschedules itself (e.g. engine::Yield) is not run from
+    // within a task scope. It goes to the back of the queue to let others run.
+    consumer->local_queue.enqueue(consumer->local_producer, raw_context);
+  }
+
+  NotifyOne();
+}
+
+boost::intrusive_ptr<impl::TaskContext> WorkStealingTaskQueue::PopBlocking() {
+  auto& consumer = BindLocalConsumer();
+
+  while (true) {
+    if (auto* context = TryPop(consumer)) return {context, false};
+    if (auto* context = Search(consumer)) return {context, false};
+    if (is_stopped_.load()) return nullptr;
+    if (auto* context = Park(consumer)) return {context, false};
+  }
+}
+
+void WorkStealingTaskQueue::StopProcessing() {
+  is_stopped_.store(true);
+  NotifyAll();
+}
+
+std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
+  std::size_t size = global_queue_.size_approx();
+  for (const auto& consumer : consumers_) {
+    size += consumer->local_queue.size_approx();
+    if (consumer->lifo_slot.load(std::memory_order_relaxed)) ++size;
+  }
+  return size;
+}
+
+WorkStealingTaskQueue::Consumer*
+WorkStealingTaskQueue::GetLocalConsumer() noexcept {
+  USERVER_IMPL_PREVENT_TLS_CACHING_ASM;
+  auto* const consumer = static_cast<Consumer*>(local_consumer);
+  if (consumer && &consumer->owner == this) return consumer;
+  return nullptr;
+}
+
+WorkStealingTaskQueue::Consumer& WorkStealingTaskQueue::BindLocalConsumer() {
+  if (auto* consumer = GetLocalConsumer()) return *consumer;
+
+  const auto index = bound_consumers_.fetch_add(1);
+  UINVARIANT(index < consumers_count_,
+             "More threads are popping from WorkStealingTaskQueue than there "
+             "are workers in TaskProcessorConfig");
+  local_consumer = consumers_[index].get();
+  return *consumers_[index];
+}
+
+void WorkStealingTaskQueue::PushLocal(Consumer& consumer,
+                                      impl::TaskContext* context) {
+  auto* const previous =
+      consumer.lifo_slot.exchange(context, std::memory_order_acq_rel);
+  if (previous) {
+    consumer.local_queue.enqueue(consumer.local_producer, previous);
+  }
+}
+
+void WorkStealingTaskQueue::PushGlobal(impl::TaskContext* context) {
+  global_queue_.enqueue(context);
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPop(Consumer& consumer) {
+  if (++consumer.pops_count == kGlobalQueueCheckInterval) {
+    consumer.pops_count = 0;
+    if (auto* context = TryPopGlobal(consumer)) return context;
+  }
+
+  if (auto* context = TryPopLocal(consumer)) return context;
+  return TryPopGlobal(consumer);
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopLocal(Consumer& consumer) {
+  auto& lifo_slot = consumer.lifo_slot;
+
+  if (consumer.lifo_pops_in_row < kMaxLifoPopsInRow &&
+      lifo_slot.load(std::memory_order_relaxed)) {
+    auto* context = lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+    if (context) {
+      ++consumer.lifo_pops_in_row;
+      return context;
+    }
+  }
+  consumer.lifo_pops_in_row = 0;
+
+  impl::TaskContext* context = nullptr;
+  if (consumer.local_queue.try_dequeue_from_producer(consumer.local_producer,
+                                                     context)) {
+    return context;
+  }
+
+  if (!lifo_slot.load(std::memory_order_relaxed)) return nullptr;
+  return lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopGlobal(Consumer& consumer) {
+  impl::TaskContext* context = nullptr;
+  global_queue_.try_dequeue(consumer.global_token, context);
+  return context;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TrySteal(Consumer& consumer,
+                                                   bool include_lifo_slots) {
+  const auto start = utils::RandRange(consumers_count_);
+  for (std::size_t i = 0; i < consumers_count_; ++i) {
+    auto& victim = *consumers_[(start + i) % consumers_count_];
+    if (&victim == &consumer) continue;
+
+    if (auto* context = TryStealFrom(consumer, victim, include_lifo_slots)) {
+      return context;
+    }
+  }
+  return nullptr;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryStealFrom(Consumer& thief,
+                                                       Consumer& victim,
+                                                       bool include_lifo_slot) {
+  const auto victim_size = victim.local_queue.size_approx();
+  if (victim_size != 0) {
+    // Steal a half, rounding up, so that a single task is stolen as well
+    const auto batch = std::min(victim_size - victim_size / 2, kMaxStealBatch);
+    const auto stolen = victim.local_queue.try_dequeue_bulk_from_producer(
+        victim.local_producer, thief.steal_buffer.begin(), batch);
+
+    if (stolen != 0) {
+      if (stolen > 1) {
+        thief.local_queue.enqueue_bulk(
+            thief.local_producer, thief.steal_buffer.begin() + 1, stolen - 1);
+      }
+      return thief.steal_buffer[0];
+    }
+  }
+
+  if (!include_lifo_slot ||
+      !victim.lifo_slot.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return victim.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+impl::TaskContext* WorkStealingTaskQueue::Search(Consumer& consumer) {
+  StartSearching();
+
+  impl::TaskContext* context = nullptr;
+  const auto start = utils::RandRange(consumers_count_);
+  for (std::size_t attempt = 0; attempt < spinning_iterations_; ++attempt) {
+    const auto victim_index = (start + attempt) % consumers_count_;
+    if (victim_index == consumer.index) {
+      context = TryPopGlobal(consumer);
+    } else {
+      // LIFO slots are likely to be popped by their owners soon, do not
+      // steal from them during the first round
+      context = TryStealFrom(consumer, *consumers_[victim_index],
+                             /*include_lifo_slot=*/attempt >= consumers_count_);
+    }
+    if (context) break;
+  }
+
+  // The last searcher to find work wakes up another worker, as there may be
+  // more work available.
+  if (StopSearching() && context) NotifyOne();
+  return context;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::Park(Consumer& consumer) {
+  {
+    std::lock_guard lock(sleepers_mutex_);
+    sleepers_.push_back(consumer.index);
+    sleeping_count_->fetch_add(1);
+  }
+
+  // Pairs with the fence in NotifyOne(). Either the pusher sees us sleeping,
+  // or we see the task it pushed.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  auto* context = TryPopGlobal(consumer);
+  if (!context) context = TrySteal(consumer, /*include_lifo_slots=*/true);
+
+  if (context || is_stopped_.load()) {
+    if (!TryCancelSleep(consumer)) {
+      // Someone has already removed us from sleepers and is going to signal,
+      // consume the signal to keep the semaphore balanced.
+      consumer.wakeup.wait();
+    }
+    return context;
+  }
+
+  consumer.wakeup.wait();
+  return nullptr;
+}
+
+void WorkStealingTaskQueue::StartSearching() noexcept {
+  searching_count_->fetch_add(1);
+}
+
+bool WorkStealingTaskQueue::StopSearching() noexcept {
+  return searching_count_->fetch_sub(1) == 1;
+}
+
+void WorkStealingTaskQueue::NotifyOne() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  // A searching worker is going to find the task or to wake up someone else
+  // in Search(), no need to wake up a sleeping one.
+  if (searching_count_->load() != 0) return;
+  if (sleeping_count_->load() == 0) return;
+
+  std::size_t index{};
+  {
+    std::lock_guard lock(sleepers_mutex_);
+    if (sleepers_.empty()) return;
+    index = sleepers_.back();
+    sleepers_.pop_back();
+    sleeping_count_->fetch_sub(1);
+  }
+  consumers_[index]->wakeup.signal();
+}
+
+void WorkStealingTaskQueue::NotifyAll() {
+  std::vector<std::size_t> sleepers;
+  {
+    std::lock_guard lock(sleepers_mutex_);
+    sleepers.swap(sleepers_);
+    sleeping_count_->store(0);
+  }
+  for (const auto index : sleepers) {
+    consumers_[index]->wakeup.signal();
+  }
+}
+
+bool WorkStealingTaskQueue::TryCancelSleep(Consumer& consumer) {
+  std::lock_guard lock(sleepers_mutex_);
+  const auto it = std::find(sleepers_.begin(), sleepers_.end(), consumer.index);
+  if (it == sleepers_.end()) return false;
+
+  sleepers_.erase(it);
+  sleeping_count_->fetch_sub(1);
+  return true;
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <moodycamel/concurrentqueue.h>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <engine/task/task_processor_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+/// A scheduler queue with a local queue per worker thread.
+///
+/// * Tasks scheduled from a worker thread of the owning TaskProcessor go to
+///   the LIFO slot of that worker. A task previously occupying the slot is
+///   moved to the worker's local FIFO queue.
+/// * Tasks scheduled from other threads go to the shared global queue.
+/// * A worker without local work checks the global queue, then steals half
+///   of the local queue of randomly chosen workers, and only then sleeps.
+///
+/// Wakeups are performed only if there is no worker that is already searching
+/// for work, so under load the shared state is only read, never written.
+class WorkStealingTaskQueue final {
+ public:
+  explicit WorkStealingTaskQueue(const TaskProcessorConfig& config);
+  ~WorkStealingTaskQueue();
+
+  void Push(boost::intrusive_ptr<impl::TaskContext>&& context);
+
+  // Returns nullptr as a stop signal
+  boost::intrusive_ptr<impl::TaskContext> PopBlocking();
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  struct Consumer;
+
+  Consumer* GetLocalConsumer() noexcept;
+  Consumer& BindLocalConsumer();
+
+  void PushLocal(Consumer& consumer, impl::TaskContext* context);
+  void PushGlobal(impl::TaskContext* context);
+
+  impl::TaskContext* TryPop(Consumer& consumer);
+  impl::TaskContext* TryPopLocal(Consumer& consumer);
+  impl::TaskContext* TryPopGlobal(Consumer& consumer);
+  impl::TaskContext* TrySteal(Consumer& consumer, bool include_lifo_slots);
+  impl::TaskContext* TryStealFrom(Consumer& thief, Consumer& victim,
+                                  bool include_lifo_slot);
+
+  impl::TaskContext* Search(Consumer& consumer);
+  impl::TaskContext* Park(Consumer& consumer);
+
+  void StartSearching() noexcept;
+  bool StopSearching() noexcept;
+
+  void NotifyOne();
+  void NotifyAll();
+  bool TryCancelSleep(Consumer& consumer);
+
+  const std::size_t spinning_iterations_;
+  const std::size_t consumers_count_;
+  moodycamel::ConcurrentQueue<impl::TaskContext*> global_queue_;
+  std::vector<std::unique_ptr<Consumer>> consumers_;
+  std::atomic<std::size_t> bound_consumers_{0};
+
+  concurrent::impl::InterferenceShield<std::atomic<std::size_t>>
+      searching_count_{0};
+  concurrent::impl::InterferenceShield<std::atomic<std::size_t>>
+      sleeping_count_{0};
+  std::atomic<bool> is_stopped_{false};
+
+  std::mutex sleepers_mutex_;
+  std::vector<std::size_t> sleepers_;
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
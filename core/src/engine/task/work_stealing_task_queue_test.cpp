@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include <engine/impl/standalone.hpp>
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kTasksCount = 1000;
+constexpr std::size_t kMutexTasksCount = 16;
+constexpr std::size_t kIterations = 1000;
+
+void RunWorkStealing(std::size_t worker_threads,
+                     utils::function_ref<void()> payload) {
+  engine::TaskProcessorConfig config;
+  config.name = "work-stealing";
+  config.thread_name = "ws-worker";
+  config.worker_threads = worker_threads;
+  config.task_processor_queue = engine::TaskQueueType::kWorkStealingTaskQueue;
+
+  engine::TaskProcessor task_processor{
+      std::move(config), engine::impl::MakeTaskProcessorPools({})};
+  engine::impl::RunOnTaskProcessorSync(task_processor, payload);
+}
+
+}  // namespace
+
+TEST(WorkStealingTaskQueue, RunsAllTasks) {
+  RunWorkStealing(4, [] {
+    std::atomic<std::size_t> counter{0};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(kTasksCount);
+    for (std::size_t i = 0; i < kTasksCount; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&counter] {
+        engine::AsyncNoSpan([&counter] { ++counter; }).Get();
+      }));
+    }
+
+    engine::WaitAllChecked(tasks);
+    EXPECT_EQ(counter.load(), kTasksCount);
+  });
+}
+
+TEST(WorkStealingTaskQueue, CrossThreadWakeups) {
+  RunWorkStealing(4, [] {
+    engine::Mutex mutex;
+    std::size_t counter = 0;
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(kMutexTasksCount);
+    for (std::size_t i = 0; i < kMutexTasksCount; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        for (std::size_t j = 0; j < kIterations; ++j) {
+          std::lock_guard lock(mutex);
+          ++counter;
+        }
+      }));
+    }
+
+    engine::WaitAllChecked(tasks);
+    EXPECT_EQ(counter, kMutexTasksCount * kIterations);
+  });
+}
+
+TEST(WorkStealingTaskQueue, YieldLetsOthersRun) {
+  RunWorkStealing(1, [] {
+    std::atomic<bool> is_set{false};
+
+    auto waiter = engine::AsyncNoSpan([&is_set] {
+      while (!is_set) engine::Yield();
+    });
+    auto setter = engine::AsyncNoSpan([&is_set] { is_set = true; });
+
+    setter.Get();
+    waiter.Get();
+  });
+}
+
+USERVER_NAMESPACE_END
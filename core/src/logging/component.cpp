@@ -262,10 +262,18 @@ properties:
                       - tskv
                       - ltsv
                       - raw
+                      - binary
                 flush_level:
                     type: string
                     description: messages of this and higher levels get flushed to the file immediately
                     defaultDescription: warning
+                compression:
+                    type: string
+                    description: "compression of the log file: `none` or `gzip`, the latter writes the records as a separate gzip member at most once a second or every 1MB"
+                    defaultDescription: none
+                    enum:
+                      - none
+                      - gzip
                 message_queue_size:
                     type: integer
                     description: the size of internal message queue, must be a power of 2
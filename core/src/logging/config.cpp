@@ -18,6 +18,16 @@ QueueOverflowBehavior Parse(const yaml_config::YamlConfig& value,
   return utils::ParseFromValueString(value, kMap);
 }
 
+FileCompression Parse(const yaml_config::YamlConfig& value,
+                      formats::parse::To<FileCompression>) {
+  static constexpr utils::TrivialBiMap kMap([](auto selector) {
+    return selector()
+        .Case(FileCompression::kNone, "none")
+        .Case(FileCompression::kGzip, "gzip");
+  });
+  return utils::ParseFromValueString(value, kMap);
+}
+
 Format Parse(const yaml_config::YamlConfig& value, formats::parse::To<Format>) {
   const auto format_str = value.As<std::string>("tskv");
   return FormatFromString(format_str);
@@ -45,6 +55,9 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
   config.flush_level =
       value["flush_level"].As<logging::Level>(config.flush_level);
 
+  config.compression =
+      value["compression"].As<FileCompression>(config.compression);
+
   config.message_queue_size =
       value["message_queue_size"].As<size_t>(config.message_queue_size);
 
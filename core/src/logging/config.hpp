@@ -24,6 +24,11 @@ enum class QueueOverflowBehavior { kDiscard, kBlock };
 QueueOverflowBehavior Parse(const yaml_config::YamlConfig& value,
                             formats::parse::To<QueueOverflowBehavior>);
 
+enum class FileCompression { kNone, kGzip };
+
+FileCompression Parse(const yaml_config::YamlConfig& value,
+                      formats::parse::To<FileCompression>);
+
 struct LoggerConfig final {
   static constexpr size_t kDefaultMessageQueueSize = 1 << 16;
 
@@ -35,6 +40,7 @@ struct LoggerConfig final {
   Level level = Level::kInfo;
   Format format = Format::kTskv;
   Level flush_level = Level::kWarning;
+  FileCompression compression = FileCompression::kNone;
 
   // must be a power of 2
   size_t message_queue_size = kDefaultMessageQueueSize;
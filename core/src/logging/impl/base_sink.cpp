@@ -14,6 +14,20 @@ void BaseSink::Log(const LogMessage& message) {
   }
 }
 
+void BaseSink::LogBatch(utils::span<const LogMessage> messages) {
+  batch_.clear();
+  for (const auto& message : messages) {
+    if (ShouldLog(message.level)) batch_.push_back(message.payload);
+  }
+  if (!batch_.empty()) WriteBatch(batch_);
+}
+
+void BaseSink::WriteBatch(utils::span<const std::string_view> logs) {
+  for (const auto log : logs) {
+    Write(log);
+  }
+}
+
 void BaseSink::Flush() {}
 
 void BaseSink::Reopen(ReopenMode) {}
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <string_view>
+#include <vector>
 
 #include <logging/impl/reopen_mode.hpp>
 #include <userver/logging/level.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -22,6 +25,9 @@ class BaseSink {
 
   void Log(const LogMessage& message);
 
+  /// Writes the messages that pass the level filter, in order
+  void LogBatch(utils::span<const LogMessage> messages);
+
   virtual void Flush();
 
   virtual void Reopen(ReopenMode);
@@ -35,8 +41,13 @@ class BaseSink {
 
   virtual void Write(std::string_view log) = 0;
 
+  /// Writes several records at once, by default one by one
+  virtual void WriteBatch(utils::span<const std::string_view> logs);
+
  private:
   std::atomic<Level> level_{Level::kTrace};
+  // Reused by LogBatch to avoid allocations
+  std::vector<std::string_view> batch_;
 };
 
 }  // namespace logging::impl
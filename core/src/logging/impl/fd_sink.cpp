@@ -1,13 +1,64 @@
 #include "fd_sink.hpp"
 
+#include <sys/uio.h>
+
+#include <array>
+#include <cerrno>
+#include <system_error>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+// Well below IOV_MAX, which is at least 1024 on Linux
+constexpr std::size_t kMaxIovecs = 64;
+
+void WriteAll(int fd, ::iovec* iov, std::size_t count) {
+  while (count > 0) {
+    const ::ssize_t written = ::writev(fd, iov, static_cast<int>(count));
+    if (written < 0) {
+      if (errno == EAGAIN || errno == EINTR) continue;
+
+      const auto code = std::make_error_code(std::errc{errno});
+      throw std::system_error(code, "calling ::writev");
+    }
+
+    // Skip the written buffers and the written part of a partially written one
+    auto left = static_cast<std::size_t>(written);
+    while (count > 0 && left >= iov->iov_len) {
+      left -= iov->iov_len;
+      ++iov;
+      --count;
+    }
+    if (count > 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+      iov->iov_len -= left;
+    }
+  }
+}
+
+}  // namespace
+
 FdSink::FdSink(fs::blocking::FileDescriptor fd) : fd_{std::move(fd)} {}
 
 void FdSink::Write(std::string_view log) { fd_.Write(log); }
 
+void FdSink::WriteBatch(utils::span<const std::string_view> logs) {
+  std::array<::iovec, kMaxIovecs> iov{};
+  std::size_t count = 0;
+  for (const auto log : logs) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    iov[count++] = {const_cast<char*>(log.data()), log.size()};
+    if (count == iov.size()) {
+      WriteAll(fd_.GetNative(), iov.data(), count);
+      count = 0;
+    }
+  }
+  if (count > 0) WriteAll(fd_.GetNative(), iov.data(), count);
+}
+
 void FdSink::Flush() {
   if (fd_.IsOpen()) {
     fd_.FSync();
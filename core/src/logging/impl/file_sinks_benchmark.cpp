@@ -5,6 +5,7 @@
 
 #include "buffered_file_sink.hpp"
 #include "file_sink.hpp"
+#include "gzip_file_sink.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -38,4 +39,18 @@ void check_buffered_file_sink(benchmark::State& state) {
 }
 BENCHMARK(check_buffered_file_sink);
 
+void check_gzip_file_sink(benchmark::State& state) {
+  const auto temp_root = fs::blocking::TempDirectory::Create();
+  const std::string filename =
+      temp_root.GetPath() + "/temp_file_" + std::to_string(utils::Rand());
+  auto sink = logging::impl::GzipFileSink(filename);
+  for ([[maybe_unused]] auto _ : state) {
+    for (auto i = 0; i < kCountLogs; ++i) {
+      sink.Log({"message\n", logging::Level::kWarning});
+    }
+  }
+  sink.Flush();
+}
+BENCHMARK(check_gzip_file_sink);
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,60 @@
+#include "gzip_file_sink.hpp"
+
+#include <compression/gzip.hpp>
+#include <userver/utils/datetime.hpp>
+
+#include "open_file_helper.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+GzipFileSink::GzipFileSink(const std::string& filename)
+    : filename_{filename},
+      fd_(OpenFile<fs::blocking::FileDescriptor>(filename)) {
+  // No separator is written into a non-empty file, unlike FileSink does, as
+  // anything but a gzip member would end the decompression.
+  buffer_.reserve(kMaxMemberSize);
+}
+
+GzipFileSink::~GzipFileSink() {
+  try {
+    WriteMember();
+  } catch (const std::exception&) {
+    // There is nowhere to report the failure to
+  }
+}
+
+void GzipFileSink::Reopen(ReopenMode mode) {
+  WriteMember();
+  std::move(fd_).Close();
+  fd_ = OpenFile<fs::blocking::FileDescriptor>(filename_, mode);
+  // The first flush writes into the new file at once
+  last_member_time_ = {};
+}
+
+void GzipFileSink::Flush() {
+  if (utils::datetime::SteadyNow() - last_member_time_ < kMinMemberInterval) {
+    return;
+  }
+  WriteMember();
+}
+
+void GzipFileSink::Write(std::string_view log) {
+  buffer_.append(log);
+  if (buffer_.size() >= kMaxMemberSize) WriteMember();
+}
+
+void GzipFileSink::WriteMember() {
+  if (buffer_.empty() || !fd_.IsOpen()) return;
+
+  const auto member = compression::gzip::Compress(buffer_, kCompressionLevel);
+  buffer_.clear();
+  fd_.Write(member);
+  fd_.FSync();
+  last_member_time_ = utils::datetime::SteadyNow();
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include <userver/fs/blocking/file_descriptor.hpp>
+
+#include "base_sink.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// Writes the logs into a file compressed with gzip.
+///
+/// Records are buffered and written as a separate gzip member by Flush(), but
+/// not more often than once in kMinMemberInterval, or when kMaxMemberSize of
+/// them are buffered. The logger flushes on every record of flush_level, a
+/// member per such record would be tiny and compress badly, so those flushes
+/// are left for the periodic one. A concatenation of members is a valid gzip
+/// file, so the file can be read with `zcat` while being written, and a crash
+/// loses at most the records of the last unwritten member.
+class GzipFileSink final : public BaseSink {
+ public:
+  // Logs compress well even with the fastest level, and it is much cheaper
+  static constexpr int kCompressionLevel = 1;
+
+  // A member is written early if this much data is buffered between flushes
+  static constexpr std::size_t kMaxMemberSize = 1 << 20;
+
+  // Less than the period of the logging component flushes
+  static constexpr std::chrono::seconds kMinMemberInterval{1};
+
+  explicit GzipFileSink(const std::string& filename);
+  ~GzipFileSink() override;
+
+  void Reopen(ReopenMode mode) override;
+
+  void Flush() override;
+
+ protected:
+  void Write(std::string_view log) override;
+
+ private:
+  void WriteMember();
+
+  std::string filename_;
+  fs::blocking::FileDescriptor fd_;
+  std::string buffer_;
+  std::chrono::steady_clock::time_point last_member_time_{};
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,117 @@
+#include "gzip_file_sink.hpp"
+
+#include <compression/gzip.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/mock_now.hpp>
+
+#include "sink_helper_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kMaxDecompressedSize = 1 << 24;
+
+std::vector<std::string> ReadGzipFile(const std::string& filename) {
+  return test::NormalizeLogs(compression::gzip::Decompress(
+      fs::blocking::ReadFileContents(filename), kMaxDecompressedSize));
+}
+
+}  // namespace
+
+UTEST(GzipFileSink, WritesMemberOnFlush) {
+  const auto temp_root = fs::blocking::TempDirectory::Create();
+  const auto filename = temp_root.GetPath() + "/temp_file.gz";
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  logging::impl::GzipFileSink sink{filename};
+
+  sink.Log({"message\n", logging::Level::kWarning});
+  EXPECT_EQ(fs::blocking::ReadFileContents(filename), "");
+
+  sink.Flush();
+  EXPECT_EQ(ReadGzipFile(filename), test::Messages("message"));
+
+  utils::datetime::MockSleep(logging::impl::GzipFileSink::kMinMemberInterval);
+  sink.Log({"message 2\n", logging::Level::kInfo});
+  sink.Flush();
+  EXPECT_EQ(ReadGzipFile(filename), test::Messages("message", "message 2"));
+}
+
+UTEST(GzipFileSink, CoalescesFrequentFlushes) {
+  const auto temp_root = fs::blocking::TempDirectory::Create();
+  const auto filename = temp_root.GetPath() + "/temp_file.gz";
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  logging::impl::GzipFileSink sink{filename};
+
+  sink.Log({"message\n", logging::Level::kWarning});
+  sink.Flush();
+  const auto first_member = fs::blocking::ReadFileContents(filename);
+
+  // Flushes of the records of flush_level do not write members on their own
+  auto expected = test::Messages("message");
+  for (int i = 0; i < 10; ++i) {
+    sink.Log({"error\n", logging::Level::kError});
+    sink.Flush();
+    expected.push_back("error");
+  }
+  EXPECT_EQ(fs::blocking::ReadFileContents(filename), first_member);
+
+  utils::datetime::MockSleep(logging::impl::GzipFileSink::kMinMemberInterval);
+  sink.Flush();
+  EXPECT_EQ(ReadGzipFile(filename), expected);
+}
+
+UTEST(GzipFileSink, ReopenAppend) {
+  const auto temp_root = fs::blocking::TempDirectory::Create();
+  const auto filename = temp_root.GetPath() + "/temp_file.gz";
+
+  {
+    logging::impl::GzipFileSink sink{filename};
+    sink.Log({"message\n", logging::Level::kWarning});
+    sink.Reopen(logging::impl::ReopenMode::kAppend);
+    sink.Log({"message 2\n", logging::Level::kWarning});
+  }
+
+  // Reopening an existing file must keep it decodable
+  logging::impl::GzipFileSink sink{filename};
+  sink.Log({"message 3\n", logging::Level::kWarning});
+  sink.Flush();
+
+  EXPECT_EQ(ReadGzipFile(filename),
+            test::Messages("message", "message 2", "message 3"));
+}
+
+UTEST(GzipFileSink, ReopenTruncate) {
+  const auto temp_root = fs::blocking::TempDirectory::Create();
+  const auto filename = temp_root.GetPath() + "/temp_file.gz";
+  logging::impl::GzipFileSink sink{filename};
+
+  sink.Log({"message\n", logging::Level::kWarning});
+  sink.Flush();
+  sink.Log({"message 2\n", logging::Level::kWarning});
+  sink.Reopen(logging::impl::ReopenMode::kTruncate);
+  sink.Log({"message 3\n", logging::Level::kWarning});
+  sink.Flush();
+
+  EXPECT_EQ(ReadGzipFile(filename), test::Messages("message 3"));
+}
+
+UTEST(GzipFileSink, WritesMemberWhenBufferIsFull) {
+  const auto temp_root = fs::blocking::TempDirectory::Create();
+  const auto filename = temp_root.GetPath() + "/temp_file.gz";
+  logging::impl::GzipFileSink sink{filename};
+
+  const std::string message(1024, 'a');
+  const auto record = message + '\n';
+  const auto count =
+      logging::impl::GzipFileSink::kMaxMemberSize / record.size() + 1;
+  for (std::size_t i = 0; i < count; ++i) {
+    sink.Log({record, logging::Level::kInfo});
+  }
+
+  EXPECT_EQ(ReadGzipFile(filename), std::vector<std::string>(count, message));
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,99 @@
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include <logging/logging_test.hpp>
+#include <userver/logging/impl/binary_log.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
+#include <userver/logging/logger.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string DecodeToTskv(std::string_view data) {
+  std::string result;
+  while (!data.empty()) {
+    const auto consumed =
+        logging::impl::binary::DecodeRecordToTskv(data, result);
+    if (consumed == 0) throw std::runtime_error("Truncated binary log");
+    data.remove_prefix(consumed);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST_F(LoggingBinaryTest, Basic) {
+  LOG_INFO() << "This is the binary\ttext to log";
+  logging::LogFlush();
+
+  const auto tskv = DecodeToTskv(GetStreamString());
+  EXPECT_EQ(ParseLoggedText(tskv, logging::Format::kTskv),
+            "This is the binary\\ttext to log");
+  EXPECT_EQ(tskv.rfind("tskv\ttimestamp=", 0), 0) << tskv;
+  EXPECT_NE(tskv.find("\tlevel=INFO\t"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tmodule="), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tthread_id="), std::string::npos) << tskv;
+  EXPECT_EQ(tskv.back(), '\n');
+}
+
+TEST_F(LoggingBinaryTest, Extra) {
+  // The size of a medium value fits into the reserved bytes, the size of a
+  // long one does not
+  const std::string medium_value(1000, 'y');
+  const std::string long_value(20000, 'x');
+  LOG_INFO() << "text" << logging::LogExtra{{"custom.key", "a\nb"},
+                                            {"medium", medium_value},
+                                            {"long", long_value},
+                                            {"number", 42},
+                                            {"negative", -42}};
+  LOG_INFO() << "next";
+  logging::LogFlush();
+
+  const auto tskv = DecodeToTskv(GetStreamString());
+  EXPECT_EQ(std::count(tskv.begin(), tskv.end(), '\n'), 2) << tskv;
+  EXPECT_NE(tskv.find("\tcustom_key=a\\nb"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tmedium=" + medium_value), std::string::npos);
+  EXPECT_NE(tskv.find("\tlong=" + long_value), std::string::npos);
+  EXPECT_NE(tskv.find("\tnumber=42"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tnegative=-42"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\ttext=next"), std::string::npos) << tskv;
+}
+
+TEST_F(LoggingBinaryTest, IntegerTags) {
+  const auto record = [] {
+    logging::impl::binary::RecordBuilder builder{logging::Level::kInfo, {}};
+    builder.AddIntegerTag("small",
+                          logging::impl::binary::MakeIntegerValue(1ULL));
+    builder.AddIntegerTag(
+        "max", logging::impl::binary::MakeIntegerValue(
+                   std::numeric_limits<unsigned long long>::max()));
+    builder.AddIntegerTag("min", logging::impl::binary::MakeIntegerValue(
+                                     std::numeric_limits<long long>::min()));
+    return std::move(builder).Extract();
+  }();
+  // The integers are stored as varints, not as text
+  EXPECT_EQ(record.find("18446744073709551615"), std::string::npos);
+
+  const auto tskv = DecodeToTskv(record);
+  EXPECT_NE(tskv.find("\tsmall=1\t"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tmax=18446744073709551615\t"), std::string::npos)
+      << tskv;
+  EXPECT_NE(tskv.find("\tmin=-9223372036854775808\n"), std::string::npos)
+      << tskv;
+}
+
+TEST_F(LoggingBinaryTest, LogRaw) {
+  logging::impl::LogRaw(logging::GetDefaultLogger(), logging::Level::kInfo,
+                        "foo\tbar");
+  LOG_INFO() << "next";
+  logging::LogFlush();
+
+  const auto tskv = DecodeToTskv(GetStreamString());
+  EXPECT_EQ(std::count(tskv.begin(), tskv.end(), '\n'), 2) << tskv;
+  EXPECT_NE(tskv.find("\ttext=foo\\tbar\n"), std::string::npos) << tskv;
+}
+
+USERVER_NAMESPACE_END
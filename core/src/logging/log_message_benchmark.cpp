@@ -5,6 +5,7 @@
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
 #include <userver/logging/logger.hpp>
 
 #include <utils/gbench_auxilary.hpp>
@@ -15,7 +16,8 @@ namespace {
 
 class NoopLogger : public logging::impl::LoggerBase {
  public:
-  NoopLogger() noexcept : LoggerBase(logging::Format::kRaw) {
+  explicit NoopLogger(logging::Format format = logging::Format::kRaw) noexcept
+      : LoggerBase(format) {
     SetLevel(logging::Level::kInfo);
   }
   void Log(logging::Level, std::string_view) override {}
@@ -162,6 +164,22 @@ void LogPrependedTags(benchmark::State& state) {
 }
 BENCHMARK(LogPrependedTags);
 
+// Text with characters that need escaping in the text formats
+void LogFormat(benchmark::State& state) {
+  const logging::DefaultLoggerGuard guard{std::make_shared<NoopLogger>(
+      static_cast<logging::Format>(state.range(0)))};
+
+  const auto msg = Launder(std::string{"tab\tseparated\nmulti\nline text"});
+  for ([[maybe_unused]] auto _ : state) {
+    LOG_INFO() << msg << logging::LogExtra{{"uri", "/v1/handler?a=b"},
+                                           {"status", 200}};
+  }
+}
+BENCHMARK(LogFormat)
+    ->Arg(static_cast<int>(logging::Format::kTskv))
+    ->Arg(static_cast<int>(logging::Format::kLtsv))
+    ->Arg(static_cast<int>(logging::Format::kBinary));
+
 }  // namespace
 
 USERVER_NAMESPACE_END
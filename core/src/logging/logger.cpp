@@ -1,11 +1,13 @@
 #include <userver/logging/logger.hpp>
 
+#include <chrono>
 #include <memory>
 
 #include <logging/impl/buffered_file_sink.hpp>
 #include <logging/impl/fd_sink.hpp>
 #include <logging/impl/unix_socket_sink.hpp>
 #include <logging/tp_logger.hpp>
+#include <userver/logging/impl/binary_log.hpp>
 
 #include "config.hpp"
 
@@ -56,6 +58,15 @@ LoggerPtr MakeFileLogger(const std::string& name, const std::string& path,
 namespace impl {
 
 void LogRaw(LoggerBase& logger, Level level, std::string_view message) {
+  if (logger.GetFormat() == Format::kBinary) {
+    // The binary records are length-prefixed, a raw text line would break
+    // the decoding of the following records
+    binary::RecordBuilder record{level, std::chrono::system_clock::now()};
+    record.AddTag("text", message);
+    logger.Log(level, std::move(record).Extract());
+    return;
+  }
+
   std::string message_with_newline;
   message_with_newline.reserve(message.size() + 1);
   message_with_newline.append(message);
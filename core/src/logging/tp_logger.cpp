@@ -14,12 +14,23 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+// Log records are written to the sinks in batches of up to this size
+constexpr std::size_t kMaxBatchSize = 64;
+
+// Limits the memory kept by the reused log nodes
+constexpr std::size_t kMaxPooledNodes = 1024;
+constexpr std::size_t kMaxPooledPayloadCapacity = 2048;
+
+}  // namespace
+
 struct TpLogger::ActionVisitor final {
   TpLogger& logger;
 
-  void operator()(impl::async::Log&& log) const {
-    logger.AccountLogConsumed();
-    logger.BackendLog(std::move(log));
+  void operator()(impl::async::Log&&) const noexcept {
+    // Log records are written in batches by BackendLogBatch.
+    UASSERT_MSG(false, "Log actions must not be performed one by one");
   }
 
   void operator()(impl::async::Stop&&) const noexcept {
@@ -47,6 +58,8 @@ struct TpLogger::ActionVisitor final {
 TpLogger::TpLogger(Format format, std::string logger_name)
     : LoggerBase(format), logger_name_(std::move(logger_name)) {
   SetLevel(logging::Level::kInfo);
+  batch_.reserve(kMaxBatchSize);
+  batch_messages_.reserve(kMaxBatchSize);
 }
 
 void TpLogger::StartConsumerTask(engine::TaskProcessor& task_processor,
@@ -85,6 +98,10 @@ TpLogger::~TpLogger() {
   UASSERT_MSG(!consuming_task_.IsValid(),
               "We may be in non coroutine context, async logger must be in "
               "sync mode and consuming task must be stopped");
+  UASSERT(batch_.empty());
+
+  free_nodes_.DisposeUnsafe(
+      [](impl::async::ActionNode& node) noexcept { delete &node; });
 }
 
 void TpLogger::StopConsumerTask() {
@@ -138,13 +155,20 @@ void TpLogger::Log(Level level, std::string_view msg) {
     // in queue_ will not typically go over max_size + n_threads.
     produced_->fetch_add(1);
 
+    impl::async::ActionNode* node = nullptr;
     try {
-      Push(impl::async::Log{level, std::string{msg}});
+      node = &AcquireLogNode();
+      auto& log = std::get<impl::async::Log>(node->action);
+      log.level = level;
+      log.payload.assign(msg);
+      log.time = std::chrono::system_clock::now();
     } catch (const std::exception&) {
-      // failed to construct a Log action or a node in Push
+      // failed to allocate a node or the payload
+      if (node) ReleaseLogNode(*node);
       produced_->fetch_sub(1);
       throw;
     }
+    DoPush(*node);
   } else {
     ++stats_.dropped;
   }
@@ -252,6 +276,34 @@ void TpLogger::Push(impl::async::Action&& action) {
   DoPush(*node.release());
 }
 
+impl::async::ActionNode& TpLogger::AcquireLogNode() {
+  auto* node = free_nodes_.TryPop();
+  if (!node) {
+    node = new impl::async::ActionNode{};
+    node->action.emplace<impl::async::Log>();
+  }
+  return *node;
+}
+
+void TpLogger::ReleaseLogNode(impl::async::ActionNode& node) noexcept {
+  auto& payload = std::get<impl::async::Log>(node.action).payload;
+  if (payload.capacity() > kMaxPooledPayloadCapacity) {
+    payload = std::string{};
+  } else {
+    payload.clear();
+  }
+
+  if (!node.is_pooled) {
+    if (pooled_nodes_.load(std::memory_order_relaxed) >= kMaxPooledNodes) {
+      delete &node;
+      return;
+    }
+    pooled_nodes_.fetch_add(1, std::memory_order_relaxed);
+    node.is_pooled = true;
+  }
+  free_nodes_.Push(node);
+}
+
 void TpLogger::DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept {
   auto consumer = queue_.PushAndTryStartConsuming(node);
   if (consumer.IsValid()) {
@@ -259,8 +311,8 @@ void TpLogger::DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept {
   }
 }
 
-void TpLogger::AccountLogConsumed() noexcept {
-  consumed_->store(consumed_->load(std::memory_order_relaxed) + 1,
+void TpLogger::AccountLogsConsumed(QueueSize count) noexcept {
+  consumed_->store(consumed_->load(std::memory_order_relaxed) + count,
                    std::memory_order_relaxed);
   if (overflow_policy_.load() == QueueOverflowBehavior::kBlock) {
     {
@@ -281,6 +333,15 @@ void TpLogger::ConsumeNode(
   auto& action_node = static_cast<impl::async::ActionNode&>(node);
   if (&action_node == &stop_node_) return;
 
+  if (std::holds_alternative<impl::async::Log>(action_node.action)) {
+    // Does not allocate, the capacity is reserved in the constructor
+    batch_.push_back(&action_node);
+    if (batch_.size() == kMaxBatchSize) BackendLogBatch();
+    return;
+  }
+
+  // Keep the order of log records relative to flushes and reopens
+  BackendLogBatch();
   BackendPerform(std::move(action_node.action));
   delete &action_node;
 }
@@ -289,30 +350,44 @@ void TpLogger::ConsumeQueueOnce(Queue::Consumer& consumer) noexcept {
   while (auto* const node_base = consumer.TryPop()) {
     ConsumeNode(*node_base);
   }
+  BackendLogBatch();
 }
 
 void TpLogger::CleanUpQueue(Queue::Consumer&& consumer) noexcept {
-  std::move(consumer).ConsumeAndStop(
-      [this](auto& node) noexcept { ConsumeNode(node); });
+  // Not Consumer::ConsumeAndStop, as the batch must be written before
+  // another producer may become the consumer.
+  do {
+    ConsumeQueueOnce(consumer);
+  } while (!consumer.TryStopConsuming());
 }
 
-void TpLogger::BackendLog(impl::async::Log&& action) const {
-  LogMessage message;
-  message.payload = action.payload;
-  message.level = action.level;
+void TpLogger::BackendLogBatch() noexcept {
+  if (batch_.empty()) return;
+
+  bool should_flush = false;
+  for (auto* const node : batch_) {
+    const auto& log = std::get<impl::async::Log>(node->action);
+    batch_messages_.push_back({log.payload, log.level});
+    should_flush = should_flush || ShouldFlush(log.level);
+  }
 
   for (const auto& sink : GetSinks()) {
     try {
-      sink->Log(message);
+      sink->LogBatch(batch_messages_);
     } catch (const std::exception& e) {
       UASSERT_MSG(false, "While writing a log message caught an exception: " +
                              std::string(e.what()));
     }
   }
 
-  if (ShouldFlush(message.level)) {
+  if (should_flush) {
     BackendFlush();
   }
+
+  AccountLogsConsumed(static_cast<QueueSize>(batch_.size()));
+  for (auto* const node : batch_) ReleaseLogNode(*node);
+  batch_.clear();
+  batch_messages_.clear();
 }
 
 void TpLogger::BackendFlush() const {
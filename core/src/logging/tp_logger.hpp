@@ -18,6 +18,7 @@
 
 #include <concurrent/impl/interference_shield.hpp>
 #include <concurrent/impl/intrusive_hooks.hpp>
+#include <concurrent/impl/intrusive_stack.hpp>
 #include <engine/impl/async_flat_combining_queue.hpp>
 #include <logging/config.hpp>
 #include <logging/impl/base_sink.hpp>
@@ -57,6 +58,10 @@ using Action = std::variant<Stop, Log, FlushCoro, FlushThreaded, ReopenCoro>;
 
 struct ActionNode final : public concurrent::impl::SinglyLinkedBaseHook {
   Action action{Stop{}};
+
+  // Log nodes are reused to avoid allocations, see TpLogger::AcquireLogNode
+  concurrent::impl::SinglyLinkedHook<ActionNode> free_list_hook;
+  bool is_pooled{false};
 };
 
 }  // namespace async
@@ -99,18 +104,23 @@ class TpLogger final : public LoggerBase {
 
   using Queue = engine::impl::AsyncFlatCombiningQueue;
   using QueueSize = std::int64_t;
+  using NodePool = concurrent::impl::IntrusiveStack<
+      impl::async::ActionNode,
+      concurrent::impl::MemberHook<&impl::async::ActionNode::free_list_hook>>;
 
   void ProcessingLoop();
   bool HasFreeQueueCapacity() noexcept;
   bool TryWaitFreeQueueCapacity();
   void Push(impl::async::Action&& action);
+  impl::async::ActionNode& AcquireLogNode();
+  void ReleaseLogNode(impl::async::ActionNode& node) noexcept;
   void DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
   void ConsumeNode(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
   void ConsumeQueueOnce(Queue::Consumer& consumer) noexcept;
   void CleanUpQueue(Queue::Consumer&& consumer) noexcept;
-  void AccountLogConsumed() noexcept;
+  void AccountLogsConsumed(QueueSize count) noexcept;
   void BackendPerform(impl::async::Action&& action) noexcept;
-  void BackendLog(impl::async::Log&& action) const;
+  void BackendLogBatch() noexcept;
   void BackendFlush() const;
   void BackendReopen(ReopenMode reopen_mode) const;
 
@@ -133,6 +143,17 @@ class TpLogger final : public LoggerBase {
   Queue queue_;
   concurrent::impl::InterferenceShield<std::atomic<QueueSize>> produced_{0};
   concurrent::impl::InterferenceShield<std::atomic<QueueSize>> consumed_{0};
+
+  // Nodes of the consumed log records, reused by the producers. A node that
+  // got into the pool is never deleted until the logger is destroyed.
+  NodePool free_nodes_;
+  std::atomic<std::size_t> pooled_nodes_{0};
+
+  // Log records popped by the current consumer and not written yet. Written
+  // to the sinks at once, before any other action and before the consumer
+  // leaves the queue.
+  std::vector<impl::async::ActionNode*> batch_;
+  std::vector<LogMessage> batch_messages_;
 };
 
 }  // namespace logging::impl
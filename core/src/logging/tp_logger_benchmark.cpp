@@ -1,9 +1,15 @@
 #include <logging/tp_logger.hpp>
 
+#include <atomic>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 
+#include <logging/impl/fd_sink.hpp>
 #include <logging/impl/null_sink.hpp>
+#include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/logger.hpp>
 #include <userver/tracing/span.hpp>
@@ -26,14 +32,17 @@ class TpLoggerBenchmark : public benchmark::Fixture {
  protected:
   void SetUp(const benchmark::State&) override {
     tp_logger_ =
-        MakeLoggerFromSink("test", std::make_unique<logging::impl::NullSink>(),
-                           logging::Format::kTskv);
+        MakeLoggerFromSink("test", MakeSink(), logging::Format::kTskv);
     tp_logger_->SetLevel(logging::Level::kInfo);
     guard_.emplace(tp_logger_);
   }
 
   void TearDown(const benchmark::State&) override { guard_.reset(); }
 
+  virtual logging::impl::SinkPtr MakeSink() {
+    return std::make_unique<logging::impl::NullSink>();
+  }
+
   auto StartAsyncLoggerScope() {
     tp_logger_->StartConsumerTask(engine::current_task::GetTaskProcessor(),
                                   1 << 30,
@@ -47,6 +56,16 @@ class TpLoggerBenchmark : public benchmark::Fixture {
   std::optional<logging::DefaultLoggerGuard> guard_;
 };
 
+// Measures the real write syscalls, that are batched by the consumer
+class TpLoggerFdSinkBenchmark : public TpLoggerBenchmark {
+ protected:
+  logging::impl::SinkPtr MakeSink() override {
+    return std::make_unique<logging::impl::FdSink>(
+        fs::blocking::FileDescriptor::Open("/dev/null",
+                                           fs::blocking::OpenFlag::kWrite));
+  }
+};
+
 }  // namespace
 
 BENCHMARK_DEFINE_F(TpLoggerBenchmark, LogString)(benchmark::State& state) {
@@ -65,6 +84,47 @@ BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogString)
     ->Range(8, 8 << 10)
     ->Complexity();
 
+BENCHMARK_DEFINE_F(TpLoggerFdSinkBenchmark, LogString)
+(benchmark::State& state) {
+  engine::RunStandalone(2, [&] {
+    auto scope = StartAsyncLoggerScope();
+    const auto msg = Launder(std::string(state.range(0), '*'));
+    for ([[maybe_unused]] auto _ : state) {
+      LOG_INFO() << msg;
+    }
+  });
+}
+BENCHMARK_REGISTER_F(TpLoggerFdSinkBenchmark, LogString)
+    ->RangeMultiplier(8)
+    ->Range(8, 8 << 10);
+
+// Several producers, the consumer gets larger batches
+BENCHMARK_DEFINE_F(TpLoggerFdSinkBenchmark, LogStringMultiThread)
+(benchmark::State& state) {
+  engine::RunStandalone(4, [&] {
+    auto scope = StartAsyncLoggerScope();
+    const auto msg = Launder(std::string(100, '*'));
+
+    std::atomic<bool> keep_logging{true};
+    std::vector<engine::TaskWithResult<void>> producers;
+    for (int i = 0; i < state.range(0); ++i) {
+      producers.push_back(engine::AsyncNoSpan([&] {
+        while (keep_logging) LOG_INFO() << msg;
+      }));
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+      LOG_INFO() << msg;
+    }
+
+    keep_logging = false;
+    for (auto& producer : producers) producer.Get();
+  });
+}
+BENCHMARK_REGISTER_F(TpLoggerFdSinkBenchmark, LogStringMultiThread)
+    ->Arg(0)
+    ->Arg(2);
+
 namespace {
 
 __attribute__((noinline)) void LogDebug() { LOG_DEBUG() << 42; }
@@ -9,6 +9,7 @@
 #include <boost/range/algorithm/find_if.hpp>
 
 #include <logging/impl/buffered_file_sink.hpp>
+#include <logging/impl/gzip_file_sink.hpp>
 #include <logging/impl/tcp_socket_sink.hpp>
 #include <logging/impl/unix_socket_sink.hpp>
 #include <userver/logging/format.hpp>
@@ -38,17 +39,28 @@ void CreateLogDirectory(const std::string& logger_name,
   }
 }
 
-SinkPtr GetSinkFromFilename(const std::string& file_path) {
+SinkPtr GetSinkFromFilename(const LoggerConfig& config) {
+  const auto& file_path = config.file_path;
   if (utils::text::StartsWith(file_path, kUnixSocketPrefix)) {
     // Use Unix-socket sink
     return std::make_unique<UnixSocketSink>(
         file_path.substr(kUnixSocketPrefix.size()));
+  } else if (config.compression == FileCompression::kGzip) {
+    return std::make_unique<GzipFileSink>(file_path);
   } else {
     return std::make_unique<BufferedFileSink>(file_path);
   }
 }
 
 SinkPtr MakeOptionalSink(const LoggerConfig& config) {
+  if (config.compression != FileCompression::kNone &&
+      (utils::text::StartsWith(config.file_path, "@") ||
+       utils::text::StartsWith(config.file_path, kUnixSocketPrefix))) {
+    throw std::runtime_error("Logger '" + config.logger_name +
+                             "': compression is only supported for files, "
+                             "not for '" + config.file_path + "'");
+  }
+
   if (config.file_path == "@null") {
     return nullptr;
   } else if (config.file_path == "@stderr") {
@@ -57,7 +69,7 @@ SinkPtr MakeOptionalSink(const LoggerConfig& config) {
     return std::make_unique<logging::impl::BufferedUnownedFileSink>(stdout);
   } else {
     CreateLogDirectory(config.logger_name, config.file_path);
-    return GetSinkFromFilename(config.file_path);
+    return GetSinkFromFilename(config);
   }
 }
 
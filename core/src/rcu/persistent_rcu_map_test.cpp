@@ -0,0 +1,182 @@
+#include <userver/rcu/persistent_rcu_map.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(PersistentRcuMap, Empty) {
+  rcu::PersistentRcuMap<std::string, int> map;
+  const auto& cmap = map;
+
+  EXPECT_EQ(0, map.SizeApprox());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(cmap.begin(), cmap.end());
+  auto snap = map.GetSnapshot();
+  map.Clear();
+  EXPECT_EQ(snap, map.GetSnapshot());
+}
+
+UTEST(PersistentRcuMap, Modify) {
+  rcu::PersistentRcuMap<std::string, int> map;
+  const auto& cmap = map;
+
+  UEXPECT_THROW(cmap["any"], rcu::MissingKeyException);
+  EXPECT_FALSE(map.Get("any"));
+  EXPECT_FALSE(cmap.Get("any"));
+  EXPECT_FALSE(map.Erase("any"));
+  EXPECT_FALSE(map.Pop("any"));
+
+  UEXPECT_NO_THROW(*map["any"] = 1);
+  EXPECT_EQ(1, *cmap["any"]);
+  EXPECT_EQ(1, *map.Get("any"));
+  EXPECT_EQ(1, *cmap.Get("any"));
+  EXPECT_TRUE(map.Erase("any"));
+  EXPECT_FALSE(map.Erase("any"));
+  EXPECT_FALSE(map.Pop("any"));
+
+  EXPECT_TRUE(map.Insert("any", std::make_shared<int>(3)).inserted);
+  EXPECT_FALSE(map.Insert("any", std::make_shared<int>(0)).inserted);
+  EXPECT_EQ(*map.Insert("any", std::make_shared<int>(0)).value, 3);
+  EXPECT_EQ(*map.Pop("any"), 3);
+
+  EXPECT_TRUE(map.Emplace("any", 4).inserted);
+  EXPECT_FALSE(map.Emplace("any", 0).inserted);
+  EXPECT_EQ(*map.Emplace("any", 0).value, 4);
+  EXPECT_EQ(*map.Pop("any"), 4);
+
+  EXPECT_TRUE(map.TryEmplace("any", 5).inserted);
+  EXPECT_FALSE(map.TryEmplace("any", 0).inserted);
+  EXPECT_EQ(*map.TryEmplace("any", 0).value, 5);
+  EXPECT_EQ(*map.Pop("any"), 5);
+
+  map.InsertOrAssign("any", std::make_shared<int>(6));
+  map.InsertOrAssign("any", std::make_shared<int>(7));
+  EXPECT_EQ(*cmap["any"], 7);
+
+  using RawMap = rcu::PersistentRcuMap<std::string, int>::RawMap;
+  UEXPECT_NO_THROW(map.Assign(RawMap{{"other", std::make_shared<int>(8)}}));
+  EXPECT_FALSE(map.Get("any"));
+  EXPECT_EQ(*map.Pop("other"), 8);
+  EXPECT_EQ(0, map.SizeApprox());
+}
+
+UTEST(PersistentRcuMap, Snapshot) {
+  rcu::PersistentRcuMap<int, int> map;
+  for (int i = 0; i < 1000; ++i) map.Emplace(i, i);
+
+  auto it = map.begin();
+  for (int i = 0; i < 1000; i += 2) map.Erase(i);
+  const auto snapshot = map.GetSnapshot();
+
+  // The keyset of the iteration is fixed at its start
+  std::size_t count = 0;
+  for (; it != map.end(); ++it) ++count;
+  EXPECT_EQ(count, 1000);
+
+  EXPECT_EQ(snapshot.size(), 500);
+  for (const auto& [key, value] : snapshot) {
+    EXPECT_EQ(key % 2, 1);
+    EXPECT_EQ(key, *value);
+  }
+}
+
+UTEST(PersistentRcuMap, SamplePersistentRcuMap) {
+  /// [Sample rcu::PersistentRcuMap usage]
+  struct Data {
+    // Access to PersistentRcuMap content must be synchronized via std::atomic
+    // or other synchronization primitives
+    std::atomic<int> x{0};
+  };
+  rcu::PersistentRcuMap<std::string, Data> map;
+
+  // Does not copy the whole map
+  map["123"]->x++;
+  map["other_data"]->x += 2;
+  ASSERT_EQ(map["123"]->x.load(), 1);
+  ASSERT_EQ(map["other_data"]->x.load(), 2);
+
+  // O(1), `snapshot` is not affected by the following changes
+  auto txn = map.StartWrite();
+  const auto snapshot = *txn;
+  txn->erase("123");
+  txn.Commit();
+  ASSERT_FALSE(map.Get("123"));
+  ASSERT_TRUE(snapshot.contains("123"));
+  /// [Sample rcu::PersistentRcuMap usage]
+}
+
+UTEST_MT(PersistentRcuMap, ConcurrentUpdates, 4) {
+  rcu::PersistentRcuMap<int, std::atomic<std::uint32_t>> map;
+  std::array<engine::TaskWithResult<void>, 4> workers;
+  std::atomic<bool> stop_flag{false};
+
+  for (std::size_t i = 0; i < workers.size(); ++i) {
+    workers[i] = utils::Async("writer", [i, &map, &stop_flag] {
+      const auto base = static_cast<int>(i << 16);
+      while (!stop_flag) {
+        for (int v = 0; v < 1000; ++v) {
+          ASSERT_TRUE(map.Emplace(base + v, v).inserted);
+        }
+        for (int v = 0; v < 1000; ++v) {
+          ASSERT_EQ(map.Pop(base + v)->load(), static_cast<std::uint32_t>(v));
+        }
+      }
+    });
+  }
+
+  engine::SleepFor(std::chrono::milliseconds(100));
+  stop_flag = true;
+  for (auto& w : workers) w.Get();
+
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+UTEST_MT(PersistentRcuMap, ConcurrentTryEmplace, 16) {
+  const std::size_t kReps = 100;
+
+  for (std::size_t rep = 0; rep < kReps; rep++) {
+    rcu::PersistentRcuMap<std::string, int> map;
+
+    const std::size_t kTasks = 16;
+    std::atomic<std::size_t> insertions = 0;
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (std::size_t i = 0; i < kTasks; i++) {
+      tasks.push_back(engine::AsyncNoSpan([&map, &insertions, i] {
+        auto key = std::string(20 + i / 2, 'x');
+        auto res = map.TryEmplace(key, i);
+        if (res.inserted) ++insertions;
+        EXPECT_EQ(*res.value / 2, i / 2);
+      }));
+    }
+    for (auto& task : tasks) {
+      task.Get();
+    }
+    EXPECT_EQ(insertions, kTasks / 2);
+  }
+}
+
+UTEST(PersistentRcuMap, MapOfConst) {
+  rcu::PersistentRcuMap<std::string, const int> map;
+  map.Emplace("foo", 10);
+  map.Emplace("bar", 20);
+  EXPECT_EQ(*map["foo"], 10);
+  EXPECT_EQ(*map["bar"], 20);
+
+  int value_sum = 0;
+  for (const auto& [key, value] : map) {
+    value_sum += *value;
+  }
+  EXPECT_EQ(value_sum, 30);
+}
+
+USERVER_NAMESPACE_END
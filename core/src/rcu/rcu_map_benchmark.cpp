@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/rcu/persistent_rcu_map.hpp>
+#include <userver/rcu/rcu_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+template <typename Map>
+void FillMap(Map& map, std::int64_t size) {
+  auto txn = map.StartWrite();
+  for (std::int64_t i = 0; i < size; ++i) {
+    txn->insert_or_assign(i, std::make_shared<std::int64_t>(i));
+  }
+  txn.Commit();
+}
+
+// Keys churn: each iteration inserts a new key and erases the oldest one
+template <typename Map>
+void KeysetChurn(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto size = state.range(0);
+    Map map;
+    FillMap(map, size);
+
+    std::int64_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      map.Emplace(size + i, i);
+      map.Erase(i);
+      ++i;
+    }
+  });
+}
+
+template <typename Map>
+void Get(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto size = state.range(0);
+    Map map;
+    FillMap(map, size);
+
+    std::int64_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(map.Get(i));
+      i = (i + 7) % size;
+    }
+  });
+}
+
+using RcuMap = rcu::RcuMap<std::int64_t, std::int64_t>;
+using PersistentRcuMap = rcu::PersistentRcuMap<std::int64_t, std::int64_t>;
+
+}  // namespace
+
+void rcu_map_keyset_churn(benchmark::State& state) {
+  KeysetChurn<RcuMap>(state);
+}
+BENCHMARK(rcu_map_keyset_churn)->RangeMultiplier(10)->Range(100, 100'000);
+
+void persistent_rcu_map_keyset_churn(benchmark::State& state) {
+  KeysetChurn<PersistentRcuMap>(state);
+}
+BENCHMARK(persistent_rcu_map_keyset_churn)
+    ->RangeMultiplier(10)
+    ->Range(100, 100'000);
+
+void rcu_map_get(benchmark::State& state) { Get<RcuMap>(state); }
+BENCHMARK(rcu_map_get)->RangeMultiplier(10)->Range(100, 100'000);
+
+void persistent_rcu_map_get(benchmark::State& state) {
+  Get<PersistentRcuMap>(state);
+}
+BENCHMARK(persistent_rcu_map_get)->RangeMultiplier(10)->Range(100, 100'000);
+
+USERVER_NAMESPACE_END
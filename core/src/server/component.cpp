@@ -36,15 +36,30 @@ Server::Server(const components::ComponentConfig& component_config,
       "http.handler.total", [this](utils::statistics::Writer& writer) {
         return server_->WriteTotalHandlerStatistics(writer);
       });
+
+  auto* secdist_component =
+      component_context.FindComponentOptional<components::Secdist>();
+  if (secdist_component &&
+      secdist_component->GetStorage().IsPeriodicUpdateEnabled()) {
+    // Rotated certificates are picked up along with the secdist, that holds
+    // the private key passphrases
+    secdist_subscriber_ = secdist_component->GetStorage().UpdateAndListen(
+        this, kName, &Server::OnSecdistUpdate);
+  }
 }
 
 Server::~Server() {
+  secdist_subscriber_.Unsubscribe();
   server_statistics_holder_.Unregister();
   handler_statistics_holder_.Unregister();
 }
 
 void Server::OnAllComponentsLoaded() { server_->Start(); }
 
+void Server::OnSecdistUpdate(const storages::secdist::SecdistConfig& secdist) {
+  server_->ReloadTls(secdist);
+}
+
 void Server::OnAllComponentsAreStopping() {
   /* components::Server has to stop all Listeners before unloading components
    * as handlers have no ability to call smth like RemoveHandler() from
@@ -134,6 +149,14 @@ properties:
                     private-key-passphrase-name:
                         type: string
                         description: passphrase name located in secdist
+                    session-tickets:
+                        type: boolean
+                        description: whether to issue TLS session tickets for stateless session resumption
+                        defaultDescription: true
+                    session-cache-size:
+                        type: integer
+                        description: max number of TLS sessions in the server side session cache, 0 disables the cache
+                        defaultDescription: 20480
             handler-defaults:
                 type: object
                 description: handler defaults options
@@ -188,9 +211,35 @@ properties:
                         type: integer
                         description: delay in microseconds of the start of abort check routine
                         defaultDescription: 20ms
+                    max_pipelined_requests:
+                        type: integer
+                        description: how many pipelined HTTP/1.1 requests from a single connection are processed concurrently, responses are still sent in order
+                        defaultDescription: 1
+                        minimum: 1
+                    http2:
+                        type: object
+                        description: HTTP/2 options
+                        additionalProperties: false
+                        properties:
+                            enabled:
+                                type: boolean
+                                description: whether to serve HTTP/2 with prior knowledge on plain connections and via ALPN on TLS connections
+                                defaultDescription: false
+                            max_concurrent_streams:
+                                type: integer
+                                description: max count of concurrently processed streams of a single HTTP/2 connection
+                                defaultDescription: 100
+                                minimum: 1
+                            initial_window_size:
+                                type: integer
+                                description: initial HTTP/2 flow control window size of a stream in bytes
+                                defaultDescription: 65535
+                                minimum: 0
+                                maximum: 2147483647
             shards:
                 type: integer
-                description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
+                description: how many sockets are bound to the same port with SO_REUSEPORT, each one with its own accept task; the kernel spreads incoming connections between them. Unix sockets always use a single one
+                defaultDescription: number of event threads
     listener-monitor:
         type: object
         description: describes the special monitoring socket, used for getting statistics and processing utility requests that should succeed even is the main socket is under heavy pressure
@@ -0,0 +1,493 @@
+#include "http2_session.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/server/request/request_base.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+constexpr std::string_view kMethodPseudoHeader = ":method";
+constexpr std::string_view kPathPseudoHeader = ":path";
+constexpr std::string_view kAuthorityPseudoHeader = ":authority";
+constexpr std::string_view kStatusPseudoHeader = ":status";
+
+bool IsBodyForbiddenForStatus(HttpStatus status) {
+  return status == HttpStatus::kNoContent ||
+         status == HttpStatus::kNotModified ||
+         (static_cast<int>(status) >= 100 && static_cast<int>(status) < 200);
+}
+
+std::string_view ToStringView(const std::uint8_t* data, std::size_t size) {
+  return {reinterpret_cast<const char*>(data), size};
+}
+
+nghttp2_nv MakeNv(std::string_view name, std::string_view value) {
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+  return nghttp2_nv{
+      reinterpret_cast<std::uint8_t*>(const_cast<char*>(name.data())),
+      reinterpret_cast<std::uint8_t*>(const_cast<char*>(value.data())),
+      name.size(), value.size(), NGHTTP2_NV_FLAG_NONE};
+  // NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+}
+
+// HTTP/2 field names must be lowercase, RFC 9113, section 8.2.1
+std::string ToLowerAscii(std::string_view name) {
+  std::string result{name};
+  for (auto& c : result) {
+    if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+  }
+  return result;
+}
+
+}  // namespace
+
+void Http2Session::SessionDeleter::operator()(
+    nghttp2_session* session) const noexcept {
+  nghttp2_session_del(session);
+}
+
+Http2Session::Http2Session(const HandlerInfoIndex& handler_info_index,
+                           const request::HttpRequestConfig& request_config,
+                           const net::Http2Config& http2_config,
+                           OnNewRequestCb&& on_new_request_cb,
+                           OnStreamClosedCb&& on_stream_closed_cb,
+                           OnBodyConsumedCb&& on_body_consumed_cb,
+                           net::ParserStats& parser_stats,
+                           net::Http2Stats& http2_stats,
+                           request::ResponseDataAccounter& data_accounter)
+    : handler_info_index_(handler_info_index),
+      request_constructor_config_{request_config},
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      on_stream_closed_cb_(std::move(on_stream_closed_cb)),
+      on_body_consumed_cb_(std::move(on_body_consumed_cb)),
+      parser_stats_(parser_stats),
+      http2_stats_(http2_stats),
+      data_accounter_(data_accounter) {
+  nghttp2_session_callbacks* callbacks = nullptr;
+  if (nghttp2_session_callbacks_new(&callbacks) != 0) {
+    throw std::bad_alloc();
+  }
+  nghttp2_session_callbacks_set_on_begin_headers_callback(callbacks,
+                                                          &OnBeginHeaders);
+  nghttp2_session_callbacks_set_on_header_callback(callbacks, &OnHeader);
+  nghttp2_session_callbacks_set_on_data_chunk_recv_callback(callbacks,
+                                                            &OnDataChunk);
+  nghttp2_session_callbacks_set_on_frame_recv_callback(callbacks,
+                                                       &OnFrameRecv);
+  nghttp2_session_callbacks_set_on_stream_close_callback(callbacks,
+                                                         &OnStreamClose);
+
+  nghttp2_session* session = nullptr;
+  const auto create_result =
+      nghttp2_session_server_new(&session, callbacks, this);
+  nghttp2_session_callbacks_del(callbacks);
+  if (create_result != 0) {
+    throw std::runtime_error(fmt::format("Failed to create HTTP/2 session: {}",
+                                         nghttp2_strerror(create_result)));
+  }
+  session_.reset(session);
+
+  const std::array settings{
+      nghttp2_settings_entry{NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS,
+                             http2_config.max_concurrent_streams},
+      nghttp2_settings_entry{NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE,
+                             http2_config.initial_window_size},
+  };
+  const auto settings_result = nghttp2_submit_settings(
+      session_.get(), NGHTTP2_FLAG_NONE, settings.data(), settings.size());
+  if (settings_result != 0) {
+    throw std::runtime_error(
+        fmt::format("Failed to submit HTTP/2 settings: {}",
+                    nghttp2_strerror(settings_result)));
+  }
+
+  http2_stats_.connections_created.Add(1);
+}
+
+Http2Session::~Http2Session() {
+  // nghttp2_session_del() does not call the stream close callbacks
+  for (const auto& [stream_id, stream] : streams_) {
+    if (stream.request_constructor) {
+      parser_stats_.parsing_request_count.Subtract(1);
+    }
+    http2_stats_.active_streams.Subtract(1);
+  }
+}
+
+bool Http2Session::Parse(const char* data, size_t size) {
+  const auto result = nghttp2_session_mem_recv(
+      session_.get(), reinterpret_cast<const std::uint8_t*>(data), size);
+  if (result < 0) {
+    LOG_WARNING() << "HTTP/2 session error: "
+                  << nghttp2_strerror(static_cast<int>(result));
+    return false;
+  }
+  UASSERT(static_cast<std::size_t>(result) == size);
+  return true;
+}
+
+void Http2Session::SubmitResponse(StreamId stream_id) {
+  auto* stream = FindStream(stream_id);
+  if (!stream || !stream->request) return;
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+  const auto& request = static_cast<const HttpRequestImpl&>(*stream->request);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+  auto& response = static_cast<HttpResponse&>(stream->request->GetResponse());
+
+  std::vector<std::pair<std::string, std::string>> fields;
+  const auto status = static_cast<int>(response.GetStatus());
+  fields.emplace_back(kStatusPseudoHeader, fmt::format("{}", status));
+  response.VisitHttp2Headers(
+      [&fields](std::string_view name, std::string_view value) {
+        fields.emplace_back(ToLowerAscii(name), value);
+      });
+
+  std::vector<nghttp2_nv> nva;
+  nva.reserve(fields.size());
+  for (const auto& [name, value] : fields) nva.push_back(MakeNv(name, value));
+
+  const bool is_body_allowed =
+      request.GetMethod() != HttpMethod::kHead &&
+      !IsBodyForbiddenForStatus(response.GetStatus());
+  // A streamed response with a body is e.g. a CustomHandlerException
+  stream->is_body_streamed =
+      response.IsBodyStreamed() && response.GetData().empty();
+  stream->has_body_provider =
+      is_body_allowed &&
+      (stream->is_body_streamed || !response.GetData().empty());
+  stream->is_response_sent = !stream->has_body_provider;
+
+  nghttp2_data_provider provider{};
+  provider.source.ptr = stream;
+  provider.read_callback = &ReadBody;
+
+  const auto result = nghttp2_submit_response(
+      session_.get(), stream_id, nva.data(), nva.size(),
+      stream->has_body_provider ? &provider : nullptr);
+  if (result != 0) {
+    LOG_ERROR() << "Failed to submit HTTP/2 response for stream " << stream_id
+                << ": " << nghttp2_strerror(result);
+    nghttp2_submit_rst_stream(session_.get(), NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_INTERNAL_ERROR);
+  }
+}
+
+void Http2Session::AppendBody(StreamId stream_id, std::string body_part) {
+  auto* stream = FindStream(stream_id);
+  if (!stream) return;
+
+  if (!stream->has_body_provider || !stream->is_body_streamed) {
+    // e.g. a response to a HEAD request, the body is dropped
+    on_body_consumed_cb_(stream_id);
+    return;
+  }
+
+  stream->body_parts.push_back(std::move(body_part));
+  ResumeBody(stream_id, *stream);
+}
+
+void Http2Session::FinishBody(StreamId stream_id) {
+  auto* stream = FindStream(stream_id);
+  if (!stream) return;
+
+  stream->is_body_finished = true;
+  ResumeBody(stream_id, *stream);
+}
+
+std::string_view Http2Session::GetOutput() {
+  const std::uint8_t* data = nullptr;
+  const auto size = nghttp2_session_mem_send(session_.get(), &data);
+  if (size < 0) {
+    throw std::runtime_error(
+        fmt::format("HTTP/2 session error: {}",
+                    nghttp2_strerror(static_cast<int>(size))));
+  }
+  return ToStringView(data, static_cast<std::size_t>(size));
+}
+
+bool Http2Session::IsActive() const {
+  return nghttp2_session_want_read(session_.get()) ||
+         nghttp2_session_want_write(session_.get());
+}
+
+int Http2Session::OnBeginHeaders(nghttp2_session*, const nghttp2_frame* frame,
+                                 void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+  if (frame->hd.type != NGHTTP2_HEADERS ||
+      frame->headers.cat != NGHTTP2_HCAT_REQUEST) {
+    return 0;
+  }
+
+  auto& stream = self->streams_[frame->hd.stream_id];
+  self->parser_stats_.parsing_request_count.Add(1);
+  self->http2_stats_.active_streams.Add(1);
+  stream.request_constructor.emplace(self->request_constructor_config_,
+                                     self->handler_info_index_,
+                                     self->data_accounter_);
+  return 0;
+}
+
+int Http2Session::OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                           const std::uint8_t* name, std::size_t name_size,
+                           const std::uint8_t* value, std::size_t value_size,
+                           std::uint8_t, void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+  auto* stream = self->FindStream(frame->hd.stream_id);
+  if (!stream || !stream->request_constructor || stream->is_malformed) {
+    return 0;
+  }
+
+  try {
+    self->OnHeaderImpl(*stream, ToStringView(name, name_size),
+                       ToStringView(value, value_size));
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append header: " << ex;
+    stream->is_malformed = true;
+  }
+  return 0;
+}
+
+int Http2Session::OnDataChunk(nghttp2_session*, std::uint8_t,
+                              StreamId stream_id, const std::uint8_t* data,
+                              std::size_t size, void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+  auto* stream = self->FindStream(stream_id);
+  if (!stream || !stream->request_constructor || stream->is_malformed) {
+    return 0;
+  }
+
+  try {
+    self->CheckUrlComplete(*stream);
+    stream->request_constructor->AppendBody(
+        reinterpret_cast<const char*>(data), size);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append body: " << ex;
+    stream->is_malformed = true;
+  }
+  return 0;
+}
+
+int Http2Session::OnFrameRecv(nghttp2_session*, const nghttp2_frame* frame,
+                              void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+  if (frame->hd.type != NGHTTP2_HEADERS && frame->hd.type != NGHTTP2_DATA) {
+    return 0;
+  }
+  if (!(frame->hd.flags & NGHTTP2_FLAG_END_STREAM)) return 0;
+
+  auto* stream = self->FindStream(frame->hd.stream_id);
+  if (!stream || !stream->request_constructor) return 0;
+
+  try {
+    self->OnEndOfRequest(frame->hd.stream_id, *stream);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to process HTTP/2 request: " << ex;
+    return NGHTTP2_ERR_CALLBACK_FAILURE;
+  }
+  return 0;
+}
+
+int Http2Session::OnStreamClose(nghttp2_session*, StreamId stream_id,
+                                std::uint32_t error_code, void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+  try {
+    self->OnStreamCloseImpl(stream_id, error_code);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to close HTTP/2 stream: " << ex;
+    return NGHTTP2_ERR_CALLBACK_FAILURE;
+  }
+  return 0;
+}
+
+ssize_t Http2Session::ReadBody(nghttp2_session*, StreamId stream_id,
+                               std::uint8_t* buf, std::size_t length,
+                               std::uint32_t* data_flags,
+                               nghttp2_data_source* source, void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+  auto* stream = static_cast<Stream*>(source->ptr);
+  UASSERT(stream != nullptr);
+  return self->ReadBodyImpl(stream_id, *stream, buf, length, data_flags);
+}
+
+void Http2Session::OnHeaderImpl(Stream& stream, std::string_view name,
+                                std::string_view value) {
+  if (!name.empty() && name[0] == ':') {
+    if (name == kMethodPseudoHeader) {
+      stream.method = value;
+    } else if (name == kPathPseudoHeader) {
+      stream.path = value;
+    } else if (name == kAuthorityPseudoHeader) {
+      stream.authority = value;
+    }
+    return;
+  }
+
+  // nghttp2 guarantees that pseudo-headers precede regular ones
+  CheckUrlComplete(stream);
+  if (name == USERVER_NAMESPACE::http::headers::kHost) stream.has_host = true;
+
+  auto& constructor = *stream.request_constructor;
+  constructor.AppendHeaderField(name.data(), name.size());
+  constructor.AppendHeaderValue(value.data(), value.size());
+}
+
+void Http2Session::OnEndOfRequest(StreamId stream_id, Stream& stream) {
+  auto& constructor = *stream.request_constructor;
+  if (!stream.is_malformed) {
+    try {
+      CheckUrlComplete(stream);
+      // RFC 9113, section 8.3.1: :authority is used instead of Host
+      if (!stream.has_host && !stream.authority.empty()) {
+        const std::string_view host = USERVER_NAMESPACE::http::headers::kHost;
+        constructor.AppendHeaderField(host.data(), host.size());
+        constructor.AppendHeaderValue(stream.authority.data(),
+                                      stream.authority.size());
+      }
+      constructor.AppendHeaderField("", 0);
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't finalize headers: " << ex;
+    }
+  }
+
+  auto request = constructor.Finalize();
+  stream.request_constructor.reset();
+  parser_stats_.parsing_request_count.Subtract(1);
+
+  if (!request) {
+    LOG_ERROR() << "request is null after Finalize()";
+    nghttp2_submit_rst_stream(session_.get(), NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_INTERNAL_ERROR);
+    return;
+  }
+
+  stream.request = request;
+  on_new_request_cb_(stream_id, std::move(request));
+}
+
+void Http2Session::OnStreamCloseImpl(StreamId stream_id,
+                                     std::uint32_t error_code) {
+  const auto it = streams_.find(stream_id);
+  if (it == streams_.end()) return;
+
+  auto& stream = it->second;
+  if (stream.request_constructor) {
+    parser_stats_.parsing_request_count.Subtract(1);
+  }
+  http2_stats_.active_streams.Subtract(1);
+  if (error_code != NGHTTP2_NO_ERROR) http2_stats_.streams_reset.Add(1);
+
+  const bool has_request = static_cast<bool>(stream.request);
+  if (has_request && stream.is_response_sent &&
+      error_code == NGHTTP2_NO_ERROR) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+    static_cast<HttpResponse&>(stream.request->GetResponse())
+        .SetHttp2Sent(stream.bytes_sent);
+  }
+  streams_.erase(it);
+
+  if (has_request) {
+    http2_stats_.streams_processed.Add(1);
+    on_stream_closed_cb_(stream_id);
+  }
+}
+
+ssize_t Http2Session::ReadBodyImpl(StreamId stream_id, Stream& stream,
+                                   std::uint8_t* buf, std::size_t length,
+                                   std::uint32_t* data_flags) {
+  if (!stream.is_body_streamed) {
+    const auto& data = stream.request->GetResponse().GetData();
+    const auto size = std::min(length, data.size() - stream.body_offset);
+    std::memcpy(buf, data.data() + stream.body_offset, size);
+    stream.body_offset += size;
+    stream.bytes_sent += size;
+    if (stream.body_offset == data.size()) {
+      *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+      stream.is_response_sent = true;
+    }
+    return static_cast<ssize_t>(size);
+  }
+
+  std::size_t copied = 0;
+  while (copied < length && !stream.body_parts.empty()) {
+    const auto& part = stream.body_parts.front();
+    const auto size =
+        std::min(length - copied, part.size() - stream.body_offset);
+    std::memcpy(buf + copied, part.data() + stream.body_offset, size);
+    copied += size;
+    stream.body_offset += size;
+    if (stream.body_offset == part.size()) {
+      stream.body_parts.pop_front();
+      stream.body_offset = 0;
+    }
+  }
+  stream.bytes_sent += copied;
+
+  if (stream.body_parts.empty()) {
+    if (stream.is_body_finished) {
+      *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+      stream.is_response_sent = true;
+    } else if (copied == 0) {
+      stream.is_body_deferred = true;
+      return NGHTTP2_ERR_DEFERRED;
+    }
+    if (copied != 0) on_body_consumed_cb_(stream_id);
+  }
+  return static_cast<ssize_t>(copied);
+}
+
+void Http2Session::CheckUrlComplete(Stream& stream) {
+  if (stream.url_complete) return;
+  stream.url_complete = true;
+
+  auto& constructor = *stream.request_constructor;
+  auto method = HttpMethod::kUnknown;
+  try {
+    method = HttpMethodFromString(stream.method);
+  } catch (const std::exception&) {
+    // Same as for HTTP/1.x, handled by the request constructor
+  }
+  constructor.SetMethod(method);
+  constructor.SetHttpMajor(2);
+  constructor.SetHttpMinor(0);
+  constructor.AppendUrl(stream.path.data(), stream.path.size());
+  constructor.ParseUrl();
+}
+
+void Http2Session::ResumeBody(StreamId stream_id, Stream& stream) {
+  if (!stream.is_body_deferred) return;
+  stream.is_body_deferred = false;
+  nghttp2_session_resume_data(session_.get(), stream_id);
+}
+
+Http2Session::Stream* Http2Session::FindStream(StreamId stream_id) {
+  const auto it = streams_.find(stream_id);
+  if (it == streams_.end()) return nullptr;
+  return &it->second;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <nghttp2/nghttp2.h>
+
+#include <server/net/connection_config.hpp>
+#include <server/net/stats.hpp>
+#include <server/request/request_parser.hpp>
+
+#include <userver/server/request/request_config.hpp>
+
+#include "http_request_constructor.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// HTTP/2 server side of a connection (RFC 9113) on top of nghttp2.
+///
+/// Performs no I/O: received bytes are fed via Parse(), bytes to be sent are
+/// taken via GetOutput(). A request is reported as soon as the client
+/// half-closes its stream; responses are submitted by stream id in any order.
+class Http2Session final : public request::RequestParser {
+ public:
+  using StreamId = std::int32_t;
+  using OnNewRequestCb =
+      std::function<void(StreamId, std::shared_ptr<request::RequestBase>&&)>;
+  // Called when nghttp2 closes a stream with a reported request, either after
+  // the response was sent or because of a reset.
+  using OnStreamClosedCb = std::function<void(StreamId)>;
+  // Called when all the submitted parts of a streamed body were consumed.
+  using OnBodyConsumedCb = std::function<void(StreamId)>;
+
+  Http2Session(const HandlerInfoIndex& handler_info_index,
+               const request::HttpRequestConfig& request_config,
+               const net::Http2Config& http2_config,
+               OnNewRequestCb&& on_new_request_cb,
+               OnStreamClosedCb&& on_stream_closed_cb,
+               OnBodyConsumedCb&& on_body_consumed_cb,
+               net::ParserStats& parser_stats, net::Http2Stats& http2_stats,
+               request::ResponseDataAccounter& data_accounter);
+  ~Http2Session() override;
+
+  Http2Session(Http2Session&&) = delete;
+  Http2Session& operator=(Http2Session&&) = delete;
+
+  /// Returns false on a connection error, the session should be closed
+  /// after sending the remaining output.
+  bool Parse(const char* data, size_t size) override;
+
+  /// Submits the headers of a ready response and its body, if it is not
+  /// streamed.
+  void SubmitResponse(StreamId stream_id);
+
+  /// Appends a part of a streamed response body.
+  void AppendBody(StreamId stream_id, std::string body_part);
+
+  /// Marks the end of a streamed response body.
+  void FinishBody(StreamId stream_id);
+
+  /// Returns the next bytes to send or an empty string_view if there is
+  /// nothing to send. The data is valid until the next call to the session.
+  std::string_view GetOutput();
+
+  /// Returns false if both sides are done with the connection.
+  bool IsActive() const;
+
+ private:
+  struct Stream {
+    std::optional<HttpRequestConstructor> request_constructor;
+    std::string method;
+    std::string path;
+    std::string authority;
+    bool has_host{false};
+    bool url_complete{false};
+    bool is_malformed{false};
+
+    std::shared_ptr<request::RequestBase> request;
+    bool has_body_provider{false};
+    bool is_body_streamed{false};
+    bool is_body_finished{false};
+    bool is_body_deferred{false};
+    std::deque<std::string> body_parts;
+    std::size_t body_offset{0};
+    std::size_t bytes_sent{0};
+    bool is_response_sent{false};
+  };
+
+  struct SessionDeleter {
+    void operator()(nghttp2_session* session) const noexcept;
+  };
+
+  static int OnBeginHeaders(nghttp2_session* session,
+                            const nghttp2_frame* frame, void* user_data);
+  static int OnHeader(nghttp2_session* session, const nghttp2_frame* frame,
+                      const std::uint8_t* name, std::size_t name_size,
+                      const std::uint8_t* value, std::size_t value_size,
+                      std::uint8_t flags, void* user_data);
+  static int OnDataChunk(nghttp2_session* session, std::uint8_t flags,
+                         StreamId stream_id, const std::uint8_t* data,
+                         std::size_t size, void* user_data);
+  static int OnFrameRecv(nghttp2_session* session, const nghttp2_frame* frame,
+                         void* user_data);
+  static int OnStreamClose(nghttp2_session* session, StreamId stream_id,
+                           std::uint32_t error_code, void* user_data);
+  static ssize_t ReadBody(nghttp2_session* session, StreamId stream_id,
+                          std::uint8_t* buf, std::size_t length,
+                          std::uint32_t* data_flags,
+                          nghttp2_data_source* source, void* user_data);
+
+  void OnHeaderImpl(Stream& stream, std::string_view name,
+                    std::string_view value);
+  void OnEndOfRequest(StreamId stream_id, Stream& stream);
+  void OnStreamCloseImpl(StreamId stream_id, std::uint32_t error_code);
+  ssize_t ReadBodyImpl(StreamId stream_id, Stream& stream, std::uint8_t* buf,
+                       std::size_t length, std::uint32_t* data_flags);
+
+  void CheckUrlComplete(Stream& stream);
+  void ResumeBody(StreamId stream_id, Stream& stream);
+  Stream* FindStream(StreamId stream_id);
+
+  const HandlerInfoIndex& handler_info_index_;
+  const HttpRequestConstructor::Config request_constructor_config_;
+
+  OnNewRequestCb on_new_request_cb_;
+  OnStreamClosedCb on_stream_closed_cb_;
+  OnBodyConsumedCb on_body_consumed_cb_;
+
+  net::ParserStats& parser_stats_;
+  net::Http2Stats& http2_stats_;
+  request::ResponseDataAccounter& data_accounter_;
+
+  std::unordered_map<StreamId, Stream> streams_;
+  std::unique_ptr<nghttp2_session, SessionDeleter> session_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
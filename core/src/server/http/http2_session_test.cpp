@@ -0,0 +1,270 @@
+#include <server/http/http2_session.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+#include <userver/server/http/http_response.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using StreamId = server::http::Http2Session::StreamId;
+using RequestPtr = std::shared_ptr<server::request::RequestBase>;
+
+constexpr server::request::HttpRequestConfig kTestRequestConfig{
+    /*.max_url_size = */ 8192,
+    /*.max_request_size = */ 1024 * 1024,
+    /*.max_headers_size = */ 65536,
+    /*.parse_args_from_body = */ false,
+    /*.testing_mode = */ true,  // non default value
+    /*.decompress_request = */ false,
+};
+
+// Minimal in-memory HTTP/2 client on top of nghttp2
+class TestClient final {
+ public:
+  struct Response {
+    std::map<std::string, std::string> headers;
+    std::string body;
+    bool is_closed{false};
+  };
+
+  TestClient() {
+    nghttp2_session_callbacks* callbacks = nullptr;
+    nghttp2_session_callbacks_new(&callbacks);
+    nghttp2_session_callbacks_set_on_header_callback(
+        callbacks, [](nghttp2_session*, const nghttp2_frame* frame,
+                      const std::uint8_t* name, std::size_t name_size,
+                      const std::uint8_t* value, std::size_t value_size,
+                      std::uint8_t, void* user_data) {
+          auto& self = *static_cast<TestClient*>(user_data);
+          self.responses_[frame->hd.stream_id].headers.emplace(
+              std::string(reinterpret_cast<const char*>(name), name_size),
+              std::string(reinterpret_cast<const char*>(value), value_size));
+          return 0;
+        });
+    nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
+        callbacks, [](nghttp2_session*, std::uint8_t, StreamId stream_id,
+                      const std::uint8_t* data, std::size_t size,
+                      void* user_data) {
+          auto& self = *static_cast<TestClient*>(user_data);
+          self.responses_[stream_id].body.append(
+              reinterpret_cast<const char*>(data), size);
+          return 0;
+        });
+    nghttp2_session_callbacks_set_on_stream_close_callback(
+        callbacks,
+        [](nghttp2_session*, StreamId stream_id, std::uint32_t,
+           void* user_data) {
+          auto& self = *static_cast<TestClient*>(user_data);
+          self.responses_[stream_id].is_closed = true;
+          return 0;
+        });
+    nghttp2_session_client_new(&session_, callbacks, this);
+    nghttp2_session_callbacks_del(callbacks);
+    nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, nullptr, 0);
+  }
+
+  ~TestClient() { nghttp2_session_del(session_); }
+
+  StreamId SubmitRequest(std::string_view method, std::string_view path,
+                         std::string body = {}) {
+    body_ = std::move(body);
+    body_offset_ = 0;
+
+    const std::vector<std::pair<std::string_view, std::string_view>> headers{
+        {":method", method},
+        {":scheme", "http"},
+        {":authority", "localhost:8080"},
+        {":path", path},
+        {"x-test-header", "test-value"},
+    };
+    std::vector<nghttp2_nv> nva;
+    for (const auto& [name, value] : headers) {
+      nva.push_back(nghttp2_nv{
+          reinterpret_cast<std::uint8_t*>(const_cast<char*>(name.data())),
+          reinterpret_cast<std::uint8_t*>(const_cast<char*>(value.data())),
+          name.size(), value.size(), NGHTTP2_NV_FLAG_NONE});
+    }
+
+    nghttp2_data_provider provider{};
+    provider.source.ptr = this;
+    provider.read_callback = [](nghttp2_session*, StreamId, std::uint8_t* buf,
+                                std::size_t length, std::uint32_t* data_flags,
+                                nghttp2_data_source* source,
+                                void*) -> ssize_t {
+      auto& self = *static_cast<TestClient*>(source->ptr);
+      const auto size =
+          std::min(length, self.body_.size() - self.body_offset_);
+      std::copy_n(self.body_.data() + self.body_offset_, size, buf);
+      self.body_offset_ += size;
+      if (self.body_offset_ == self.body_.size()) {
+        *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+      }
+      return static_cast<ssize_t>(size);
+    };
+
+    return nghttp2_submit_request(session_, nullptr, nva.data(), nva.size(),
+                                  body_.empty() ? nullptr : &provider,
+                                  nullptr);
+  }
+
+  // Exchanges data with the server until both sides have nothing to send
+  void Exchange(server::http::Http2Session& server) {
+    bool has_data = true;
+    while (has_data) {
+      has_data = false;
+
+      const std::uint8_t* data = nullptr;
+      for (auto size = nghttp2_session_mem_send(session_, &data); size > 0;
+           size = nghttp2_session_mem_send(session_, &data)) {
+        has_data = true;
+        ASSERT_TRUE(server.Parse(reinterpret_cast<const char*>(data), size));
+      }
+
+      for (auto output = server.GetOutput(); !output.empty();
+           output = server.GetOutput()) {
+        has_data = true;
+        ASSERT_EQ(nghttp2_session_mem_recv(
+                      session_,
+                      reinterpret_cast<const std::uint8_t*>(output.data()),
+                      output.size()),
+                  static_cast<ssize_t>(output.size()));
+      }
+    }
+  }
+
+  const Response& GetResponse(StreamId stream_id) {
+    return responses_[stream_id];
+  }
+
+ private:
+  nghttp2_session* session_{nullptr};
+  std::map<StreamId, Response> responses_;
+  std::string body_;
+  std::size_t body_offset_{0};
+};
+
+struct TestServer {
+  server::http::Http2Session& Create() {
+    session.emplace(
+        handler_info_index, kTestRequestConfig, http2_config,
+        [this](StreamId stream_id, RequestPtr&& request) {
+          requests.emplace(stream_id, std::move(request));
+        },
+        [this](StreamId stream_id) { closed_streams.push_back(stream_id); },
+        [](StreamId) {}, parser_stats, http2_stats, data_accounter);
+    return *session;
+  }
+
+  server::http::HttpRequestImpl& GetRequest(StreamId stream_id) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+    return static_cast<server::http::HttpRequestImpl&>(
+        *requests.at(stream_id));
+  }
+
+  server::http::HandlerInfoIndex handler_info_index;
+  server::net::Http2Config http2_config;
+  server::net::ParserStats parser_stats;
+  server::net::Http2Stats http2_stats;
+  server::request::ResponseDataAccounter data_accounter;
+
+  std::map<StreamId, RequestPtr> requests;
+  std::vector<StreamId> closed_streams;
+  std::optional<server::http::Http2Session> session;
+};
+
+}  // namespace
+
+UTEST(Http2Session, ParsesRequest) {
+  TestServer server;
+  auto& session = server.Create();
+  TestClient client;
+
+  const auto stream_id =
+      client.SubmitRequest("POST", "/foo/bar?arg=value", "request body");
+  client.Exchange(session);
+
+  ASSERT_EQ(server.requests.size(), 1);
+  const auto& request = server.GetRequest(stream_id);
+  EXPECT_EQ(request.GetMethod(), server::http::HttpMethod::kPost);
+  EXPECT_EQ(request.GetHttpMajor(), 2);
+  EXPECT_EQ(request.GetHttpMinor(), 0);
+  EXPECT_EQ(request.GetUrl(), "/foo/bar?arg=value");
+  EXPECT_EQ(request.GetRequestPath(), "/foo/bar");
+  EXPECT_EQ(request.GetArg("arg"), "value");
+  EXPECT_EQ(request.GetHeader("X-Test-Header"), "test-value");
+  EXPECT_EQ(request.GetHeader("Host"), "localhost:8080");
+  EXPECT_EQ(request.RequestBody(), "request body");
+  EXPECT_EQ(server.parser_stats.parsing_request_count.Read(), 0);
+}
+
+UTEST(Http2Session, MultiplexedResponses) {
+  TestServer server;
+  auto& session = server.Create();
+  TestClient client;
+
+  const auto first_stream = client.SubmitRequest("GET", "/first");
+  const auto second_stream = client.SubmitRequest("GET", "/second");
+  client.Exchange(session);
+  ASSERT_EQ(server.requests.size(), 2);
+
+  // Responses are sent in any order
+  for (const auto stream_id : {second_stream, first_stream}) {
+    auto& response = server.GetRequest(stream_id).GetHttpResponse();
+    response.SetStatus(server::http::HttpStatus::kCreated);
+    response.SetHeader(std::string_view{"X-Response-Header"}, "value");
+    response.SetData(server.GetRequest(stream_id).GetUrl());
+    session.SubmitResponse(stream_id);
+    client.Exchange(session);
+
+    const auto& client_response = client.GetResponse(stream_id);
+    EXPECT_TRUE(client_response.is_closed);
+    EXPECT_EQ(client_response.headers.at(":status"), "201");
+    EXPECT_EQ(client_response.headers.at("x-response-header"), "value");
+    EXPECT_EQ(client_response.headers.at("content-length"),
+              std::to_string(client_response.body.size()));
+    EXPECT_EQ(client_response.body, server.GetRequest(stream_id).GetUrl());
+    EXPECT_TRUE(response.IsSent());
+  }
+
+  EXPECT_EQ(server.closed_streams,
+            (std::vector<StreamId>{second_stream, first_stream}));
+  EXPECT_EQ(server.http2_stats.streams_processed.Read(), 2);
+  EXPECT_EQ(server.http2_stats.active_streams.Read(), 0);
+}
+
+UTEST(Http2Session, StreamedBody) {
+  TestServer server;
+  auto& session = server.Create();
+  TestClient client;
+
+  const auto stream_id = client.SubmitRequest("GET", "/stream");
+  client.Exchange(session);
+
+  auto& response = server.GetRequest(stream_id).GetHttpResponse();
+  response.SetStreamBody();
+  session.SubmitResponse(stream_id);
+  client.Exchange(session);
+  EXPECT_FALSE(client.GetResponse(stream_id).is_closed);
+  EXPECT_EQ(client.GetResponse(stream_id).headers.count("content-length"), 0);
+
+  session.AppendBody(stream_id, "first ");
+  client.Exchange(session);
+  session.AppendBody(stream_id, "second");
+  session.FinishBody(stream_id);
+  client.Exchange(session);
+
+  EXPECT_TRUE(client.GetResponse(stream_id).is_closed);
+  EXPECT_EQ(client.GetResponse(stream_id).body, "first second");
+}
+
+USERVER_NAMESPACE_END
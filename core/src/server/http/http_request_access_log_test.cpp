@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <sstream>
+
+#include <gmock/gmock.h>
+
+#include <logging/logging_test.hpp>
+#include <server/http/http_request_impl.hpp>
+#include <userver/logging/impl/binary_log.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// The same conversion as in tools/binary_log_decoder
+std::string DecodeLog(const StringStreamLogger& logger) {
+  logger.logger->Flush();
+  std::istringstream input{logger.stream.str()};
+  std::ostringstream output;
+  EXPECT_TRUE(logging::impl::binary::DecodeStreamToTskv(input, output));
+  return output.str();
+}
+
+}  // namespace
+
+UTEST(HttpRequestAccessLog, Binary) {
+  const auto access =
+      MakeNamedStreamLogger("access", logging::Format::kBinary);
+  const auto access_tskv =
+      MakeNamedStreamLogger("access-tskv", logging::Format::kBinary);
+
+  server::request::ResponseDataAccounter accounter;
+  const server::http::HttpRequestImpl request{accounter};
+  request.GetHttpResponse().SetStatus(server::http::HttpStatus::kNotFound);
+
+  request.WriteAccessLogs(access.logger, access_tskv.logger, "127.0.0.1");
+  request.WriteAccessLogs(access.logger, access_tskv.logger, "::1");
+
+  const auto access_records = DecodeLog(access);
+  EXPECT_EQ(std::count(access_records.begin(), access_records.end(), '\n'), 2)
+      << access_records;
+  EXPECT_THAT(access_records, testing::StartsWith("tskv\ttimestamp="));
+  EXPECT_THAT(access_records, testing::HasSubstr(" 127.0.0.1 "));
+  EXPECT_THAT(access_records, testing::HasSubstr(" 404 "));
+
+  const auto tskv_records = DecodeLog(access_tskv);
+  EXPECT_EQ(std::count(tskv_records.begin(), tskv_records.end(), '\n'), 2)
+      << tskv_records;
+  EXPECT_THAT(tskv_records, testing::HasSubstr("\tstatus=404\t"));
+  EXPECT_THAT(tskv_records, testing::HasSubstr("\tprotocol=HTTP/"));
+  EXPECT_THAT(tskv_records, testing::HasSubstr("\tremote_addr=127.0.0.1\t"));
+  EXPECT_THAT(tskv_records, testing::HasSubstr("\tremote_addr=::1\t"));
+  EXPECT_THAT(tskv_records, testing::HasSubstr("\trequest_body=\n"));
+}
+
+USERVER_NAMESPACE_END
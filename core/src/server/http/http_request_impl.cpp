@@ -5,6 +5,7 @@
 #include <userver/engine/task/task.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/http/parser/http_request_parse_args.hpp>
+#include <userver/logging/impl/binary_log.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/logger.hpp>
 #include <userver/utils/datetime.hpp>
@@ -349,20 +350,26 @@ void HttpRequestImpl::WriteAccessLog(
     const std::string& remote_address) const {
   if (!logger_access) return;
 
-  logger_access->Log(
-      logging::Level::kInfo,
-      fmt::format(
-          R"([{}] {} {} "{} {} HTTP/{}.{}" {} "{}" "{}" "{}" {:0.6f} - {} {:0.6f})",
-          utils::datetime::LocalTimezoneTimestring(tp,
-                                                   "%Y-%m-%d %H:%M:%E6S %Ez"),
-          EscapeForAccessLog(GetHost()), EscapeForAccessLog(remote_address),
-          EscapeForAccessLog(GetMethodStr()), EscapeForAccessLog(GetUrl()),
-          GetHttpMajor(), GetHttpMinor(),
-          static_cast<int>(response_.GetStatus()),
-          EscapeForAccessLog(GetHeader("Referer")),
-          EscapeForAccessLog(GetHeader("User-Agent")),
-          EscapeForAccessLog(GetHeader("Cookie")), GetRequestTime().count(),
-          GetResponse().BytesSent(), GetResponseTime().count()));
+  auto record = fmt::format(
+      R"([{}] {} {} "{} {} HTTP/{}.{}" {} "{}" "{}" "{}" {:0.6f} - {} {:0.6f})",
+      utils::datetime::LocalTimezoneTimestring(tp, "%Y-%m-%d %H:%M:%E6S %Ez"),
+      EscapeForAccessLog(GetHost()), EscapeForAccessLog(remote_address),
+      EscapeForAccessLog(GetMethodStr()), EscapeForAccessLog(GetUrl()),
+      GetHttpMajor(), GetHttpMinor(), static_cast<int>(response_.GetStatus()),
+      EscapeForAccessLog(GetHeader("Referer")),
+      EscapeForAccessLog(GetHeader("User-Agent")),
+      EscapeForAccessLog(GetHeader("Cookie")), GetRequestTime().count(),
+      GetResponse().BytesSent(), GetResponseTime().count());
+
+  if (logger_access->GetFormat() == logging::Format::kBinary) {
+    // The line is kept as is, the binary record only frames it
+    logging::impl::binary::RecordBuilder binary_record{logging::Level::kInfo,
+                                                       tp};
+    binary_record.AddTag("text", record);
+    record = std::move(binary_record).Extract();
+  }
+
+  logger_access->Log(logging::Level::kInfo, record);
 }
 
 void HttpRequestImpl::WriteAccessTskvLog(
@@ -371,6 +378,11 @@ void HttpRequestImpl::WriteAccessTskvLog(
     const std::string& remote_address) const {
   if (!logger_access_tskv) return;
 
+  if (logger_access_tskv->GetFormat() == logging::Format::kBinary) {
+    WriteAccessBinaryLog(*logger_access_tskv, tp, remote_address);
+    return;
+  }
+
   logger_access_tskv->Log(
       logging::Level::kInfo,
       fmt::format("tskv"
@@ -411,6 +423,41 @@ void HttpRequestImpl::WriteAccessTskvLog(
                   EscapeForAccessTskvLog(RequestBody())));
 }
 
+void HttpRequestImpl::WriteAccessBinaryLog(
+    logging::impl::LoggerBase& logger_access_tskv,
+    utils::datetime::WallCoarseClock::time_point tp,
+    const std::string& remote_address) const {
+  // Same fields as in the TSKV record, the values are stored unescaped and
+  // the timestamp is in the record header
+  logging::impl::binary::RecordBuilder record{logging::Level::kInfo, tp};
+  record.AddTag("timezone",
+                utils::datetime::LocalTimezoneTimestring(tp, "%Ez"));
+  record.AddIntegerTag("status", logging::impl::binary::MakeIntegerValue(
+                                     static_cast<unsigned long long>(
+                                         response_.GetStatus())));
+  record.AddTag("protocol",
+                fmt::format("HTTP/{}.{}", GetHttpMajor(), GetHttpMinor()));
+  record.AddTag("method", GetMethodStr());
+  record.AddTag("request", GetUrl());
+  record.AddTag("referer", GetHeader("Referer"));
+  record.AddTag("cookies", GetHeader("Cookie"));
+  record.AddTag("user_agent", GetHeader("User-Agent"));
+  record.AddTag("vhost", GetHost());
+  record.AddTag("ip", remote_address);
+  record.AddTag("x_forwarded_for", GetHeader("X-Forwarded-For"));
+  record.AddTag("x_real_ip", GetHeader("X-Real-IP"));
+  record.AddTag("upstream_http_x_yarequestid", GetHeader("X-YaRequestId"));
+  record.AddTag("http_host", GetHost());
+  record.AddTag("remote_addr", remote_address);
+  record.AddTag("request_time",
+                fmt::format("{:0.3f}", GetRequestTime().count()));
+  record.AddTag("upstream_response_time",
+                fmt::format("{:0.3f}", GetResponseTime().count()));
+  record.AddTag("request_body", RequestBody());
+
+  logger_access_tskv.Log(logging::Level::kInfo, std::move(record).Extract());
+}
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
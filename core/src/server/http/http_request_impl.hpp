@@ -120,6 +120,11 @@ class HttpRequestImpl final : public request::RequestBase {
                           utils::datetime::WallCoarseClock::time_point tp,
                           const std::string& remote_address) const;
 
+  // The access_tskv record for a logger with logging::Format::kBinary
+  void WriteAccessBinaryLog(logging::impl::LoggerBase& logger_access_tskv,
+                            utils::datetime::WallCoarseClock::time_point tp,
+                            const std::string& remote_address) const;
+
   void SetPathArgs(std::vector<std::pair<std::string, std::string>> args);
 
   void SetMatchedPathLength(size_t length) override;
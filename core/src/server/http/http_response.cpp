@@ -96,6 +96,16 @@ void AppendToCharArray(char*& data, const std::string_view what) {
 
 const std::string kEmptyString{};
 
+// RFC 9113, section 8.2.2
+bool IsConnectionSpecificHeader(std::string_view name) {
+  namespace headers = USERVER_NAMESPACE::http::headers;
+  return utils::StrIcaseEqual{}(name, headers::kConnection) ||
+         utils::StrIcaseEqual{}(name, "keep-alive") ||
+         utils::StrIcaseEqual{}(name, headers::kTransferEncoding) ||
+         utils::StrIcaseEqual{}(name, headers::kUpgrade) ||
+         utils::StrIcaseEqual{}(name, "proxy-connection");
+}
+
 }  // namespace
 
 namespace server::http {
@@ -326,6 +336,60 @@ void HttpResponse::SendResponse(engine::io::RwBase& socket) {
   SetSent(sent_bytes, std::chrono::steady_clock::now());
 }
 
+void HttpResponse::VisitHttp2Headers(Http2HeaderVisitor visitor) {
+  namespace headers = USERVER_NAMESPACE::http::headers;
+
+  headers_.erase(headers::kContentLength);
+  const auto end = headers_.end();
+  if (headers_.find(headers::kDate) == end) {
+    visitor(headers::kDate, impl::GetCachedDate());
+  }
+  if (headers_.find(headers::kContentType) == end) {
+    visitor(headers::kContentType, kDefaultContentType);
+  }
+  for (const auto& [name, value] : headers_) {
+    if (IsConnectionSpecificHeader(name)) continue;
+    visitor(name, value);
+  }
+  for (const auto& cookie : cookies_) {
+    visitor(headers::kSetCookie, cookie.second.ToString());
+  }
+
+  // A streamed response with a body is e.g. a CustomHandlerException
+  const bool is_body_streamed = IsBodyStreamed() && GetData().empty();
+  if (!is_body_streamed && !IsBodyForbiddenForStatus(status_)) {
+    visitor(headers::kContentLength,
+            fmt::format(FMT_COMPILE("{}"), GetData().size()));
+  }
+}
+
+bool HttpResponse::PopBodyPart(std::string& body_part) {
+  UASSERT(IsBodyStreamed());
+  if (!body_stream_encoder_) return body_stream_->Pop(body_part);
+
+  while (body_stream_->Pop(body_part)) {
+    if (body_part.empty()) continue;
+    body_part = body_stream_encoder_->Encode(body_part);
+    if (!body_part.empty()) return true;
+  }
+  body_part = body_stream_encoder_->Finish();
+  body_stream_encoder_.reset();
+  return !body_part.empty();
+}
+
+void HttpResponse::SetStreamBodyEncoder(
+    std::unique_ptr<StreamBodyEncoder> encoder) {
+  UASSERT(IsBodyStreamed());
+  body_stream_encoder_ = std::move(encoder);
+}
+
+void HttpResponse::SetHttp2Sent(std::size_t bytes_sent) {
+  body_stream_producer_.reset();
+  body_stream_.reset();
+
+  SetSent(bytes_sent, std::chrono::steady_clock::now());
+}
+
 std::size_t HttpResponse::SetBodyNotStreamed(
     engine::io::RwBase& socket,
     USERVER_NAMESPACE::http::headers::HeadersString& header) {
@@ -384,7 +448,7 @@ std::size_t HttpResponse::SetBodyStreamed(
   // First chunk must be sent without kCrlf
   // because kCrlf was sent with headers
   bool first_chunk_processed = false;
-  while (body_stream_->Pop(body_part)) {
+  while (PopBodyPart(body_part)) {
     if (body_part.empty()) {
       LOG_DEBUG() << "Zero size body_part in http_response.cpp";
       continue;
@@ -0,0 +1,215 @@
+#include <server/middlewares/compression.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <compression/gzip.hpp>
+
+#include <userver/formats/yaml/serialize.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/tracing/scope_time.hpp>
+#include <userver/utils/str_icase.hpp>
+#include <userver/utils/text_light.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::middlewares {
+
+namespace {
+
+namespace headers = USERVER_NAMESPACE::http::headers;
+
+constexpr std::string_view kGzip = "gzip";
+constexpr std::size_t kDefaultMinSize = 1024;
+
+std::string_view TrimView(std::string_view value) {
+  constexpr std::string_view kWhitespace = " \t";
+  const auto begin = value.find_first_not_of(kWhitespace);
+  if (begin == std::string_view::npos) return {};
+  const auto end = value.find_last_not_of(kWhitespace);
+  return value.substr(begin, end - begin + 1);
+}
+
+// Only "q=0", "q=0.", "q=0.0" etc. forbid a coding, values above 1 are
+// invalid and are not taken into account
+bool IsZeroQuality(std::string_view params) {
+  for (const auto param : utils::text::SplitIntoStringViewVector(params, ";")) {
+    const auto trimmed = TrimView(param);
+    if (trimmed.size() < 2 || (trimmed[0] != 'q' && trimmed[0] != 'Q') ||
+        trimmed[1] != '=') {
+      continue;
+    }
+    const auto value = trimmed.substr(2);
+    return !value.empty() &&
+           value.find_first_not_of("0.") == std::string_view::npos;
+  }
+  return false;
+}
+
+bool IsBodyForbidden(http::HttpStatus status) {
+  return status == http::HttpStatus::kNoContent ||
+         status == http::HttpStatus::kNotModified ||
+         (static_cast<int>(status) >= 100 && static_cast<int>(status) < 200);
+}
+
+void AddVaryAcceptEncoding(http::HttpResponse& response) {
+  const auto& vary = response.GetHeader(headers::kVary);
+  if (vary.empty()) {
+    response.SetHeader(headers::kVary, std::string{headers::kAcceptEncoding});
+    return;
+  }
+
+  const utils::StrIcaseEqual equal;
+  for (const auto value : utils::text::SplitIntoStringViewVector(vary, ",")) {
+    const auto trimmed = TrimView(value);
+    if (trimmed == "*" || equal(trimmed, headers::kAcceptEncoding)) return;
+  }
+  response.SetHeader(headers::kVary,
+                     fmt::format("{}, {}", vary, headers::kAcceptEncoding));
+}
+
+class GzipStreamBodyEncoder final
+    : public http::HttpResponse::StreamBodyEncoder {
+ public:
+  explicit GzipStreamBodyEncoder(int level) : compressor_(level) {}
+
+  std::string Encode(std::string_view body_part) override {
+    return compressor_.Compress(body_part);
+  }
+
+  std::string Finish() override { return compressor_.Finish(); }
+
+ private:
+  compression::gzip::Compressor compressor_;
+};
+
+}  // namespace
+
+bool IsGzipAccepted(std::string_view accept_encoding) {
+  const utils::StrIcaseEqual equal;
+  std::optional<bool> is_gzip_accepted;
+  bool is_any_accepted = false;
+
+  for (const auto coding :
+       utils::text::SplitIntoStringViewVector(accept_encoding, ",")) {
+    const auto params_pos = coding.find(';');
+    const auto name = TrimView(coding.substr(0, params_pos));
+    const bool is_accepted =
+        params_pos == std::string_view::npos ||
+        !IsZeroQuality(coding.substr(params_pos + 1));
+
+    if (equal(name, kGzip) || equal(name, "x-gzip")) {
+      is_gzip_accepted = is_accepted;
+    } else if (name == "*") {
+      is_any_accepted = is_accepted;
+    }
+  }
+
+  return is_gzip_accepted.value_or(is_any_accepted);
+}
+
+ResponseCompressor::ResponseCompressor(std::size_t min_size, int level)
+    : min_size_{min_size}, level_{level} {}
+
+void ResponseCompressor::Start(http::HttpResponse& response,
+                               bool is_accepted) const {
+  // Headers of a streamed response may be sent before the handler returns
+  if (!response.IsBodyStreamed()) return;
+
+  AddVaryAcceptEncoding(response);
+  if (!is_accepted) return;
+  response.SetHeader(headers::kContentEncoding, std::string{kGzip});
+  response.SetStreamBodyEncoder(
+      std::make_unique<GzipStreamBodyEncoder>(level_));
+}
+
+void ResponseCompressor::Finish(http::HttpResponse& response,
+                                bool is_accepted) const {
+  const auto& data = response.GetData();
+  if (IsBodyForbidden(response.GetStatus())) return;
+
+  // A streamed response may still get a not streamed body, e.g. on errors,
+  // it must match the already chosen content coding
+  const bool is_stream_compressed =
+      response.IsBodyStreamed() && is_accepted &&
+      response.GetHeader(headers::kContentEncoding) == kGzip;
+  if (!is_stream_compressed) {
+    if (response.IsBodyStreamed() || data.size() < min_size_) return;
+    AddVaryAcceptEncoding(response);
+    if (!is_accepted || response.HasHeader(headers::kContentEncoding)) return;
+  }
+  if (data.empty()) return;
+
+  const auto scope_time = tracing::ScopeTime::CreateOptionalScopeTime(
+      "http_compress_response_body");
+  auto compressed = compression::gzip::Compress(data, level_);
+  if (!is_stream_compressed && compressed.size() >= data.size()) return;
+
+  response.SetData(std::move(compressed));
+  response.SetHeader(headers::kContentEncoding, std::string{kGzip});
+}
+
+Compression::Compression(const handlers::HttpHandlerBase&,
+                         const yaml_config::YamlConfig& middleware_config)
+    : enabled_{middleware_config["enabled"].As<bool>(true)},
+      compressor_{
+          middleware_config["min-size"].As<std::size_t>(kDefaultMinSize),
+          middleware_config["level"].As<int>(
+              compression::gzip::kDefaultLevel)} {}
+
+void Compression::HandleRequest(http::HttpRequest& request,
+                                request::RequestContext& context) const {
+  if (!enabled_) {
+    Next(request, context);
+    return;
+  }
+
+  auto& response = request.GetHttpResponse();
+  const bool is_accepted =
+      IsGzipAccepted(request.GetHeader(headers::kAcceptEncoding));
+
+  compressor_.Start(response, is_accepted);
+  Next(request, context);
+  compressor_.Finish(response, is_accepted);
+}
+
+std::unique_ptr<HttpMiddlewareBase> CompressionFactory::Create(
+    const handlers::HttpHandlerBase& handler,
+    yaml_config::YamlConfig middleware_config) const {
+  return std::make_unique<Compression>(handler, middleware_config);
+}
+
+yaml_config::Schema CompressionFactory::GetMiddlewareConfigSchema() const {
+  return formats::yaml::FromString(R"(
+type: object
+description: response compression settings of the handler
+additionalProperties: false
+properties:
+    enabled:
+        type: boolean
+        description: whether to compress the responses
+        defaultDescription: true
+    min-size:
+        type: integer
+        description: min size of a not streamed response body to compress
+        defaultDescription: 1024
+        minimum: 0
+    level:
+        type: integer
+        description: gzip compression level, higher is slower but better
+        defaultDescription: 6
+        minimum: 1
+        maximum: 9
+)")
+      .As<yaml_config::Schema>();
+}
+
+}  // namespace server::middlewares
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+
+#include <userver/server/middlewares/http_middleware_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+class HttpResponse;
+}
+
+namespace server::middlewares {
+
+/// Applies gzip content coding to a response, the middleware independent part
+/// of Compression.
+class ResponseCompressor final {
+ public:
+  ResponseCompressor(std::size_t min_size, int level);
+
+  /// Called before the handler, sets up the compression of a streamed body
+  void Start(http::HttpResponse& response, bool is_accepted) const;
+
+  /// Called after the handler, compresses a not streamed body
+  void Finish(http::HttpResponse& response, bool is_accepted) const;
+
+ private:
+  const std::size_t min_size_;
+  const int level_;
+};
+
+/// Compresses response bodies with a content coding accepted by the client.
+///
+/// Not streamed bodies are compressed if they are at least `min-size` bytes,
+/// streamed bodies are compressed part by part regardless of their size.
+class Compression final : public HttpMiddlewareBase {
+ public:
+  static constexpr std::string_view kName{"userver-compression-middleware"};
+
+  Compression(const handlers::HttpHandlerBase&,
+              const yaml_config::YamlConfig& middleware_config);
+
+ private:
+  void HandleRequest(http::HttpRequest& request,
+                     request::RequestContext& context) const override;
+
+  const bool enabled_;
+  const ResponseCompressor compressor_;
+};
+
+class CompressionFactory final : public HttpMiddlewareFactoryBase {
+ public:
+  static constexpr std::string_view kName = Compression::kName;
+
+  using HttpMiddlewareFactoryBase::HttpMiddlewareFactoryBase;
+
+ private:
+  std::unique_ptr<HttpMiddlewareBase> Create(
+      const handlers::HttpHandlerBase&,
+      yaml_config::YamlConfig middleware_config) const override;
+
+  yaml_config::Schema GetMiddlewareConfigSchema() const override;
+};
+
+/// Returns whether gzip content coding is acceptable according to the
+/// Accept-Encoding request header value (RFC 9110, 12.5.3).
+bool IsGzipAccepted(std::string_view accept_encoding);
+
+}  // namespace server::middlewares
+
+template <>
+inline constexpr bool
+    components::kHasValidate<server::middlewares::CompressionFactory> = true;
+
+template <>
+inline constexpr auto
+    components::kConfigFileMode<server::middlewares::CompressionFactory> =
+        ConfigFileMode::kNotRequired;
+
+USERVER_NAMESPACE_END
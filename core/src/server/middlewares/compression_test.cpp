@@ -0,0 +1,214 @@
+#include <server/middlewares/compression.hpp>
+
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <compression/gzip.hpp>
+#include <server/http/http_request_impl.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace headers = http::headers;
+
+constexpr std::size_t kMinSize = 64;
+constexpr std::size_t kMaxDecompressedSize = 1 << 20;
+
+std::string MakeCompressibleBody() {
+  std::string body;
+  while (body.size() < 4096) body += "compressible response body ";
+  return body;
+}
+
+std::string MakeIncompressibleBody() {
+  std::mt19937 engine{42};
+  std::uniform_int_distribution<int> distribution{0, 255};
+  std::string body(4096, '\0');
+  for (auto& c : body) c = static_cast<char>(distribution(engine));
+  return body;
+}
+
+class ResponseCompressorTest : public testing::Test {
+ protected:
+  server::http::HttpResponse& GetResponse() {
+    return request_.GetHttpResponse();
+  }
+
+  const server::middlewares::ResponseCompressor compressor_{
+      kMinSize, compression::gzip::kDefaultLevel};
+
+ private:
+  server::request::ResponseDataAccounter accounter_;
+  server::http::HttpRequestImpl request_{accounter_};
+};
+
+}  // namespace
+
+TEST(CompressionMiddleware, IsGzipAccepted) {
+  using server::middlewares::IsGzipAccepted;
+
+  EXPECT_TRUE(IsGzipAccepted("gzip"));
+  EXPECT_TRUE(IsGzipAccepted("deflate, GZIP;q=0.5"));
+  EXPECT_TRUE(IsGzipAccepted("br, x-gzip"));
+  EXPECT_TRUE(IsGzipAccepted("*"));
+  EXPECT_TRUE(IsGzipAccepted("gzip;q=0.001"));
+
+  EXPECT_FALSE(IsGzipAccepted(""));
+  EXPECT_FALSE(IsGzipAccepted("identity"));
+  EXPECT_FALSE(IsGzipAccepted("gzip;q=0"));
+  EXPECT_FALSE(IsGzipAccepted("gzip; q=0.000, deflate"));
+  EXPECT_FALSE(IsGzipAccepted("*, gzip;q=0"));
+  EXPECT_FALSE(IsGzipAccepted("*;q=0"));
+}
+
+TEST_F(ResponseCompressorTest, CompressesBody) {
+  auto& response = GetResponse();
+  const auto body = MakeCompressibleBody();
+  response.SetData(body);
+
+  compressor_.Start(response, true);
+  compressor_.Finish(response, true);
+
+  EXPECT_EQ(response.GetHeader(headers::kContentEncoding), "gzip");
+  EXPECT_EQ(response.GetHeader(headers::kVary), "Accept-Encoding");
+  EXPECT_LT(response.GetData().size(), body.size());
+  EXPECT_EQ(compression::gzip::Decompress(response.GetData(),
+                                          kMaxDecompressedSize),
+            body);
+}
+
+TEST_F(ResponseCompressorTest, NotAccepted) {
+  auto& response = GetResponse();
+  const auto body = MakeCompressibleBody();
+  response.SetData(body);
+
+  compressor_.Start(response, false);
+  compressor_.Finish(response, false);
+
+  EXPECT_EQ(response.GetData(), body);
+  EXPECT_FALSE(response.HasHeader(headers::kContentEncoding));
+  // The response still depends on Accept-Encoding for caches
+  EXPECT_EQ(response.GetHeader(headers::kVary), "Accept-Encoding");
+}
+
+TEST_F(ResponseCompressorTest, MinSize) {
+  auto& response = GetResponse();
+  const std::string body(kMinSize - 1, 'a');
+  response.SetData(body);
+
+  compressor_.Finish(response, true);
+
+  EXPECT_EQ(response.GetData(), body);
+  EXPECT_FALSE(response.HasHeader(headers::kContentEncoding));
+  EXPECT_FALSE(response.HasHeader(headers::kVary));
+
+  const std::string min_size_body(kMinSize, 'a');
+  response.SetData(min_size_body);
+  compressor_.Finish(response, true);
+  EXPECT_EQ(response.GetHeader(headers::kContentEncoding), "gzip");
+}
+
+TEST_F(ResponseCompressorTest, Incompressible) {
+  auto& response = GetResponse();
+  const auto body = MakeIncompressibleBody();
+  response.SetData(body);
+
+  compressor_.Finish(response, true);
+
+  EXPECT_EQ(response.GetData(), body);
+  EXPECT_FALSE(response.HasHeader(headers::kContentEncoding));
+  EXPECT_EQ(response.GetHeader(headers::kVary), "Accept-Encoding");
+}
+
+TEST_F(ResponseCompressorTest, Headers) {
+  auto& response = GetResponse();
+  response.SetHeader(headers::kVary, std::string{"Origin"});
+  response.SetData(MakeCompressibleBody());
+
+  compressor_.Finish(response, true);
+  EXPECT_EQ(response.GetHeader(headers::kVary), "Origin, Accept-Encoding");
+
+  // Vary is not duplicated
+  response.SetData(MakeCompressibleBody());
+  response.ClearHeaders();
+  response.SetHeader(headers::kVary, std::string{"accept-encoding"});
+  compressor_.Finish(response, true);
+  EXPECT_EQ(response.GetHeader(headers::kVary), "accept-encoding");
+  EXPECT_EQ(response.GetHeader(headers::kContentEncoding), "gzip");
+
+  // A body already encoded by the handler is left as is
+  const auto body = MakeCompressibleBody();
+  response.SetData(body);
+  response.ClearHeaders();
+  response.SetHeader(headers::kContentEncoding, std::string{"br"});
+  compressor_.Finish(response, true);
+  EXPECT_EQ(response.GetData(), body);
+  EXPECT_EQ(response.GetHeader(headers::kContentEncoding), "br");
+}
+
+TEST_F(ResponseCompressorTest, BodyForbidden) {
+  auto& response = GetResponse();
+  const auto body = MakeCompressibleBody();
+  response.SetData(body);
+  response.SetStatus(server::http::HttpStatus::kNoContent);
+
+  compressor_.Finish(response, true);
+
+  EXPECT_EQ(response.GetData(), body);
+  EXPECT_FALSE(response.HasHeader(headers::kContentEncoding));
+}
+
+UTEST_F(ResponseCompressorTest, StreamedBody) {
+  auto& response = GetResponse();
+  response.SetStreamBody();
+
+  compressor_.Start(response, true);
+  EXPECT_EQ(response.GetHeader(headers::kContentEncoding), "gzip");
+  EXPECT_EQ(response.GetHeader(headers::kVary), "Accept-Encoding");
+
+  std::string body;
+  {
+    auto producer = response.GetBodyProducer();
+    // Parts smaller than min-size are compressed too
+    for (const std::string part : {"first ", "", "second ", "third"}) {
+      body += part;
+      ASSERT_TRUE(producer.Push(std::string{part}, {}));
+    }
+  }
+  compressor_.Finish(response, true);
+
+  std::string compressed;
+  std::string part;
+  while (response.PopBodyPart(part)) compressed += part;
+  EXPECT_EQ(
+      compression::gzip::Decompress(compressed, kMaxDecompressedSize), body);
+}
+
+UTEST_F(ResponseCompressorTest, StreamedBodyNotAccepted) {
+  auto& response = GetResponse();
+  response.SetStreamBody();
+
+  compressor_.Start(response, false);
+  EXPECT_FALSE(response.HasHeader(headers::kContentEncoding));
+  EXPECT_EQ(response.GetHeader(headers::kVary), "Accept-Encoding");
+
+  {
+    auto producer = response.GetBodyProducer();
+    ASSERT_TRUE(producer.Push(std::string{"first "}, {}));
+    ASSERT_TRUE(producer.Push(std::string{"second"}, {}));
+  }
+  compressor_.Finish(response, false);
+
+  std::string body;
+  std::string part;
+  while (response.PopBodyPart(part)) body += part;
+  EXPECT_EQ(body, "first second");
+}
+
+USERVER_NAMESPACE_END
@@ -7,6 +7,7 @@
 
 #include <server/middlewares/auth.hpp>
 #include <server/middlewares/baggage.hpp>
+#include <server/middlewares/compression.hpp>
 #include <server/middlewares/deadline_propagation.hpp>
 #include <server/middlewares/decompression.hpp>
 #include <server/middlewares/exceptions_handling.hpp>
@@ -57,6 +58,7 @@ components::ComponentList DefaultMiddlewareComponents() {
       .Append<DeadlinePropagationFactory>()
       .Append<DecompressionFactory>()
       .Append<SetAcceptEncodingFactory>()
+      .Append<CompressionFactory>()
       .Append<ExceptionsHandlingFactory>()
       .Append<UnknownExceptionsHandlingFactory>()
       .Append<testsuite::ExceptionsHandlingMiddlewareFactory>();
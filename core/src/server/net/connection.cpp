@@ -1,18 +1,29 @@
 #include "connection.hpp"
 
+#include <algorithm>
 #include <array>
+#include <deque>
+#include <optional>
+#include <string_view>
 #include <system_error>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/request_handler_base.hpp>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/exception.hpp>
+#include <userver/engine/future.hpp>
 #include <userver/engine/io/exception.hpp>
 #include <userver/engine/io/tls_wrapper.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/wait_any.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_config.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
@@ -21,6 +32,66 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+constexpr std::string_view kHttp2AlpnProtocol = "h2";
+constexpr std::string_view kHttp2Preface = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+// "PRI " is not a valid HTTP/1.x method, so that is enough to tell HTTP/2
+// prior knowledge from HTTP/1.x if the preface is split between reads.
+constexpr std::size_t kHttp2PrefaceMinSize = 4;
+
+struct Http2Event {
+  enum class Type { kResponseReady, kBodyPart, kBodyEnd };
+
+  std::int32_t stream_id;
+  Type type;
+  std::string body_part{};
+};
+
+}  // namespace
+
+// Passes events from the per-stream tasks to the connection task, which waits
+// for either the socket or a new event.
+class Connection::Http2EventQueue final {
+ public:
+  void Push(Http2Event&& event) {
+    std::optional<engine::Promise<void>> wakeup;
+    {
+      std::lock_guard lock(mutex_);
+      events_.push_back(std::move(event));
+      wakeup.swap(wakeup_);
+    }
+    if (wakeup) wakeup->set_value();
+  }
+
+  // Returns std::nullopt if there are events to process
+  std::optional<engine::Future<void>> PrepareWait() {
+    std::lock_guard lock(mutex_);
+    if (!events_.empty()) return std::nullopt;
+    wakeup_.emplace();
+    return wakeup_->get_future();
+  }
+
+  std::vector<Http2Event> PopAll() {
+    std::lock_guard lock(mutex_);
+    wakeup_.reset();
+    return std::exchange(events_, {});
+  }
+
+ private:
+  engine::Mutex mutex_;
+  std::vector<Http2Event> events_;
+  std::optional<engine::Promise<void>> wakeup_;
+};
+
+struct Connection::Http2Stream {
+  std::shared_ptr<request::RequestBase> request;
+  bool is_response_submitted{false};
+  engine::SingleConsumerEvent body_consumed;
+  engine::TaskWithResult<void> task;
+};
+
 Connection::Connection(
     const ConnectionConfig& config,
     const request::HttpRequestConfig& handler_defaults_config,
@@ -87,6 +158,7 @@ void Connection::ListenForRequests() noexcept {
         stats_->parser_stats, data_accounter_);
 
     pending_data_.resize(config_.in_buffer_size);
+    bool is_protocol_detected = !config_.http2.enabled;
     while (is_accepting_requests_) {
       auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
 
@@ -127,6 +199,14 @@ void Connection::ListenForRequests() noexcept {
                     << Getpeername() << " on fd " << Fd();
       }
 
+      if (!is_protocol_detected) {
+        is_protocol_detected = true;
+        if (IsHttp2Connection()) {
+          ProcessHttp2();
+          return;
+        }
+      }
+
       bool should_stop_accepting_requests = false;
       if (!request_parser.Parse(pending_data_.data(), pending_data_size_)) {
         LOG_DEBUG() << "Malformed request from " << Getpeername() << " on fd "
@@ -137,8 +217,12 @@ void Connection::ListenForRequests() noexcept {
       }
       pending_data_size_ = 0;
 
-      for (auto&& request : pending_requests) {
-        ProcessRequest(std::move(request));
+      if (config_.max_pipelined_requests > 1 && pending_requests.size() > 1) {
+        ProcessPipelinedRequests(pending_requests);
+      } else {
+        for (auto&& request : pending_requests) {
+          ProcessRequest(std::move(request));
+        }
       }
       pending_requests.resize(0);
       if (should_stop_accepting_requests) is_accepting_requests_ = false;
@@ -173,6 +257,52 @@ void Connection::ProcessRequest(
   stats_->active_request_count.Add(1);
 
   auto task = HandleQueueItem(request_ptr);
+  FinishRequest(std::move(request_ptr));
+}
+
+void Connection::ProcessPipelinedRequests(
+    std::vector<std::shared_ptr<request::RequestBase>>& requests) {
+  struct InFlightRequest {
+    std::shared_ptr<request::RequestBase> request;
+    engine::TaskWithResult<void> task;
+  };
+
+  // Responses are sent in order of requests, so the handlers of up to
+  // max_pipelined_requests requests may run concurrently while we are waiting
+  // for the oldest one.
+  std::deque<InFlightRequest> in_flight;
+  auto next = requests.begin();
+
+  while (next != requests.end() || !in_flight.empty()) {
+    while (next != requests.end() &&
+           in_flight.size() < config_.max_pipelined_requests) {
+      // Connection upgrade takes over the socket, so such a request is
+      // processed only after all the previous ones and before the next ones.
+      if ((*next)->IsUpgradeWebsocket() && !in_flight.empty()) break;
+
+      auto& request_ptr = *next;
+      if (request_ptr->IsFinal()) {
+        is_accepting_requests_ = false;
+      }
+      stats_->active_request_count.Add(1);
+
+      auto task = request_handler_.StartRequestTask(request_ptr);
+      const bool is_upgrade = request_ptr->IsUpgradeWebsocket();
+      in_flight.push_back({std::move(request_ptr), std::move(task)});
+      ++next;
+
+      if (is_upgrade) break;
+    }
+
+    auto& oldest = in_flight.front();
+    WaitForRequestTask(oldest.request, oldest.task);
+    FinishRequest(std::move(oldest.request));
+    in_flight.pop_front();
+  }
+}
+
+void Connection::FinishRequest(
+    std::shared_ptr<request::RequestBase>&& request_ptr) {
   SendResponse(*request_ptr);
 
   if (request_ptr->IsUpgradeWebsocket())
@@ -203,14 +333,20 @@ bool Connection::ReadSome() {
 engine::TaskWithResult<void> Connection::HandleQueueItem(
     const std::shared_ptr<request::RequestBase>& request) noexcept {
   auto request_task = request_handler_.StartRequestTask(request);
+  WaitForRequestTask(request, request_task);
+  return request_task;
+}
 
+void Connection::WaitForRequestTask(
+    const std::shared_ptr<request::RequestBase>& request,
+    engine::TaskWithResult<void>& request_task) noexcept {
   if (engine::current_task::IsCancelRequested()) {
-    // We could've packed all remaining requests into a vector and cancel them
-    // in parallel. But pipelining is almost never used so why bother.
+    // Pipelined requests that are already started are cancelled one by one
+    // while the response chain is drained.
     request_task.SyncCancel();
     LOG_DEBUG() << "Request processing interrupted";
     is_response_chain_valid_ = false;
-    return request_task;  // avoids throwing and catching exception down below
+    return;  // avoids throwing and catching exception down below
   }
 
   try {
@@ -263,7 +399,6 @@ engine::TaskWithResult<void> Connection::HandleQueueItem(
     LOG_WARNING() << "Request failed with unhandled exception: " << e;
     request->MarkAsInternalServerError();
   }
-  return request_task;
 }
 
 void Connection::SendResponse(request::RequestBase& request) {
@@ -298,6 +433,193 @@ void Connection::SendResponse(request::RequestBase& request) {
                           request_handler_.LoggerAccessTskv(), peer_name_);
 }
 
+bool Connection::IsHttp2Connection() const {
+  auto* tls_socket = dynamic_cast<engine::io::TlsWrapper*>(peer_socket_.get());
+  if (tls_socket) return tls_socket->GetAlpnProtocol() == kHttp2AlpnProtocol;
+
+  const std::string_view data{pending_data_.data(), pending_data_size_};
+  const auto size = std::min(data.size(), kHttp2Preface.size());
+  return size >= kHttp2PrefaceMinSize &&
+         data.substr(0, size) == kHttp2Preface.substr(0, size);
+}
+
+void Connection::ProcessHttp2() {
+  LOG_DEBUG() << "Processing HTTP/2 connection from " << Getpeername()
+              << " on fd " << Fd();
+
+  Http2EventQueue events;
+  std::unordered_map<http::Http2Session::StreamId, Http2Stream> streams;
+  utils::FastScopeGuard streams_guard{[this, &streams]() noexcept {
+    for (auto& [stream_id, stream] : streams) FinishHttp2Stream(stream);
+  }};
+
+  http::Http2Session session(
+      request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+      config_.http2,
+      [this, &events, &streams](
+          http::Http2Session::StreamId stream_id,
+          std::shared_ptr<request::RequestBase>&& request_ptr) {
+        auto& stream = streams[stream_id];
+        stream.request = std::move(request_ptr);
+        stats_->active_request_count.Add(1);
+        stream.task = StartHttp2Stream(events, stream_id, stream);
+      },
+      [this, &streams](http::Http2Session::StreamId stream_id) {
+        const auto it = streams.find(stream_id);
+        if (it == streams.end()) return;
+        FinishHttp2Stream(it->second);
+        streams.erase(it);
+      },
+      [&streams](http::Http2Session::StreamId stream_id) {
+        const auto it = streams.find(stream_id);
+        if (it != streams.end()) it->second.body_consumed.Send();
+      },
+      stats_->parser_stats, stats_->http2_stats, data_accounter_);
+
+  bool is_valid = session.Parse(pending_data_.data(), pending_data_size_);
+  pending_data_size_ = 0;
+
+  while (true) {
+    for (auto& event : events.PopAll()) {
+      switch (event.type) {
+        case Http2Event::Type::kResponseReady: {
+          const auto it = streams.find(event.stream_id);
+          if (it == streams.end()) break;
+          it->second.request->SetStartSendResponseTime();
+          it->second.is_response_submitted = true;
+          session.SubmitResponse(event.stream_id);
+          break;
+        }
+        case Http2Event::Type::kBodyPart:
+          session.AppendBody(event.stream_id, std::move(event.body_part));
+          break;
+        case Http2Event::Type::kBodyEnd:
+          session.FinishBody(event.stream_id);
+          break;
+      }
+    }
+
+    for (auto output = session.GetOutput(); !output.empty();
+         output = session.GetOutput()) {
+      const auto sent_bytes =
+          peer_socket_->WriteAll(output.data(), output.size(), {});
+      if (sent_bytes != output.size()) {
+        LOG_DEBUG() << "Peer " << Getpeername() << " on fd " << Fd()
+                    << " closed HTTP/2 connection";
+        return;
+      }
+    }
+
+    // On a connection error the GOAWAY frame is already sent
+    if (!is_valid || !session.IsActive()) return;
+
+    auto wakeup = events.PrepareWait();
+    if (!wakeup) continue;
+
+    const auto deadline =
+        streams.empty()
+            ? engine::Deadline::FromDuration(config_.keepalive_timeout)
+            : engine::Deadline{};
+    engine::io::ReadableBase& peer_read = *peer_socket_;
+    const auto ready = engine::WaitAnyUntil(deadline, peer_read, *wakeup);
+    if (!ready) {
+      if (!engine::current_task::ShouldCancel()) {
+        LOG_INFO() << "Closing idle HTTP/2 connection on timeout";
+      }
+      return;
+    }
+
+    if (*ready == 0) {
+      if (!ReadSome()) {
+        LOG_TRACE() << "Peer " << Getpeername() << " on fd " << Fd()
+                    << " closed HTTP/2 connection";
+        return;
+      }
+      is_valid = session.Parse(pending_data_.data(), pending_data_size_);
+      pending_data_size_ = 0;
+    }
+  }
+}
+
+engine::TaskWithResult<void> Connection::StartHttp2Stream(
+    Http2EventQueue& events, std::int32_t stream_id, Http2Stream& stream) {
+  // The stream must be answered even under TaskProcessor overload
+  return engine::CriticalAsyncNoSpan([this, &events, stream_id, &stream] {
+    auto request_task = request_handler_.StartRequestTask(stream.request);
+    if (!WaitForHttp2RequestTask(*stream.request, request_task)) return;
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+    auto& response = static_cast<http::HttpResponse&>(
+        stream.request->GetResponse());
+    const bool is_body_streamed = response.IsBodyStreamed();
+    events.Push({stream_id, Http2Event::Type::kResponseReady});
+    if (!is_body_streamed) return;
+
+    std::string body_part;
+    while (response.PopBodyPart(body_part)) {
+      if (body_part.empty()) continue;
+
+      events.Push(
+          {stream_id, Http2Event::Type::kBodyPart, std::move(body_part)});
+      body_part = {};
+
+      // Do not pop the next part until the current one is sent, so that the
+      // connection does not buffer the whole body of a fast producer.
+      if (!stream.body_consumed.WaitForEvent()) return;
+    }
+    events.Push({stream_id, Http2Event::Type::kBodyEnd});
+  });
+}
+
+bool Connection::WaitForHttp2RequestTask(
+    request::RequestBase& request, engine::TaskWithResult<void>& request_task) {
+  // Closed streams and connections are handled by the connection task, which
+  // cancels the stream task.
+  try {
+    auto& response = request.GetResponse();
+    if (response.IsBodyStreamed()) {
+      return response.WaitForHeadersEnd();
+    }
+    request_task.Get();
+  } catch (const engine::TaskCancelledException& e) {
+    LOG_LIMITED_ERROR() << "Handler task was cancelled with reason: "
+                        << ToString(e.Reason());
+    auto& response = request.GetResponse();
+    if (!response.IsReady()) {
+      response.SetReady();
+      response.SetStatusServiceUnavailable();
+    }
+  } catch (const engine::WaitInterruptedException&) {
+    LOG_DEBUG() << "Request processing interrupted";
+    return false;
+  } catch (const std::exception& e) {
+    LOG_WARNING() << "Request failed with unhandled exception: " << e;
+    request.MarkAsInternalServerError();
+  }
+  return true;
+}
+
+void Connection::FinishHttp2Stream(Http2Stream& stream) noexcept {
+  if (stream.task.IsValid()) stream.task.SyncCancel();
+
+  auto& request = *stream.request;
+  auto& response = request.GetResponse();
+  if (!stream.is_response_submitted) request.SetStartSendResponseTime();
+  if (!response.IsSent()) {
+    response.SetSendFailed(std::chrono::steady_clock::now());
+  }
+  request.SetFinishSendResponseTime();
+  stats_->active_request_count.Subtract(1);
+  stats_->requests_processed_count.Add(1);
+
+  try {
+    request.WriteAccessLogs(request_handler_.LoggerAccess(),
+                            request_handler_.LoggerAccessTskv(), peer_name_);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to write access logs: " << ex;
+  }
+}
+
 std::string Connection::Getpeername() const { return peer_name_; }
 
 }  // namespace server::net
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <server/http/http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
@@ -40,11 +42,28 @@ class Connection final {
 
   void ListenForRequests() noexcept;
   void ProcessRequest(std::shared_ptr<request::RequestBase>&& request_ptr);
+  void ProcessPipelinedRequests(
+      std::vector<std::shared_ptr<request::RequestBase>>& requests);
+  void FinishRequest(std::shared_ptr<request::RequestBase>&& request_ptr);
 
   engine::TaskWithResult<void> HandleQueueItem(
       const std::shared_ptr<request::RequestBase>& request) noexcept;
+  void WaitForRequestTask(const std::shared_ptr<request::RequestBase>& request,
+                          engine::TaskWithResult<void>& request_task) noexcept;
   void SendResponse(request::RequestBase& request);
 
+  class Http2EventQueue;
+  struct Http2Stream;
+
+  bool IsHttp2Connection() const;
+  void ProcessHttp2();
+  engine::TaskWithResult<void> StartHttp2Stream(Http2EventQueue& events,
+                                                std::int32_t stream_id,
+                                                Http2Stream& stream);
+  bool WaitForHttp2RequestTask(request::RequestBase& request,
+                               engine::TaskWithResult<void>& request_task);
+  void FinishHttp2Stream(Http2Stream& stream) noexcept;
+
   std::string Getpeername() const;
 
   void ParseRequestData(http::HttpRequestParser& request_parser,
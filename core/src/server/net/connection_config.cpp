@@ -1,5 +1,7 @@
 #include <server/net/connection_config.hpp>
 
+#include <stdexcept>
+
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -20,6 +22,25 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
           config.keepalive_timeout);
   config.abort_check_delay = utils::StringToDuration(
       value["stream_close_check_delay"].As<std::string>("20ms"));
+  config.max_pipelined_requests = value["max_pipelined_requests"].As<size_t>(
+      config.max_pipelined_requests);
+  if (config.max_pipelined_requests == 0) {
+    throw std::runtime_error("Invalid max_pipelined_requests value in " +
+                             value.GetPath());
+  }
+
+  const auto http2 = value["http2"];
+  config.http2.enabled = http2["enabled"].As<bool>(config.http2.enabled);
+  config.http2.max_concurrent_streams =
+      http2["max_concurrent_streams"].As<std::uint32_t>(
+          config.http2.max_concurrent_streams);
+  config.http2.initial_window_size =
+      http2["initial_window_size"].As<std::uint32_t>(
+          config.http2.initial_window_size);
+  if (config.http2.max_concurrent_streams == 0) {
+    throw std::runtime_error("Invalid http2.max_concurrent_streams value in " +
+                             value.GetPath());
+  }
 
   return config;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -9,11 +10,19 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+struct Http2Config {
+  bool enabled = false;
+  std::uint32_t max_concurrent_streams = 100;
+  std::uint32_t initial_window_size = 65535;
+};
+
 struct ConnectionConfig {
   size_t in_buffer_size = 32 * 1024;
   size_t requests_queue_size_threshold = 100;
   std::chrono::seconds keepalive_timeout{10 * 60};
   std::chrono::milliseconds abort_check_delay{20};
+  size_t max_pipelined_requests = 1;
+  Http2Config http2;
 };
 
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
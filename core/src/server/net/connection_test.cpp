@@ -1,5 +1,7 @@
 #include <server/net/connection.hpp>
 
+#include <array>
+
 #include <fmt/format.h>
 
 #include <server/handlers/http_handler_base_statistics.hpp>
@@ -23,7 +25,7 @@ constexpr auto kAcceptTimeout = utest::kMaxTestWaitTime;
 
 class TestHttprequestHandler : public server::http::RequestHandlerBase {
  public:
-  enum class Behaviors { kNoop, kHang };
+  enum class Behaviors { kNoop, kHang, kEchoPathSlowly };
 
   explicit TestHttprequestHandler(Behaviors behavior = Behaviors::kNoop)
       : behavior_(behavior) {}
@@ -45,6 +47,21 @@ class TestHttprequestHandler : public server::http::RequestHandlerBase {
           ASSERT_TRUE(engine::current_task::IsCancelRequested());
           ++asyncs_finished;
         });
+      case Behaviors::kEchoPathSlowly:
+        return engine::AsyncNoSpan([this, &http_request]() {
+          const auto concurrent = ++asyncs_running;
+          auto max_concurrent = max_asyncs_running.load();
+          while (max_concurrent < concurrent &&
+                 !max_asyncs_running.compare_exchange_weak(max_concurrent,
+                                                           concurrent)) {
+          }
+
+          engine::SleepFor(std::chrono::milliseconds{50});
+          http_request.GetHttpResponse().SetData(http_request.GetRequestPath());
+
+          --asyncs_running;
+          ++asyncs_finished;
+        });
     }
 
     UINVARIANT(false, "Unexpected behavior");
@@ -63,6 +80,10 @@ class TestHttprequestHandler : public server::http::RequestHandlerBase {
 
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   mutable std::atomic<std::size_t> asyncs_finished{0};
+  // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+  mutable std::atomic<std::size_t> asyncs_running{0};
+  // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+  mutable std::atomic<std::size_t> max_asyncs_running{0};
 
  private:
   const Behaviors behavior_;
@@ -323,4 +344,68 @@ UTEST(ServerNetConnection, CancelMultipleInFlight) {
   FAIL() << "Failed to simulate cancellation of multiple requests";
 }
 
+UTEST(ServerNetConnection, PipelinedRequestsConcurrently) {
+  constexpr std::size_t kPipelinedRequests = 4;
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.max_pipelined_requests = kPipelinedRequests;
+  auto request_socket = net::CreateSocket(config);
+
+  auto addr = engine::io::Sockaddr::MakeLoopbackAddress();
+  addr.SetPort(request_socket.Getsockname().Port());
+  engine::io::Socket client{addr.Domain(), engine::io::SocketType::kStream};
+  client.Connect(addr, Deadline::FromDuration(utest::kMaxTestWaitTime));
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler{
+      TestHttprequestHandler::Behaviors::kEchoPathSlowly};
+
+  auto task = engine::AsyncNoSpan([&] {
+    net::Connection connection(
+        config.connection_config, config.handler_defaults,
+        std::make_unique<engine::io::Socket>(std::move(peer)), {}, handler,
+        stats, data_accounter);
+
+    connection.Process();
+  });
+
+  std::string requests;
+  for (std::size_t i = 0; i < kPipelinedRequests; ++i) {
+    requests += fmt::format(
+        "GET /request{} HTTP/1.1\r\nHost: localhost\r\n\r\n", i);
+  }
+  ASSERT_EQ(client.SendAll(requests.data(), requests.size(),
+                           Deadline::FromDuration(utest::kMaxTestWaitTime)),
+            requests.size());
+
+  std::string responses;
+  const auto last_path = fmt::format("/request{}", kPipelinedRequests - 1);
+  while (responses.find(last_path) == std::string::npos) {
+    std::array<char, 1024> buffer{};
+    const auto received =
+        client.RecvSome(buffer.data(), buffer.size(),
+                        Deadline::FromDuration(utest::kMaxTestWaitTime));
+    ASSERT_NE(received, 0);
+    responses.append(buffer.data(), received);
+  }
+
+  // Responses are sent in the order of requests
+  std::size_t previous_position = 0;
+  for (std::size_t i = 0; i < kPipelinedRequests; ++i) {
+    const auto position = responses.find(fmt::format("/request{}", i));
+    ASSERT_NE(position, std::string::npos);
+    EXPECT_GE(position, previous_position);
+    previous_position = position;
+  }
+
+  EXPECT_EQ(handler.asyncs_finished, kPipelinedRequests);
+  EXPECT_EQ(handler.max_asyncs_running, kPipelinedRequests);
+
+  task.RequestCancel();
+  task.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(task.IsFinished());
+}
+
 USERVER_NAMESPACE_END
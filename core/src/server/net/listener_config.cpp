@@ -49,6 +49,7 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
   if (!cert_path.empty()) {
     auto contents = fs::blocking::ReadFileContents(cert_path);
     config.tls_cert = crypto::Certificate::LoadFromString(contents);
+    config.tls_cert_path = cert_path;
     config.tls = true;
   }
   if (!pkey_path.empty()) {
@@ -57,12 +58,18 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
   if (!pkey_pass_name.empty()) {
     config.tls_private_key_passphrase_name = pkey_pass_name;
   }
-  auto ca_paths = value["tls"]["ca"].As<std::vector<std::string>>({});
-  for (const auto& ca_path : ca_paths) {
+  config.tls_certificate_authorities_paths =
+      value["tls"]["ca"].As<std::vector<std::string>>({});
+  for (const auto& ca_path : config.tls_certificate_authorities_paths) {
     auto contents = fs::blocking::ReadFileContents(ca_path);
     config.tls_certificate_authorities.push_back(
         crypto::Certificate::LoadFromString(contents));
   }
+  config.tls_session_tickets =
+      value["tls"]["session-tickets"].As<bool>(config.tls_session_tickets);
+  config.tls_session_cache_size =
+      value["tls"]["session-cache-size"].As<size_t>(
+          config.tls_session_cache_size);
 
   return config;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 
 #include <userver/crypto/certificate.hpp>
@@ -12,6 +13,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace engine::io {
+class TlsServerContext;
+}  // namespace engine::io
+
 namespace server::net {
 
 struct ListenerConfig {
@@ -26,11 +31,19 @@ struct ListenerConfig {
   std::string task_processor;
 
   bool tls{false};
+  std::string tls_cert_path;
   crypto::Certificate tls_cert;
   std::string tls_private_key_path;
   std::string tls_private_key_passphrase_name;
   crypto::PrivateKey tls_private_key;
+  std::vector<std::string> tls_certificate_authorities_paths;
   std::vector<crypto::Certificate> tls_certificate_authorities;
+  bool tls_session_tickets{true};
+  size_t tls_session_cache_size{20480};
+
+  // Built once the private key is loaded, shared by all the connections.
+  // Reloaded from the files on secdist updates
+  std::shared_ptr<engine::io::TlsServerContext> tls_context;
 };
 
 ListenerConfig Parse(const yaml_config::YamlConfig& value,
@@ -64,6 +64,7 @@ StatsAggregation ListenerImpl::GetStats() const {
 
 void ListenerImpl::AcceptConnection(engine::io::Socket& request_socket) {
   auto peer_socket = request_socket.Accept({});
+  ++stats_->connections_accepted;
 
   const auto new_connection_count = ++endpoint_info_->connection_count;
   utils::FastScopeGuard guard{
@@ -101,11 +102,11 @@ void ListenerImpl::ProcessConnection(engine::io::Socket peer_socket) {
   std::unique_ptr<engine::io::RwBase> socket;
   auto remote_address = peer_socket.Getpeername();
   if (endpoint_info_->listener_config.tls) {
-    const auto& config = endpoint_info_->listener_config;
+    const auto& tls_context = endpoint_info_->listener_config.tls_context;
+    UASSERT(tls_context);
     socket = std::make_unique<engine::io::TlsWrapper>(
-        engine::io::TlsWrapper::StartTlsServer(
-            std::move(peer_socket), config.tls_cert, config.tls_private_key, {},
-            config.tls_certificate_authorities));
+        engine::io::TlsWrapper::StartTlsServer(std::move(peer_socket),
+                                               *tls_context, {}));
   } else {
     socket = std::make_unique<engine::io::Socket>(std::move(peer_socket));
   }
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include <userver/concurrent/striped_counter.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -29,8 +30,40 @@ struct ParserStatsAggregation final {
   std::size_t parsing_request_count{0};
 };
 
+struct Http2Stats {
+  concurrent::StripedCounter connections_created;
+  concurrent::StripedCounter active_streams;
+  concurrent::StripedCounter streams_processed;
+  concurrent::StripedCounter streams_reset;
+};
+
+struct Http2StatsAggregation final {
+  Http2StatsAggregation() = default;
+
+  explicit Http2StatsAggregation(const Http2Stats& stats)
+      : connections_created{stats.connections_created.Read()},
+        active_streams{stats.active_streams.NonNegativeRead()},
+        streams_processed{stats.streams_processed.Read()},
+        streams_reset{stats.streams_reset.Read()} {}
+
+  Http2StatsAggregation& operator+=(const Http2StatsAggregation& other) {
+    connections_created += other.connections_created;
+    active_streams += other.active_streams;
+    streams_processed += other.streams_processed;
+    streams_reset += other.streams_reset;
+
+    return *this;
+  }
+
+  std::size_t connections_created{0};
+  std::size_t active_streams{0};
+  std::size_t streams_processed{0};
+  std::size_t streams_reset{0};
+};
+
 struct Stats {
   // per listener
+  utils::statistics::RateCounter connections_accepted;
   std::atomic<size_t> active_connections{0};
   std::atomic<size_t> connections_created{0};
   std::atomic<size_t> connections_closed{0};
@@ -39,20 +72,24 @@ struct Stats {
   ParserStats parser_stats;
   concurrent::StripedCounter active_request_count;
   concurrent::StripedCounter requests_processed_count;
+  Http2Stats http2_stats;
 };
 
 struct StatsAggregation final {
   StatsAggregation() = default;
 
   explicit StatsAggregation(const Stats& stats)
-      : active_connections{stats.active_connections.load()},
+      : connections_accepted{stats.connections_accepted.Load()},
+        active_connections{stats.active_connections.load()},
         connections_created{stats.connections_created.load()},
         connections_closed{stats.connections_closed.load()},
         parser_stats{stats.parser_stats},
         active_request_count{stats.active_request_count.NonNegativeRead()},
-        requests_processed_count{stats.requests_processed_count.Read()} {}
+        requests_processed_count{stats.requests_processed_count.Read()},
+        http2_stats{stats.http2_stats} {}
 
   StatsAggregation& operator+=(const StatsAggregation& other) {
+    connections_accepted += other.connections_accepted;
     active_connections += other.active_connections;
     connections_created += other.connections_created;
     connections_closed += other.connections_closed;
@@ -60,10 +97,12 @@ struct StatsAggregation final {
     parser_stats += other.parser_stats;
     active_request_count += other.active_request_count;
     requests_processed_count += other.requests_processed_count;
+    http2_stats += other.http2_stats;
 
     return *this;
   }
 
+  utils::statistics::Rate connections_accepted;
   std::size_t active_connections{0};
   std::size_t connections_created{0};
   std::size_t connections_closed{0};
@@ -72,6 +111,7 @@ struct StatsAggregation final {
   ParserStatsAggregation parser_stats;
   std::size_t active_request_count{0};
   std::size_t requests_processed_count{0};
+  Http2StatsAggregation http2_stats;
 };
 
 }  // namespace server::net
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <shared_mutex>
 #include <stdexcept>
+#include <string>
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
@@ -18,6 +19,7 @@
 #include <server/pph_config.hpp>
 #include <server/requests_view.hpp>
 #include <server/server_config.hpp>
+#include <userver/engine/io/tls_wrapper.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/server/middlewares/configuration.hpp>
 
@@ -61,9 +63,18 @@ void PortInfo::Init(const ServerConfig& config,
   endpoint_info_ =
       std::make_shared<net::EndpointInfo>(listener_config, *request_handler_);
 
+  // Each shard binds its own SO_REUSEPORT socket with a separate accept task,
+  // so the kernel spreads incoming connections between them
   const auto& event_thread_pool = task_processor.EventThreadPool();
   size_t listener_shards = listener_config.shards ? *listener_config.shards
                                                   : event_thread_pool.GetSize();
+  if (!listener_config.unix_socket_path.empty() && listener_shards > 1) {
+    // Binding a unix socket replaces the previous socket file, so only the
+    // last of the sockets would receive connections
+    LOG_INFO() << "Using a single acceptor for unix socket "
+               << listener_config.unix_socket_path;
+    listener_shards = 1;
+  }
 
   listeners_.reserve(listener_shards);
   while (listener_shards--) {
@@ -98,6 +109,71 @@ bool PortInfo::IsRunning() const noexcept {
   return request_handler_ && request_handler_->IsAddHandlerDisabled();
 }
 
+// Reads the certificate, the private key and the certificate authorities of
+// the listener from the files
+engine::io::TlsServerContext::Settings MakeTlsSettings(
+    const net::ListenerConfig& listener_config,
+    const storages::secdist::SecdistConfig& secdist) {
+  engine::io::TlsServerContext::Settings settings;
+  settings.cert = crypto::Certificate::LoadFromString(
+      fs::blocking::ReadFileContents(listener_config.tls_cert_path));
+
+  auto contents =
+      fs::blocking::ReadFileContents(listener_config.tls_private_key_path);
+  auto pph = secdist.Get<PassphraseConfig>().GetPassphrase(
+      listener_config.tls_private_key_passphrase_name);
+  settings.key =
+      crypto::PrivateKey::LoadFromString(contents, pph.GetUnderlying());
+
+  for (const auto& ca_path :
+       listener_config.tls_certificate_authorities_paths) {
+    settings.cert_authorities.push_back(crypto::Certificate::LoadFromString(
+        fs::blocking::ReadFileContents(ca_path)));
+  }
+  if (listener_config.connection_config.http2.enabled) {
+    settings.alpn_protocols = {"h2", "http/1.1"};
+  }
+  settings.session_tickets = listener_config.tls_session_tickets;
+  settings.session_cache_size = listener_config.tls_session_cache_size;
+  return settings;
+}
+
+// Loads the private key and builds the TLS context shared by all the
+// connections of the listener
+void InitTls(net::ListenerConfig& listener_config,
+             const storages::secdist::SecdistConfig& secdist) {
+  if (!listener_config.tls) return;
+
+  auto settings = MakeTlsSettings(listener_config, secdist);
+  listener_config.tls_private_key = settings.key;
+  listener_config.tls_context =
+      std::make_shared<engine::io::TlsServerContext>(settings);
+}
+
+// Rereads the TLS files for new connections, established ones are not affected
+void ReloadListenerTls(const net::ListenerConfig& listener_config,
+                       const storages::secdist::SecdistConfig& secdist) {
+  if (!listener_config.tls_context) return;
+
+  try {
+    listener_config.tls_context->Reload(
+        MakeTlsSettings(listener_config, secdist));
+  } catch (const std::exception& e) {
+    LOG_ERROR() << "Failed to reload TLS certificate and private key, the "
+                   "previous ones are still in use: "
+                << e;
+  }
+}
+
+void AccountTlsHandshakes(const net::ListenerConfig& listener_config,
+                          engine::io::TlsServerContext::HandshakeStats& stats) {
+  if (!listener_config.tls_context) return;
+
+  const auto listener_stats = listener_config.tls_context->GetHandshakeStats();
+  stats.full += listener_stats.full;
+  stats.resumed += listener_stats.resumed;
+}
+
 }  // namespace
 
 class ServerImpl final {
@@ -117,6 +193,7 @@ class ServerImpl final {
   std::chrono::milliseconds GetAvgRequestTimeMs() const;
   const http::HttpRequestHandler& GetHttpRequestHandler(bool is_monitor) const;
   net::StatsAggregation GetServerStats() const;
+  void WriteAcceptorStatistics(utils::statistics::Writer& writer) const;
   const ServerConfig& GetServerConfig() const { return config_; }
   const std::vector<std::string>& GetMiddlewares() const;
 
@@ -127,6 +204,9 @@ class ServerImpl final {
   void SetRpsRatelimit(std::optional<size_t> rps);
   std::uint64_t GetTotalRequests() const;
 
+  void ReloadTls(const storages::secdist::SecdistConfig& secdist);
+  engine::io::TlsServerContext::HandshakeStats GetTlsHandshakeStats() const;
+
  private:
   PortInfo main_port_info_;
   PortInfo monitor_port_info_;
@@ -149,13 +229,9 @@ ServerImpl::ServerImpl(ServerConfig config,
     : config_(std::move(config)) {
   LOG_DEBUG() << "Creating server";
 
-  if (config_.listener.tls) {
-    auto contents =
-        fs::blocking::ReadFileContents(config_.listener.tls_private_key_path);
-    auto pph = secdist.Get<PassphraseConfig>().GetPassphrase(
-        config_.listener.tls_private_key_passphrase_name);
-    config_.listener.tls_private_key =
-        crypto::PrivateKey::LoadFromString(contents, pph.GetUnderlying());
+  InitTls(config_.listener, secdist);
+  if (config_.monitor_listener) {
+    InitTls(*config_.monitor_listener, secdist);
   }
 
   main_port_info_.Init(config_, config_.listener, component_context, false);
@@ -273,6 +349,19 @@ net::StatsAggregation ServerImpl::GetServerStats() const {
   return summary;
 }
 
+void ServerImpl::WriteAcceptorStatistics(
+    utils::statistics::Writer& writer) const {
+  std::shared_lock lock{on_stop_mutex_};
+  if (is_stopping_) return;
+
+  const auto& listeners = main_port_info_.listeners_;
+  for (std::size_t i = 0; i < listeners.size(); ++i) {
+    writer["accepted"].ValueWithLabels(
+        listeners[i].GetStats().connections_accepted,
+        {"acceptor", std::to_string(i)});
+  }
+}
+
 const std::vector<std::string>& ServerImpl::GetMiddlewares() const {
   return middlewares_;
 }
@@ -329,6 +418,23 @@ std::uint64_t ServerImpl::GetTotalRequests() const {
   return stats.active_request_count + stats.requests_processed_count;
 }
 
+void ServerImpl::ReloadTls(const storages::secdist::SecdistConfig& secdist) {
+  ReloadListenerTls(config_.listener, secdist);
+  if (config_.monitor_listener) {
+    ReloadListenerTls(*config_.monitor_listener, secdist);
+  }
+}
+
+engine::io::TlsServerContext::HandshakeStats ServerImpl::GetTlsHandshakeStats()
+    const {
+  engine::io::TlsServerContext::HandshakeStats stats;
+  AccountTlsHandshakes(config_.listener, stats);
+  if (config_.monitor_listener) {
+    AccountTlsHandshakes(*config_.monitor_listener, stats);
+  }
+  return stats;
+}
+
 Server::Server(ServerConfig config,
                const storages::secdist::SecdistConfig& secdist,
                const components::ComponentContext& component_context)
@@ -353,6 +459,24 @@ void Server::WriteMonitorData(utils::statistics::Writer& writer) const {
     conn_stats["closed"] = server_stats.connections_closed;
   }
 
+  if (auto acceptor_stats = writer["acceptors"]) {
+    pimpl->WriteAcceptorStatistics(acceptor_stats);
+  }
+
+  if (auto tls_stats = writer["tls"]) {
+    const auto handshakes = pimpl->GetTlsHandshakeStats();
+    tls_stats["handshakes"]["full"] = handshakes.full;
+    tls_stats["handshakes"]["resumed"] = handshakes.resumed;
+  }
+
+  if (auto http2_stats = writer["http2"]) {
+    const auto& stats = server_stats.http2_stats;
+    http2_stats["connections"]["opened"] = stats.connections_created;
+    http2_stats["streams"]["active"] = stats.active_streams;
+    http2_stats["streams"]["processed"] = stats.streams_processed;
+    http2_stats["streams"]["reset"] = stats.streams_reset;
+  }
+
   if (auto request_stats = writer["requests"]) {
     request_stats["active"] = server_stats.active_request_count;
     request_stats["avg-lifetime-ms"] = pimpl->GetAvgRequestTimeMs().count();
@@ -392,6 +516,10 @@ void Server::Start() {
 
 void Server::Stop() { pimpl->Stop(); }
 
+void Server::ReloadTls(const storages::secdist::SecdistConfig& secdist) {
+  pimpl->ReloadTls(secdist);
+}
+
 RequestsView& Server::GetRequestsView() { return pimpl->GetRequestsView(); }
 
 void Server::SetRpsRatelimit(std::optional<size_t> rps) {
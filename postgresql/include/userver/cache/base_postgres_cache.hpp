@@ -17,6 +17,7 @@
 #include <userver/cache/caching_component_base.hpp>
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
@@ -26,6 +27,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/utils/meta.hpp>
 #include <userver/utils/void_t.hpp>
@@ -66,6 +68,8 @@ namespace components {
 /// incremental-update-op-timeout | timeout for an incremental update | 1s
 /// update-correction | incremental update window adjustment | - (0 for caches with defined GetLastKnownUpdated)
 /// chunk-size | number of rows to request from PostgreSQL via portals, 0 to fetch all rows in one request without portals | 1000
+/// full-update-partitions | number of partitions to fetch in parallel on a full update, requires `kFullUpdatePartitionKey` in policy; 0 or 1 to fetch the data with a single query | 0
+/// full-update-spread-replicas | use the round-robin host selection for the partitions to spread them across the replicas | false
 ///
 /// @section pg_cc_cache_policy Cache policy
 ///
@@ -97,6 +101,50 @@ namespace components {
 ///
 /// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Custom Container With Write Notification Example
 ///
+/// @section pg_cc_partitioned Partitioned full updates
+///
+/// Full updates of big caches may be split into `full-update-partitions`
+/// queries that are executed in parallel on different connections. Policy
+/// must define `kFullUpdatePartitionKey`, an integer SQL expression that
+/// distributes rows among the partitions; a row goes to partition
+/// `abs(kFullUpdatePartitionKey % full-update-partitions)`, rows with NULL
+/// keys go to partition 0. Use a hash function, e.g. `hashtext(name)`, for
+/// keys that are not integers.
+///
+/// Each partition decodes a received chunk while fetching the next one. The
+/// decoded rows are inserted into the cache container in the updating task.
+/// Time the updating task spends on waiting for the partitions is reported in
+/// cache statistics as `last-update-fetch-duration-ms`. The decoding time
+/// summed over the partitions and the time of filling the container are
+/// reported as `last-update-parse-duration-ms`.
+///
+/// @note Every partition holds a connection for the duration of the update,
+/// make sure the connection pool is big enough.
+///
+/// @section pg_cc_notifications Updates on notifications
+///
+/// Policy may define `kNotifyChannel` to make the cache LISTEN on that
+/// channel on the master host of every shard. A notification on the channel
+/// triggers an update of the cache as soon as possible, an incremental one if
+/// incremental updates are allowed. Notifications that arrive while an update
+/// is in progress are coalesced into a single update after it. The periodic
+/// updates are still performed, so `update-interval` may be increased to
+/// serve as a fallback for missed notifications. For example, the following
+/// trigger notifies the cache on every change of the table:
+///
+/// @code{.sql}
+/// create function test.notify_my_data() returns trigger as $$
+/// begin
+///   perform pg_notify('my_data_changed', null);
+///   return null;
+/// end;
+/// $$ language plpgsql;
+///
+/// create trigger my_data_changed
+/// after insert or update or delete on test.my_data
+/// for each statement execute function test.notify_my_data();
+/// @endcode
+///
 /// @section pg_cc_forward_declaration Forward Declaration
 ///
 /// To forward declare a cache you can forward declare a trait and
@@ -161,6 +209,20 @@ using HasWhere = decltype(T::kWhere);
 template <typename T>
 inline constexpr bool kHasWhere = meta::kIsDetected<HasWhere, T>;
 
+// Component kFullUpdatePartitionKey in policy
+template <typename T>
+using HasFullUpdatePartitionKey = decltype(T::kFullUpdatePartitionKey);
+template <typename T>
+inline constexpr bool kHasFullUpdatePartitionKey =
+    meta::kIsDetected<HasFullUpdatePartitionKey, T>;
+
+// Component kNotifyChannel in policy
+template <typename T>
+using HasNotifyChannel = decltype(T::kNotifyChannel);
+template <typename T>
+inline constexpr bool kHasNotifyChannel =
+    meta::kIsDetected<HasNotifyChannel, T>;
+
 // Update field
 template <typename T>
 using HasUpdatedField = decltype(T::kUpdatedField);
@@ -357,17 +419,49 @@ struct PolicyChecker {
       CachingComponentBase<DataCacheContainerType<PostgreCachePolicy>>;
 };
 
+// Query of a partition of a full update, the number of partitions is bound
+// as $1 and the index of the partition as $2
+template <typename PostgreCachePolicy>
+storages::postgres::Query GetPartitionQuery() {
+  static_assert(kHasFullUpdatePartitionKey<PostgreCachePolicy>);
+  storages::postgres::Query query =
+      PolicyChecker<PostgreCachePolicy>::GetQuery();
+  const auto partition_filter =
+      fmt::format("abs(coalesce(({}), 0) % $1) = $2",
+                  PostgreCachePolicy::kFullUpdatePartitionKey);
+
+  if constexpr (kHasWhere<PostgreCachePolicy>) {
+    return {fmt::format("{} where ({}) and {}", query.Statement(),
+                        PostgreCachePolicy::kWhere, partition_filter),
+            query.GetName()};
+  } else {
+    return {fmt::format("{} where {}", query.Statement(), partition_filter),
+            query.GetName()};
+  }
+}
+
 inline constexpr std::chrono::minutes kDefaultFullUpdateTimeout{1};
 inline constexpr std::chrono::seconds kDefaultIncrementalUpdateTimeout{1};
 inline constexpr std::chrono::milliseconds kStatementTimeoutOff{0};
 inline constexpr std::chrono::milliseconds kCpuRelaxThreshold{10};
 inline constexpr std::chrono::milliseconds kCpuRelaxInterval{2};
+inline constexpr std::chrono::minutes kNotifyWaitTimeout{1};
+inline constexpr std::chrono::seconds kListenRetryInterval{1};
 
 inline constexpr std::string_view kCopyStage = "copy_data";
 inline constexpr std::string_view kFetchStage = "fetch";
 inline constexpr std::string_view kParseStage = "parse";
 
 inline constexpr std::size_t kDefaultChunkSize = 1000;
+
+// LISTENs on the channel on the master of the cluster and requests an update
+// of the cache of the given type on every notification. Re-subscribes if
+// the connection is lost and requests an update, as the notifications sent
+// meanwhile are lost. Returns when the task is cancelled.
+void ListenNotifications(storages::postgres::Cluster& cluster,
+                         std::string_view channel,
+                         cache::CacheUpdateTrait& cache,
+                         cache::UpdateType update_type);
 }  // namespace pg_cache::detail
 
 /// @ingroup userver_components
@@ -420,8 +514,19 @@ class PostgreCache final
                     cache::UpdateStatisticsScope& stats_scope,
                     tracing::ScopeTime& scope);
 
+  std::size_t UpdatePartitioned(CachedData& data_cache,
+                                cache::UpdateStatisticsScope& stats_scope,
+                                tracing::ScopeTime& scope);
+  std::vector<ValueType> FetchPartition(
+      storages::postgres::Cluster& cluster, std::size_t partition,
+      cache::UpdateStatisticsScope& stats_scope) const;
+  void DecodeResults(storages::postgres::ResultSet res,
+                     std::vector<ValueType>& values,
+                     cache::UpdateStatisticsScope& stats_scope) const;
+
   static storages::postgres::Query GetAllQuery();
   static storages::postgres::Query GetDeltaQuery();
+  static storages::postgres::Query GetPartitionQuery();
 
   std::chrono::milliseconds ParseCorrection(const ComponentConfig& config);
 
@@ -431,8 +536,11 @@ class PostgreCache final
   const std::chrono::milliseconds full_update_timeout_;
   const std::chrono::milliseconds incremental_update_timeout_;
   const std::size_t chunk_size_;
+  const std::size_t full_update_partitions_;
+  const storages::postgres::ClusterHostTypeFlags partition_host_type_flags_;
   std::size_t cpu_relax_iterations_parse_{0};
   std::size_t cpu_relax_iterations_copy_{0};
+  std::vector<engine::TaskWithResult<void>> listen_tasks_;
 };
 
 template <typename PostgreCachePolicy>
@@ -450,7 +558,15 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
           config["incremental-update-op-timeout"].As<std::chrono::milliseconds>(
               pg_cache::detail::kDefaultIncrementalUpdateTimeout)},
       chunk_size_{config["chunk-size"].As<size_t>(
-          pg_cache::detail::kDefaultChunkSize)} {
+          pg_cache::detail::kDefaultChunkSize)},
+      full_update_partitions_{
+          config["full-update-partitions"].As<size_t>(0)},
+      partition_host_type_flags_{
+          config["full-update-spread-replicas"].As<bool>(false)
+              ? (kClusterHostTypeFlags &
+                 storages::postgres::kClusterHostRolesMask) |
+                    storages::postgres::ClusterHostType::kRoundRobin
+              : kClusterHostTypeFlags} {
   UINVARIANT(
       !chunk_size_ || storages::postgres::Portal::IsSupportedByDriver(),
       "Either set 'chunk-size' to 0, or enable PostgreSQL portals by building "
@@ -464,6 +580,13 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
         "name is specified in traits of '" +
         config.Name() + "' cache");
   }
+  if (full_update_partitions_ > 1 &&
+      !pg_cache::detail::kHasFullUpdatePartitionKey<PostgreCachePolicy>) {
+    throw std::logic_error(
+        "Partitioned full updates are requested in config but no partition "
+        "key is specified in traits of '" +
+        config.Name() + "' cache");
+  }
   if (correction_.count() < 0) {
     throw std::logic_error(
         "Refusing to set forward (negative) update correction requested in "
@@ -486,12 +609,38 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
   LOG_INFO() << "Cache " << kName << " full update query `"
              << GetAllQuery().Statement() << "` incremental update query `"
              << GetDeltaQuery().Statement() << "`";
+  if (full_update_partitions_ > 1) {
+    LOG_INFO() << "Cache " << kName << " full update is split into "
+               << full_update_partitions_ << " partitions with query `"
+               << GetPartitionQuery().Statement() << "`";
+  }
 
   this->StartPeriodicUpdates();
+
+  if constexpr (pg_cache::detail::kHasNotifyChannel<PostgreCachePolicy>) {
+    const auto update_type =
+        kIncrementalUpdates && this->GetAllowedUpdateTypes() !=
+                                   cache::AllowedUpdateTypes::kOnlyFull
+            ? cache::UpdateType::kIncremental
+            : cache::UpdateType::kFull;
+    cache::CacheUpdateTrait* update_trait = this;
+    for (const auto& cluster : clusters_) {
+      listen_tasks_.push_back(utils::CriticalAsync(
+          "pg-cache-listen/" + config.Name(),
+          [cluster, update_trait, update_type] {
+            pg_cache::detail::ListenNotifications(
+                *cluster, PostgreCachePolicy::kNotifyChannel, *update_trait,
+                update_type);
+          }));
+    }
+  }
 }
 
 template <typename PostgreCachePolicy>
 PostgreCache<PostgreCachePolicy>::~PostgreCache() {
+  for (auto& task : listen_tasks_) {
+    task.SyncCancel();
+  }
   this->StopPeriodicUpdates();
 }
 
@@ -527,6 +676,17 @@ storages::postgres::Query PostgreCache<PostgreCachePolicy>::GetDeltaQuery() {
   }
 }
 
+template <typename PostgreCachePolicy>
+storages::postgres::Query
+PostgreCache<PostgreCachePolicy>::GetPartitionQuery() {
+  if constexpr (pg_cache::detail::kHasFullUpdatePartitionKey<
+                    PostgreCachePolicy>) {
+    return pg_cache::detail::GetPartitionQuery<PostgreCachePolicy>();
+  } else {
+    return GetAllQuery();
+  }
+}
+
 template <typename PostgreCachePolicy>
 std::chrono::milliseconds PostgreCache<PostgreCachePolicy>::ParseCorrection(
     const ComponentConfig& config) {
@@ -576,46 +736,51 @@ void PostgreCache<PostgreCachePolicy>::Update(
   scope.Reset(std::string{pg_cache::detail::kFetchStage});
 
   size_t changes = 0;
-  // Iterate clusters
-  for (auto& cluster : clusters_) {
-    if (chunk_size_ > 0) {
-      auto trx = cluster->Begin(
-          kClusterHostTypeFlags, pg::Transaction::RO,
-          pg::CommandControl{timeout, pg_cache::detail::kStatementTimeoutOff});
-      auto portal =
-          trx.MakePortal(query, GetLastUpdated(last_update, *data_cache));
-      while (portal) {
-        scope.Reset(std::string{pg_cache::detail::kFetchStage});
-        auto res = portal.Fetch(chunk_size_);
+  if (type == cache::UpdateType::kFull && full_update_partitions_ > 1) {
+    changes = UpdatePartitioned(data_cache, stats_scope, scope);
+  } else {
+    const pg::CommandControl cmd_ctl{timeout,
+                                     pg_cache::detail::kStatementTimeoutOff};
+    // Iterate clusters
+    for (auto& cluster : clusters_) {
+      if (chunk_size_ > 0) {
+        auto trx =
+            cluster->Begin(kClusterHostTypeFlags, pg::Transaction::RO, cmd_ctl);
+        auto portal =
+            trx.MakePortal(query, GetLastUpdated(last_update, *data_cache));
+        while (portal) {
+          scope.Reset(std::string{pg_cache::detail::kFetchStage});
+          auto res = portal.Fetch(chunk_size_);
+          stats_scope.IncreaseDocumentsReadCount(res.Size());
+
+          scope.Reset(std::string{pg_cache::detail::kParseStage});
+          CacheResults(res, data_cache, stats_scope, scope);
+          changes += res.Size();
+        }
+        trx.Commit();
+      } else {
+        bool has_parameter = query.Statement().find('$') != std::string::npos;
+        auto res = has_parameter
+                       ? cluster->Execute(
+                             kClusterHostTypeFlags, cmd_ctl, query,
+                             GetLastUpdated(last_update, *data_cache))
+                       : cluster->Execute(kClusterHostTypeFlags, cmd_ctl,
+                                          query);
         stats_scope.IncreaseDocumentsReadCount(res.Size());
 
         scope.Reset(std::string{pg_cache::detail::kParseStage});
         CacheResults(res, data_cache, stats_scope, scope);
         changes += res.Size();
       }
-      trx.Commit();
-    } else {
-      bool has_parameter = query.Statement().find('$') != std::string::npos;
-      auto res = has_parameter
-                     ? cluster->Execute(
-                           kClusterHostTypeFlags,
-                           pg::CommandControl{
-                               timeout, pg_cache::detail::kStatementTimeoutOff},
-                           query, GetLastUpdated(last_update, *data_cache))
-                     : cluster->Execute(
-                           kClusterHostTypeFlags,
-                           pg::CommandControl{
-                               timeout, pg_cache::detail::kStatementTimeoutOff},
-                           query);
-      stats_scope.IncreaseDocumentsReadCount(res.Size());
-
-      scope.Reset(std::string{pg_cache::detail::kParseStage});
-      CacheResults(res, data_cache, stats_scope, scope);
-      changes += res.Size();
     }
   }
 
   scope.Reset();
+  stats_scope.SetStageDurations(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          scope.ElapsedTotal(std::string{pg_cache::detail::kFetchStage})),
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          scope.ElapsedTotal(std::string{pg_cache::detail::kParseStage})));
 
   if constexpr (pg_cache::detail::kIsContainerCopiedByElement<DataType>) {
     if (old_size > 0) {
@@ -682,6 +847,103 @@ void PostgreCache<PostgreCachePolicy>::CacheResults(
   }
 }
 
+template <typename PostgreCachePolicy>
+std::size_t PostgreCache<PostgreCachePolicy>::UpdatePartitioned(
+    CachedData& data_cache, cache::UpdateStatisticsScope& stats_scope,
+    tracing::ScopeTime& scope) {
+  std::vector<engine::TaskWithResult<std::vector<ValueType>>> tasks;
+  tasks.reserve(clusters_.size() * full_update_partitions_);
+  for (auto& cluster : clusters_) {
+    for (std::size_t i = 0; i < full_update_partitions_; ++i) {
+      tasks.push_back(utils::Async(
+          "pg_cache_fetch_partition",
+          [this, &cluster, i, &stats_scope] {
+            return FetchPartition(*cluster, i, stats_scope);
+          }));
+    }
+  }
+
+  // Partitions are merged in order, the rest keep fetching meanwhile
+  size_t changes = 0;
+  for (auto& task : tasks) {
+    scope.Reset(std::string{pg_cache::detail::kFetchStage});
+    auto values = task.Get();
+
+    scope.Reset(std::string{pg_cache::detail::kParseStage});
+    utils::CpuRelax relax{cpu_relax_iterations_parse_, &scope};
+    for (auto& value : values) {
+      relax.Relax();
+      using pg_cache::detail::CacheInsertOrAssign;
+      CacheInsertOrAssign(*data_cache, std::move(value),
+                          PostgreCachePolicy::kKeyMember);
+    }
+    changes += values.size();
+  }
+  return changes;
+}
+
+template <typename PostgreCachePolicy>
+std::vector<typename PostgreCache<PostgreCachePolicy>::ValueType>
+PostgreCache<PostgreCachePolicy>::FetchPartition(
+    storages::postgres::Cluster& cluster, std::size_t partition,
+    cache::UpdateStatisticsScope& stats_scope) const {
+  namespace pg = storages::postgres;
+  const auto query = GetPartitionQuery();
+  const pg::CommandControl cmd_ctl{full_update_timeout_,
+                                   pg_cache::detail::kStatementTimeoutOff};
+  const auto partitions = static_cast<pg::Bigint>(full_update_partitions_);
+  const auto partition_index = static_cast<pg::Bigint>(partition);
+
+  std::vector<ValueType> values;
+  if (chunk_size_ == 0) {
+    auto res = cluster.Execute(partition_host_type_flags_, cmd_ctl, query,
+                               partitions, partition_index);
+    stats_scope.IncreaseDocumentsReadCount(res.Size());
+    DecodeResults(std::move(res), values, stats_scope);
+    return values;
+  }
+
+  auto trx = cluster.Begin(partition_host_type_flags_, pg::Transaction::RO,
+                           cmd_ctl);
+  auto portal = trx.MakePortal(query, partitions, partition_index);
+  // A chunk is decoded while the next one is being fetched
+  engine::TaskWithResult<void> decode;
+  while (portal) {
+    auto res = portal.Fetch(chunk_size_);
+    stats_scope.IncreaseDocumentsReadCount(res.Size());
+
+    if (decode.IsValid()) decode.Get();
+    decode = utils::Async(
+        "pg_cache_decode", [this, res = std::move(res), &values, &stats_scope] {
+          DecodeResults(res, values, stats_scope);
+        });
+  }
+  if (decode.IsValid()) decode.Get();
+  trx.Commit();
+  return values;
+}
+
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::DecodeResults(
+    storages::postgres::ResultSet res, std::vector<ValueType>& values,
+    cache::UpdateStatisticsScope& stats_scope) const {
+  const auto start = std::chrono::steady_clock::now();
+  auto rows = res.AsSetOf<RawValueType>(storages::postgres::kRowTag);
+  values.reserve(values.size() + rows.Size());
+  utils::CpuRelax relax{cpu_relax_iterations_parse_, nullptr};
+  for (auto p = rows.begin(); p != rows.end(); ++p) {
+    relax.Relax();
+    try {
+      values.push_back(pg_cache::detail::ExtractValue<PostgreCachePolicy>(*p));
+    } catch (const std::exception& e) {
+      stats_scope.IncreaseDocumentsParseFailures(1);
+      LOG_ERROR() << "Error parsing data row in cache '" << kName << "' to '"
+                  << compiler::GetTypeName<ValueType>() << "': " << e.what();
+    }
+  }
+  stats_scope.AddParseDuration(std::chrono::steady_clock::now() - start);
+}
+
 template <typename PostgreCachePolicy>
 typename PostgreCache<PostgreCachePolicy>::CachedData
 PostgreCache<PostgreCachePolicy>::GetDataSnapshot(cache::UpdateType type,
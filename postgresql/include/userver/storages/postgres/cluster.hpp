@@ -4,6 +4,7 @@
 /// @brief @copybrief storages::postgres::Cluster
 
 #include <memory>
+#include <optional>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/dynamic_config/source.hpp>
@@ -12,14 +13,17 @@
 #include <userver/error_injection/settings_fwd.hpp>
 #include <userver/testsuite/postgres_control.hpp>
 #include <userver/testsuite/tasks.hpp>
+#include <userver/utils/function_ref.hpp>
 
 #include <userver/storages/postgres/cluster_types.hpp>
 #include <userver/storages/postgres/database.hpp>
 #include <userver/storages/postgres/detail/non_transaction.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/query.hpp>
 #include <userver/storages/postgres/query_queue.hpp>
+#include <userver/storages/postgres/result_stream.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/storages/postgres/transaction.hpp>
 
@@ -187,6 +191,11 @@ class Cluster {
   /// control settings.
   /// @note You must specify at least one role from ClusterHostType here
   ///
+  /// If query batching is enabled in ClusterSettings and the statement is
+  /// executed on a slave, it is sent along with the statements of other tasks
+  /// over one of a few pipelined connections, see QueryBatchingSettings.
+  /// Statements that end up on the master are never batched.
+  ///
   /// @warning Do NOT create a query string manually by embedding arguments!
   /// It leads to vulnerabilities and bad performance. Either pass arguments
   /// separately, or use storages::postgres::ParameterScope.
@@ -204,6 +213,25 @@ class Cluster {
   ResultSet Execute(ClusterHostTypeFlags flags,
                     OptionalCommandControl statement_cmd_ctl,
                     const Query& query, const ParameterStore& store);
+
+  /// @brief Execute a statement at host of specified type and return a stream
+  /// of its result rows, see ResultStream.
+  /// @note You must specify at least one role from ClusterHostType here
+  ///
+  /// The stream owns a connection taken from the pool until it is destroyed.
+  template <typename... Args>
+  ResultStream Stream(ClusterHostTypeFlags, const Query& query,
+                      const Args&... args);
+
+  /// @brief Execute a statement with specified host selection rules and command
+  /// control settings and return a stream of its result rows, see
+  /// ResultStream.
+  /// @note You must specify at least one role from ClusterHostType here
+  ///
+  /// The stream owns a connection taken from the pool until it is destroyed.
+  template <typename... Args>
+  ResultStream Stream(ClusterHostTypeFlags, OptionalCommandControl,
+                      const Query& query, const Args&... args);
   /// @}
 
   /// @brief Listen for notifications on channel
@@ -240,8 +268,17 @@ class Cluster {
   void SetStatementMetricsSettings(const StatementMetricsSettings& settings);
 
  private:
+  using ParamsWriter =
+      USERVER_NAMESPACE::utils::function_ref<detail::DynamicQueryParameters(
+          const UserTypes&)>;
+
   detail::NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
 
+  bool IsQueryBatchingEnabled(ClusterHostTypeFlags flags) const;
+  std::optional<ResultSet> ExecuteBatched(
+      ClusterHostTypeFlags flags, OptionalCommandControl statement_cmd_ctl,
+      const Query& query, ParamsWriter params_writer);
+
   OptionalCommandControl GetQueryCmdCtl(const std::string& query_name) const;
   OptionalCommandControl GetHandlersCmdCtl(
       OptionalCommandControl cmd_ctl) const;
@@ -263,10 +300,37 @@ ResultSet Cluster::Execute(ClusterHostTypeFlags flags,
     statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
   }
   statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
+  if (IsQueryBatchingEnabled(flags)) {
+    auto result = ExecuteBatched(flags, statement_cmd_ctl, query,
+                                 [&args...](const UserTypes& types) {
+                                   detail::DynamicQueryParameters params;
+                                   params.Write(types, args...);
+                                   return params;
+                                 });
+    if (result) return std::move(*result);
+  }
   auto ntrx = Start(flags, statement_cmd_ctl);
   return ntrx.Execute(statement_cmd_ctl, query, args...);
 }
 
+template <typename... Args>
+ResultStream Cluster::Stream(ClusterHostTypeFlags flags, const Query& query,
+                             const Args&... args) {
+  return Stream(flags, OptionalCommandControl{}, query, args...);
+}
+
+template <typename... Args>
+ResultStream Cluster::Stream(ClusterHostTypeFlags flags,
+                             OptionalCommandControl statement_cmd_ctl,
+                             const Query& query, const Args&... args) {
+  if (!statement_cmd_ctl && query.GetName()) {
+    statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
+  }
+  statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
+  return Start(flags, statement_cmd_ctl)
+      .Stream(statement_cmd_ctl, query, args...);
+}
+
 }  // namespace storages::postgres
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,241 @@
+#pragma once
+
+/// @file userver/storages/postgres/copy.hpp
+/// @brief Binary COPY data streams
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/io/field_buffer.hpp>
+#include <userver/storages/postgres/io/row_types.hpp>
+#include <userver/storages/postgres/io/supported_types.hpp>
+#include <userver/storages/postgres/io/traits.hpp>
+#include <userver/storages/postgres/io/type_traits.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/storages/postgres/query.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+class UserTypes;
+
+namespace detail {
+
+/// Appends the binary COPY file header to the buffer
+void WriteCopyHeader(std::string& buffer);
+
+/// Appends the binary COPY file trailer to the buffer
+void WriteCopyTrailer(std::string& buffer);
+
+/// Skips the binary COPY file header at the beginning of the buffer
+/// @throws InvalidBinaryBuffer if the header is malformed
+void ReadCopyHeader(io::FieldBuffer& buffer);
+
+/// Reads the field count of a binary COPY tuple, returns false for the file
+/// trailer
+/// @throws InvalidTupleSizeRequested if the tuple contains a different number
+/// of fields
+bool ReadCopyTupleHeader(io::FieldBuffer& buffer, std::size_t field_count);
+
+/// Appends a tuple in binary COPY format to the buffer
+template <typename... Fields>
+void WriteCopyTuple(const UserTypes& types, std::string& buffer,
+                    const Fields&... fields) {
+  io::WriteBuffer(types, buffer, static_cast<Smallint>(sizeof...(Fields)));
+  (io::WriteRawBinary(types, buffer, fields), ...);
+}
+
+/// Reads fields of a binary COPY tuple, the tuple header must be already
+/// consumed with ReadCopyTupleHeader
+template <typename... Fields>
+void ReadCopyTuple(io::FieldBuffer& buffer,
+                   const io::TypeBufferCategory& categories,
+                   Fields&... fields) {
+  (buffer.ReadRaw(fields, categories,
+                  io::traits::kTypeBufferCategory<std::decay_t<Fields>>),
+   ...);
+  if (buffer.length != 0) {
+    throw InvalidBinaryBuffer{"Unexpected data after the COPY tuple"};
+  }
+}
+
+}  // namespace detail
+
+// clang-format off
+/// @brief Writer of rows into a `COPY ... FROM STDIN (FORMAT binary)`
+/// statement.
+///
+/// Created by Transaction::CopyIn. Rows are serialized with the same
+/// io::BufferFormatter specializations that are used for query parameters, so
+/// any type that can be passed to Transaction::Execute can be a field.
+///
+/// Rows are accumulated in a buffer and sent to the server in chunks. Sending a
+/// chunk suspends the coroutine until the connection socket accepts the data,
+/// so a slow server throttles the producer instead of growing the buffers.
+///
+/// Finish must be called to complete the COPY. If the stream is destroyed
+/// without Finish, the COPY is aborted and the transaction fails.
+///
+/// @par Usage synopsis
+/// @code
+/// auto trx = cluster->Begin(/* transaction options */);
+/// auto copy = trx.CopyIn("COPY foobar (foo, bar) FROM STDIN (FORMAT binary)");
+/// for (const auto& item : items) {
+///   copy.WriteFields(item.foo, item.bar);
+/// }
+/// copy.Finish();
+/// trx.Commit();
+/// @endcode
+// clang-format on
+class CopyInStream {
+ public:
+  /// Default size of the data chunks sent to the server
+  static constexpr std::size_t kDefaultChunkSize = 64 * 1024;
+
+  /// @cond
+  CopyInStream(detail::Connection* conn, const Query& query,
+               OptionalCommandControl cmd_ctl = {},
+               std::size_t chunk_size = kDefaultChunkSize);
+  /// @endcond
+
+  CopyInStream(CopyInStream&&) noexcept;
+  CopyInStream& operator=(CopyInStream&&) = delete;
+
+  CopyInStream(const CopyInStream&) = delete;
+  CopyInStream& operator=(const CopyInStream&) = delete;
+
+  ~CopyInStream();
+
+  /// Write a row. The row type must be a tuple, an aggregate or a type with
+  /// an Introspect method, see @ref pg_user_row_types
+  template <typename Row>
+  void WriteRow(const Row& row) {
+    io::traits::AssertIsValidRowType<Row>();
+    using RowType = io::RowType<Row>;
+    std::apply(
+        [this](const auto&... fields) { WriteFields(fields...); },
+        RowType::GetTuple(row));
+  }
+
+  /// Write a row consisting of the fields
+  template <typename... Fields>
+  void WriteFields(const Fields&... fields) {
+    detail::WriteCopyTuple(GetUserTypes(), buffer_, fields...);
+    ++rows_written_;
+    if (buffer_.size() >= chunk_size_) {
+      SendBuffer();
+    }
+  }
+
+  /// Write all rows of the container
+  template <typename Container>
+  void WriteRows(const Container& rows) {
+    for (const auto& row : rows) {
+      WriteRow(row);
+    }
+  }
+
+  /// Send the rest of the data and complete the COPY.
+  /// Suspends coroutine until command complete.
+  /// @returns the number of rows processed by the server
+  std::size_t Finish();
+
+  /// Number of rows written to the stream so far
+  std::size_t RowsWritten() const { return rows_written_; }
+
+ private:
+  const UserTypes& GetUserTypes() const;
+  void SendBuffer();
+
+  detail::Connection* conn_;
+  std::string buffer_;
+  std::size_t chunk_size_;
+  std::size_t rows_written_{0};
+};
+
+// clang-format off
+/// @brief Reader of rows from a `COPY ... TO STDOUT (FORMAT binary)`
+/// statement.
+///
+/// Created by Transaction::CopyOut. Fields are parsed with the same
+/// io::BufferParser specializations that are used for result sets. Rows are
+/// received from the server one at a time, reading suspends the coroutine
+/// until the next row arrives.
+///
+/// All the rows must be read before the connection can be used for another
+/// query. If the stream is destroyed earlier, the transaction can only be
+/// rolled back.
+///
+/// @par Usage synopsis
+/// @code
+/// auto trx = cluster->Begin(/* transaction options */);
+/// auto copy = trx.CopyOut("COPY foobar (foo, bar) TO STDOUT (FORMAT binary)");
+/// MyRow row;
+/// while (copy.ReadRow(row)) {
+///   DoSomething(row);
+/// }
+/// trx.Commit();
+/// @endcode
+// clang-format on
+class CopyOutStream {
+ public:
+  /// @cond
+  CopyOutStream(detail::Connection* conn, const Query& query,
+                OptionalCommandControl cmd_ctl = {});
+  /// @endcond
+
+  CopyOutStream(CopyOutStream&&) noexcept;
+  CopyOutStream& operator=(CopyOutStream&&) = delete;
+
+  CopyOutStream(const CopyOutStream&) = delete;
+  CopyOutStream& operator=(const CopyOutStream&) = delete;
+
+  ~CopyOutStream();
+
+  /// Read the next row. The row type must be a tuple, an aggregate or a type
+  /// with an Introspect method, see @ref pg_user_row_types
+  /// @returns false if there are no more rows
+  template <typename Row>
+  bool ReadRow(Row& row) {
+    io::traits::AssertIsValidRowType<Row>();
+    using RowType = io::RowType<Row>;
+    return std::apply(
+        [this](auto&... fields) { return ReadFields(fields...); },
+        RowType::GetTuple(row));
+  }
+
+  /// Read the next row into the fields
+  /// @returns false if there are no more rows
+  template <typename... Fields>
+  bool ReadFields(Fields&... fields) {
+    io::FieldBuffer buffer;
+    if (!FetchTuple(buffer, sizeof...(Fields))) return false;
+    detail::ReadCopyTuple(buffer, GetTypeBufferCategories(), fields...);
+    return true;
+  }
+
+  /// Returns true if all the rows were read
+  bool Done() const { return done_; }
+
+  /// Number of rows read from the stream so far
+  std::size_t RowsRead() const { return rows_read_; }
+
+ private:
+  const io::TypeBufferCategory& GetTypeBufferCategories() const;
+  bool FetchTuple(io::FieldBuffer& buffer, std::size_t field_count);
+
+  detail::Connection* conn_;
+  std::string data_;
+  std::size_t rows_read_{0};
+  bool header_read_{false};
+  bool done_{false};
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -7,6 +7,7 @@
 #include <userver/storages/postgres/postgres_fwd.hpp>
 #include <userver/storages/postgres/query.hpp>
 #include <userver/storages/postgres/result_set.hpp>
+#include <userver/storages/postgres/result_stream.hpp>
 
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
@@ -64,8 +65,24 @@ class NonTransaction {
   /// Suspends coroutine for execution.
   ResultSet Execute(OptionalCommandControl statement_cmd_ctl,
                     const std::string& statement, const ParameterStore& store);
+
+  /// Execute statement with arbitrary parameters and per-statement command
+  /// control and return a stream of its result rows. The stream takes over
+  /// the connection.
+  template <typename... Args>
+  ResultStream Stream(OptionalCommandControl statement_cmd_ctl,
+                      const Query& query, const Args&... args) && {
+    detail::StaticQueryParameters<sizeof...(args)> params;
+    params.Write(GetConnectionUserTypes(), args...);
+    return std::move(*this).DoStream(query, detail::QueryParameters{params},
+                                     statement_cmd_ctl);
+  }
   /// @}
  private:
+  ResultStream DoStream(const Query& query,
+                        const detail::QueryParameters& params,
+                        OptionalCommandControl statement_cmd_ctl) &&;
+
   ResultSet DoExecute(const Query& query, const detail::QueryParameters& params,
                       OptionalCommandControl statement_cmd_ctl);
   const UserTypes& GetConnectionUserTypes() const;
@@ -203,7 +203,7 @@ struct RowTypeImpl<T, traits::RowCategoryType::kAggregate> {
     return boost::pfr::structure_tie(v);
   }
   static auto GetTuple(const ValueType& value) {
-    return boost::pfr::structure_to_tuple(value);
+    return boost::pfr::structure_tie(value);
   }
 };
 
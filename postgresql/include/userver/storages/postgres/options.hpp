@@ -306,6 +306,26 @@ enum class ConnlimitMode {
   kAuto,
 };
 
+/// Default limit of queries sent to a batching connection at once
+inline constexpr std::size_t kDefaultBatchingMaxInFlight = 64;
+
+/// @brief Settings for multiplexing single statements of different tasks onto
+/// a few pipelined connections
+///
+/// Batching applies to Cluster::Execute calls with directly passed arguments
+/// that are executed on a slave, including kSlaveOrMaster statements that
+/// select a slave. Queries accumulated while the previous
+/// batch is in flight are sent together in a single network round-trip.
+/// Requires pipeline mode and prepared statements to be enabled, otherwise
+/// the queries are executed one by one.
+struct QueryBatchingSettings {
+  /// Number of batching connections per host, 0 disables batching
+  std::size_t connections{0};
+
+  /// Maximum number of queries sent to a batching connection at once
+  std::size_t max_in_flight{kDefaultBatchingMaxInFlight};
+};
+
 /// Settings for storages::postgres::Cluster
 struct ClusterSettings {
   /// settings for statements metrics
@@ -331,6 +351,9 @@ struct ClusterSettings {
 
   /// congestion control settings
   congestion_control::v2::LinearController::StaticConfig cc_config;
+
+  /// settings for batching of single statements
+  QueryBatchingSettings batching_settings;
 };
 
 }  // namespace storages::postgres
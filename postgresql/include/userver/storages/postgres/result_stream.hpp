@@ -0,0 +1,114 @@
+#pragma once
+
+/// @file userver/storages/postgres/result_stream.hpp
+/// @brief Streamed query results
+
+#include <cstddef>
+#include <optional>
+
+#include <userver/storages/postgres/detail/connection_ptr.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+// clang-format off
+/// @brief Reader of the result rows of a statement as they arrive from the
+/// server.
+///
+/// Created by Transaction::Stream, NonTransaction::Stream and Cluster::Stream.
+/// Unlike a ResultSet, the result is not materialized in memory as a whole:
+/// the rows are received in small chunks (a single row with libpq older than
+/// 17), reading suspends the coroutine until the next chunk arrives and the
+/// memory of a chunk is released when the next one is fetched. So the memory
+/// usage does not depend on the size of the result.
+///
+/// Rows are parsed with the same mapping that is used for ResultSet and
+/// TypedResultSet, see @ref pg_user_row_types.
+///
+/// All the rows must be read before the connection can be used for another
+/// query. If a stream of a transaction is destroyed earlier, the transaction
+/// can only be rolled back. A stream that owns its connection (created by
+/// NonTransaction::Stream or Cluster::Stream) returns the connection to the
+/// pool on destruction, an unfinished statement is cancelled by the pool.
+///
+/// @par Usage synopsis
+/// @code
+/// auto trx = cluster->Begin(/* transaction options */);
+/// auto stream = trx.Stream("SELECT foo, bar FROM foobar WHERE foo > $1", 42);
+/// MyRow row;
+/// while (stream.ReadRow(row, storages::postgres::kRowTag)) {
+///   DoSomething(row);
+/// }
+/// trx.Commit();
+/// @endcode
+// clang-format on
+class ResultStream {
+ public:
+  /// @cond
+  ResultStream(detail::Connection* conn, const Query& query,
+               const detail::QueryParameters& params,
+               OptionalCommandControl cmd_ctl = {});
+  ResultStream(detail::ConnectionPtr&& conn, const Query& query,
+               const detail::QueryParameters& params,
+               OptionalCommandControl cmd_ctl = {});
+  /// @endcond
+
+  ResultStream(ResultStream&&) noexcept;
+  ResultStream& operator=(ResultStream&&) = delete;
+
+  ResultStream(const ResultStream&) = delete;
+  ResultStream& operator=(const ResultStream&) = delete;
+
+  ~ResultStream();
+
+  /// Read the next row consisting of a single field
+  /// @returns false if there are no more rows
+  template <typename T>
+  bool ReadRow(T& row) {
+    return ReadRow(row, kFieldTag);
+  }
+
+  /// Read the next row, the tag selects how the row is mapped to the type the
+  /// same way as in ResultSet::AsSetOf
+  /// @returns false if there are no more rows
+  template <typename T, typename Tag>
+  bool ReadRow(T& row, Tag tag) {
+    if (!HasRow()) return false;
+    (*rows_)[row_index_++].To(row, tag);
+    ++rows_read_;
+    return true;
+  }
+
+  /// Receive the next chunk of rows, the rows of the previous chunk that were
+  /// not read with ReadRow are skipped.
+  /// The chunk can be converted to typed rows with ResultSet::AsSetOf.
+  /// @returns std::nullopt if there are no more rows
+  std::optional<ResultSet> FetchRows();
+
+  /// Returns true if all the rows were received
+  bool Done() const { return done_; }
+
+  /// Number of rows received from the stream so far
+  std::size_t RowsRead() const { return rows_read_; }
+
+ private:
+  bool HasRow();
+  bool FetchChunk();
+
+  std::optional<detail::ConnectionPtr> owned_conn_;
+  detail::Connection* conn_;
+  std::optional<ResultSet> rows_;
+  std::size_t row_index_{0};
+  std::size_t rows_read_{0};
+  bool done_{false};
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
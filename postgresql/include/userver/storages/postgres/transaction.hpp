@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 
+#include <userver/storages/postgres/copy.hpp>
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
@@ -15,6 +16,7 @@
 #include <userver/storages/postgres/postgres_fwd.hpp>
 #include <userver/storages/postgres/query.hpp>
 #include <userver/storages/postgres/result_set.hpp>
+#include <userver/storages/postgres/result_stream.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -101,6 +103,49 @@ namespace storages::postgres {
 /// trx.Commit();
 /// @endcode
 ///
+/// @par Bulk data transfer
+///
+/// Large amounts of rows are loaded and unloaded faster with the COPY
+/// statement in binary format, than with multi-row inserts or selects. The
+/// fields are written and read with the same types as the query parameters
+/// and results.
+///
+/// @code
+/// auto trx = cluster->Begin(/* transaction options */);
+/// auto copy_in = trx.CopyIn("COPY foobar FROM STDIN (FORMAT binary)");
+/// copy_in.WriteFields(42, "baz");
+/// copy_in.Finish();
+///
+/// auto copy_out = trx.CopyOut("COPY foobar TO STDOUT (FORMAT binary)");
+/// int foo = 0;
+/// std::string bar;
+/// while (copy_out.ReadFields(foo, bar)) {
+///   // ...
+/// }
+/// trx.Commit();
+/// @endcode
+///
+/// @see CopyInStream
+/// @see CopyOutStream
+///
+/// @par Streaming results
+///
+/// A result too large to be kept in memory as a whole is read as a stream of
+/// rows. The rows are received from the server as they are produced, there
+/// is no need in a portal and in round trips for every batch of rows.
+///
+/// @code
+/// auto trx = cluster->Begin(/* transaction options */);
+/// auto stream = trx.Stream("select foo, bar from foobar where foo > $1", 42);
+/// MyRow row;
+/// while (stream.ReadRow(row, storages::postgres::kRowTag)) {
+///   // ...
+/// }
+/// trx.Commit();
+/// @endcode
+///
+/// @see ResultStream
+///
 /// @see Transaction
 /// @see ResultSet
 ///
@@ -290,6 +335,45 @@ class Transaction {
   Portal MakePortal(OptionalCommandControl statement_cmd_ctl,
                     const Query& query, const ParameterStore& store);
 
+  /// Start a `COPY ... FROM STDIN (FORMAT binary)` statement and return a
+  /// stream for writing the rows.
+  ///
+  /// The transaction cannot run other statements until the stream is
+  /// finished.
+  CopyInStream CopyIn(const Query& query,
+                      OptionalCommandControl statement_cmd_ctl = {});
+
+  /// Start a `COPY ... TO STDOUT (FORMAT binary)` statement and return a
+  /// stream for reading the rows.
+  ///
+  /// The transaction cannot run other statements until all the rows are
+  /// read.
+  CopyOutStream CopyOut(const Query& query,
+                        OptionalCommandControl statement_cmd_ctl = {});
+
+  /// Execute statement with arbitrary parameters and return a stream of its
+  /// result rows, see ResultStream.
+  ///
+  /// The transaction cannot run other statements until all the rows are
+  /// read.
+  template <typename... Args>
+  ResultStream Stream(const Query& query, const Args&... args) {
+    return Stream(OptionalCommandControl{}, query, args...);
+  }
+
+  /// Execute statement with arbitrary parameters and per-statement command
+  /// control and return a stream of its result rows, see ResultStream.
+  ///
+  /// The transaction cannot run other statements until all the rows are
+  /// read.
+  template <typename... Args>
+  ResultStream Stream(OptionalCommandControl statement_cmd_ctl,
+                      const Query& query, const Args&... args) {
+    detail::StaticQueryParameters<sizeof...(args)> params;
+    params.Write(GetConnectionUserTypes(), args...);
+    return DoStream(query, detail::QueryParameters{params}, statement_cmd_ctl);
+  }
+
   /// Set a connection parameter
   /// https://www.postgresql.org/docs/current/sql-set.html
   /// The parameter is set for this transaction only
@@ -312,6 +396,10 @@ class Transaction {
   TimeoutDuration GetConnStatementTimeoutDebug() const;
 
  private:
+  ResultStream DoStream(const Query& query,
+                        const detail::QueryParameters& params,
+                        OptionalCommandControl statement_cmd_ctl);
+
   ResultSet DoExecute(const Query& query, const detail::QueryParameters& params,
                       OptionalCommandControl statement_cmd_ctl);
   Portal MakePortal(const PortalName&, const Query& query,
@@ -1,5 +1,10 @@
 #include <userver/cache/base_postgres_cache.hpp>
 
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/notify.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -28,6 +33,15 @@ properties:
         type: integer
         description: number of rows to request from PostgreSQL, 0 to fetch all rows in one request
         defaultDescription: 1000
+    full-update-partitions:
+        type: integer
+        description: number of partitions to fetch in parallel on a full update, 0 or 1 to fetch the data with a single query
+        defaultDescription: 0
+        minimum: 0
+    full-update-spread-replicas:
+        type: boolean
+        description: use the round-robin host selection for the partitions to spread them across the replicas
+        defaultDescription: false
     pgcomponent:
         type: string
         description: PostgreSQL component name
@@ -37,4 +51,42 @@ properties:
 
 }  // namespace components::impl
 
+namespace components::pg_cache::detail {
+
+void ListenNotifications(storages::postgres::Cluster& cluster,
+                         std::string_view channel,
+                         cache::CacheUpdateTrait& cache,
+                         cache::UpdateType update_type) {
+  bool listened_before = false;
+  while (!engine::current_task::ShouldCancel()) {
+    try {
+      auto scope = cluster.Listen(channel);
+      if (listened_before) {
+        // Notifications sent while we were not listening are lost
+        cache.InvalidateAsync(update_type);
+      }
+      listened_before = true;
+
+      while (!engine::current_task::ShouldCancel()) {
+        try {
+          scope.WaitNotify(engine::Deadline::FromDuration(kNotifyWaitTimeout));
+        } catch (const storages::postgres::ConnectionTimeoutError&) {
+          continue;
+        }
+        LOG_DEBUG() << "Cache " << cache.Name()
+                    << " got a notification on channel '" << channel << "'";
+        cache.InvalidateAsync(update_type);
+      }
+    } catch (const std::exception& e) {
+      if (engine::current_task::ShouldCancel()) break;
+      LOG_WARNING() << "Cache " << cache.Name()
+                    << " failed to listen on channel '" << channel
+                    << "': " << e;
+      engine::InterruptibleSleepFor(kListenRetryInterval);
+    }
+  }
+}
+
+}  // namespace components::pg_cache::detail
+
 USERVER_NAMESPACE_END
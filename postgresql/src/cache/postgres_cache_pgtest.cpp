@@ -0,0 +1,449 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+
+#include <userver/alerts/storage.hpp>
+#include <userver/cache/base_postgres_cache.hpp>
+#include <userver/cache/cache_config.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/components/minimal_component_list.hpp>
+#include <userver/components/run.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/dump/config.hpp>
+#include <userver/dynamic_config/storage_mock.hpp>
+#include <userver/dynamic_config/test_helpers.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/formats/yaml/serialize.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/portal.hpp>
+#include <userver/testsuite/cache_control.hpp>
+#include <userver/testsuite/dump_control.hpp>
+#include <userver/testsuite/tasks.hpp>
+#include <userver/testsuite/testsuite_support.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+#include <cache/cache_dependencies.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+namespace pg_cache = components::pg_cache;
+
+namespace {
+
+struct PartitionedRow {
+  int id{};
+  std::string value;
+};
+
+struct PartitionedPolicy {
+  static constexpr std::string_view kName = "partitioned-pg-cache";
+  using ValueType = PartitionedRow;
+  static constexpr auto kKeyMember = &PartitionedRow::id;
+  static constexpr const char* kQuery =
+      "select id, value from partitioned_cache_test";
+  static constexpr const char* kUpdatedField = "";
+  static constexpr const char* kWhere = "value <> 'skip' or id = 0";
+  static constexpr const char* kFullUpdatePartitionKey = "shard";
+};
+
+using CacheContainer = std::unordered_map<int, PartitionedRow>;
+
+void InsertRows(pg::ResultSet res, CacheContainer& cache) {
+  for (auto row : res.AsSetOf<PartitionedRow>(pg::kRowTag)) {
+    pg_cache::detail::CacheInsertOrAssign(cache, std::move(row),
+                                          PartitionedPolicy::kKeyMember);
+  }
+}
+
+UTEST_P(PostgreConnection, CachePartitionedFullUpdate) {
+  CheckConnection(GetConn());
+
+  UEXPECT_NO_THROW(GetConn()->Execute(
+      "create temporary table partitioned_cache_test("
+      "id integer primary key, shard integer, value text)"));
+  // Rows with `id % 50 = 7` have NULL partition keys
+  UEXPECT_NO_THROW(GetConn()->Execute(
+      "insert into partitioned_cache_test "
+      "select i, case when i % 50 = 7 then null else i end, "
+      "case when i % 5 = 0 then 'skip' else i::text end "
+      "from generate_series(-100, 100) i"));
+
+  CacheContainer expected;
+  // The same as the full update query of an unpartitioned cache
+  InsertRows(GetConn()->Execute(
+                 "select id, value from partitioned_cache_test "
+                 "where value <> 'skip' or id = 0"),
+             expected);
+  ASSERT_FALSE(expected.empty());
+  ASSERT_EQ(1, expected.count(-99));
+  ASSERT_EQ(1, expected.count(57));
+
+  const auto query = pg_cache::detail::GetPartitionQuery<PartitionedPolicy>();
+  for (const pg::Bigint partitions : {2, 3, 7, 16}) {
+    CacheContainer cache;
+    for (pg::Bigint partition = 0; partition < partitions; ++partition) {
+      auto res = GetConn()->Execute(query, partitions, partition);
+      for (auto row : res.AsSetOf<PartitionedRow>(pg::kRowTag)) {
+        const auto expected_partition =
+            row.id % 50 == 7 ? 0 : std::abs(row.id % partitions);
+        EXPECT_EQ(partition, expected_partition) << row.id;
+        // Every row belongs to a single partition
+        EXPECT_EQ(0, cache.count(row.id)) << row.id;
+      }
+      InsertRows(std::move(res), cache);
+    }
+
+    EXPECT_EQ(expected.size(), cache.size()) << partitions;
+    for (const auto& [id, row] : expected) {
+      const auto it = cache.find(id);
+      ASSERT_NE(cache.end(), it) << id << " partitions: " << partitions;
+      EXPECT_EQ(row.value, it->second.value);
+    }
+  }
+}
+
+constexpr std::size_t kGeneratedRows = 100000;
+
+struct GeneratedRowsPolicy {
+  static constexpr std::string_view kName = "partitioned-generated-pg-cache";
+  using ValueType = PartitionedRow;
+  static constexpr auto kKeyMember = &PartitionedRow::id;
+  static constexpr const char* kQuery =
+      "select i, i::text from generate_series(1, 100000) i";
+  static constexpr const char* kUpdatedField = "";
+  static constexpr const char* kFullUpdatePartitionKey = "i";
+};
+
+struct UnpartitionedGeneratedRowsPolicy : GeneratedRowsPolicy {
+  static constexpr std::string_view kName = "generated-pg-cache";
+};
+
+using PartitionedCache = components::PostgreCache<GeneratedRowsPolicy>;
+using UnpartitionedCache =
+    components::PostgreCache<UnpartitionedGeneratedRowsPolicy>;
+
+// Compares the caches after their initial full updates, the chunks are
+// smaller than the partitions
+constexpr std::string_view kPartitionedCachesConfig = R"(
+components_manager:
+  default_task_processor: main-task-processor
+  event_thread_pool:
+    threads: 1
+  task_processors:
+    main-task-processor:
+      worker_threads: 4
+  components:
+    logging:
+      fs-task-processor: main-task-processor
+      loggers:
+        default:
+          file_path: '@null'
+    testsuite-support:
+    postgres-db:
+      dbconnection: '{}'
+      blocking_task_processor: main-task-processor
+      dns_resolver: getaddrinfo
+    partitioned-generated-pg-cache:
+      pgcomponent: postgres-db
+      update-types: only-full
+      update-interval: 1h
+      chunk-size: 1000
+      full-update-partitions: 4
+    generated-pg-cache:
+      pgcomponent: postgres-db
+      update-types: only-full
+      update-interval: 1h
+      chunk-size: 1000
+    partitioned-caches-check:
+)";
+
+class PartitionedCachesCheck final : public components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "partitioned-caches-check";
+
+  PartitionedCachesCheck(const components::ComponentConfig& config,
+                         const components::ComponentContext& context)
+      : LoggableComponentBase(config, context) {
+    const auto partitioned = context.FindComponent<PartitionedCache>().Get();
+    const auto expected = context.FindComponent<UnpartitionedCache>().Get();
+
+    EXPECT_EQ(kGeneratedRows, expected->size());
+    EXPECT_EQ(expected->size(), partitioned->size());
+    for (const auto& [id, row] : *expected) {
+      const auto it = partitioned->find(id);
+      if (it == partitioned->end()) {
+        ADD_FAILURE() << "Missing row " << id;
+        continue;
+      }
+      EXPECT_EQ(row.value, it->second.value);
+    }
+
+    const utils::statistics::Snapshot statistics{
+        context.FindComponent<components::StatisticsStorage>().GetStorage(),
+        "cache.full.time",
+        {{"cache_name", std::string{GeneratedRowsPolicy::kName}}}};
+    const auto fetch_ms =
+        statistics.SingleMetric("last-update-fetch-duration-ms").AsInt();
+    // Only the time the updating task waits for the partitions is accounted
+    // as fetching
+    EXPECT_GT(fetch_ms, 0);
+    EXPECT_LE(fetch_ms,
+              statistics.SingleMetric("last-update-duration-ms").AsInt());
+    // Includes the decoding time of the partition tasks
+    EXPECT_GT(statistics.SingleMetric("last-update-parse-duration-ms").AsInt(),
+              0);
+  }
+};
+
+constexpr std::chrono::milliseconds kBurstDeliveryTime{100};
+
+struct CacheEnvironment final {
+  dynamic_config::StorageMock config_storage{{dump::kConfigSet, {}},
+                                             {cache::kCacheConfigSet, {}}};
+  utils::statistics::Storage statistics_storage;
+  alerts::Storage alerts_storage;
+  testsuite::CacheControl cache_control{
+      testsuite::impl::PeriodicUpdatesMode::kEnabled,
+      testsuite::CacheControl::UnitTests{}};
+  testsuite::DumpControl dump_control{
+      testsuite::DumpControl::PeriodicsMode::kDisabled};
+};
+
+cache::CacheDependencies MakeDependencies(CacheEnvironment& environment) {
+  static const yaml_config::YamlConfig kConfig{formats::yaml::FromString(R"(
+update-types: full-and-incremental
+full-update-interval: 1h
+update-interval: 1h
+)"),
+                                               {}};
+  return {
+      "notified-pg-cache",
+      cache::Config{kConfig, std::nullopt},
+      engine::current_task::GetTaskProcessor(),
+      environment.config_storage.GetSource(),
+      environment.statistics_storage,
+      environment.alerts_storage,
+      environment.cache_control,
+      std::nullopt,
+      nullptr,
+      &engine::current_task::GetTaskProcessor(),
+      environment.dump_control,
+  };
+}
+
+// Counts the updates, an update may be held to receive notifications while
+// it is in progress
+class NotifiedCache final : public cache::CacheUpdateTrait {
+ public:
+  explicit NotifiedCache(CacheEnvironment& environment)
+      : cache::CacheUpdateTrait(MakeDependencies(environment)) {
+    StartPeriodicUpdates();
+  }
+
+  ~NotifiedCache() override { StopPeriodicUpdates(); }
+
+  std::size_t GetUpdatesCount() const { return updates_count_; }
+  std::size_t GetIncrementalUpdatesCount() const {
+    return incremental_updates_count_;
+  }
+  bool IsUpdating() const { return updating_; }
+
+  void HoldUpdates() { hold_updates_ = true; }
+  void ReleaseUpdates() {
+    hold_updates_ = false;
+    release_event_.Send();
+  }
+
+ private:
+  void Update(cache::UpdateType type,
+              const std::chrono::system_clock::time_point& /*last_update*/,
+              const std::chrono::system_clock::time_point& /*now*/,
+              cache::UpdateStatisticsScope& stats_scope) override {
+    updating_ = true;
+    if (hold_updates_) {
+      [[maybe_unused]] const auto released =
+          release_event_.WaitForEventFor(utest::kMaxTestWaitTime);
+    }
+    if (type == cache::UpdateType::kIncremental) ++incremental_updates_count_;
+    ++updates_count_;
+    updating_ = false;
+
+    OnCacheModified();
+    stats_scope.Finish(0);
+  }
+
+  void Cleanup() override {}
+
+  std::atomic<std::size_t> updates_count_{0};
+  std::atomic<std::size_t> incremental_updates_count_{0};
+  std::atomic<bool> updating_{false};
+  std::atomic<bool> hold_updates_{false};
+  engine::SingleConsumerEvent release_event_;
+};
+
+template <typename Predicate>
+bool WaitFor(Predicate predicate) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (!predicate()) {
+    if (deadline.IsReached()) return false;
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  return true;
+}
+
+}  // namespace
+
+class PostgreCacheNotify : public PostgreSQLBase {
+ protected:
+  pg::Cluster CreateCluster() {
+    return pg::Cluster(GetDsnListFromEnv(), nullptr, GetTaskProcessor(),
+                       {{},
+                        {utest::kMaxTestWaitTime},
+                        {0, 4, 4},
+                        kCachePreparedStatements,
+                        pg::InitMode::kAsync,
+                        "",
+                        {},
+                        {}},
+                       {kTestCmdCtl, {}, {}}, {}, {}, testsuite_tasks_,
+                       dynamic_config::GetDefaultSource(), 0);
+  }
+
+  // The listener does not report subscribing, a notification sent before
+  // it would be lost
+  static bool WaitListening(pg::Cluster& cluster, std::string_view channel) {
+    return WaitFor([&cluster, channel] {
+      return cluster
+                 .Execute(pg::ClusterHostType::kMaster,
+                          "select count(*) from pg_stat_activity "
+                          "where pid <> pg_backend_pid() and query = $1",
+                          fmt::format("listen \"{}\"", channel))
+                 .AsSingleRow<pg::Bigint>() > 0;
+    });
+  }
+
+  static void Notify(pg::Cluster& cluster, std::string_view channel,
+                     int count = 1) {
+    cluster.Execute(
+        pg::ClusterHostType::kMaster,
+        "select pg_notify($1, i::text) from generate_series(1, $2) i", channel,
+        count);
+  }
+
+ private:
+  testsuite::TestsuiteTasks testsuite_tasks_{true};
+};
+
+UTEST_F(PostgreCacheNotify, NotificationTriggersUpdate) {
+  constexpr std::string_view kChannel = "pg_cache_notify_update";
+  auto cluster = CreateCluster();
+  CacheEnvironment environment;
+  NotifiedCache cache{environment};
+  const auto initial_updates = cache.GetUpdatesCount();
+
+  auto listener = engine::AsyncNoSpan([&cluster, &cache, kChannel] {
+    pg_cache::detail::ListenNotifications(cluster, kChannel, cache,
+                                          cache::UpdateType::kIncremental);
+  });
+  ASSERT_TRUE(WaitListening(cluster, kChannel));
+  EXPECT_EQ(initial_updates, cache.GetUpdatesCount());
+
+  Notify(cluster, kChannel);
+  ASSERT_TRUE(WaitFor(
+      [&] { return cache.GetUpdatesCount() == initial_updates + 1; }));
+  EXPECT_EQ(1u, cache.GetIncrementalUpdatesCount());
+
+  listener.SyncCancel();
+}
+
+UTEST_F(PostgreCacheNotify, NotificationBurstIsCoalesced) {
+  constexpr std::string_view kChannel = "pg_cache_notify_burst";
+  constexpr int kBurstSize = 20;
+  auto cluster = CreateCluster();
+  CacheEnvironment environment;
+  NotifiedCache cache{environment};
+  const auto initial_updates = cache.GetUpdatesCount();
+
+  auto listener = engine::AsyncNoSpan([&cluster, &cache, kChannel] {
+    pg_cache::detail::ListenNotifications(cluster, kChannel, cache,
+                                          cache::UpdateType::kIncremental);
+  });
+  ASSERT_TRUE(WaitListening(cluster, kChannel));
+
+  // The burst arrives while the update triggered by the first notification
+  // is in progress
+  cache.HoldUpdates();
+  Notify(cluster, kChannel);
+  ASSERT_TRUE(WaitFor([&] { return cache.IsUpdating(); }));
+  Notify(cluster, kChannel, kBurstSize);
+  engine::SleepFor(kBurstDeliveryTime);
+  cache.ReleaseUpdates();
+
+  ASSERT_TRUE(WaitFor(
+      [&] { return cache.GetUpdatesCount() >= initial_updates + 2; }));
+  engine::SleepFor(kBurstDeliveryTime);
+  EXPECT_EQ(initial_updates + 2, cache.GetUpdatesCount());
+  EXPECT_FALSE(cache.IsUpdating());
+
+  listener.SyncCancel();
+}
+
+UTEST_F(PostgreCacheNotify, ResubscribesAfterConnectionLoss) {
+  constexpr std::string_view kChannel = "pg_cache_notify_reconnect";
+  auto cluster = CreateCluster();
+  CacheEnvironment environment;
+  NotifiedCache cache{environment};
+  const auto initial_updates = cache.GetUpdatesCount();
+
+  auto listener = engine::AsyncNoSpan([&cluster, &cache, kChannel] {
+    pg_cache::detail::ListenNotifications(cluster, kChannel, cache,
+                                          cache::UpdateType::kIncremental);
+  });
+  ASSERT_TRUE(WaitListening(cluster, kChannel));
+
+  cluster.Execute(pg::ClusterHostType::kMaster,
+                  "select pg_terminate_backend(pid) from pg_stat_activity "
+                  "where pid <> pg_backend_pid() and query = $1",
+                  fmt::format("listen \"{}\"", kChannel));
+
+  // Notifications sent while the cache was not listening are lost, so an
+  // update is performed after re-subscribing
+  ASSERT_TRUE(WaitFor(
+      [&] { return cache.GetUpdatesCount() == initial_updates + 1; }));
+  EXPECT_EQ(1u, cache.GetIncrementalUpdatesCount());
+
+  ASSERT_TRUE(WaitListening(cluster, kChannel));
+  Notify(cluster, kChannel);
+  ASSERT_TRUE(WaitFor(
+      [&] { return cache.GetUpdatesCount() == initial_updates + 2; }));
+  EXPECT_EQ(2u, cache.GetIncrementalUpdatesCount());
+
+  listener.SyncCancel();
+}
+
+class PostgreCacheComponent : public PostgreSQLBase {};
+
+TEST_F(PostgreCacheComponent, PartitionedFullUpdate) {
+  if (!pg::Portal::IsSupportedByDriver()) {
+    GTEST_SKIP() << "Chunked updates require PostgreSQL portals";
+  }
+
+  components::RunOnce(
+      components::InMemoryConfig{fmt::format(
+          kPartitionedCachesConfig, GetDsnFromEnv().GetUnderlying())},
+      components::MinimalComponentList()
+          .Append<components::TestsuiteSupport>()
+          .Append<components::Postgres>("postgres-db")
+          .Append<PartitionedCache>()
+          .Append<UnpartitionedCache>()
+          .Append<PartitionedCachesCheck>());
+}
+
+USERVER_NAMESPACE_END
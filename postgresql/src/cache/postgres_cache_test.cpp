@@ -72,6 +72,18 @@ struct PostgresExamplePolicy {
   // Required: no
   static constexpr const char* kWhere = "id > 10";
 
+  // Integer SQL expression to split the full update query into partitions
+  // by, see `full-update-partitions` static config option.
+  //
+  // Required: no
+  static constexpr const char* kFullUpdatePartitionKey = "id";
+
+  // Channel to LISTEN on, a notification on it triggers an update of the
+  // cache.
+  //
+  // Required: no
+  static constexpr const char* kNotifyChannel = "my_data_changed";
+
   // Cache container type.
   //
   // It can be of any map type. The default is `unordered_map`, it is not
@@ -122,6 +134,12 @@ struct PostgresExamplePolicy2 {
 static_assert(pg_cache::detail::kHasName<PostgresExamplePolicy>);
 static_assert(pg_cache::detail::kHasQuery<PostgresExamplePolicy>);
 static_assert(pg_cache::detail::kHasKeyMember<PostgresExamplePolicy>);
+static_assert(
+    pg_cache::detail::kHasFullUpdatePartitionKey<PostgresExamplePolicy>);
+static_assert(
+    !pg_cache::detail::kHasFullUpdatePartitionKey<PostgresExamplePolicy2>);
+static_assert(pg_cache::detail::kHasNotifyChannel<PostgresExamplePolicy>);
+static_assert(!pg_cache::detail::kHasNotifyChannel<PostgresExamplePolicy2>);
 
 static_assert((std::is_same<
                pg_cache::detail::KeyMemberType<PostgresExamplePolicy>, int>{}));
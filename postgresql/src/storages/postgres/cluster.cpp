@@ -111,6 +111,17 @@ detail::NonTransaction Cluster::Start(ClusterHostTypeFlags flags,
   return pimpl_->Start(flags, cmd_ctl);
 }
 
+bool Cluster::IsQueryBatchingEnabled(ClusterHostTypeFlags flags) const {
+  return pimpl_->IsQueryBatchingEnabled(flags);
+}
+
+std::optional<ResultSet> Cluster::ExecuteBatched(
+    ClusterHostTypeFlags flags, OptionalCommandControl statement_cmd_ctl,
+    const Query& query, ParamsWriter params_writer) {
+  return pimpl_->ExecuteBatched(flags, statement_cmd_ctl, query,
+                                params_writer);
+}
+
 OptionalCommandControl Cluster::GetQueryCmdCtl(
     const std::string& query_name) const {
   return pimpl_->GetQueryCmdCtl(query_name);
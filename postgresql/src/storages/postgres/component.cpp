@@ -90,6 +90,13 @@ Postgres::Postgres(const ComponentConfig& config,
   initial_settings_.connlimit_mode =
       ParseConnlimitMode(config["connlimit_mode"].As<std::string>("auto"));
 
+  const auto batching_config = config["query_batching"];
+  initial_settings_.batching_settings.connections =
+      batching_config["connections"].As<std::size_t>(0);
+  initial_settings_.batching_settings.max_in_flight =
+      batching_config["max_in_flight"].As<std::size_t>(
+          storages::postgres::kDefaultBatchingMaxInFlight);
+
   initial_settings_.topology_settings.max_replication_lag =
       config["max_replication_lag"].As<std::chrono::milliseconds>(
           storages::postgres::kDefaultMaxReplicationLag);
@@ -328,6 +335,23 @@ properties:
          - auto
          - manual
         description: how to learn the `max_pool_size`
+    query_batching:
+        type: object
+        description: |
+            multiplexing of single statements executed on slaves by different
+            tasks onto a few pipelined connections, requires pipeline mode
+        additionalProperties: false
+        properties:
+            connections:
+                type: integer
+                minimum: 0
+                description: number of batching connections per host, 0 disables batching
+                defaultDescription: 0
+            max_in_flight:
+                type: integer
+                minimum: 1
+                description: maximum number of queries sent to a batching connection at once
+                defaultDescription: 64
 )");
 }
 
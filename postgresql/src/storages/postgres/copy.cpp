@@ -0,0 +1,182 @@
+#include <userver/storages/postgres/copy.hpp>
+
+#include <string_view>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace detail {
+
+namespace {
+
+// https://www.postgresql.org/docs/current/sql-copy.html#id-1.9.3.55.9.4
+constexpr std::string_view kCopySignature{"PGCOPY\n\377\r\n\0", 11};
+// Bit 16 of the flags field means that OIDs are included in the data
+constexpr Integer kCopyOidsFlag = 1 << 16;
+constexpr Smallint kCopyTrailer = -1;
+
+const UserTypes kPredefinedTypes;
+
+}  // namespace
+
+void WriteCopyHeader(std::string& buffer) {
+  buffer.append(kCopySignature);
+  // flags
+  io::WriteBuffer(kPredefinedTypes, buffer, Integer{0});
+  // header extension area length
+  io::WriteBuffer(kPredefinedTypes, buffer, Integer{0});
+}
+
+void WriteCopyTrailer(std::string& buffer) {
+  io::WriteBuffer(kPredefinedTypes, buffer, kCopyTrailer);
+}
+
+void ReadCopyHeader(io::FieldBuffer& buffer) {
+  if (buffer.length < kCopySignature.size() ||
+      std::string_view{reinterpret_cast<const char*>(buffer.buffer),
+                       kCopySignature.size()} != kCopySignature) {
+    throw InvalidBinaryBuffer{"Invalid binary COPY signature"};
+  }
+  buffer.buffer += kCopySignature.size();
+  buffer.length -= kCopySignature.size();
+
+  Integer flags{0};
+  buffer.Read(flags, io::BufferCategory::kPlainBuffer);
+  if (flags & kCopyOidsFlag) {
+    throw InvalidBinaryBuffer{"Binary COPY data with OIDs is not supported"};
+  }
+  Integer extension_length{0};
+  buffer.Read(extension_length, io::BufferCategory::kPlainBuffer);
+  if (extension_length < 0 ||
+      static_cast<std::size_t>(extension_length) > buffer.length) {
+    throw InvalidBinaryBuffer{"Invalid binary COPY header extension length"};
+  }
+  buffer.buffer += extension_length;
+  buffer.length -= extension_length;
+}
+
+bool ReadCopyTupleHeader(io::FieldBuffer& buffer, std::size_t field_count) {
+  Smallint tuple_size{0};
+  buffer.Read(tuple_size, io::BufferCategory::kPlainBuffer);
+  if (tuple_size == kCopyTrailer) {
+    return false;
+  }
+  if (tuple_size < 0 || static_cast<std::size_t>(tuple_size) != field_count) {
+    throw InvalidTupleSizeRequested{static_cast<std::size_t>(tuple_size),
+                                    field_count};
+  }
+  return true;
+}
+
+}  // namespace detail
+
+CopyInStream::CopyInStream(detail::Connection* conn, const Query& query,
+                           OptionalCommandControl cmd_ctl,
+                           std::size_t chunk_size)
+    : conn_{conn}, chunk_size_{chunk_size} {
+  UASSERT(conn_);
+  conn_->StartCopyIn(query, std::move(cmd_ctl));
+  buffer_.reserve(chunk_size_);
+  detail::WriteCopyHeader(buffer_);
+}
+
+CopyInStream::CopyInStream(CopyInStream&& other) noexcept
+    : conn_{std::exchange(other.conn_, nullptr)},
+      buffer_{std::move(other.buffer_)},
+      chunk_size_{other.chunk_size_},
+      rows_written_{other.rows_written_} {}
+
+CopyInStream::~CopyInStream() {
+  if (conn_) {
+    LOG_INFO() << "COPY stream is destroyed without an explicit finish, "
+                  "aborting the COPY";
+    try {
+      conn_->AbortCopyIn("COPY stream is destroyed without finishing");
+    } catch (const std::exception& e) {
+      LOG_LIMITED_ERROR() << "Exception when aborting an abandoned COPY: " << e;
+    }
+  }
+}
+
+std::size_t CopyInStream::Finish() {
+  if (!conn_) {
+    throw LogicError{"COPY stream is already finished"};
+  }
+  detail::WriteCopyTrailer(buffer_);
+  SendBuffer();
+  auto res = std::exchange(conn_, nullptr)->FinishCopyIn();
+  return res.RowsAffected();
+}
+
+const UserTypes& CopyInStream::GetUserTypes() const {
+  if (!conn_) {
+    throw LogicError{"COPY stream is already finished"};
+  }
+  return conn_->GetUserTypes();
+}
+
+void CopyInStream::SendBuffer() {
+  conn_->PutCopyData(buffer_);
+  buffer_.clear();
+}
+
+CopyOutStream::CopyOutStream(detail::Connection* conn, const Query& query,
+                             OptionalCommandControl cmd_ctl)
+    : conn_{conn} {
+  UASSERT(conn_);
+  conn_->StartCopyOut(query, std::move(cmd_ctl));
+}
+
+CopyOutStream::CopyOutStream(CopyOutStream&& other) noexcept
+    : conn_{std::exchange(other.conn_, nullptr)},
+      data_{std::move(other.data_)},
+      rows_read_{other.rows_read_},
+      header_read_{other.header_read_},
+      done_{std::exchange(other.done_, true)} {}
+
+CopyOutStream::~CopyOutStream() {
+  if (conn_ && !done_) {
+    LOG_LIMITED_WARNING() << "COPY stream is destroyed before reading all the "
+                             "data, the connection stays busy until cleanup";
+  }
+}
+
+const io::TypeBufferCategory& CopyOutStream::GetTypeBufferCategories() const {
+  return conn_->GetUserTypes().GetTypeBufferCategories();
+}
+
+bool CopyOutStream::FetchTuple(io::FieldBuffer& buffer,
+                               std::size_t field_count) {
+  if (done_) return false;
+
+  // The server sends every tuple in a separate message, the file header comes
+  // along with the first tuple and the trailer comes alone
+  if (!conn_->GetCopyData(data_)) {
+    throw InvalidBinaryBuffer{"Binary COPY data ended without a trailer"};
+  }
+  buffer = io::FieldBuffer{false, io::BufferCategory::kPlainBuffer,
+                           data_.size(),
+                           reinterpret_cast<const std::uint8_t*>(data_.data())};
+  if (!header_read_) {
+    detail::ReadCopyHeader(buffer);
+    header_read_ = true;
+  }
+  if (!detail::ReadCopyTupleHeader(buffer, field_count)) {
+    if (conn_->GetCopyData(data_)) {
+      throw InvalidBinaryBuffer{"Unexpected binary COPY data after trailer"};
+    }
+    done_ = true;
+    return false;
+  }
+  ++rows_read_;
+  return true;
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/copy.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+
+void CreateTable(pg::detail::Connection& conn) {
+  conn.Execute(
+      "create temporary table if not exists copy_bench("
+      "id integer, value text)");
+  conn.Execute("truncate copy_bench");
+}
+
+BENCHMARK_DEFINE_F(PgConnection, CopyIn)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    CreateTable(GetConnection());
+    const auto count = static_cast<int>(state.range(0));
+    const std::string value(32, 'x');
+    for (auto _ : state) {
+      pg::CopyInStream copy{&GetConnection(),
+                            "copy copy_bench from stdin (format binary)"};
+      for (int i = 0; i < count; ++i) {
+        copy.WriteFields(i, value);
+      }
+      copy.Finish();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, CopyIn)->Range(1 << 6, 1 << 14);
+
+BENCHMARK_DEFINE_F(PgConnection, InsertUnnest)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    CreateTable(GetConnection());
+    const auto count = static_cast<int>(state.range(0));
+    const std::string value(32, 'x');
+    for (auto _ : state) {
+      std::vector<int> ids(count);
+      std::vector<std::string> values(count, value);
+      for (int i = 0; i < count; ++i) {
+        ids[i] = i;
+      }
+      GetConnection().Execute(
+          "insert into copy_bench select * from unnest($1, $2)", ids, values);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, InsertUnnest)->Range(1 << 6, 1 << 14);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
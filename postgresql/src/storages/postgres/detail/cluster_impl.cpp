@@ -1,5 +1,7 @@
 #include <storages/postgres/detail/cluster_impl.hpp>
 
+#include <algorithm>
+
 #include <fmt/format.h>
 
 #include <userver/dynamic_config/value.hpp>
@@ -75,6 +77,8 @@ ClusterImpl::ClusterImpl(DsnList dsns, clients::dns::Resolver* resolver,
     : default_cmd_ctls_(default_cmd_ctls),
       cluster_settings_(cluster_settings),
       bg_task_processor_(bg_task_processor),
+      batching_settings_(cluster_settings.batching_settings),
+      testsuite_pg_ctl_(testsuite_pg_ctl),
       rr_host_idx_(0),
       config_source_(std::move(config_source)),
       connlimit_watchdog_(*this, testsuite_tasks, shard_number,
@@ -112,6 +116,17 @@ ClusterImpl::ClusterImpl(DsnList dsns, clients::dns::Resolver* resolver,
   }
   LOG_DEBUG() << "Pools initialized";
 
+  if (cluster_settings.batching_settings.connections > 0) {
+    LOG_INFO() << "Batching single statements over "
+               << cluster_settings.batching_settings.connections
+               << " connections per host";
+    // The batchers are started on the first statement batched to a host,
+    // a host that only serves as the master never gets one
+    host_batchers_ =
+        std::vector<std::atomic<QueryBatcher*>>(host_pools_.size());
+    owned_batchers_.resize(host_pools_.size());
+  }
+
   // Do not use IsConnlimitModeAuto() here because we don't care about
   // the current dynamic config value
   if (cluster_settings.connlimit_mode == ConnlimitMode::kAuto) {
@@ -204,8 +219,7 @@ ClusterStatisticsPtr ClusterImpl::GetStatistics() const {
   return cluster_stats;
 }
 
-ClusterImpl::ConnectionPoolPtr ClusterImpl::FindPool(
-    ClusterHostTypeFlags flags) {
+std::size_t ClusterImpl::FindPoolIndex(ClusterHostTypeFlags flags) {
   LOG_TRACE() << "Looking for pool: " << flags;
 
   size_t dsn_index = -1;
@@ -249,7 +263,12 @@ ClusterImpl::ConnectionPoolPtr ClusterImpl::FindPool(
   }
 
   UASSERT(dsn_index < host_pools_.size());
-  return host_pools_.at(dsn_index);
+  return dsn_index;
+}
+
+ClusterImpl::ConnectionPoolPtr ClusterImpl::FindPool(
+    ClusterHostTypeFlags flags) {
+  return host_pools_.at(FindPoolIndex(flags));
 }
 
 Transaction ClusterImpl::Begin(ClusterHostTypeFlags flags,
@@ -292,6 +311,55 @@ QueryQueue ClusterImpl::CreateQueryQueue(ClusterHostTypeFlags flags,
                         engine::Deadline::FromDuration(acquire_timeout))};
 }
 
+bool ClusterImpl::IsQueryBatchingEnabled(ClusterHostTypeFlags flags) const {
+  if (host_batchers_.empty()) return false;
+  // Only the statements that may be executed on a slave are read-only
+  const auto role_flags = flags & kClusterHostRolesMask;
+  return (role_flags & ClusterHostType::kSlave) ||
+         (role_flags & ClusterHostType::kSyncSlave);
+}
+
+std::optional<ResultSet> ClusterImpl::ExecuteBatched(
+    ClusterHostTypeFlags flags, OptionalCommandControl statement_cmd_ctl,
+    const Query& query, QueryBatcher::ParamsWriter params_writer) {
+  UASSERT(IsQueryBatchingEnabled(flags));
+  LOG_TRACE() << "Requested batched statement on " << flags;
+  const auto dsn_index = FindPoolIndex(flags);
+  {
+    // A slave role may fall back to the master or the master may be
+    // selected for kSlaveOrMaster. Statements on the master are not
+    // batched, as they may modify data.
+    const auto dsn_indices_by_type = topology_->GetDsnIndicesByType();
+    const auto master_it = dsn_indices_by_type->find(ClusterHostType::kMaster);
+    if (master_it != dsn_indices_by_type->end() &&
+        std::find(master_it->second.begin(), master_it->second.end(),
+                  dsn_index) != master_it->second.end()) {
+      return std::nullopt;
+    }
+  }
+  return GetHostBatcher(dsn_index).Execute(
+      statement_cmd_ctl.value_or(GetDefaultCommandControl()), query,
+      params_writer);
+}
+
+QueryBatcher& ClusterImpl::GetHostBatcher(std::size_t dsn_index) {
+  UASSERT(dsn_index < host_batchers_.size());
+  auto* batcher = host_batchers_[dsn_index].load(std::memory_order_acquire);
+  if (batcher) return *batcher;
+
+  std::lock_guard lock{batchers_mutex_};
+  auto& owned_batcher = owned_batchers_[dsn_index];
+  if (!owned_batcher) {
+    LOG_INFO() << "Starting the query batcher for host "
+               << GetHostPort(topology_->GetDsnList()[dsn_index]);
+    owned_batcher = std::make_unique<QueryBatcher>(
+        host_pools_[dsn_index], batching_settings_, testsuite_pg_ctl_);
+    host_batchers_[dsn_index].store(owned_batcher.get(),
+                                    std::memory_order_release);
+  }
+  return *owned_batcher;
+}
+
 void ClusterImpl::SetDefaultCommandControl(CommandControl cmd_ctl,
                                            DefaultCommandControlSource source) {
   default_cmd_ctls_.UpdateDefaultCmdCtl(cmd_ctl, source);
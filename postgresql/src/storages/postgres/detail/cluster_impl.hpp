@@ -2,10 +2,12 @@
 
 #include <atomic>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/dynamic_config/source.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/error_injection/settings.hpp>
 #include <userver/testsuite/postgres_control.hpp>
@@ -14,6 +16,7 @@
 #include <storages/postgres/connlimit_watchdog.hpp>
 #include <storages/postgres/detail/pg_impl_types.hpp>
 #include <storages/postgres/detail/pool.hpp>
+#include <storages/postgres/detail/query_batcher.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 #include <storages/postgres/detail/topology/base.hpp>
 #include <userver/storages/postgres/cluster_types.hpp>
@@ -53,6 +56,14 @@ class ClusterImpl {
   QueryQueue CreateQueryQueue(ClusterHostTypeFlags flags,
                               TimeoutDuration acquire_timeout);
 
+  bool IsQueryBatchingEnabled(ClusterHostTypeFlags flags) const;
+
+  /// Returns std::nullopt if the statement is to be executed on the master,
+  /// such statements are not batched
+  std::optional<ResultSet> ExecuteBatched(
+      ClusterHostTypeFlags flags, OptionalCommandControl statement_cmd_ctl,
+      const Query& query, QueryBatcher::ParamsWriter params_writer);
+
   void SetDefaultCommandControl(CommandControl, DefaultCommandControlSource);
   CommandControl GetDefaultCommandControl() const;
 
@@ -83,13 +94,23 @@ class ClusterImpl {
 
   using ConnectionPoolPtr = std::shared_ptr<ConnectionPool>;
 
+  std::size_t FindPoolIndex(ClusterHostTypeFlags);
   ConnectionPoolPtr FindPool(ClusterHostTypeFlags);
+  QueryBatcher& GetHostBatcher(std::size_t dsn_index);
 
   DefaultCommandControls default_cmd_ctls_;
   rcu::Variable<ClusterSettings> cluster_settings_;
   std::unique_ptr<topology::TopologyBase> topology_;
   engine::TaskProcessor& bg_task_processor_;
   std::vector<ConnectionPoolPtr> host_pools_;
+  const QueryBatchingSettings batching_settings_;
+  const testsuite::PostgresControl testsuite_pg_ctl_;
+  // Same order as host_pools_, empty if batching is disabled. A slot is null
+  // until a statement is batched to the host while it is a slave.
+  std::vector<std::atomic<QueryBatcher*>> host_batchers_;
+  // Guards the creation of the batchers
+  engine::Mutex batchers_mutex_;
+  std::vector<std::unique_ptr<QueryBatcher>> owned_batchers_;
   std::atomic<uint32_t> rr_host_idx_;
   dynamic_config::Source config_source_;
   ConnlimitWatchdog connlimit_watchdog_;
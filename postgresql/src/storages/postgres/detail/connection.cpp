@@ -141,6 +141,11 @@ std::vector<ResultSet> Connection::GatherPipeline(
   return pimpl_->GatherPipeline(timeout, descriptions);
 }
 
+std::vector<Connection::PipelineResult> Connection::GatherPipelineResults(
+    TimeoutDuration timeout, const std::vector<ResultSet>& descriptions) {
+  return pimpl_->GatherPipelineResults(timeout, descriptions);
+}
+
 ResultSet Connection::Execute(const Query& query, const ParameterStore& store) {
   return Execute(query, detail::QueryParameters{store.GetInternalData()});
 }
@@ -200,6 +205,40 @@ Notification Connection::WaitNotify(engine::Deadline deadline) {
   return pimpl_->WaitNotify(deadline);
 }
 
+void Connection::StartCopyIn(const Query& query,
+                             OptionalCommandControl cmd_ctl) {
+  pimpl_->StartCopyIn(query, std::move(cmd_ctl));
+}
+
+void Connection::PutCopyData(std::string_view data) {
+  pimpl_->PutCopyData(data);
+}
+
+ResultSet Connection::FinishCopyIn() { return pimpl_->FinishCopyIn(); }
+
+void Connection::AbortCopyIn(const std::string& reason) {
+  pimpl_->AbortCopyIn(reason);
+}
+
+void Connection::StartCopyOut(const Query& query,
+                              OptionalCommandControl cmd_ctl) {
+  pimpl_->StartCopyOut(query, std::move(cmd_ctl));
+}
+
+bool Connection::GetCopyData(std::string& data) {
+  return pimpl_->GetCopyData(data);
+}
+
+void Connection::StartStream(const Query& query,
+                             const detail::QueryParameters& params,
+                             OptionalCommandControl cmd_ctl) {
+  pimpl_->StartStream(query, params, std::move(cmd_ctl));
+}
+
+std::optional<ResultSet> Connection::FetchStreamRows() {
+  return pimpl_->FetchStreamRows();
+}
+
 TimeoutDuration Connection::GetIdleDuration() const {
   return pimpl_->GetIdleDuration();
 }
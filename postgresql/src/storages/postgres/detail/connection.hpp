@@ -2,6 +2,8 @@
 
 #include <atomic>
 #include <chrono>
+#include <exception>
+#include <optional>
 #include <string>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
@@ -227,6 +229,17 @@ class Connection {
   std::vector<ResultSet> GatherPipeline(
       TimeoutDuration timeout, const std::vector<ResultSet>& descriptions);
 
+  /// Result of a single pipelined query, either a result set or an error
+  struct PipelineResult final {
+    ResultSet result{nullptr};
+    std::exception_ptr error;
+  };
+
+  /// Same as GatherPipeline, but an error in one of the queries does not
+  /// discard the results of the others
+  std::vector<PipelineResult> GatherPipelineResults(
+      TimeoutDuration timeout, const std::vector<ResultSet>& descriptions);
+
   template <typename... T>
   ResultSet Execute(const Query& query, const T&... args) {
     detail::StaticQueryParameters<sizeof...(args)> params;
@@ -284,6 +297,27 @@ class Connection {
   void Unlisten(std::string_view channel, OptionalCommandControl);
 
   Notification WaitNotify(engine::Deadline deadline);
+
+  /// Start a `COPY ... FROM STDIN (FORMAT binary)` statement
+  void StartCopyIn(const Query& query, OptionalCommandControl);
+  /// Send a chunk of COPY data, suspends until the data is sent
+  void PutCopyData(std::string_view data);
+  /// Complete the COPY and wait for its result
+  ResultSet FinishCopyIn();
+  /// Abort the COPY, the transaction fails
+  void AbortCopyIn(const std::string& reason);
+
+  /// Start a `COPY ... TO STDOUT (FORMAT binary)` statement
+  void StartCopyOut(const Query& query, OptionalCommandControl);
+  /// Receive the next chunk of COPY data, returns false at the end of data
+  bool GetCopyData(std::string& data);
+
+  /// Send a statement whose result rows are received as they arrive
+  void StartStream(const Query& query, const detail::QueryParameters& params,
+                   OptionalCommandControl);
+  /// Receive the next rows of the streamed result, returns std::nullopt after
+  /// the last rows
+  std::optional<ResultSet> FetchStreamRows();
   //@}
 
   /// Get duration since last network operation
@@ -37,6 +37,10 @@ constexpr std::string_view kStatementVacuum = "vacuum";
 constexpr std::string_view kStatementListen = "listen {}";
 constexpr std::string_view kStatementUnlisten = "unlisten {}";
 
+constexpr const char* kCopyTextFormatError =
+    "Only binary COPY format is supported, add `(FORMAT binary)` to the "
+    "COPY statement";
+
 const Query kSetConfigQuery{fmt::format("SELECT set_config($1, $2, $3) as {}",
                                         kSetConfigQueryResultName)};
 
@@ -95,6 +99,27 @@ class CountPortalBind {
   bool completed_{false};
 };
 
+class CountStream {
+ public:
+  CountStream(Connection::Statistics& stats, SteadyClock::time_point start_time)
+      : stats_(stats), start_time_(start_time) {}
+
+  ~CountStream() {
+    auto now = SteadyClock::now();
+    if (!completed_) ++stats_.error_execute_total;
+    stats_.sum_query_duration += now - start_time_;
+    stats_.last_execute_finish = now;
+  }
+
+  void AccountResult(ResultSet&) { AccountCompletion(); }
+  void AccountCompletion() { completed_ = true; }
+
+ private:
+  Connection::Statistics& stats_;
+  SteadyClock::time_point start_time_;
+  bool completed_{false};
+};
+
 struct TrackTrxEnd {
   TrackTrxEnd(Connection::Statistics& stats) : stats_(stats) {}
   ~TrackTrxEnd() { stats_.trx_end_time = SteadyClock::now(); }
@@ -530,6 +555,139 @@ Notification ConnectionImpl::WaitNotify(engine::Deadline deadline) {
   return conn_wrapper_.WaitNotify(deadline);
 }
 
+void ConnectionImpl::StartCopyIn(const Query& query,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  StartCopy(query, std::move(statement_cmd_ctl), PGRES_COPY_IN);
+}
+
+void ConnectionImpl::PutCopyData(std::string_view data) {
+  conn_wrapper_.PutCopyData(
+      data, testsuite_pg_ctl_.MakeExecuteDeadline(stream_network_timeout_));
+}
+
+ResultSet ConnectionImpl::FinishCopyIn() {
+  auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(stream_network_timeout_);
+  conn_wrapper_.PutCopyEnd(deadline, nullptr);
+  return WaitCopyResult(deadline);
+}
+
+void ConnectionImpl::AbortCopyIn(const std::string& reason) {
+  auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(stream_network_timeout_);
+  auto span = MakeQuerySpan(stream_query_,
+                            {stream_network_timeout_, GetStatementTimeout()});
+  auto scope = span.CreateScopeTime();
+  CountStream count_stream{stats_, stream_start_time_};
+  conn_wrapper_.PutCopyEnd(deadline, reason.c_str());
+  try {
+    conn_wrapper_.WaitResult(deadline, scope, nullptr);
+  } catch (const QueryCancelled&) {
+    // Expected, the server reports the abort as a cancelled statement
+  }
+  ResumePipeline();
+}
+
+void ConnectionImpl::StartCopyOut(const Query& query,
+                                  OptionalCommandControl statement_cmd_ctl) {
+  StartCopy(query, std::move(statement_cmd_ctl), PGRES_COPY_OUT);
+}
+
+bool ConnectionImpl::GetCopyData(std::string& data) {
+  auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(stream_network_timeout_);
+  if (conn_wrapper_.GetCopyData(data, deadline)) {
+    return true;
+  }
+  WaitCopyResult(deadline);
+  return false;
+}
+
+void ConnectionImpl::StartStream(const Query& query,
+                                 const QueryParameters& params,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  stream_network_timeout_ = ExecuteTimeout(statement_cmd_ctl);
+  auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(stream_network_timeout_);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+  DiscardOldPreparedStatements(deadline);
+  CheckDeadlineReached(deadline);
+
+  const auto& statement = query.Statement();
+  if (settings_.ignore_unused_query_params ==
+      ConnectionSettings::kCheckUnused) {
+    CheckQueryParameters(statement, params);
+  }
+
+  stream_query_ = query;
+  stream_start_time_ = SteadyClock::now();
+  stream_description_.reset();
+  ++stats_.execute_total;
+  auto span =
+      MakeQuerySpan(query, {stream_network_timeout_, GetStatementTimeout()});
+  auto scope = span.CreateScopeTime();
+  try {
+    SuspendPipeline(deadline, scope);
+    if (settings_.prepared_statements ==
+        ConnectionSettings::kNoPreparedStatements) {
+      conn_wrapper_.SendQuery(statement, params, scope);
+    } else {
+      const auto& prepared_info =
+          DoPrepareStatement(statement, params, deadline, span, scope);
+      scope.Reset(scopes::kExec);
+      conn_wrapper_.SendPreparedQuery(prepared_info.statement_name, params,
+                                      scope, nullptr);
+    }
+    conn_wrapper_.SetRowsMode();
+  } catch (const std::exception&) {
+    CountStream count_stream{stats_, stream_start_time_};
+    span.AddTag(tracing::kErrorFlag, true);
+    const auto state = GetConnectionState();
+    if (state != ConnectionState::kOffline &&
+        state != ConnectionState::kTranActive) {
+      ResumePipeline();
+    }
+    throw;
+  }
+}
+
+std::optional<ResultSet> ConnectionImpl::FetchStreamRows() {
+  auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(stream_network_timeout_);
+  std::optional<ResultSet> rows;
+  try {
+    rows = conn_wrapper_.WaitRows(deadline);
+  } catch (const std::exception&) {
+    CountStream count_stream{stats_, stream_start_time_};
+    stream_description_.reset();
+    const auto state = GetConnectionState();
+    if (state != ConnectionState::kOffline &&
+        state != ConnectionState::kTranActive) {
+      ResumePipeline();
+    }
+    throw;
+  }
+
+  if (rows) {
+    // All the chunks share the row description, the buffer categories are
+    // looked up once per stream
+    if (stream_description_) {
+      rows->SetBufferCategoriesFrom(*stream_description_);
+    } else {
+      FillBufferCategories(*rows);
+      stream_description_ = rows;
+    }
+    return rows;
+  }
+
+  CountStream count_stream{stats_, stream_start_time_};
+  count_stream.AccountCompletion();
+  stream_description_.reset();
+  ResumePipeline();
+  return std::nullopt;
+}
+
 void ConnectionImpl::CancelAndCleanup(TimeoutDuration timeout) {
   auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(timeout);
 
@@ -908,6 +1066,21 @@ void ConnectionImpl::AddIntoPipeline(CommandControl cc,
 
 std::vector<ResultSet> ConnectionImpl::GatherPipeline(
     TimeoutDuration timeout, const std::vector<ResultSet>& descriptions) {
+  auto results = GatherPipelineResults(timeout, descriptions);
+
+  std::vector<ResultSet> result;
+  result.reserve(results.size());
+  for (auto& single_result : results) {
+    if (single_result.error) {
+      std::rethrow_exception(single_result.error);
+    }
+    result.push_back(std::move(single_result.result));
+  }
+  return result;
+}
+
+std::vector<Connection::PipelineResult> ConnectionImpl::GatherPipelineResults(
+    TimeoutDuration timeout, const std::vector<ResultSet>& descriptions) {
   const auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(timeout);
   CheckDeadlineReached(deadline);
 
@@ -922,7 +1095,9 @@ std::vector<ResultSet> ConnectionImpl::GatherPipeline(
   auto result = conn_wrapper_.GatherPipeline(deadline, native_descriptions);
 
   for (auto& single_result : result) {
-    FillBufferCategories(single_result);
+    if (!single_result.error) {
+      FillBufferCategories(single_result.result);
+    }
   }
 
   return result;
@@ -987,6 +1162,90 @@ void ConnectionImpl::SetParameter(std::string_view name, std::string_view value,
   }
 }
 
+void ConnectionImpl::StartCopy(const Query& query,
+                               OptionalCommandControl statement_cmd_ctl,
+                               ExecStatusType direction) {
+  CheckBusy();
+  stream_network_timeout_ = ExecuteTimeout(statement_cmd_ctl);
+  auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(stream_network_timeout_);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+  CheckDeadlineReached(deadline);
+
+  stream_query_ = query;
+  stream_start_time_ = SteadyClock::now();
+  ++stats_.execute_total;
+  auto span =
+      MakeQuerySpan(query, {stream_network_timeout_, GetStatementTimeout()});
+  auto scope = span.CreateScopeTime();
+  bool is_binary = false;
+  try {
+    SuspendPipeline(deadline, scope);
+    conn_wrapper_.SendQuery(query.Statement(), scope);
+    is_binary = conn_wrapper_.WaitCopyStart(deadline, scope, direction);
+  } catch (const std::exception&) {
+    CountStream count_stream{stats_, stream_start_time_};
+    span.AddTag(tracing::kErrorFlag, true);
+    const auto state = GetConnectionState();
+    if (state != ConnectionState::kOffline &&
+        state != ConnectionState::kTranActive) {
+      ResumePipeline();
+    }
+    throw;
+  }
+  if (is_binary) return;
+
+  // Binary encoding of the rows would be garbage for the text format, so
+  // finish the COPY without transferring anything
+  LOG_LIMITED_WARNING() << kCopyTextFormatError;
+  if (direction == PGRES_COPY_IN) {
+    AbortCopyIn(kCopyTextFormatError);
+  } else {
+    std::string data;
+    while (GetCopyData(data)) {
+    }
+  }
+  throw LogicError{kCopyTextFormatError};
+}
+
+void ConnectionImpl::SuspendPipeline(engine::Deadline deadline,
+                                     tracing::ScopeTime& scope) {
+  resume_pipeline_ = IsPipelineActive();
+  if (resume_pipeline_) {
+    // libpq supports neither COPY nor single-row mode in pipeline mode. The
+    // commands already in the pipeline are completed, and the pipeline mode
+    // is restored when the stream is over
+    conn_wrapper_.WaitResult(deadline, scope, nullptr);
+    conn_wrapper_.ExitPipelineMode();
+  }
+}
+
+void ConnectionImpl::ResumePipeline() {
+  if (resume_pipeline_) {
+    resume_pipeline_ = false;
+    conn_wrapper_.EnterPipelineMode();
+  }
+}
+
+ResultSet ConnectionImpl::WaitCopyResult(engine::Deadline deadline) {
+  const auto& statement = stream_query_.Statement();
+  auto span = MakeQuerySpan(stream_query_,
+                            {stream_network_timeout_, GetStatementTimeout()});
+  auto scope = span.CreateScopeTime();
+  CountStream count_stream{stats_, stream_start_time_};
+  try {
+    auto res = WaitResult(statement, deadline, stream_network_timeout_,
+                          count_stream, span, scope, nullptr);
+    ResumePipeline();
+    return res;
+  } catch (const Error&) {
+    if (GetConnectionState() != ConnectionState::kOffline) {
+      ResumePipeline();
+    }
+    throw;
+  }
+}
+
 void ConnectionImpl::LoadUserTypes(engine::Deadline deadline) {
   UASSERT(settings_.user_types != ConnectionSettings::kPredefinedTypesOnly);
   try {
@@ -88,6 +88,8 @@ class ConnectionImpl {
                        const ResultSet& description, tracing::ScopeTime& scope);
   std::vector<ResultSet> GatherPipeline(
       TimeoutDuration timeout, const std::vector<ResultSet>& descriptions);
+  std::vector<Connection::PipelineResult> GatherPipelineResults(
+      TimeoutDuration timeout, const std::vector<ResultSet>& descriptions);
 
   void Begin(const TransactionOptions& options,
              SteadyClock::time_point trx_start_time,
@@ -111,6 +113,20 @@ class ConnectionImpl {
   void Unlisten(std::string_view channel, OptionalCommandControl);
   Notification WaitNotify(engine::Deadline deadline);
 
+  void StartCopyIn(const Query& query,
+                   OptionalCommandControl statement_cmd_ctl);
+  void PutCopyData(std::string_view data);
+  ResultSet FinishCopyIn();
+  void AbortCopyIn(const std::string& reason);
+
+  void StartCopyOut(const Query& query,
+                    OptionalCommandControl statement_cmd_ctl);
+  bool GetCopyData(std::string& data);
+
+  void StartStream(const Query& query, const QueryParameters& params,
+                   OptionalCommandControl statement_cmd_ctl);
+  std::optional<ResultSet> FetchStreamRows();
+
   void CancelAndCleanup(TimeoutDuration timeout);
   bool Cleanup(TimeoutDuration timeout);
 
@@ -180,6 +196,12 @@ class ConnectionImpl {
                     Connection::ParameterScope scope,
                     engine::Deadline deadline);
 
+  void StartCopy(const Query& query, OptionalCommandControl statement_cmd_ctl,
+                 ExecStatusType direction);
+  ResultSet WaitCopyResult(engine::Deadline deadline);
+  void SuspendPipeline(engine::Deadline deadline, tracing::ScopeTime& scope);
+  void ResumePipeline();
+
   void LoadUserTypes(engine::Deadline deadline);
   void FillBufferCategories(ResultSet& res);
 
@@ -211,6 +233,11 @@ class ConnectionImpl {
   testsuite::PostgresControl testsuite_pg_ctl_;
   OptionalCommandControl transaction_cmd_ctl_;
   TimeoutDuration current_statement_timeout_{};
+  Query stream_query_;
+  TimeoutDuration stream_network_timeout_{};
+  SteadyClock::time_point stream_start_time_;
+  std::optional<ResultSet> stream_description_;
+  bool resume_pipeline_{false};
   const error_injection::Settings ei_settings_;
 
   std::unordered_set<std::string> statements_reported_;
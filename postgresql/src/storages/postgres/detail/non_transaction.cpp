@@ -15,7 +15,9 @@ NonTransaction::NonTransaction(ConnectionPtr&& conn,
 }
 
 NonTransaction::NonTransaction(NonTransaction&&) noexcept = default;
-NonTransaction::~NonTransaction() { conn_->Finish(); }
+NonTransaction::~NonTransaction() {
+  if (conn_) conn_->Finish();
+}
 
 NonTransaction& NonTransaction::operator=(NonTransaction&&) noexcept = default;
 
@@ -47,6 +49,13 @@ ResultSet NonTransaction::DoExecute(const Query& query,
   return res;
 }
 
+ResultStream NonTransaction::DoStream(
+    const Query& query, const detail::QueryParameters& params,
+    OptionalCommandControl statement_cmd_ctl) && {
+  return ResultStream{std::move(conn_), query, params,
+                      std::move(statement_cmd_ctl)};
+}
+
 const UserTypes& NonTransaction::GetConnectionUserTypes() const {
   return conn_->GetUserTypes();
 }
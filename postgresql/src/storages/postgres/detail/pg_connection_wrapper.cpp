@@ -64,6 +64,18 @@ namespace {
 // TODO move to config
 constexpr bool kVerboseErrors = false;
 
+#if LIBPQ_HAS_CHUNK_MODE
+// Max number of rows in a single result of a streamed query
+constexpr int kStreamChunkRows = 1000;
+#endif
+
+bool IsStreamedRows(ExecStatusType status) {
+#if LIBPQ_HAS_CHUNK_MODE
+  if (status == PGRES_TUPLES_CHUNK) return true;
+#endif
+  return status == PGRES_SINGLE_TUPLE;
+}
+
 const char* MsgForStatus(ConnStatusType status) {
   switch (status) {
     case CONNECTION_OK:
@@ -563,6 +575,126 @@ ResultSet PGConnectionWrapper::WaitResult(Deadline deadline,
   return MakeResult(std::move(handle));
 }
 
+bool PGConnectionWrapper::WaitCopyStart(Deadline deadline,
+                                        tracing::ScopeTime& scope,
+                                        ExecStatusType expected) {
+  scope.Reset(scopes::kLibpqWaitResult);
+  Flush(deadline);
+  auto handle = MakeResultHandle(ReadResult(deadline, nullptr));
+  const auto status =
+      handle ? PQresultStatus(handle.get()) : PGRES_EMPTY_QUERY;
+  if (status == expected) {
+    return PQbinaryTuples(handle.get()) != 0;
+  }
+  if (status == PGRES_COPY_IN || status == PGRES_COPY_OUT ||
+      status == PGRES_COPY_BOTH) {
+    PGCW_LOG_LIMITED_ERROR()
+        << "PostgreSQL COPY command transfers data in an unexpected direction";
+    CloseWithError(LogicError{"COPY data transfer direction mismatch"});
+  }
+  // The statement failed or is not a COPY, the rest of the results must be
+  // consumed before reporting the error
+  while (auto* pg_res = ReadResult(deadline, nullptr)) {
+    handle = MakeResultHandle(pg_res);
+  }
+  MakeResult(std::move(handle));
+  throw LogicError{"The statement is not a COPY"};
+}
+
+void PGConnectionWrapper::SetRowsMode() {
+#if LIBPQ_HAS_CHUNK_MODE
+  const bool switched = PQsetChunkedRowsMode(conn_, kStreamChunkRows) != 0;
+#else
+  const bool switched = PQsetSingleRowMode(conn_) != 0;
+#endif
+  if (!switched) {
+    PGCW_LOG_LIMITED_ERROR()
+        << "Failed to switch libpq to row streaming for the query";
+    throw LogicError{"Failed to switch libpq to row streaming"};
+  }
+}
+
+std::optional<ResultSet> PGConnectionWrapper::WaitRows(Deadline deadline) {
+  Flush(deadline);
+  auto handle = MakeResultHandle(ReadResult(deadline, nullptr));
+  if (handle && IsStreamedRows(PQresultStatus(handle.get()))) {
+    return MakeResult(std::move(handle));
+  }
+  // The final result carries no rows, the rest of the results must be
+  // consumed before reporting it or an error
+  while (auto* pg_res = ReadResult(deadline, nullptr)) {
+    handle = MakeResultHandle(pg_res);
+  }
+  MakeResult(std::move(handle));
+  return std::nullopt;
+}
+
+void PGConnectionWrapper::PutCopyData(std::string_view data,
+                                      Deadline deadline) {
+  int put_res = 0;
+  while (!put_res) {
+    put_res = PQputCopyData(conn_, data.data(), static_cast<int>(data.size()));
+    if (put_res < 0) {
+      HandleSocketPostClose();
+      throw CommandError(std::string{"PQputCopyData execution error: "} +
+                         PQerrorMessage(conn_));
+    }
+    // Zero means that the data was not queued because of full buffers,
+    // flushing is required either way to make the producer wait for the
+    // socket instead of growing libpq output buffer
+    Flush(deadline);
+  }
+  UpdateLastUse();
+}
+
+void PGConnectionWrapper::PutCopyEnd(Deadline deadline,
+                                     const char* error_message) {
+  int put_res = 0;
+  while (!put_res) {
+    put_res = PQputCopyEnd(conn_, error_message);
+    if (put_res < 0) {
+      HandleSocketPostClose();
+      throw CommandError(std::string{"PQputCopyEnd execution error: "} +
+                         PQerrorMessage(conn_));
+    }
+    if (!put_res) Flush(deadline);
+  }
+  UpdateLastUse();
+}
+
+bool PGConnectionWrapper::GetCopyData(std::string& data, Deadline deadline) {
+  char* buffer = nullptr;
+  int get_res = PQgetCopyData(conn_, &buffer, /* async = */ 1);
+  while (!get_res) {
+    HandleSocketPostClose();
+    if (!WaitSocketReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted("Task cancelled while reading COPY data");
+      }
+      PGCW_LOG_LIMITED_WARNING()
+          << "Timeout while reading COPY data from PostgreSQL connection "
+             "socket";
+      throw ConnectionTimeoutError("Timed out while reading COPY data");
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+    UpdateLastUse();
+    get_res = PQgetCopyData(conn_, &buffer, /* async = */ 1);
+  }
+  if (get_res == -1) {
+    // COPY is done, the result of the command is available with PQgetResult
+    return false;
+  }
+  if (get_res < 0) {
+    HandleSocketPostClose();
+    throw CommandError(std::string{"PQgetCopyData execution error: "} +
+                       PQerrorMessage(conn_));
+  }
+  const std::unique_ptr<char, decltype(&PQfreemem)> holder{buffer,
+                                                           &PQfreemem};
+  data.assign(buffer, get_res);
+  return true;
+}
+
 Notification PGConnectionWrapper::WaitNotify(Deadline deadline) {
   auto notify = std::unique_ptr<PGnotify, decltype(&PQfreemem)>(
       PQnotifies(conn_), &PQfreemem);
@@ -582,7 +714,7 @@ Notification PGConnectionWrapper::WaitNotify(Deadline deadline) {
   return result;
 }
 
-std::vector<ResultSet> PGConnectionWrapper::GatherPipeline(
+std::vector<Connection::PipelineResult> PGConnectionWrapper::GatherPipeline(
     [[maybe_unused]] Deadline deadline,
     const std::vector<const PGresult*>& descriptions) {
   UASSERT(!descriptions.empty());
@@ -592,7 +724,7 @@ std::vector<ResultSet> PGConnectionWrapper::GatherPipeline(
 #else
   Flush(deadline);
 
-  std::vector<ResultSet> result{};
+  std::vector<Connection::PipelineResult> result{};
   const PGresult* current_description = descriptions.front();
 
   std::size_t null_res_counter{0};
@@ -628,7 +760,21 @@ std::vector<ResultSet> PGConnectionWrapper::GatherPipeline(
                std::string_view{first_field_name} == kSetConfigQueryResultName;
       }();
       if (!is_set_config_response) {
-        result.push_back(MakeResult(std::move(handle)));
+        auto& single_result = result.emplace_back();
+        if (PQresultStatus(handle.get()) == PGRES_FATAL_ERROR) {
+          // An error of this very query, the following ones are executed
+          // after its pipeline sync. Errors of the connection itself are
+          // thrown as usual.
+          try {
+            single_result.result = MakeResult(std::move(handle));
+          } catch (const ConnectionError&) {
+            throw;
+          } catch (const Error&) {
+            single_result.error = std::current_exception();
+          }
+        } else {
+          single_result.result = MakeResult(std::move(handle));
+        }
       }
     }
 
@@ -704,16 +850,20 @@ ResultSet PGConnectionWrapper::MakeResult(ResultHandle&& handle) {
       PGCW_LOG_TRACE() << "Successful completion of a command returning data";
       break;
     case PGRES_SINGLE_TUPLE:
-      PGCW_LOG_LIMITED_ERROR()
-          << "libpq was switched to SINGLE_ROW mode, this is not supported.";
-      CloseWithError(NotImplemented{"Single row mode is not supported"});
+#if LIBPQ_HAS_CHUNK_MODE
+    case PGRES_TUPLES_CHUNK:
+#endif
+      PGCW_LOG_TRACE() << "Rows of a streamed result";
+      break;
     case PGRES_COPY_IN:
     case PGRES_COPY_OUT:
     case PGRES_COPY_BOTH:
       PGCW_LOG_LIMITED_ERROR()
-          << "PostgreSQL COPY command invoked which is not implemented"
+          << "PostgreSQL COPY command invoked outside of a COPY stream"
           << logging::LogExtra::Stacktrace();
-      CloseWithError(NotImplemented{"Copy is not implemented"});
+      CloseWithError(NotImplemented{
+          "COPY is supported only via Transaction::CopyIn and "
+          "Transaction::CopyOut"});
     case PGRES_BAD_RESPONSE:
       CloseWithError(ConnectionError{"Failed to parse server response"});
     case PGRES_NONFATAL_ERROR: {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <optional>
 #include <string_view>
 
 #include <libpq-fe.h>
@@ -106,6 +107,37 @@ class PGConnectionWrapper {
   void SendPortalExecute(const std::string& portal_name, std::uint32_t n_rows,
                          tracing::ScopeTime&);
 
+  /// @brief Wait for a COPY statement sent by SendQuery to start the data
+  /// transfer in the expected direction (PGRES_COPY_IN or PGRES_COPY_OUT).
+  /// Will throw an exception if the statement failed or is not such COPY.
+  /// Returns true if the data is in binary format
+  bool WaitCopyStart(Deadline deadline, tracing::ScopeTime&,
+                     ExecStatusType expected);
+
+  /// @brief Wrapper for PQputCopyData
+  /// Suspends until the data is sent to the server
+  void PutCopyData(std::string_view data, Deadline deadline);
+
+  /// @brief Wrapper for PQputCopyEnd
+  /// A non-null error message aborts the COPY. The COPY result should be read
+  /// with WaitResult after that
+  void PutCopyEnd(Deadline deadline, const char* error_message);
+
+  /// @brief Wrapper for PQgetCopyData
+  /// Replaces the contents of `data` with the next row of COPY data.
+  /// Returns false at the end of data, the COPY result should be read with
+  /// WaitResult after that
+  bool GetCopyData(std::string& data, Deadline deadline);
+
+  /// @brief Switch the query just sent to single-row mode, or to chunked rows
+  /// mode if libpq supports it. Must be called before reading any result
+  void SetRowsMode();
+
+  /// @brief Wait for the next rows of a query switched by SetRowsMode.
+  /// Returns std::nullopt after the last rows, will throw an exception if the
+  /// query failed
+  std::optional<ResultSet> WaitRows(Deadline deadline);
+
   /// @brief Wait for query result
   /// Will return result or throw an exception
   ResultSet WaitResult(Deadline deadline, tracing::ScopeTime&,
@@ -114,7 +146,10 @@ class PGConnectionWrapper {
   /// @brief Wait for notification
   Notification WaitNotify(Deadline deadline);
 
-  std::vector<ResultSet> GatherPipeline(
+  /// @brief Read results of the queries sent into the pipeline
+  /// An error of a query is returned in place of its result, the results of
+  /// the following queries are still read
+  std::vector<Connection::PipelineResult> GatherPipeline(
       Deadline deadline, const std::vector<const PGresult*>& descriptions);
 
   /// Consume input from connection
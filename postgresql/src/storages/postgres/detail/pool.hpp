@@ -94,6 +94,10 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
 
   void SetMaxConnectionsCc(std::size_t max_connections);
 
+  /// Accounts a statement executed by the QueryBatcher as an out-of-transaction
+  /// execution of its own, like the ones of NonTransaction
+  void AccountBatchedStatement(const Connection::Statistics& stats);
+
   dynamic_config::Source GetConfigSource() const;
 
  private:
@@ -121,6 +125,7 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   void DropOutdatedConnection(Connection* connection);
 
   void AccountConnectionStats(Connection::Statistics stats);
+  void AccountTransactionStats(const Connection::Statistics& stats);
 
   Connection* AcquireImmediate();
   void MaintainConnections();
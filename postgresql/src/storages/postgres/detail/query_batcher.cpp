@@ -0,0 +1,384 @@
+#include <storages/postgres/detail/query_batcher.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <optional>
+
+#include <fmt/format.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <storages/postgres/detail/pool.hpp>
+#include <storages/postgres/detail/tracing_tags.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+const std::string kBatchedQuery = "pg_query_batched";
+
+}  // namespace
+
+struct QueryBatcher::Request final {
+  Request(CommandControl cmd_ctl, const Query& query,
+          ParamsWriter params_writer, engine::Deadline deadline,
+          const tracing::Span& span)
+      : cmd_ctl{cmd_ctl},
+        query{query},
+        params_writer{params_writer},
+        deadline{deadline},
+        trace_id{span.GetTraceId()},
+        span_id{span.GetSpanId()},
+        link{span.GetLink()} {}
+
+  // The span of the batch task that continues the span of the caller
+  tracing::Span MakeSpan(std::size_t batch_size) const {
+    auto span = tracing::Span::MakeSpan(kBatchedQuery, trace_id, span_id, link);
+    span.AddTag("batch_size", batch_size);
+    return span;
+  }
+
+  void SetResult(ResultSet&& result) {
+    done = true;
+    promise.set_value(std::move(result));
+  }
+
+  void SetError(std::exception_ptr error) {
+    done = true;
+    promise.set_exception(std::move(error));
+  }
+
+  const CommandControl cmd_ctl;
+  const Query query;
+  const ParamsWriter params_writer;
+  const engine::Deadline deadline;
+  const std::string trace_id;
+  const std::string span_id;
+  const std::string link;
+  DynamicQueryParameters params;
+  engine::Promise<ResultSet> promise;
+
+  // Protected by the channel mutex
+  bool taken{false};
+  bool abandoned{false};
+  std::optional<SteadyClock::time_point> send_time;
+
+  // Accessed by the channel task only
+  bool done{false};
+};
+
+struct QueryBatcher::Channel final {
+  engine::Mutex mutex;
+  engine::ConditionVariable queue_cv;
+  std::deque<RequestPtr> queue;
+};
+
+QueryBatcher::QueryBatcher(std::shared_ptr<ConnectionPool> pool,
+                           const QueryBatchingSettings& settings,
+                           const testsuite::PostgresControl& testsuite_pg_ctl)
+    : pool_{std::move(pool)},
+      max_in_flight_{std::max<std::size_t>(settings.max_in_flight, 1)},
+      testsuite_pg_ctl_{testsuite_pg_ctl} {
+  UASSERT(pool_);
+  UASSERT(settings.connections > 0);
+  channels_.reserve(settings.connections);
+  for (std::size_t i = 0; i < settings.connections; ++i) {
+    auto& channel = *channels_.emplace_back(std::make_unique<Channel>());
+    tasks_.Detach(
+        engine::CriticalAsyncNoSpan([this, &channel] { Run(channel); }));
+  }
+}
+
+QueryBatcher::~QueryBatcher() {
+  tasks_.CancelAndWait();
+  for (auto& channel : channels_) {
+    FailQueued(*channel, MakeShutdownError());
+  }
+  // The callers lock the channel mutex after their result is set
+  callers_.WaitForAllTokens();
+}
+
+ResultSet QueryBatcher::Execute(CommandControl cmd_ctl, const Query& query,
+                                ParamsWriter params_writer) {
+  const auto caller_token = callers_.GetToken();
+  tracing::Span span{scopes::kQuery};
+  span.AddTag("network_timeout_ms", cmd_ctl.execute.count());
+  span.AddTag("statement_timeout_ms", cmd_ctl.statement.count());
+  query.FillSpanTags(span);
+
+  Connection::Statistics stats;
+  stats.trx_total = 1;
+  stats.out_of_trx = 1;
+  stats.trx_start_time = SteadyClock::now();
+
+  auto request = std::make_shared<Request>(
+      cmd_ctl, query, params_writer,
+      testsuite_pg_ctl_.MakeExecuteDeadline(cmd_ctl.execute), span);
+  auto future = request->promise.get_future();
+
+  auto& channel = *channels_[next_channel_.fetch_add(
+                                 1, std::memory_order_relaxed) %
+                             channels_.size()];
+  {
+    std::lock_guard lock{channel.mutex};
+    channel.queue.push_back(request);
+  }
+  channel.queue_cv.NotifyOne();
+
+  const auto status = future.wait_until(request->deadline);
+  {
+    // The parameters of a taken request are already written, so the
+    // params_writer is not used anymore. The result will be discarded.
+    std::lock_guard lock{channel.mutex};
+    if (!request->taken) {
+      request->abandoned = true;
+    }
+    if (request->send_time) {
+      ++stats.execute_total;
+      stats.work_start_time = *request->send_time;
+    } else {
+      stats.work_start_time = SteadyClock::now();
+    }
+  }
+
+  const auto account = [this, &stats](bool completed) {
+    stats.trx_end_time = stats.last_execute_finish = SteadyClock::now();
+    if (!completed) ++stats.error_execute_total;
+    if (stats.execute_total) {
+      stats.sum_query_duration = stats.trx_end_time - stats.work_start_time;
+    }
+    pool_->AccountBatchedStatement(stats);
+  };
+
+  std::optional<ResultSet> result;
+  try {
+    if (status == engine::FutureStatus::kCancelled) {
+      throw ConnectionInterrupted{
+          "Task cancelled while waiting for the batched query result"};
+    }
+    if (status != engine::FutureStatus::kReady) {
+      throw ConnectionTimeoutError{
+          "Timed out while waiting for the batched query result"};
+    }
+    result.emplace(future.get());
+  } catch (const ConnectionTimeoutError&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    ++stats.execute_timeout;
+    account(false);
+    throw;
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    account(false);
+    throw;
+  }
+
+  if (result->FieldCount()) ++stats.reply_total;
+  account(true);
+  if (query.GetName()) {
+    pool_->GetStatementTimingsStorage().Account(
+        query.GetName()->GetUnderlying(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            stats.trx_end_time - stats.trx_start_time)
+            .count());
+  }
+  return std::move(*result);
+}
+
+void QueryBatcher::Run(Channel& channel) {
+  while (true) {
+    auto acquire_deadline = engine::Deadline::Passed();
+    {
+      std::unique_lock lock{channel.mutex};
+      if (!channel.queue_cv.Wait(
+              lock, [&channel] { return !channel.queue.empty(); })) {
+        lock.unlock();
+        FailQueued(channel, MakeShutdownError());
+        return;
+      }
+      for (const auto& request : channel.queue) {
+        if (acquire_deadline.TimeLeft() < request->deadline.TimeLeft()) {
+          acquire_deadline = request->deadline;
+        }
+      }
+    }
+
+    // The connection is returned to the pool after every batch, so that it
+    // is balanced and maintained by the pool as usual
+    std::optional<ConnectionPtr> conn;
+    try {
+      conn.emplace(pool_->Acquire(acquire_deadline));
+    } catch (const std::exception& e) {
+      LOG_LIMITED_WARNING() << "Failed to acquire a connection for batched "
+                               "queries: "
+                            << e;
+      FailQueued(channel, std::current_exception());
+      continue;
+    }
+
+    auto batch = TakeBatch(channel, (*conn)->GetUserTypes());
+    if (batch.empty()) continue;
+
+    if ((*conn)->IsPipelineActive() &&
+        (*conn)->ArePreparedStatementsEnabled()) {
+      ExecutePipelined(**conn, batch);
+    } else {
+      ExecuteSequentially(**conn, batch);
+    }
+  }
+}
+
+QueryBatcher::Batch QueryBatcher::TakeBatch(Channel& channel,
+                                            const UserTypes& types) {
+  Batch batch;
+  std::deque<RequestPtr> rest;
+  // Queries with a different statement timeout would require a SET between
+  // them, which is not possible while the pipeline is syncing
+  std::optional<TimeoutDuration> statement_timeout;
+
+  std::lock_guard lock{channel.mutex};
+  for (auto& request : channel.queue) {
+    if (request->abandoned) continue;
+
+    if (batch.size() >= max_in_flight_ ||
+        (statement_timeout &&
+         *statement_timeout != request->cmd_ctl.statement)) {
+      rest.push_back(std::move(request));
+      continue;
+    }
+
+    request->taken = true;
+    if (request->deadline.IsReached()) {
+      request->SetError(std::make_exception_ptr(ConnectionTimeoutError{
+          "Deadline reached before sending the batched query"}));
+      continue;
+    }
+    try {
+      request->params = request->params_writer(types);
+    } catch (const std::exception&) {
+      request->SetError(std::current_exception());
+      continue;
+    }
+    statement_timeout = request->cmd_ctl.statement;
+    request->send_time = SteadyClock::now();
+    batch.push_back(std::move(request));
+  }
+  channel.queue.swap(rest);
+
+  return batch;
+}
+
+void QueryBatcher::FailQueued(Channel& channel, std::exception_ptr error) {
+  std::lock_guard lock{channel.mutex};
+  for (auto& request : channel.queue) {
+    if (request->abandoned) continue;
+    request->taken = true;
+    request->SetError(error);
+  }
+  channel.queue.clear();
+}
+
+std::exception_ptr QueryBatcher::MakeShutdownError() {
+  return std::make_exception_ptr(
+      ConnectionInterrupted{"Query batcher is shutting down"});
+}
+
+void QueryBatcher::ExecutePipelined(Connection& conn, Batch& batch) {
+  std::vector<tracing::Span> spans;
+  spans.reserve(batch.size());
+  for (const auto& request : batch) {
+    spans.push_back(request->MakeSpan(batch.size()));
+    spans.back().DetachFromCoroStack();
+  }
+
+  try {
+    // All the statements must be prepared before anything is sent into the
+    // pipeline, as preparing waits for the server response
+    Batch sent;
+    std::vector<tracing::Span*> sent_spans;
+    std::vector<std::string> statement_names;
+    std::vector<ResultSet> descriptions;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      auto& request = batch[i];
+      try {
+        auto meta = conn.PrepareStatement(request->query,
+                                          QueryParameters{request->params},
+                                          request->cmd_ctl.execute);
+        statement_names.push_back(std::move(meta.statement_name));
+        descriptions.push_back(std::move(meta.description));
+        sent.push_back(request);
+        sent_spans.push_back(&spans[i]);
+      } catch (const Error&) {
+        if (conn.IsBroken()) throw;
+        spans[i].AddTag(tracing::kErrorFlag, true);
+        request->SetError(std::current_exception());
+      }
+    }
+    if (sent.empty()) return;
+
+    TimeoutDuration timeout{0};
+    for (std::size_t i = 0; i < sent.size(); ++i) {
+      const auto& request = sent[i];
+      timeout = std::max(timeout, std::chrono::duration_cast<TimeoutDuration>(
+                                      request->deadline.TimeLeft()));
+      auto scope = sent_spans[i]->CreateScopeTime();
+      conn.AddIntoPipeline(request->cmd_ctl, statement_names[i],
+                           QueryParameters{request->params}, descriptions[i],
+                           scope);
+    }
+
+    auto results = conn.GatherPipelineResults(timeout, descriptions);
+    if (results.size() != sent.size()) {
+      throw RuntimeError{
+          fmt::format("Query batch results count mismatch: expected {}, got {}",
+                      sent.size(), results.size())};
+    }
+    for (std::size_t i = 0; i < sent.size(); ++i) {
+      if (results[i].error) {
+        sent_spans[i]->AddTag(tracing::kErrorFlag, true);
+        sent[i]->SetError(results[i].error);
+      } else {
+        sent[i]->SetResult(std::move(results[i].result));
+      }
+    }
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Query batch failed: " << e;
+    const auto error = std::current_exception();
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      if (batch[i]->done) continue;
+      spans[i].AddTag(tracing::kErrorFlag, true);
+      batch[i]->SetError(error);
+    }
+  }
+}
+
+void QueryBatcher::ExecuteSequentially(Connection& conn, Batch& batch) {
+  for (auto& request : batch) {
+    auto span = request->MakeSpan(batch.size());
+    try {
+      if (request->deadline.IsReached()) {
+        throw ConnectionTimeoutError{
+            "Deadline reached before sending the batched query"};
+      }
+      request->SetResult(
+          conn.Execute(request->query, QueryParameters{request->params},
+                       OptionalCommandControl{request->cmd_ctl}));
+    } catch (const std::exception&) {
+      span.AddTag(tracing::kErrorFlag, true);
+      request->SetError(std::current_exception());
+    }
+  }
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/testsuite/postgres_control.hpp>
+#include <userver/utils/function_ref.hpp>
+#include <userver/utils/impl/wait_token_storage.hpp>
+
+#include <userver/storages/postgres/detail/connection_ptr.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+class Connection;
+class ConnectionPool;
+
+/// @brief Multiplexes single statements of different tasks onto a few
+/// pipelined connections of a pool.
+///
+/// Every batching connection is served by a background task. Queries that
+/// were enqueued while the previous batch was in flight are prepared, sent
+/// into the pipeline and gathered together, so that a single network
+/// round-trip serves many tasks. Every query is followed by its own pipeline
+/// sync, so an error in one query does not affect the others.
+///
+/// The connections are acquired from the pool for the time of a batch, so
+/// the pool keeps maintaining them as usual. Every query is traced, accounted
+/// in the pool statistics and in the statement metrics as an
+/// out-of-transaction execution of its own.
+class QueryBatcher final {
+ public:
+  using ParamsWriter =
+      USERVER_NAMESPACE::utils::function_ref<DynamicQueryParameters(
+          const UserTypes&)>;
+
+  QueryBatcher(std::shared_ptr<ConnectionPool> pool,
+               const QueryBatchingSettings& settings,
+               const testsuite::PostgresControl& testsuite_pg_ctl);
+  ~QueryBatcher();
+
+  QueryBatcher(const QueryBatcher&) = delete;
+  QueryBatcher& operator=(const QueryBatcher&) = delete;
+
+  /// Enqueue the query and suspend until its result is ready or
+  /// `cmd_ctl.execute` expires. Queries that are still queued when the
+  /// batcher is destroyed fail with ConnectionInterrupted, the destructor
+  /// waits for their callers to leave Execute.
+  /// `params_writer` is called with the user types of the connection the
+  /// query is sent to, it is not called after Execute returns.
+  ResultSet Execute(CommandControl cmd_ctl, const Query& query,
+                    ParamsWriter params_writer);
+
+ private:
+  struct Request;
+  struct Channel;
+
+  using RequestPtr = std::shared_ptr<Request>;
+  using Batch = std::vector<RequestPtr>;
+
+  void Run(Channel& channel);
+
+  Batch TakeBatch(Channel& channel, const UserTypes& types);
+  void FailQueued(Channel& channel, std::exception_ptr error);
+  static std::exception_ptr MakeShutdownError();
+
+  void ExecutePipelined(Connection& conn, Batch& batch);
+  void ExecuteSequentially(Connection& conn, Batch& batch);
+
+  std::shared_ptr<ConnectionPool> pool_;
+  const std::size_t max_in_flight_;
+  testsuite::PostgresControl testsuite_pg_ctl_;
+  std::vector<std::unique_ptr<Channel>> channels_;
+  std::atomic<std::size_t> next_channel_{0};
+  USERVER_NAMESPACE::utils::impl::WaitTokenStorage callers_;
+  concurrent::BackgroundTaskStorageCore tasks_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,80 @@
+#include <userver/storages/postgres/result_stream.hpp>
+
+#include <utility>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+ResultStream::ResultStream(detail::Connection* conn, const Query& query,
+                           const detail::QueryParameters& params,
+                           OptionalCommandControl cmd_ctl)
+    : conn_{conn} {
+  UASSERT(conn_);
+  conn_->StartStream(query, params, std::move(cmd_ctl));
+}
+
+ResultStream::ResultStream(detail::ConnectionPtr&& conn, const Query& query,
+                           const detail::QueryParameters& params,
+                           OptionalCommandControl cmd_ctl)
+    : owned_conn_{std::move(conn)}, conn_{owned_conn_->get()} {
+  UASSERT(conn_);
+  conn_->StartStream(query, params, std::move(cmd_ctl));
+}
+
+ResultStream::ResultStream(ResultStream&& other) noexcept
+    : owned_conn_{std::exchange(other.owned_conn_, std::nullopt)},
+      conn_{std::exchange(other.conn_, nullptr)},
+      rows_{std::exchange(other.rows_, std::nullopt)},
+      row_index_{other.row_index_},
+      rows_read_{other.rows_read_},
+      done_{std::exchange(other.done_, true)} {}
+
+ResultStream::~ResultStream() {
+  if (owned_conn_) {
+    // An unfinished statement is cancelled when the connection is returned to
+    // the pool
+    (*owned_conn_)->Finish();
+  } else if (conn_ && !done_) {
+    LOG_LIMITED_WARNING() << "Result stream is destroyed before reading all "
+                             "the rows, the connection stays busy until "
+                             "cleanup";
+  }
+}
+
+std::optional<ResultSet> ResultStream::FetchRows() {
+  if (!FetchChunk()) return std::nullopt;
+  rows_read_ += rows_->Size();
+  return std::exchange(rows_, std::nullopt);
+}
+
+bool ResultStream::HasRow() {
+  while (!rows_ || row_index_ >= rows_->Size()) {
+    if (!FetchChunk()) return false;
+  }
+  return true;
+}
+
+bool ResultStream::FetchChunk() {
+  rows_.reset();
+  row_index_ = 0;
+  if (done_) return false;
+  try {
+    rows_ = conn_->FetchStreamRows();
+  } catch (const std::exception&) {
+    done_ = true;
+    throw;
+  }
+  if (!rows_) {
+    done_ = true;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/portal.hpp>
+#include <userver/storages/postgres/result_stream.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+
+constexpr std::uint32_t kPortalChunkSize = 1000;
+
+const pg::Query kSelectRows{
+    "select i, repeat('x', 32) from generate_series(1, $1) i"};
+
+struct BenchRow {
+  int id{};
+  std::string value;
+};
+
+BENCHMARK_DEFINE_F(PgConnection, StreamRows)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto count = static_cast<int>(state.range(0));
+    pg::detail::StaticQueryParameters<1> params;
+    params.Write(GetConnection().GetUserTypes(), count);
+    for (auto _ : state) {
+      pg::ResultStream stream{&GetConnection(), kSelectRows,
+                              pg::detail::QueryParameters{params}};
+      BenchRow row;
+      while (stream.ReadRow(row, pg::kRowTag)) {
+        benchmark::DoNotOptimize(row);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, StreamRows)->Range(1 << 6, 1 << 16);
+
+BENCHMARK_DEFINE_F(PgConnection, PortalFetch)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto count = static_cast<int>(state.range(0));
+    pg::detail::StaticQueryParameters<1> params;
+    params.Write(GetConnection().GetUserTypes(), count);
+    for (auto _ : state) {
+      GetConnection().Begin({}, pg::detail::SteadyClock::now());
+      pg::Portal portal{&GetConnection(), kSelectRows,
+                        pg::detail::QueryParameters{params}};
+      while (portal) {
+        auto res = portal.Fetch(kPortalChunkSize);
+        for (auto row : res.AsSetOf<BenchRow>(pg::kRowTag)) {
+          benchmark::DoNotOptimize(row);
+        }
+      }
+      GetConnection().Commit();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, PortalFetch)->Range(1 << 6, 1 << 16);
+
+BENCHMARK_DEFINE_F(PgConnection, ExecuteRows)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+      auto res = GetConnection().Execute(kSelectRows, count);
+      for (auto row : res.AsSetOf<BenchRow>(pg::kRowTag)) {
+        benchmark::DoNotOptimize(row);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, ExecuteRows)->Range(1 << 6, 1 << 16);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -7,6 +7,7 @@
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/postgres_config.hpp>
 #include <userver/dynamic_config/test_helpers.hpp>
+#include <userver/engine/async.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/dsn.hpp>
 #include <userver/storages/postgres/exceptions.hpp>
@@ -45,7 +46,8 @@ void CheckRwTransaction(pg::Transaction trx) {
 pg::Cluster CreateCluster(
     const pg::DsnList& dsns, engine::TaskProcessor& bg_task_processor,
     size_t max_size, testsuite::TestsuiteTasks& testsuite_tasks,
-    pg::ConnectionSettings conn_settings = kCachePreparedStatements) {
+    pg::ConnectionSettings conn_settings = kCachePreparedStatements,
+    pg::QueryBatchingSettings batching_settings = {}) {
   auto source = dynamic_config::GetDefaultSource();
   return pg::Cluster(dsns, nullptr, bg_task_processor,
                      {{},
@@ -55,7 +57,8 @@ pg::Cluster CreateCluster(
                       storages::postgres::InitMode::kAsync,
                       "",
                       {},
-                      {}},
+                      {},
+                      batching_settings},
                      {kTestCmdCtl, {}, {}}, {}, {}, testsuite_tasks, source, 0);
 }
 
@@ -399,6 +402,113 @@ UTEST_F(PostgreCluster, NonTransactionExecuteWithParameterStoreMove) {
   }
 }
 
+// Statements are batched only on slave hosts. With a single host in the
+// environment kSlave falls back to the master and the statements below are
+// executed without batching, the results must be the same.
+UTEST_F_MT(PostgreCluster, QueryBatching, 4) {
+  testsuite::TestsuiteTasks testsuite_tasks{true};
+  auto cluster = CreateCluster(GetDsnListFromEnv(), GetTaskProcessor(), 4,
+                               testsuite_tasks, kPipelineEnabled, {2, 8});
+
+  constexpr int kTasks = 100;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasks);
+  for (int i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&cluster, i] {
+      const auto res = cluster.Execute(pg::ClusterHostType::kSlave,
+                                       "select $1::integer + 1", i);
+      EXPECT_EQ(i + 1, res.AsSingleRow<int>());
+    }));
+  }
+  for (auto& task : tasks) {
+    UEXPECT_NO_THROW(task.Get());
+  }
+
+  // An error in one of the batched queries does not affect the others
+  tasks.clear();
+  for (int i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&cluster, i] {
+      if (i % 10 == 0) {
+        UEXPECT_THROW(cluster.Execute(pg::ClusterHostType::kSlave,
+                                      "select 1 / ($1::integer - $1)", i),
+                      pg::DataException);
+      } else {
+        const auto res = cluster.Execute(pg::ClusterHostType::kSlave,
+                                         "select $1::integer", i);
+        EXPECT_EQ(i, res.AsSingleRow<int>());
+      }
+    }));
+  }
+  for (auto& task : tasks) {
+    UEXPECT_NO_THROW(task.Get());
+  }
+
+  // Different statement timeouts are sent in separate batches
+  const pg::CommandControl cc{utest::kMaxTestWaitTime,
+                              std::chrono::milliseconds{500}};
+  UEXPECT_NO_THROW(cluster.Execute(pg::ClusterHostType::kSlave, cc,
+                                   "select $1::integer", 1));
+  UEXPECT_THROW(cluster.Execute(pg::ClusterHostType::kSlave, cc,
+                                "select pg_sleep(1)"),
+                pg::QueryCancelled);
+
+  // Statements on master are not batched
+  UEXPECT_NO_THROW(
+      cluster.Execute(pg::ClusterHostType::kMaster, "select $1::integer", 1));
+}
+
+UTEST_F(PostgreCluster, QueryBatchingTimeout) {
+  testsuite::TestsuiteTasks testsuite_tasks{true};
+  auto cluster = CreateCluster(GetDsnListFromEnv(), GetTaskProcessor(), 1,
+                               testsuite_tasks, kPipelineEnabled, {1, 8});
+
+  const pg::CommandControl cc{std::chrono::milliseconds{100},
+                              utest::kMaxTestWaitTime};
+  UEXPECT_THROW(cluster.Execute(pg::ClusterHostType::kSlave, cc,
+                                "select pg_sleep(1)"),
+                pg::ConnectionTimeoutError);
+  UEXPECT_NO_THROW(
+      cluster.Execute(pg::ClusterHostType::kSlave, "select $1::integer", 1));
+}
+
+UTEST_F(PostgreCluster, QueryBatchingWithoutPipeline) {
+  testsuite::TestsuiteTasks testsuite_tasks{true};
+  auto cluster = CreateCluster(GetDsnListFromEnv(), GetTaskProcessor(), 1,
+                               testsuite_tasks, kCachePreparedStatements,
+                               {1, 8});
+
+  const auto res =
+      cluster.Execute(pg::ClusterHostType::kSlave, "select $1::integer", 42);
+  EXPECT_EQ(42, res.AsSingleRow<int>());
+}
+
+UTEST_F(PostgreCluster, Stream) {
+  testsuite::TestsuiteTasks testsuite_tasks{true};
+  auto cluster = CreateCluster(GetDsnListFromEnv(), GetTaskProcessor(), 1,
+                               testsuite_tasks);
+
+  {
+    auto stream = cluster.Stream(pg::ClusterHostType::kMaster,
+                                 "select generate_series(1, $1)", 1000);
+    int value{};
+    int count = 0;
+    while (stream.ReadRow(value)) {
+      EXPECT_EQ(++count, value);
+    }
+    EXPECT_EQ(1000, count);
+  }
+  {
+    // The connection of an abandoned stream is cleaned up by the pool
+    auto stream = cluster.Stream(pg::ClusterHostType::kMaster,
+                                 "select generate_series(1, $1)", 100000);
+    int value{};
+    EXPECT_TRUE(stream.ReadRow(value));
+  }
+  const auto res =
+      cluster.Execute(pg::ClusterHostType::kMaster, "select $1::integer", 42);
+  EXPECT_EQ(42, res.AsSingleRow<int>());
+}
+
 UTEST_F(PostgreCluster, ListenNotify) {
   constexpr auto kListenChannel = std::string_view{"foo"};
   constexpr auto kNotifyPayload = std::string_view{"bar"};
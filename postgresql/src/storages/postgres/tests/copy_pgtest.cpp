@@ -0,0 +1,182 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/storages/postgres/copy.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+struct CopyRow {
+  int id{};
+  std::string value;
+  std::optional<double> number;
+};
+
+bool operator==(const CopyRow& lhs, const CopyRow& rhs) {
+  return lhs.id == rhs.id && lhs.value == rhs.value &&
+         lhs.number == rhs.number;
+}
+
+std::vector<CopyRow> MakeRows(std::size_t count) {
+  std::vector<CopyRow> rows;
+  rows.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto id = static_cast<int>(i);
+    rows.push_back({id, std::to_string(id),
+                    i % 3 ? std::optional<double>{i * 0.5} : std::nullopt});
+  }
+  return rows;
+}
+
+void CreateCopyTable(pg::Transaction& trx) {
+  trx.Execute(
+      "create temporary table copy_test("
+      "id integer, value text, number double precision)");
+}
+
+UTEST_P(PostgreConnection, CopyInOut) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  CreateCopyTable(trx);
+
+  // Enough rows to be sent in several chunks
+  const auto rows = MakeRows(10000);
+  auto copy_in = trx.CopyIn(
+      "copy copy_test (id, value, number) from stdin (format binary)");
+  copy_in.WriteRows(rows);
+  EXPECT_EQ(rows.size(), copy_in.RowsWritten());
+  EXPECT_EQ(rows.size(), copy_in.Finish());
+  UEXPECT_THROW(copy_in.Finish(), pg::LogicError);
+
+  auto res = trx.Execute("select count(*) from copy_test");
+  EXPECT_EQ(rows.size(), res.Front().As<pg::Bigint>(pg::kFieldTag));
+
+  auto copy_out = trx.CopyOut(
+      "copy (select id, value, number from copy_test order by id) "
+      "to stdout (format binary)");
+  std::vector<CopyRow> read_rows;
+  CopyRow row;
+  while (copy_out.ReadRow(row)) {
+    read_rows.push_back(row);
+  }
+  EXPECT_TRUE(copy_out.Done());
+  EXPECT_FALSE(copy_out.ReadRow(row));
+  EXPECT_EQ(rows.size(), copy_out.RowsRead());
+  EXPECT_TRUE(rows == read_rows);
+
+  // The connection is usable after the COPY
+  UEXPECT_NO_THROW(trx.Execute("select 1"));
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, CopyFields) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  CreateCopyTable(trx);
+
+  auto copy_in = trx.CopyIn("copy copy_test from stdin (format binary)");
+  copy_in.WriteFields(1, std::string{"foo"}, std::optional<double>{});
+  copy_in.WriteFields(2, std::string{"bar"}, 4.2);
+  EXPECT_EQ(2, copy_in.Finish());
+
+  auto copy_out = trx.CopyOut(
+      "copy (select value from copy_test order by id) "
+      "to stdout (format binary)");
+  std::string value;
+  ASSERT_TRUE(copy_out.ReadFields(value));
+  EXPECT_EQ("foo", value);
+  ASSERT_TRUE(copy_out.ReadFields(value));
+  EXPECT_EQ("bar", value);
+  EXPECT_FALSE(copy_out.ReadFields(value));
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, CopyEmpty) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  CreateCopyTable(trx);
+
+  auto copy_in = trx.CopyIn("copy copy_test from stdin (format binary)");
+  EXPECT_EQ(0, copy_in.Finish());
+
+  auto copy_out = trx.CopyOut("copy copy_test to stdout (format binary)");
+  CopyRow row;
+  EXPECT_FALSE(copy_out.ReadRow(row));
+  EXPECT_TRUE(copy_out.Done());
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, CopyAbort) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  CreateCopyTable(trx);
+  {
+    auto copy_in = trx.CopyIn("copy copy_test from stdin (format binary)");
+    copy_in.WriteRows(MakeRows(10));
+  }
+  // The aborted COPY fails the transaction
+  UEXPECT_THROW(trx.Execute("select 1"), pg::Error);
+  trx.Rollback();
+}
+
+UTEST_P(PostgreConnection, CopyErrors) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  CreateCopyTable(trx);
+
+  UEXPECT_THROW(trx.CopyIn("select 1"), pg::LogicError);
+  UEXPECT_THROW(trx.CopyOut("copy copy_test to stdout"), pg::LogicError);
+  UEXPECT_NO_THROW(trx.Execute("select 1"));
+
+  // Text COPY IN is aborted and fails the transaction
+  UEXPECT_THROW(trx.CopyIn("copy copy_test from stdin"), pg::LogicError);
+  trx.Rollback();
+}
+
+UTEST_P(PostgreConnection, CopyWrongDirection) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  CreateCopyTable(trx);
+  UEXPECT_THROW(trx.CopyOut("copy copy_test from stdin (format binary)"),
+                pg::LogicError);
+}
+
+UTEST_P(PostgreConnection, CopyInvalidData) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  CreateCopyTable(trx);
+
+  auto copy_in = trx.CopyIn("copy copy_test from stdin (format binary)");
+  copy_in.WriteFields(1, std::string{"foo"});
+  UEXPECT_THROW(copy_in.Finish(), pg::Error);
+  trx.Rollback();
+}
+
+UTEST_P(PostgreConnection, CopyOutFieldMismatch) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  auto copy_out = trx.CopyOut("copy (select 1, 2) to stdout (format binary)");
+  int value{};
+  UEXPECT_THROW(copy_out.ReadFields(value), pg::InvalidTupleSizeRequested);
+  trx.Rollback();
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/storages/postgres/copy.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+#include <userver/utest/assert_macros.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+namespace io = pg::io;
+
+namespace {
+
+const pg::UserTypes types;
+
+io::FieldBuffer MakeBuffer(const std::string& data) {
+  return {false, io::BufferCategory::kPlainBuffer, data.size(),
+          reinterpret_cast<const std::uint8_t*>(data.data())};
+}
+
+TEST(PostgreCopy, Header) {
+  std::string data;
+  pg::detail::WriteCopyHeader(data);
+  EXPECT_EQ(data, std::string("PGCOPY\n\377\r\n\0\0\0\0\0\0\0\0\0", 19));
+
+  auto buffer = MakeBuffer(data);
+  UEXPECT_NO_THROW(pg::detail::ReadCopyHeader(buffer));
+  EXPECT_EQ(buffer.length, 0);
+
+  data[0] = 'X';
+  buffer = MakeBuffer(data);
+  UEXPECT_THROW(pg::detail::ReadCopyHeader(buffer), pg::InvalidBinaryBuffer);
+
+  const std::string truncated{"PGCOPY"};
+  buffer = MakeBuffer(truncated);
+  UEXPECT_THROW(pg::detail::ReadCopyHeader(buffer), pg::InvalidBinaryBuffer);
+}
+
+TEST(PostgreCopy, Tuple) {
+  std::string data;
+  pg::detail::WriteCopyTuple(types, data, pg::Integer{42}, std::string{"foo"},
+                             std::optional<double>{}, std::vector<int>{1, 2});
+  // field count, 4-byte length + data for each field, -1 length for null
+  EXPECT_EQ(data.substr(0, 12), std::string("\0\4\0\0\0\4\0\0\0\x2a\0\0", 12));
+
+  auto buffer = MakeBuffer(data);
+  ASSERT_TRUE(pg::detail::ReadCopyTupleHeader(buffer, 4));
+
+  pg::Integer number{0};
+  std::string text;
+  std::optional<double> nothing{1.0};
+  std::vector<int> array;
+  pg::detail::ReadCopyTuple(buffer, types.GetTypeBufferCategories(), number,
+                            text, nothing, array);
+  EXPECT_EQ(number, 42);
+  EXPECT_EQ(text, "foo");
+  EXPECT_EQ(nothing, std::nullopt);
+  EXPECT_EQ(array, (std::vector<int>{1, 2}));
+}
+
+TEST(PostgreCopy, TupleErrors) {
+  std::string data;
+  pg::detail::WriteCopyTuple(types, data, pg::Integer{42}, std::string{});
+
+  auto buffer = MakeBuffer(data);
+  UEXPECT_THROW(pg::detail::ReadCopyTupleHeader(buffer, 3),
+                pg::InvalidTupleSizeRequested);
+
+  buffer = MakeBuffer(data);
+  ASSERT_TRUE(pg::detail::ReadCopyTupleHeader(buffer, 2));
+  pg::Integer number{0};
+  UEXPECT_THROW(pg::detail::ReadCopyTuple(
+                    buffer, types.GetTypeBufferCategories(), number),
+                pg::InvalidBinaryBuffer);
+
+  data.clear();
+  pg::detail::WriteCopyTuple(types, data, std::optional<int>{});
+  buffer = MakeBuffer(data);
+  ASSERT_TRUE(pg::detail::ReadCopyTupleHeader(buffer, 1));
+  UEXPECT_THROW(pg::detail::ReadCopyTuple(
+                    buffer, types.GetTypeBufferCategories(), number),
+                pg::TypeCannotBeNull);
+}
+
+TEST(PostgreCopy, Trailer) {
+  std::string data;
+  pg::detail::WriteCopyTrailer(data);
+  EXPECT_EQ(data, "\xff\xff");
+
+  auto buffer = MakeBuffer(data);
+  EXPECT_FALSE(pg::detail::ReadCopyTupleHeader(buffer, 2));
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
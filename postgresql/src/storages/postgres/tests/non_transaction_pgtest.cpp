@@ -39,4 +39,19 @@ UTEST_P(PostgreConnection, NonTransactionStatementTimeout) {
   UEXPECT_NO_THROW(ntrx.Execute("SELECT 1"));
 }
 
+UTEST_P(PostgreConnection, NonTransactionStream) {
+  CheckConnection(GetConn());
+  pg::detail::NonTransaction ntrx(std::move(GetConn()));
+
+  auto stream = std::move(ntrx).Stream(
+      {}, "SELECT i FROM generate_series(1, $1) i", 1000);
+  int value{};
+  int sum = 0;
+  while (stream.ReadRow(value)) {
+    sum += value;
+  }
+  EXPECT_EQ(1000 * 1001 / 2, sum);
+  EXPECT_TRUE(stream.Done());
+}
+
 USERVER_NAMESPACE_END
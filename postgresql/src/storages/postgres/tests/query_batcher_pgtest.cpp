@@ -0,0 +1,287 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <userver/dynamic_config/test_helpers.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_use_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <storages/postgres/detail/pool.hpp>
+#include <storages/postgres/detail/query_batcher.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+using TimePoint = std::chrono::steady_clock::time_point;
+
+// The statements below sleep for 100ms each, the parameters of the
+// statements of a single batch are written at once
+constexpr auto kBatchGap = std::chrono::milliseconds{50};
+
+// NOLINTNEXTLINE(fuchsia-multiple-inheritance)
+class PostgreQueryBatcher
+    : public PostgreSQLBase,
+      public ::testing::WithParamInterface<pg::ConnectionSettings> {
+ protected:
+  std::shared_ptr<pg::detail::ConnectionPool> MakePool() {
+    return pg::detail::ConnectionPool::Create(
+        GetDsnFromEnv(), nullptr, GetTaskProcessor(), "", pg::InitMode::kAsync,
+        {0, 4, 16}, GetParam(), {}, GetTestCmdCtls(), {}, {}, {},
+        dynamic_config::GetDefaultSource());
+  }
+};
+
+pg::detail::DynamicQueryParameters WriteParams(const pg::UserTypes& types,
+                                               int value) {
+  pg::detail::DynamicQueryParameters params;
+  params.Write(types, value);
+  return params;
+}
+
+pg::ResultSet Execute(pg::detail::QueryBatcher& batcher,
+                      const pg::Query& query, int value,
+                      pg::CommandControl cmd_ctl = kTestCmdCtl) {
+  return batcher.Execute(cmd_ctl, query, [value](const pg::UserTypes& types) {
+    return WriteParams(types, value);
+  });
+}
+
+// Executes the statement in the background, `written` records the time the
+// parameters were written, i.e. the time the request was taken into a batch
+engine::TaskWithResult<pg::ResultSet> ExecuteAsync(
+    pg::detail::QueryBatcher& batcher, const pg::Query& query, int value,
+    TimePoint& written, pg::CommandControl cmd_ctl = kTestCmdCtl) {
+  return engine::AsyncNoSpan([&batcher, query, value, &written, cmd_ctl] {
+    return batcher.Execute(cmd_ctl, query,
+                           [value, &written](const pg::UserTypes& types) {
+                             written = std::chrono::steady_clock::now();
+                             return WriteParams(types, value);
+                           });
+  });
+}
+
+// Occupies the channel of a single connection batcher until the returned
+// task is finished
+engine::TaskWithResult<pg::ResultSet> Block(pg::detail::QueryBatcher& batcher,
+                                            std::chrono::milliseconds time) {
+  engine::SingleUseEvent taken;
+  auto task = engine::AsyncNoSpan([&batcher, &taken, time] {
+    return batcher.Execute(
+        kTestCmdCtl, "select pg_sleep($1::integer / 1000.0)",
+        [&taken, time](const pg::UserTypes& types) {
+          taken.Send();
+          return WriteParams(types, static_cast<int>(time.count()));
+        });
+  });
+  taken.WaitNonCancellable();
+  return task;
+}
+
+// Splits the times of writing the parameters into batches
+std::vector<std::size_t> GetBatchSizes(std::vector<TimePoint> times) {
+  std::sort(times.begin(), times.end());
+  std::vector<std::size_t> sizes;
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    if (i == 0 || times[i] - times[i - 1] > kBatchGap) sizes.push_back(0);
+    ++sizes.back();
+  }
+  return sizes;
+}
+
+}  // namespace
+
+INSTANTIATE_UTEST_SUITE_P(
+    BatchingSettings, PostgreQueryBatcher,
+    ::testing::Values(kCachePreparedStatements, kPipelineEnabled),
+    [](const testing::TestParamInfo<PostgreQueryBatcher::ParamType>& info) {
+      if (info.param.pipeline_mode == pg::PipelineMode::kEnabled) {
+        return "Pipelined";
+      } else {
+        return "Sequential";
+      }
+    });
+
+UTEST_P_MT(PostgreQueryBatcher, ConcurrentResults, 4) {
+  const auto pool = MakePool();
+  const auto& stats = pool->GetStatistics().transaction;
+  const std::uint32_t total_before = stats.total;
+  const std::uint32_t out_of_trx_before = stats.out_of_trx_total;
+  const std::uint32_t errors_before = stats.error_execute_total;
+  {
+    pg::detail::QueryBatcher batcher{pool, {2, 8}, {}};
+
+    constexpr int kTasks = 100;
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(kTasks);
+    for (int i = 0; i < kTasks; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&batcher, i] {
+        const auto res = Execute(batcher, "select $1::integer + 1", i);
+        EXPECT_EQ(i + 1, res.AsSingleRow<int>());
+      }));
+    }
+    for (auto& task : tasks) {
+      UEXPECT_NO_THROW(task.Get());
+    }
+  }
+
+  // Every statement is accounted as an out-of-transaction execution
+  EXPECT_EQ(stats.total - total_before, 100);
+  EXPECT_EQ(stats.out_of_trx_total - out_of_trx_before, 100);
+  EXPECT_EQ(stats.error_execute_total - errors_before, 0);
+}
+
+UTEST_P_MT(PostgreQueryBatcher, QueryErrors, 4) {
+  pg::detail::QueryBatcher batcher{MakePool(), {1, 8}, {}};
+
+  // An error in one of the batched queries does not affect the others
+  constexpr int kTasks = 50;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasks);
+  for (int i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&batcher, i] {
+      if (i % 10 == 0) {
+        UEXPECT_THROW(Execute(batcher, "select 1 / ($1::integer - $1)", i),
+                      pg::DataException);
+      } else if (i % 10 == 5) {
+        // Fails when the statement is prepared
+        UEXPECT_THROW(Execute(batcher, "selec $1::integer", i),
+                      pg::SyntaxError);
+      } else {
+        const auto res = Execute(batcher, "select $1::integer", i);
+        EXPECT_EQ(i, res.AsSingleRow<int>());
+      }
+    }));
+  }
+  for (auto& task : tasks) {
+    UEXPECT_NO_THROW(task.Get());
+  }
+
+  // A failure to write the parameters fails only its own query
+  UEXPECT_THROW_MSG(
+      batcher.Execute(kTestCmdCtl, "select $1::integer",
+                      [](const pg::UserTypes&)
+                          -> pg::detail::DynamicQueryParameters {
+                        throw std::runtime_error("params failure");
+                      }),
+      std::runtime_error, "params failure");
+  EXPECT_EQ(1, Execute(batcher, "select $1::integer", 1).AsSingleRow<int>());
+}
+
+UTEST_P(PostgreQueryBatcher, MaxInFlight) {
+  pg::detail::QueryBatcher batcher{MakePool(), {1, 2}, {}};
+
+  auto blocker = Block(batcher, std::chrono::milliseconds{200});
+  constexpr std::size_t kTasks = 5;
+  std::vector<TimePoint> written(kTasks);
+  std::vector<engine::TaskWithResult<pg::ResultSet>> tasks;
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(ExecuteAsync(batcher,
+                                 "select $1::integer from pg_sleep(0.1)",
+                                 static_cast<int>(i), written[i]));
+  }
+
+  UEXPECT_NO_THROW(blocker.Get());
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    EXPECT_EQ(static_cast<int>(i), tasks[i].Get().AsSingleRow<int>());
+  }
+  EXPECT_EQ(GetBatchSizes(written), (std::vector<std::size_t>{2, 2, 1}));
+}
+
+UTEST_P(PostgreQueryBatcher, StatementTimeoutGroups) {
+  pg::detail::QueryBatcher batcher{MakePool(), {1, 8}, {}};
+
+  const pg::CommandControl short_cc{utest::kMaxTestWaitTime,
+                                    std::chrono::milliseconds{1000}};
+  const pg::CommandControl long_cc{utest::kMaxTestWaitTime,
+                                   std::chrono::milliseconds{2000}};
+  const pg::Query kQuery{"select $1::integer from pg_sleep(0.1)"};
+
+  auto blocker = Block(batcher, std::chrono::milliseconds{200});
+  std::vector<TimePoint> written(3);
+  // The tasks enqueue their requests in order, as the test has a single
+  // thread. The second one requires a different statement timeout.
+  auto first = ExecuteAsync(batcher, kQuery, 1, written[0], short_cc);
+  auto second = ExecuteAsync(batcher, kQuery, 2, written[1], long_cc);
+  auto third = ExecuteAsync(batcher, kQuery, 3, written[2], short_cc);
+
+  UEXPECT_NO_THROW(blocker.Get());
+  EXPECT_EQ(1, first.Get().AsSingleRow<int>());
+  EXPECT_EQ(2, second.Get().AsSingleRow<int>());
+  EXPECT_EQ(3, third.Get().AsSingleRow<int>());
+
+  EXPECT_LT(written[2] - written[0], kBatchGap);
+  EXPECT_GT(written[1] - written[2], kBatchGap);
+}
+
+UTEST_P(PostgreQueryBatcher, CallerTimeoutInFlight) {
+  pg::detail::QueryBatcher batcher{MakePool(), {1, 8}, {}};
+
+  const pg::CommandControl cc{std::chrono::milliseconds{100},
+                              utest::kMaxTestWaitTime};
+  UEXPECT_THROW(Execute(batcher, "select $1::integer from pg_sleep(1)", 1, cc),
+                pg::ConnectionTimeoutError);
+
+  // The batcher continues with a new connection
+  EXPECT_EQ(2, Execute(batcher, "select $1::integer", 2).AsSingleRow<int>());
+}
+
+UTEST_P(PostgreQueryBatcher, CallerTimeoutInQueue) {
+  pg::detail::QueryBatcher batcher{MakePool(), {1, 8}, {}};
+
+  auto blocker = Block(batcher, std::chrono::milliseconds{500});
+
+  // The request is abandoned while queued, its parameters are never written
+  std::atomic<bool> written{false};
+  const pg::CommandControl cc{std::chrono::milliseconds{100},
+                              utest::kMaxTestWaitTime};
+  UEXPECT_THROW(batcher.Execute(cc, "select $1::integer",
+                                [&written](const pg::UserTypes& types) {
+                                  written = true;
+                                  return WriteParams(types, 1);
+                                }),
+                pg::ConnectionTimeoutError);
+
+  UEXPECT_NO_THROW(blocker.Get());
+  EXPECT_EQ(2, Execute(batcher, "select $1::integer", 2).AsSingleRow<int>());
+  EXPECT_FALSE(written);
+}
+
+UTEST_P(PostgreQueryBatcher, DestroyWithQueued) {
+  auto batcher = std::make_unique<pg::detail::QueryBatcher>(
+      MakePool(), pg::QueryBatchingSettings{1, 8},
+      testsuite::PostgresControl{});
+
+  auto blocker = Block(*batcher, std::chrono::milliseconds{1000});
+  constexpr std::size_t kTasks = 3;
+  std::vector<TimePoint> written(kTasks);
+  std::vector<engine::TaskWithResult<pg::ResultSet>> tasks;
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(ExecuteAsync(*batcher, "select $1::integer",
+                                 static_cast<int>(i), written[i]));
+  }
+  // Let the tasks enqueue their requests
+  engine::Yield();
+
+  // The destructor interrupts the batch in flight, fails the queued
+  // requests and waits for their callers
+  batcher.reset();
+
+  UEXPECT_THROW(blocker.Get(), std::exception);
+  for (auto& task : tasks) {
+    UEXPECT_THROW(task.Get(), pg::ConnectionInterrupted);
+  }
+  for (const auto& time : written) {
+    EXPECT_EQ(time, TimePoint{});
+  }
+}
+
+USERVER_NAMESPACE_END
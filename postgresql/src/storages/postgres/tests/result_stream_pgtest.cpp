@@ -0,0 +1,115 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <optional>
+#include <string>
+
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/result_stream.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+constexpr int kRowCount = 10000;
+
+struct StreamRow {
+  int id{};
+  std::string value;
+  std::optional<double> number;
+};
+
+UTEST_P(PostgreConnection, StreamRows) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  auto stream = trx.Stream(
+      "select i, i::text, case when i % 3 = 0 then null else i * 0.5 end "
+      "from generate_series(1, $1) i",
+      kRowCount);
+  StreamRow row;
+  int expected_id = 0;
+  while (stream.ReadRow(row, pg::kRowTag)) {
+    ++expected_id;
+    EXPECT_EQ(expected_id, row.id);
+    EXPECT_EQ(std::to_string(expected_id), row.value);
+    EXPECT_EQ(expected_id % 3 == 0, !row.number.has_value());
+  }
+  EXPECT_EQ(kRowCount, expected_id);
+  EXPECT_TRUE(stream.Done());
+  EXPECT_FALSE(stream.ReadRow(row, pg::kRowTag));
+  EXPECT_EQ(kRowCount, static_cast<int>(stream.RowsRead()));
+
+  // The connection is usable after the stream
+  UEXPECT_NO_THROW(trx.Execute("select 1"));
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, StreamFetchRows) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  auto stream =
+      trx.Stream("select i from generate_series(1, $1) i", kRowCount);
+  int expected = 0;
+  while (auto rows = stream.FetchRows()) {
+    EXPECT_FALSE(rows->IsEmpty());
+    for (auto value : rows->AsSetOf<int>()) {
+      EXPECT_EQ(++expected, value);
+    }
+  }
+  EXPECT_EQ(kRowCount, expected);
+  EXPECT_EQ(kRowCount, static_cast<int>(stream.RowsRead()));
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, StreamEmpty) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  auto stream = trx.Stream("select 1 where false");
+  int value{};
+  EXPECT_FALSE(stream.ReadRow(value));
+  EXPECT_TRUE(stream.Done());
+
+  auto command = trx.Stream("create temporary table stream_test(id integer)");
+  EXPECT_FALSE(command.FetchRows());
+  EXPECT_TRUE(command.Done());
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, StreamError) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  // The division fails after some rows are sent to the client
+  auto stream =
+      trx.Stream("select 1 / (i - $1) from generate_series(1, $2) i",
+                 kRowCount / 2, kRowCount);
+  const auto read_all = [&stream] {
+    int value{};
+    while (stream.ReadRow(value)) {
+    }
+  };
+  UEXPECT_THROW(read_all(), pg::DataException);
+  EXPECT_TRUE(stream.Done());
+  EXPECT_GT(stream.RowsRead(), 0u);
+  UEXPECT_NO_THROW(read_all());
+  trx.Rollback();
+}
+
+UTEST_P(PostgreConnection, StreamFieldMismatch) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  auto stream = trx.Stream("select 1, 2");
+  int value{};
+  UEXPECT_THROW(stream.ReadRow(value), pg::NonSingleColumnResultSet);
+  trx.Rollback();
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
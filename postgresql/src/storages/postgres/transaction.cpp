@@ -100,6 +100,47 @@ Portal Transaction::MakePortal(const PortalName& portal_name,
                 std::move(statement_cmd_ctl)};
 }
 
+CopyInStream Transaction::CopyIn(const Query& query,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Copy in called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  if (!statement_cmd_ctl) {
+    statement_cmd_ctl = conn_->GetQueryCmdCtl(query.GetName());
+  }
+  return CopyInStream{conn_.get(), query, std::move(statement_cmd_ctl)};
+}
+
+CopyOutStream Transaction::CopyOut(const Query& query,
+                                   OptionalCommandControl statement_cmd_ctl) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Copy out called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  if (!statement_cmd_ctl) {
+    statement_cmd_ctl = conn_->GetQueryCmdCtl(query.GetName());
+  }
+  return CopyOutStream{conn_.get(), query, std::move(statement_cmd_ctl)};
+}
+
+ResultStream Transaction::DoStream(const Query& query,
+                                   const detail::QueryParameters& params,
+                                   OptionalCommandControl statement_cmd_ctl) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Stream called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  if (!statement_cmd_ctl) {
+    statement_cmd_ctl = conn_->GetQueryCmdCtl(query.GetName());
+  }
+  return ResultStream{conn_.get(), query, params,
+                      std::move(statement_cmd_ctl)};
+}
+
 void Transaction::SetParameter(const std::string& param_name,
                                const std::string& value) {
   if (!conn_) {
@@ -0,0 +1,83 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <userver/logging/impl/binary_log.hpp>
+
+#include <userver/utest/using_namespace_userver.hpp>
+
+namespace {
+
+struct Config {
+  std::vector<std::string> files;
+};
+
+Config ParseConfig(int argc, char** argv) {
+  namespace po = boost::program_options;
+
+  Config config;
+  po::options_description desc(
+      "Converts logs written in the 'binary' format to TSKV.\n"
+      "Reads the files in order or stdin if none given, writes to stdout.\n"
+      "Allowed options");
+  desc.add_options()("help,h", "produce help message")(
+      "files", po::value(&config.files)->composing(), "binary log files");
+
+  po::positional_options_description positional;
+  positional.add("files", -1);
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv)
+                  .options(desc)
+                  .positional(positional)
+                  .run(),
+              vm);
+    po::notify(vm);
+  } catch (const std::exception& ex) {
+    std::cerr << "Cannot parse command line: " << ex.what() << '\n';
+    exit(1);
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << '\n';
+    exit(0);
+  }
+
+  return config;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto config = ParseConfig(argc, argv);
+  std::ios::sync_with_stdio(false);
+
+  try {
+    if (config.files.empty()) {
+      if (!logging::impl::binary::DecodeStreamToTskv(std::cin, std::cout)) {
+        std::cerr << "stdin: the last record is truncated\n";
+        return 1;
+      }
+    }
+
+    for (const auto& file : config.files) {
+      std::ifstream input{file, std::ios::binary};
+      if (!input) {
+        std::cerr << file << ": cannot open\n";
+        return 1;
+      }
+      if (!logging::impl::binary::DecodeStreamToTskv(input, std::cout)) {
+        std::cerr << file << ": the last record is truncated\n";
+        return 1;
+      }
+    }
+  } catch (const std::exception& ex) {
+    std::cerr << ex.what() << '\n';
+    return 1;
+  }
+}
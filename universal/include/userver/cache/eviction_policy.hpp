@@ -0,0 +1,28 @@
+#pragma once
+
+/// @file userver/cache/eviction_policy.hpp
+/// @brief @copybrief cache::EvictionPolicy
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// Eviction policy of cache::LruMap and of the ways of cache::NWayLRU
+enum class EvictionPolicy {
+  /// Least recently used. Every access reorders the way under its mutex.
+  kLru,
+  /// CLOCK (second chance). Hits only set a flag and take no locks, inserts
+  /// and erases take the way mutex. Has a hit rate close to LRU and scales
+  /// much better on read-mostly caches. Only supported by cache::NWayLRU.
+  kClock,
+  /// W-TinyLFU: a small LRU window followed by a segmented LRU, with new
+  /// entries admitted into the latter only if they are estimated to be
+  /// accessed more frequently than the entry they evict. Resists scans and
+  /// gives a noticeably better hit rate than LRU on skewed (e.g. Zipfian)
+  /// workloads.
+  kTinyLfu,
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/slru.hpp>
+
+/*
+
+W-TinyLFU, see "TinyLFU: A Highly Efficient Cache Admission Policy"
+by G. Einziger, R. Friedman and B. Manes.
+
+New entries get into a small LRU window. An entry evicted from the window
+competes with the least recently used entry of the main SLRU part, and the one
+with the higher estimated frequency stays.
+
+*/
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Count-min sketch of 4-bit counters with aging: once the number of
+/// increments reaches the sample size, all the counters are halved, so
+/// the estimates reflect the recent popularity of the keys.
+///
+/// Like utils::FilterBloom, but with saturating counters, periodic aging and
+/// a single user provided hash.
+template <typename T, typename Hash = std::hash<T>>
+class FrequencySketch final {
+ public:
+  static constexpr std::uint8_t kMaxFrequency = 15;
+
+  explicit FrequencySketch(std::size_t capacity, const Hash& hash = Hash())
+      : hash_(hash) {
+    Resize(capacity);
+  }
+
+  void Resize(std::size_t capacity) {
+    width_log2_ = 4;
+    while ((std::size_t{1} << width_log2_) < capacity && width_log2_ < 32) {
+      ++width_log2_;
+    }
+    counters_.assign(kDepth << width_log2_, 0);
+    sample_size_ = std::size_t{10} << width_log2_;
+    additions_ = 0;
+  }
+
+  void Increment(const T& key) {
+    const auto indices = GetIndices(key);
+    const auto frequency = Estimate(indices);
+    if (frequency == kMaxFrequency) return;
+
+    // Conservative update: only the smallest counters grow
+    for (const auto index : indices) {
+      if (counters_[index] == frequency) ++counters_[index];
+    }
+    if (++additions_ >= sample_size_) Age();
+  }
+
+  std::uint8_t Estimate(const T& key) const {
+    return Estimate(GetIndices(key));
+  }
+
+  void Clear() {
+    std::fill(counters_.begin(), counters_.end(), 0);
+    additions_ = 0;
+  }
+
+ private:
+  static constexpr std::size_t kDepth = 4;
+  using Indices = std::array<std::size_t, kDepth>;
+
+  Indices GetIndices(const T& key) const {
+    static constexpr std::array<std::uint64_t, kDepth> kSeeds{
+        0x9E3779B97F4A7C15, 0xC2B2AE3D27D4EB4F, 0x165667B19E3779F9,
+        0x27D4EB2F165667C5};
+
+    const std::uint64_t hash = hash_(key);
+    Indices indices{};
+    for (std::size_t row = 0; row < kDepth; ++row) {
+      // Fibonacci hashing of a per-row remix of the hash
+      const auto mixed = (hash ^ (hash >> 29) ^ kSeeds[row]) * kSeeds[0];
+      indices[row] = (row << width_log2_) + (mixed >> (64 - width_log2_));
+    }
+    return indices;
+  }
+
+  std::uint8_t Estimate(const Indices& indices) const {
+    auto frequency = kMaxFrequency;
+    for (const auto index : indices) {
+      frequency = std::min(frequency, counters_[index]);
+    }
+    return frequency;
+  }
+
+  void Age() {
+    for (auto& counter : counters_) counter /= 2;
+    additions_ /= 2;
+  }
+
+  std::vector<std::uint8_t> counters_;
+  std::size_t width_log2_{0};
+  std::size_t sample_size_{0};
+  std::size_t additions_{0};
+  Hash hash_;
+};
+
+/// W-TinyLFU cache with the same interface as LruBase. The window takes
+/// about 1% of the capacity, the main SLRU part is split 20/80 between
+/// probation and protected segments. Each part holds at least one entry, so
+/// the capacity is at least 3.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class TinyLfuBase final {
+ public:
+  using NodeType = std::unique_ptr<LruNode<T, U>>;
+
+  explicit TinyLfuBase(std::size_t max_size, const Hash& hash = Hash(),
+                       const Equal& equal = Equal())
+      : window_(GetWindowSize(max_size), hash, equal),
+        main_(GetProbationSize(max_size), GetProtectedSize(max_size), hash,
+              equal),
+        sketch_(max_size, hash),
+        max_size_(max_size) {}
+
+  TinyLfuBase(TinyLfuBase&& other) noexcept = default;
+  TinyLfuBase& operator=(TinyLfuBase&& other) noexcept = default;
+  TinyLfuBase(const TinyLfuBase&) = delete;
+  TinyLfuBase& operator=(const TinyLfuBase&) = delete;
+
+  bool Put(const T& key, U value);
+
+  template <typename... Args>
+  U* Emplace(const T& key, Args&&... args);
+
+  void Erase(const T& key);
+
+  U* Get(const T& key);
+
+  const T* GetLeastUsedKey() const;
+
+  U* GetLeastUsedValue();
+
+  void SetMaxSize(std::size_t new_max_size);
+
+  void Clear() noexcept;
+
+  template <typename Function>
+  void VisitAll(Function&& func) const;
+
+  template <typename Function>
+  void VisitAll(Function&& func);
+
+  std::size_t GetSize() const;
+
+  std::size_t GetCapacity() const;
+
+ private:
+  static std::size_t GetWindowSize(std::size_t max_size) {
+    return std::max<std::size_t>(max_size / 100, 1);
+  }
+
+  static std::size_t GetMainSize(std::size_t max_size) {
+    return max_size - std::min(GetWindowSize(max_size), max_size);
+  }
+
+  static std::size_t GetProtectedSize(std::size_t max_size) {
+    return std::max<std::size_t>(GetMainSize(max_size) * 4 / 5, 1);
+  }
+
+  static std::size_t GetProbationSize(std::size_t max_size) {
+    const auto main_size = GetMainSize(max_size);
+    return std::max<std::size_t>(main_size - main_size * 4 / 5, 1);
+  }
+
+  U* Find(const T& key);
+  U& Add(const T& key, U value);
+
+  LruBase<T, U, Hash, Equal> window_;
+  SlruBase<T, U, Hash, Equal> main_;
+  FrequencySketch<T, Hash> sketch_;
+  std::size_t max_size_;
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+bool TinyLfuBase<T, U, Hash, Equal>::Put(const T& key, U value) {
+  sketch_.Increment(key);
+
+  auto* existing = Find(key);
+  if (existing) {
+    *existing = std::move(value);
+    return false;
+  }
+
+  Add(key, std::move(value));
+  return true;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename... Args>
+U* TinyLfuBase<T, U, Hash, Equal>::Emplace(const T& key, Args&&... args) {
+  sketch_.Increment(key);
+
+  auto* existing = Find(key);
+  if (existing) return existing;
+
+  return &Add(key, U{std::forward<Args>(args)...});
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::Erase(const T& key) {
+  window_.Erase(key);
+  main_.Erase(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfuBase<T, U, Hash, Equal>::Get(const T& key) {
+  sketch_.Increment(key);
+  return Find(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+const T* TinyLfuBase<T, U, Hash, Equal>::GetLeastUsedKey() const {
+  const auto* key = main_.GetLeastUsedKey();
+  return key ? key : window_.GetLeastUsedKey();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfuBase<T, U, Hash, Equal>::GetLeastUsedValue() {
+  auto* value = main_.GetLeastUsedValue();
+  return value ? value : window_.GetLeastUsedValue();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::SetMaxSize(std::size_t new_max_size) {
+  UASSERT(new_max_size > 0);
+  if (!new_max_size) ++new_max_size;
+
+  if (max_size_ == new_max_size) return;
+  max_size_ = new_max_size;
+
+  window_.SetMaxSize(GetWindowSize(new_max_size));
+  main_.SetMaxSize(GetProbationSize(new_max_size),
+                   GetProtectedSize(new_max_size));
+  sketch_.Resize(new_max_size);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::Clear() noexcept {
+  window_.Clear();
+  main_.Clear();
+  sketch_.Clear();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void TinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) const {
+  window_.VisitAll(func);
+  main_.VisitAll(func);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void TinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) {
+  window_.VisitAll(func);
+  main_.VisitAll(func);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t TinyLfuBase<T, U, Hash, Equal>::GetSize() const {
+  return window_.GetSize() + main_.GetSize();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t TinyLfuBase<T, U, Hash, Equal>::GetCapacity() const {
+  return window_.GetCapacity() + main_.GetCapacity();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfuBase<T, U, Hash, Equal>::Find(const T& key) {
+  auto* value = window_.Get(key);
+  return value ? value : main_.Get(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U& TinyLfuBase<T, U, Hash, Equal>::Add(const T& key, U value) {
+  NodeType node;
+  if (window_.GetSize() >= window_.GetCapacity()) {
+    auto candidate = window_.ExtractLeastUsedNode();
+
+    if (main_.GetSize() < main_.GetCapacity()) {
+      main_.InsertNode(std::move(candidate));
+    } else {
+      const auto* victim = main_.GetLeastUsedKey();
+      UASSERT(victim);
+      if (sketch_.Estimate(candidate->GetKey()) > sketch_.Estimate(*victim)) {
+        node = main_.ExtractLeastUsedNode();
+        main_.InsertNode(std::move(candidate));
+      } else {
+        node = std::move(candidate);
+      }
+    }
+  }
+
+  // Reuse the evicted node, if any
+  if (node) {
+    node->SetKey(key);
+    node->SetValue(std::move(value));
+  } else {
+    node = std::make_unique<LruNode<T, U>>(T{key}, std::move(value));
+  }
+  return window_.InsertNode(std::move(node));
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
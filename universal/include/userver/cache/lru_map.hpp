@@ -3,7 +3,11 @@
 /// @file userver/cache/lru_map.hpp
 /// @brief @copybrief cache::LruMap
 
+#include <type_traits>
+
+#include <userver/cache/eviction_policy.hpp>
 #include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/tinylfu.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,9 +18,17 @@ namespace cache {
 ///
 /// LRU key value storage (LRU cache), thread safety matches Standard Library
 /// thread safety
+///
+/// With cache::EvictionPolicy::kTinyLfu the map uses the W-TinyLFU admission
+/// policy instead of plain LRU. GetLeastUsed() then returns the next eviction
+/// candidate of the main part of the cache.
 template <typename T, typename U, typename Hash = std::hash<T>,
-          typename Equal = std::equal_to<T>>
+          typename Equal = std::equal_to<T>,
+          EvictionPolicy Policy = EvictionPolicy::kLru>
 class LruMap final {
+  static_assert(Policy != EvictionPolicy::kClock,
+                "CLOCK eviction policy is only supported by cache::NWayLRU");
+
  public:
   explicit LruMap(size_t max_size, const Hash& hash = Hash(),
                   const Equal& equal = Equal())
@@ -85,7 +97,10 @@ class LruMap final {
   std::size_t GetCapacity() const { return impl_.GetCapacity(); }
 
  private:
-  impl::LruBase<T, U, Hash, Equal> impl_;
+  std::conditional_t<Policy == EvictionPolicy::kTinyLfu,
+                     impl::TinyLfuBase<T, U, Hash, Equal>,
+                     impl::LruBase<T, U, Hash, Equal>>
+      impl_;
 };
 
 }  // namespace cache
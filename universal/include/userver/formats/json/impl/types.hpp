@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 #include <type_traits>
 
 #include <userver/formats/common/type.hpp>
@@ -61,6 +62,19 @@ class VersionedValuePtr final {
   size_t Version() const;
   void BumpVersion();
 
+  /// Whether the strings of the value are stored in a buffer of the document
+  /// rather than owned by the nodes
+  bool HasArena() const;
+
+  /// Makes the lookups build hash indexes of the members of the large objects,
+  /// the value must never be modified afterwards
+  void EnableMemberIndex();
+
+  /// Returns the member of the `object` that belongs to this value, or nullptr
+  /// if there is no such member
+  const impl::Value* FindMember(const impl::Value& object,
+                                std::string_view key) const;
+
  private:
   struct Data;
 
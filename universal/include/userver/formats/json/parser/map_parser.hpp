@@ -14,7 +14,10 @@ class MapParser final : public TypedParser<Map>,
 
   explicit MapParser(ValueParser& value_parser) : value_parser_(value_parser) {}
 
-  void Reset() override { this->state_ = State::kStart; }
+  void Reset() override {
+    this->state_ = State::kStart;
+    this->result_.clear();
+  }
 
   void StartObject() override {
     switch (state_) {
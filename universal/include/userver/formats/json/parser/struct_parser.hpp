@@ -0,0 +1,476 @@
+#pragma once
+
+/// @file userver/formats/json/parser/struct_parser.hpp
+/// @brief SAX parsers for structures, generated from a list of their fields
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/parser/array_parser.hpp>
+#include <userver/formats/json/parser/bool_parser.hpp>
+#include <userver/formats/json/parser/int_parser.hpp>
+#include <userver/formats/json/parser/map_parser.hpp>
+#include <userver/formats/json/parser/number_parser.hpp>
+#include <userver/formats/json/parser/parser_json.hpp>
+#include <userver/formats/json/parser/string_parser.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser {
+
+/// @brief JSON object field `name` that is stored in `T::*member`
+///
+/// Fields of type `std::optional` may be missing or `null`, all the other
+/// fields are required.
+template <typename T, typename Member>
+struct StructField final {
+  std::string_view name;
+  Member T::*member;
+};
+
+template <typename T, typename Member>
+constexpr StructField<T, Member> Field(std::string_view name,
+                                       Member T::*member) {
+  return {name, member};
+}
+
+template <typename T>
+class StructParser;
+
+namespace impl {
+
+template <typename T>
+using DescribeJsonStructResult =
+    decltype(DescribeJsonStruct(formats::parse::To<T>{}));
+
+template <typename Parser>
+struct ParserTag {
+  using type = Parser;
+};
+
+}  // namespace impl
+
+/// `true` if `DescribeJsonStruct(formats::parse::To<T>)` is found via ADL
+template <typename T>
+inline constexpr bool kIsDescribedStruct =
+    meta::kIsDetected<impl::DescribeJsonStructResult, T>;
+
+namespace impl {
+
+template <typename T>
+auto DetectDefaultParser();
+
+}  // namespace impl
+
+/// @brief The parser that StructParser uses for the fields of type `T`.
+///
+/// Structures described with DescribeJsonStruct, std::vector and maps with
+/// std::string keys of such types are parsed without building
+/// formats::json::Value. The other types are parsed to formats::json::Value
+/// first and then converted with `As<T>()`.
+template <typename T>
+using DefaultParser = typename decltype(impl::DetectDefaultParser<T>())::type;
+
+namespace impl {
+
+/// Consumes a single value of any type, used for the unknown fields
+class SkipParser final : public BaseParser {
+ public:
+  void Reset() { level_ = 0; }
+
+  void Null() override;
+  void Bool(bool) override;
+  void Int64(int64_t) override;
+  void Uint64(uint64_t) override;
+  void Double(double) override;
+  void String(std::string_view) override;
+  void StartObject() override;
+  void Key(std::string_view key) override;
+  void EndObject() override;
+  void StartArray() override;
+  void EndArray() override;
+
+  std::string Expected() const override;
+
+ private:
+  void MaybePopSelf();
+
+  std::string GetPathItem() const override { return {}; }
+
+  std::size_t level_{0};
+};
+
+template <typename T>
+class ValueAsParser final : public Subscriber<Value> {
+ public:
+  using ResultType = T;
+
+  ValueAsParser() { value_parser_.Subscribe(*this); }
+
+  void Reset() { value_parser_.Reset(); }
+
+  void Subscribe(Subscriber<T>& subscriber) { subscriber_ = &subscriber; }
+
+  TypedParser<Value>& GetParser() { return value_parser_; }
+
+ private:
+  void OnSend(Value&& value) override {
+    if (subscriber_) subscriber_->OnSend(value.As<T>());
+  }
+
+  JsonValueParser value_parser_;
+  Subscriber<T>* subscriber_{nullptr};
+};
+
+template <typename Item>
+class VectorParser final {
+ public:
+  using ResultType = std::vector<Item>;
+
+  VectorParser() : array_parser_(item_parser_) {}
+
+  void Reset() { array_parser_.Reset(); }
+
+  void Subscribe(Subscriber<ResultType>& subscriber) {
+    array_parser_.Subscribe(subscriber);
+  }
+
+  TypedParser<ResultType>& GetParser() { return array_parser_; }
+
+ private:
+  DefaultParser<Item> item_parser_;
+  ArrayParser<Item, DefaultParser<Item>> array_parser_;
+};
+
+template <typename Map>
+class StringMapParser final {
+ public:
+  using ResultType = Map;
+
+  StringMapParser() : map_parser_(value_parser_) {}
+
+  void Reset() { map_parser_.Reset(); }
+
+  void Subscribe(Subscriber<Map>& subscriber) {
+    map_parser_.Subscribe(subscriber);
+  }
+
+  TypedParser<Map>& GetParser() { return map_parser_; }
+
+ private:
+  using ValueParser = DefaultParser<typename Map::mapped_type>;
+
+  ValueParser value_parser_;
+  MapParser<Map, ValueParser> map_parser_;
+};
+
+template <typename T>
+auto DetectDefaultParser() {
+  if constexpr (std::is_same_v<T, bool>) {
+    return ParserTag<BoolParser>{};
+  } else if constexpr (std::is_same_v<T, std::int32_t>) {
+    return ParserTag<Int32Parser>{};
+  } else if constexpr (std::is_same_v<T, std::int64_t>) {
+    return ParserTag<Int64Parser>{};
+  } else if constexpr (std::is_same_v<T, double>) {
+    return ParserTag<DoubleParser>{};
+  } else if constexpr (std::is_same_v<T, float>) {
+    return ParserTag<FloatParser>{};
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    return ParserTag<StringParser>{};
+  } else if constexpr (std::is_same_v<T, Value>) {
+    return ParserTag<JsonValueParser>{};
+  } else if constexpr (meta::kIsVector<T>) {
+    return ParserTag<VectorParser<typename T::value_type>>{};
+  } else if constexpr (meta::kIsUniqueMap<T>) {
+    if constexpr (std::is_same_v<meta::MapKeyType<T>, std::string>) {
+      return ParserTag<StringMapParser<T>>{};
+    } else {
+      return ParserTag<ValueAsParser<T>>{};
+    }
+  } else if constexpr (kIsDescribedStruct<T>) {
+    return ParserTag<StructParser<T>>{};
+  } else {
+    return ParserTag<ValueAsParser<T>>{};
+  }
+}
+
+template <typename Member>
+struct FieldValue {
+  using type = Member;
+};
+
+template <typename Member>
+struct FieldValue<std::optional<Member>> {
+  using type = Member;
+};
+
+template <typename T, typename Member>
+class FieldParser final
+    : public Subscriber<typename FieldValue<Member>::type> {
+ public:
+  using ValueType = typename FieldValue<Member>::type;
+
+  static constexpr bool kIsOptional = meta::kIsOptional<Member>;
+
+  explicit FieldParser(StructField<T, Member> field) : field_(field) {
+    parser_.Subscribe(*this);
+  }
+
+  FieldParser(const FieldParser&) = delete;
+  FieldParser& operator=(const FieldParser&) = delete;
+
+  std::string_view GetName() const { return field_.name; }
+
+  BaseParser& Start(T& result) {
+    target_ = &(result.*field_.member);
+    parser_.Reset();
+    return parser_.GetParser();
+  }
+
+  void SetNull(T& result) { result.*field_.member = std::nullopt; }
+
+ private:
+  void OnSend(ValueType&& value) override { *target_ = std::move(value); }
+
+  StructField<T, Member> field_;
+  Member* target_{nullptr};
+  DefaultParser<ValueType> parser_;
+};
+
+template <typename T, typename Fields>
+struct FieldParsers;
+
+template <typename T, typename... Members>
+struct FieldParsers<T, std::tuple<StructField<T, Members>...>> {
+  using type = std::tuple<FieldParser<T, Members>...>;
+};
+
+}  // namespace impl
+
+/// @brief SAX parser for a structure that is described by a
+/// `DescribeJsonStruct(formats::parse::To<T>)` function.
+///
+/// The function must be declared in the namespace of `T` and must return
+/// an `std::tuple` of formats::json::parser::Field. The parser for each field
+/// is chosen by formats::json::parser::DefaultParser. Unknown fields are
+/// skipped.
+///
+/// ~~~~~~~~~~~~~~{.cpp}
+/// struct Person {
+///   std::string name;
+///   std::int64_t age{0};
+///   std::optional<std::vector<std::string>> emails;
+/// };
+///
+/// constexpr auto DescribeJsonStruct(formats::parse::To<Person>) {
+///   using formats::json::parser::Field;
+///   return std::make_tuple(Field("name", &Person::name),
+///                          Field("age", &Person::age),
+///                          Field("emails", &Person::emails));
+/// }
+///
+/// auto person = formats::json::parser::ParseToType<Person>(body);
+/// ~~~~~~~~~~~~~~
+///
+/// `T` must be default constructible. Recursive structures are not supported.
+template <typename T>
+class StructParser final : public TypedParser<T> {
+  using Fields = impl::DescribeJsonStructResult<T>;
+  using FieldParsers = typename impl::FieldParsers<T, Fields>::type;
+  static constexpr std::size_t kFieldsCount = std::tuple_size_v<Fields>;
+  static constexpr std::size_t kUnknownField = kFieldsCount;
+
+ public:
+  StructParser()
+      : StructParser(DescribeJsonStruct(formats::parse::To<T>{}),
+                     std::make_index_sequence<kFieldsCount>{}) {}
+
+  StructParser(const StructParser&) = delete;
+  StructParser& operator=(const StructParser&) = delete;
+
+  void Reset() override {
+    state_ = State::kStart;
+    field_ = kUnknownField;
+    seen_.fill(false);
+    result_ = T{};
+  }
+
+ protected:
+  void Null() override {
+    CheckValueExpected("null");
+    bool is_null_set = false;
+    VisitField([this, &is_null_set](auto& field) {
+      if constexpr (std::decay_t<decltype(field)>::kIsOptional) {
+        field.SetNull(result_);
+        is_null_set = true;
+      }
+    });
+    if (is_null_set) {
+      state_ = State::kInside;
+      return;
+    }
+    PushParser("null").Null();
+  }
+  void Bool(bool b) override { PushParser("bool").Bool(b); }
+  void Int64(int64_t i) override { PushParser("integer").Int64(i); }
+  void Uint64(uint64_t i) override { PushParser("integer").Uint64(i); }
+  void Double(double d) override { PushParser("double").Double(d); }
+  void String(std::string_view sw) override {
+    PushParser("string").String(sw);
+  }
+  void StartArray() override { PushParser("array").StartArray(); }
+
+  void StartObject() override {
+    if (state_ == State::kStart) {
+      state_ = State::kInside;
+      return;
+    }
+    PushParser("object").StartObject();
+  }
+
+  void Key(std::string_view key) override {
+    UASSERT(state_ == State::kInside);
+    state_ = State::kValue;
+    field_ = FindField(key);
+    if (field_ == kUnknownField) {
+      unknown_key_ = key;
+      return;
+    }
+
+    if (seen_[field_]) {
+      throw InternalParseError(fmt::format("Duplicate key: {}", key));
+    }
+    seen_[field_] = true;
+  }
+
+  void EndObject() override {
+    UASSERT(state_ == State::kInside);
+    field_ = kUnknownField;
+    unknown_key_.clear();
+    CheckRequiredFields(std::make_index_sequence<kFieldsCount>{});
+    this->SetResult(std::move(result_));
+  }
+
+  std::string Expected() const override {
+    switch (state_) {
+      case State::kStart:
+        return "object";
+      case State::kInside:
+        return "field or '}'";
+      case State::kValue:
+        return "value";
+    }
+
+    UINVARIANT(false, "Unexpected parser state");
+  }
+
+  std::string GetPathItem() const override {
+    if (field_ == kUnknownField) return unknown_key_;
+    return std::string{names_[field_]};
+  }
+
+ private:
+  template <std::size_t... Indices>
+  StructParser(Fields fields, std::index_sequence<Indices...>)
+      : names_{std::get<Indices>(fields).name...},
+        fields_(std::get<Indices>(fields)...) {}
+
+  void CheckValueExpected(std::string_view what) {
+    if (state_ != State::kValue) this->Throw(std::string{what});
+  }
+
+  BaseParser& PushParser(std::string_view what) {
+    CheckValueExpected(what);
+    state_ = State::kInside;
+
+    BaseParser* parser = &skip_parser_;
+    if (field_ == kUnknownField) {
+      skip_parser_.Reset();
+    } else {
+      VisitField(
+          [this, &parser](auto& field) { parser = &field.Start(result_); });
+    }
+    this->parser_state_->PushParser(*parser);
+    return *parser;
+  }
+
+  template <typename Visitor>
+  void VisitField(Visitor visitor) {
+    VisitField(visitor, std::make_index_sequence<kFieldsCount>{});
+  }
+
+  template <typename Visitor, std::size_t... Indices>
+  void VisitField(Visitor& visitor, std::index_sequence<Indices...>) {
+    ((Indices == field_ ? visitor(std::get<Indices>(fields_)) : void()), ...);
+  }
+
+  std::size_t FindField(std::string_view key) const {
+    for (std::size_t i = 0; i < kFieldsCount; ++i) {
+      if (names_[i] == key) return i;
+    }
+    return kUnknownField;
+  }
+
+  template <std::size_t... Indices>
+  void CheckRequiredFields(std::index_sequence<Indices...>) const {
+    const auto check = [this](const auto& field, bool seen) {
+      if (!seen && !std::decay_t<decltype(field)>::kIsOptional) {
+        throw InternalParseError(
+            fmt::format("Field '{}' is missing", field.GetName()));
+      }
+    };
+    (check(std::get<Indices>(fields_), seen_[Indices]), ...);
+  }
+
+  enum class State {
+    kStart,
+    kInside,
+    kValue,
+  };
+
+  State state_{State::kStart};
+  std::size_t field_{kUnknownField};
+  std::array<bool, kFieldsCount> seen_{};
+  std::string unknown_key_;
+  const std::array<std::string_view, kFieldsCount> names_;
+  FieldParsers fields_;
+  impl::SkipParser skip_parser_;
+  T result_{};
+};
+
+/// @brief Parses `input` into `T` with formats::json::parser::DefaultParser
+///
+/// Unlike `formats::json::FromString(input).As<T>()`, does not build
+/// formats::json::Value for the described structures and their fields.
+template <typename T>
+T ParseToType(std::string_view input) {
+  T result{};
+  DefaultParser<T> parser;
+  parser.Reset();
+  SubscriberSink<T> sink(result);
+  parser.Subscribe(sink);
+
+  ParserState state;
+  state.PushParser(parser.GetParser());
+  state.ProcessInput(input);
+
+  return result;
+}
+
+}  // namespace formats::json::parser
+
+USERVER_NAMESPACE_END
@@ -27,6 +27,20 @@ constexpr inline std::size_t kDepthParseLimit = 128;
 /// Parse JSON from string
 formats::json::Value FromString(std::string_view doc);
 
+/// Parse JSON from string into a document that builds a hash index of the
+/// members of a large object on the first lookup in it. Lookups by key in
+/// objects with hundreds of members become much faster, at the cost of the
+/// memory for the indexes; see json_object_wide_object_member_access
+/// benchmarks. Other documents search the members linearly.
+formats::json::Value FromStringWithMemberIndex(std::string_view doc);
+
+/// Parse JSON from string into a document that stores all its strings in a
+/// single arena, a copy of `doc` where the strings are unescaped in place.
+/// Parsing and destruction of documents with many long strings are cheaper,
+/// but the arena is released only when the document and all the values
+/// referring to it are destroyed.
+formats::json::Value FromStringWithArena(std::string_view doc);
+
 /// Parse JSON from stream
 formats::json::Value FromStream(std::istream& is);
 
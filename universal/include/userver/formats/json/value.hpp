@@ -322,6 +322,8 @@ class Value final {
   friend std::string Parse(const Value& value, parse::To<std::string>);
 
   friend formats::json::Value FromString(std::string_view);
+  friend formats::json::Value FromStringWithMemberIndex(std::string_view);
+  friend formats::json::Value FromStringWithArena(std::string_view);
   friend formats::json::Value FromStream(std::istream&);
   friend void Serialize(const formats::json::Value&, std::ostream&);
   friend std::string ToString(const formats::json::Value&);
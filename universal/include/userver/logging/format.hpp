@@ -10,7 +10,14 @@ USERVER_NAMESPACE_BEGIN
 namespace logging {
 
 /// Log formats
-enum class Format { kTskv, kLtsv, kRaw };
+enum class Format {
+  kTskv,
+  kLtsv,
+  kRaw,
+  /// Compact length-prefixed records, see logging::impl::binary. Convert to
+  /// TSKV with the `binary-log-decoder` tool.
+  kBinary,
+};
 
 /// Parse Format enum from string
 Format FormatFromString(std::string_view format_str);
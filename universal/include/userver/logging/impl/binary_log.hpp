@@ -0,0 +1,139 @@
+#pragma once
+
+/// @file userver/logging/impl/binary_log.hpp
+/// @brief Encoding of the logging::Format::kBinary log records
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+#include <userver/logging/level.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// Encoding of the logging::Format::kBinary log records.
+///
+/// The records are written one after another without separators:
+///
+///     record := varint(body size) body
+///     body   := level:u8 varint(microseconds since epoch) field*
+///     field  := varint(key id << 2 | kind) [varint(key size) key] value
+///     value  := varint(value size) bytes  for ValueKind::kString
+///             | varint(integer)           for the other kinds
+///
+/// Varints are unsigned LEB128. The sizes may be padded with redundant 0x80
+/// bytes, as the writer reserves room for them before the data. Key id 0
+/// means that the key follows inline, other ids refer to the well-known keys,
+/// see FindKnownKeyId. Keys and string values are stored unescaped.
+namespace logging::impl::binary {
+
+inline constexpr std::size_t kMaxVarintSize = 10;
+
+inline constexpr std::size_t GetVarintSize(std::uint64_t value) noexcept {
+  std::size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+/// Writes `value` into `out`, that must have at least GetVarintSize(value)
+/// bytes, and returns the position after it
+inline char* WriteVarint(std::uint64_t value, char* out) noexcept {
+  while (value >= 0x80) {
+    *(out++) = static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  *(out++) = static_cast<char>(value);
+  return out;
+}
+
+/// Writes `value` into exactly `size` bytes of `out`, padding it with
+/// redundant continuation bytes. `size` must be at least
+/// GetVarintSize(value).
+inline void WritePaddedVarint(std::uint64_t value, char* out,
+                              std::size_t size) noexcept {
+  for (std::size_t i = 0; i + 1 < size; ++i) {
+    *(out++) = static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  *out = static_cast<char>(value);
+}
+
+/// The kind of the field value, stored in the lower bits of the key id
+enum class ValueKind : std::uint8_t {
+  kString = 0,
+  /// Non-negative integer, stored as is
+  kUnsigned = 1,
+  /// Negative integer `x`, stored as `-(x + 1)`
+  kNegative = 2,
+};
+
+inline constexpr std::uint64_t kValueKindBits = 2;
+
+inline constexpr std::uint64_t MakeFieldHeader(std::uint64_t key_id,
+                                               ValueKind kind) noexcept {
+  return (key_id << kValueKindBits) | static_cast<std::uint64_t>(kind);
+}
+
+struct IntegerValue final {
+  ValueKind kind;
+  std::uint64_t payload;
+};
+
+inline constexpr IntegerValue MakeIntegerValue(
+    unsigned long long value) noexcept {
+  return {ValueKind::kUnsigned, value};
+}
+
+inline constexpr IntegerValue MakeIntegerValue(long long value) noexcept {
+  if (value >= 0) {
+    return {ValueKind::kUnsigned, static_cast<std::uint64_t>(value)};
+  }
+  return {ValueKind::kNegative, ~static_cast<std::uint64_t>(value)};
+}
+
+/// Returns the id of a well-known key, or 0 if the key is not interned.
+/// The ids are stable, new keys are only appended.
+std::uint64_t FindKnownKeyId(std::string_view key) noexcept;
+
+/// Converts a single binary record from the beginning of `data` into a TSKV
+/// line and appends it to `tskv`.
+///
+/// Returns the size of the consumed record or 0 if `data` does not contain a
+/// whole record yet.
+/// @throws std::runtime_error if the record is malformed
+std::size_t DecodeRecordToTskv(std::string_view data, std::string& tskv);
+
+/// Converts all the records of `input` into TSKV lines and writes them to
+/// `output`. Returns false if the input ends in the middle of a record.
+/// @throws std::runtime_error if a record is malformed
+bool DecodeStreamToTskv(std::istream& input, std::ostream& output);
+
+/// @brief Builds a whole record, for the records that are not written by
+/// LogHelper, like the access logs
+class RecordBuilder final {
+ public:
+  RecordBuilder(Level level, std::chrono::system_clock::time_point timestamp);
+
+  void AddTag(std::string_view key, std::string_view value);
+  void AddIntegerTag(std::string_view key, IntegerValue value);
+
+  /// Returns the record together with its size, ready to be passed to
+  /// LoggerBase::Log
+  std::string Extract() &&;
+
+ private:
+  void AddKey(std::string_view key, ValueKind kind);
+  void AddVarint(std::uint64_t value);
+
+  std::string body_;
+};
+
+}  // namespace logging::impl::binary
+
+USERVER_NAMESPACE_END
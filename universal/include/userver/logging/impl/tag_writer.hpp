@@ -62,6 +62,13 @@ class TagWriter {
 
   void MarkValueEnd() noexcept;
 
+  // Returns false if the logger stores integers as text
+  bool TryPutIntegerTag(std::string_view key, long long value);
+  bool TryPutIntegerTag(std::string_view key, unsigned long long value);
+
+  template <typename T>
+  bool TryPutInteger(std::string_view key, const T& value);
+
   LogHelper& lh_;
 };
 
@@ -85,8 +92,21 @@ USERVER_IMPL_CONSTEVAL TagKey::TagKey(const StringType& escaped_key)
   }
 }
 
+template <typename T>
+bool TagWriter::TryPutInteger(std::string_view key, const T& value) {
+  if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                !std::is_same_v<T, char>) {
+    using Integer = std::conditional_t<std::is_signed_v<T>, long long,
+                                       unsigned long long>;
+    return TryPutIntegerTag(key, static_cast<Integer>(value));
+  } else {
+    return false;
+  }
+}
+
 template <typename T>
 void TagWriter::PutTag(TagKey key, const T& value) {
+  if (TryPutInteger(key.GetEscapedKey(), value)) return;
   PutKey(key);
   lh_ << value;
   MarkValueEnd();
@@ -94,6 +114,7 @@ void TagWriter::PutTag(TagKey key, const T& value) {
 
 template <typename T>
 void TagWriter::PutTag(RuntimeTagKey key, const T& value) {
+  if (TryPutInteger(key.GetUnescapedKey(), value)) return;
   PutKey(key);
   lh_ << value;
   MarkValueEnd();
@@ -0,0 +1,559 @@
+#pragma once
+
+/// @file userver/utils/persistent_hash_map.hpp
+/// @brief @copybrief utils::PersistentHashMap
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace impl::hamt {
+
+inline constexpr std::size_t kBitsPerLevel = 5;
+inline constexpr std::size_t kHashBits =
+    std::numeric_limits<std::size_t>::digits;
+// Bitmap levels plus a collision level
+inline constexpr std::size_t kMaxDepth =
+    (kHashBits + kBitsPerLevel - 1) / kBitsPerLevel + 1;
+
+inline std::uint32_t GetBit(std::size_t hash, std::size_t shift) noexcept {
+  return std::uint32_t{1} << ((hash >> shift) & ((1 << kBitsPerLevel) - 1));
+}
+
+inline std::size_t GetIndex(std::uint32_t bitmap, std::uint32_t bit) noexcept {
+  return std::bitset<32>(bitmap & (bit - 1)).count();
+}
+
+template <typename Node>
+class NodePtr final {
+ public:
+  NodePtr() noexcept = default;
+  explicit NodePtr(Node* node) noexcept : node_(node) { Ref(); }
+
+  NodePtr(const NodePtr& other) noexcept : node_(other.node_) { Ref(); }
+  NodePtr(NodePtr&& other) noexcept : node_(std::exchange(other.node_, {})) {}
+  NodePtr& operator=(NodePtr other) noexcept {
+    std::swap(node_, other.node_);
+    return *this;
+  }
+  ~NodePtr() { Unref(); }
+
+  Node* get() const noexcept { return node_; }
+  Node* operator->() const noexcept { return node_; }
+  Node& operator*() const noexcept { return *node_; }
+  explicit operator bool() const noexcept { return node_ != nullptr; }
+
+  // Only the owner of the single reference may modify the node in place,
+  // other references belong to snapshots that may be read concurrently.
+  bool IsUnique() const noexcept {
+    return node_->refs.load(std::memory_order_acquire) == 1;
+  }
+
+ private:
+  void Ref() noexcept {
+    if (node_) node_->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void Unref() noexcept {
+    if (node_ && node_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete node_;
+    }
+  }
+
+  Node* node_{nullptr};
+};
+
+// A CHAMP-style node: entries that do not collide at this level are stored
+// inline, the rest are pushed down to children. Nodes below the last bitmap
+// level store the entries with equal hashes in `entries` unordered.
+template <typename Entry>
+struct Node final {
+  Node() = default;
+  Node(const Node& other)
+      : datamap(other.datamap),
+        nodemap(other.nodemap),
+        entries(other.entries),
+        children(other.children) {}
+
+  mutable std::atomic<std::size_t> refs{0};
+  std::uint32_t datamap{0};
+  std::uint32_t nodemap{0};
+  std::vector<Entry> entries;
+  std::vector<NodePtr<Node>> children;
+};
+
+}  // namespace impl::hamt
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief Persistent (immutable with structural sharing) hash map, based on
+/// a hash array mapped trie.
+///
+/// Copying the map takes O(1), the copies share all of their nodes.
+/// A modification copies only the nodes on the path to the changed key, so
+/// O(changed keys) memory and time are spent on updating a copy of a huge
+/// map. This makes the map a good fit for incrementally updated caches, see
+/// cache::CachingComponentBase::GetDataForUpdate.
+///
+/// Up to 32 entries of a node are copied along with it, so it is better
+/// to keep the values cheap to copy, e.g. wrap heavy values into
+/// `std::shared_ptr<const T>`.
+///
+/// Unlike `std::unordered_map`, the values are not mutable via iterators and
+/// the modifying methods do not return iterators.
+///
+/// Const member functions may be called concurrently on the same and on
+/// different copies of the map. Modifications of a map may be done
+/// concurrently with the reads of its copies.
+///
+/// @snippet src/utils/persistent_hash_map_test.cpp  Sample PersistentHashMap
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class PersistentHashMap final {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = Equal;
+
+  class const_iterator;
+  using iterator = const_iterator;
+
+  PersistentHashMap() = default;
+  explicit PersistentHashMap(const Hash& hash, const Equal& equal = Equal())
+      : hash_(hash), equal_(equal) {}
+
+  PersistentHashMap(std::initializer_list<value_type> init) {
+    for (const auto& [key, value] : init) insert_or_assign(key, value);
+  }
+
+  PersistentHashMap(const PersistentHashMap&) = default;
+  PersistentHashMap(PersistentHashMap&& other) noexcept
+      : root_(std::move(other.root_)),
+        size_(std::exchange(other.size_, 0)),
+        hash_(std::move(other.hash_)),
+        equal_(std::move(other.equal_)) {}
+  PersistentHashMap& operator=(const PersistentHashMap&) = default;
+  PersistentHashMap& operator=(PersistentHashMap&& other) noexcept {
+    root_ = std::move(other.root_);
+    size_ = std::exchange(other.size_, 0);
+    hash_ = std::move(other.hash_);
+    equal_ = std::move(other.equal_);
+    return *this;
+  }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  const_iterator begin() const { return const_iterator{root_.get()}; }
+  const_iterator end() const noexcept { return const_iterator{}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  const_iterator find(const Key& key) const;
+
+  size_type count(const Key& key) const { return FindEntry(key) ? 1 : 0; }
+  bool contains(const Key& key) const { return FindEntry(key) != nullptr; }
+
+  /// @throws std::out_of_range if there is no such key
+  const Value& at(const Key& key) const {
+    const auto* entry = FindEntry(key);
+    if (!entry) throw std::out_of_range("PersistentHashMap::at");
+    return entry->second;
+  }
+
+  /// Inserts the value or replaces the existing one.
+  /// @returns true if the key was inserted
+  template <typename K, typename V>
+  bool insert_or_assign(K&& key, V&& value);
+
+  /// Inserts the value if there is no such key.
+  /// @returns true if the key was inserted
+  template <typename K, typename... Args>
+  bool try_emplace(K&& key, Args&&... args);
+
+  /// @overload
+  bool insert(value_type value) {
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+
+  /// @returns the number of erased entries
+  size_type erase(const Key& key);
+
+  void clear() noexcept {
+    root_ = NodePtr{};
+    size_ = 0;
+  }
+
+  void swap(PersistentHashMap& other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+  }
+
+ private:
+  using Node = impl::hamt::Node<value_type>;
+  using NodePtr = impl::hamt::NodePtr<Node>;
+
+  static constexpr std::size_t kCollisionShift = impl::hamt::kHashBits;
+
+  enum class InsertResult { kInserted, kAssigned };
+
+  static Node& MakeUnique(NodePtr& node);
+  static NodePtr MakeNode(std::size_t shift, value_type&& first,
+                          std::size_t first_hash, value_type&& second,
+                          std::size_t second_hash);
+
+  const value_type* FindEntry(const Key& key) const;
+
+  template <typename K, typename V>
+  InsertResult Insert(NodePtr& node, std::size_t shift, std::size_t hash,
+                      K&& key, V&& value);
+
+  void Erase(NodePtr& node, std::size_t shift, std::size_t hash,
+             const Key& key);
+
+  NodePtr root_;
+  size_type size_{0};
+  Hash hash_;
+  Equal equal_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+class PersistentHashMap<Key, Value, Hash, Equal>::const_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = PersistentHashMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  const_iterator() = default;
+
+  reference operator*() const {
+    UASSERT(current_);
+    return *current_;
+  }
+  pointer operator->() const {
+    UASSERT(current_);
+    return current_;
+  }
+
+  const_iterator& operator++() {
+    SeekNext();
+    return *this;
+  }
+  const_iterator operator++(int) {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  bool operator==(const const_iterator& other) const noexcept {
+    return current_ == other.current_;
+  }
+  bool operator!=(const const_iterator& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  friend class PersistentHashMap;
+
+  // Entries of a node are visited first, then its children
+  struct Frame {
+    const Node* node{nullptr};
+    std::size_t pos{0};
+  };
+
+  explicit const_iterator(const Node* root) {
+    if (!root) return;
+    Push(root, 0);
+    SeekNext();
+  }
+
+  void Push(const Node* node, std::size_t pos) {
+    UASSERT(depth_ < stack_.size());
+    stack_[depth_++] = Frame{node, pos};
+  }
+
+  void SeekNext() {
+    while (depth_ > 0) {
+      auto& frame = stack_[depth_ - 1];
+      const auto& entries = frame.node->entries;
+      if (frame.pos < entries.size()) {
+        current_ = &entries[frame.pos++];
+        return;
+      }
+      const auto child = frame.pos - entries.size();
+      if (child < frame.node->children.size()) {
+        ++frame.pos;
+        Push(frame.node->children[child].get(), 0);
+        continue;
+      }
+      --depth_;
+    }
+    current_ = nullptr;
+  }
+
+  std::array<Frame, impl::hamt::kMaxDepth> stack_{};
+  std::size_t depth_{0};
+  const value_type* current_{nullptr};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::find(const Key& key) const
+    -> const_iterator {
+  const_iterator it;
+  const Node* node = root_.get();
+  if (!node) return it;
+
+  const auto hash = hash_(key);
+  for (std::size_t shift = 0;; shift += impl::hamt::kBitsPerLevel) {
+    if (shift >= kCollisionShift) {
+      for (std::size_t i = 0; i < node->entries.size(); ++i) {
+        if (equal_(node->entries[i].first, key)) {
+          it.Push(node, i + 1);
+          it.current_ = &node->entries[i];
+          return it;
+        }
+      }
+      return const_iterator{};
+    }
+
+    const auto bit = impl::hamt::GetBit(hash, shift);
+    if (node->datamap & bit) {
+      const auto index = impl::hamt::GetIndex(node->datamap, bit);
+      if (!equal_(node->entries[index].first, key)) return const_iterator{};
+      it.Push(node, index + 1);
+      it.current_ = &node->entries[index];
+      return it;
+    }
+    if (!(node->nodemap & bit)) return const_iterator{};
+
+    const auto index = impl::hamt::GetIndex(node->nodemap, bit);
+    it.Push(node, node->entries.size() + index + 1);
+    node = node->children[index].get();
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::FindEntry(const Key& key) const
+    -> const value_type* {
+  const Node* node = root_.get();
+  if (!node) return nullptr;
+
+  const auto hash = hash_(key);
+  for (std::size_t shift = 0;; shift += impl::hamt::kBitsPerLevel) {
+    if (shift >= kCollisionShift) {
+      for (const auto& entry : node->entries) {
+        if (equal_(entry.first, key)) return &entry;
+      }
+      return nullptr;
+    }
+
+    const auto bit = impl::hamt::GetBit(hash, shift);
+    if (node->datamap & bit) {
+      const auto& entry =
+          node->entries[impl::hamt::GetIndex(node->datamap, bit)];
+      return equal_(entry.first, key) ? &entry : nullptr;
+    }
+    if (!(node->nodemap & bit)) return nullptr;
+    node = node->children[impl::hamt::GetIndex(node->nodemap, bit)].get();
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename K, typename V>
+bool PersistentHashMap<Key, Value, Hash, Equal>::insert_or_assign(K&& key,
+                                                                  V&& value) {
+  if (!root_) root_ = NodePtr{new Node()};
+  const auto hash = hash_(key);
+  const auto result =
+      Insert(root_, 0, hash, std::forward<K>(key), std::forward<V>(value));
+  if (result == InsertResult::kAssigned) return false;
+  ++size_;
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename K, typename... Args>
+bool PersistentHashMap<Key, Value, Hash, Equal>::try_emplace(K&& key,
+                                                             Args&&... args) {
+  // Avoid copying the path to an existing key
+  if (contains(key)) return false;
+  return insert_or_assign(std::forward<K>(key),
+                          Value(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::erase(const Key& key)
+    -> size_type {
+  // Avoid copying the path to a missing key
+  if (!contains(key)) return 0;
+
+  Erase(root_, 0, hash_(key), key);
+  --size_;
+  if (size_ == 0) root_ = NodePtr{};
+  return 1;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::MakeUnique(NodePtr& node)
+    -> Node& {
+  if (!node.IsUnique()) node = NodePtr{new Node(*node)};
+  return *node;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::MakeNode(
+    std::size_t shift, value_type&& first, std::size_t first_hash,
+    value_type&& second, std::size_t second_hash) -> NodePtr {
+  NodePtr node{new Node()};
+  node->entries.reserve(2);
+
+  if (shift >= kCollisionShift) {
+    node->entries.push_back(std::move(first));
+    node->entries.push_back(std::move(second));
+    return node;
+  }
+
+  const auto first_bit = impl::hamt::GetBit(first_hash, shift);
+  const auto second_bit = impl::hamt::GetBit(second_hash, shift);
+  if (first_bit == second_bit) {
+    node->nodemap = first_bit;
+    node->children.push_back(MakeNode(shift + impl::hamt::kBitsPerLevel,
+                                      std::move(first), first_hash,
+                                      std::move(second), second_hash));
+    return node;
+  }
+
+  node->datamap = first_bit | second_bit;
+  if (first_bit < second_bit) {
+    node->entries.push_back(std::move(first));
+    node->entries.push_back(std::move(second));
+  } else {
+    node->entries.push_back(std::move(second));
+    node->entries.push_back(std::move(first));
+  }
+  return node;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename K, typename V>
+auto PersistentHashMap<Key, Value, Hash, Equal>::Insert(
+    NodePtr& node_ptr, std::size_t shift, std::size_t hash, K&& key, V&& value)
+    -> InsertResult {
+  auto& node = MakeUnique(node_ptr);
+
+  if (shift >= kCollisionShift) {
+    for (auto& entry : node.entries) {
+      if (equal_(entry.first, key)) {
+        entry.second = std::forward<V>(value);
+        return InsertResult::kAssigned;
+      }
+    }
+    node.entries.emplace_back(std::forward<K>(key), std::forward<V>(value));
+    return InsertResult::kInserted;
+  }
+
+  const auto bit = impl::hamt::GetBit(hash, shift);
+  if (node.datamap & bit) {
+    const auto index = impl::hamt::GetIndex(node.datamap, bit);
+    auto& entry = node.entries[index];
+    if (equal_(entry.first, key)) {
+      entry.second = std::forward<V>(value);
+      return InsertResult::kAssigned;
+    }
+
+    // Push both entries down to a new child
+    const auto entry_hash = hash_(entry.first);
+    auto child = MakeNode(
+        shift + impl::hamt::kBitsPerLevel, std::move(entry), entry_hash,
+        value_type(std::forward<K>(key), std::forward<V>(value)), hash);
+    node.entries.erase(node.entries.begin() + index);
+    node.datamap ^= bit;
+    node.nodemap |= bit;
+    node.children.insert(
+        node.children.begin() + impl::hamt::GetIndex(node.nodemap, bit),
+        std::move(child));
+    return InsertResult::kInserted;
+  }
+
+  if (node.nodemap & bit) {
+    auto& child = node.children[impl::hamt::GetIndex(node.nodemap, bit)];
+    return Insert(child, shift + impl::hamt::kBitsPerLevel, hash,
+                  std::forward<K>(key), std::forward<V>(value));
+  }
+
+  node.datamap |= bit;
+  node.entries.emplace(
+      node.entries.begin() + impl::hamt::GetIndex(node.datamap, bit),
+      std::forward<K>(key), std::forward<V>(value));
+  return InsertResult::kInserted;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void PersistentHashMap<Key, Value, Hash, Equal>::Erase(NodePtr& node_ptr,
+                                                       std::size_t shift,
+                                                       std::size_t hash,
+                                                       const Key& key) {
+  auto& node = MakeUnique(node_ptr);
+
+  if (shift >= kCollisionShift) {
+    const auto it =
+        std::find_if(node.entries.begin(), node.entries.end(),
+                     [&](const value_type& entry) {
+                       return equal_(entry.first, key);
+                     });
+    UASSERT(it != node.entries.end());
+    node.entries.erase(it);
+    return;
+  }
+
+  const auto bit = impl::hamt::GetBit(hash, shift);
+  if (node.datamap & bit) {
+    node.entries.erase(node.entries.begin() +
+                       impl::hamt::GetIndex(node.datamap, bit));
+    node.datamap ^= bit;
+    return;
+  }
+
+  UASSERT(node.nodemap & bit);
+  const auto child_index = impl::hamt::GetIndex(node.nodemap, bit);
+  auto& child = node.children[child_index];
+  Erase(child, shift + impl::hamt::kBitsPerLevel, hash, key);
+
+  // Keep the trie canonical: a child with a single entry is inlined
+  if (child->children.empty() && child->entries.size() == 1) {
+    auto entry = std::move(child->entries.front());
+    node.children.erase(node.children.begin() + child_index);
+    node.nodemap ^= bit;
+    node.datamap |= bit;
+    node.entries.insert(
+        node.entries.begin() + impl::hamt::GetIndex(node.datamap, bit),
+        std::move(entry));
+  }
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <userver/cache/lru_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kKeysCount = 100'000;
+constexpr std::size_t kTraceSize = 1'000'000;
+
+template <cache::EvictionPolicy Policy>
+using Cache = cache::LruMap<unsigned, unsigned, std::hash<unsigned>,
+                            std::equal_to<unsigned>, Policy>;
+
+// Zipfian trace with the given skew over kKeysCount keys. Every
+// `scan_period`-th request is replaced with a unique never repeated key.
+std::vector<unsigned> MakeTrace(double skew, std::size_t scan_period) {
+  std::vector<double> weights(kKeysCount);
+  for (std::size_t i = 0; i < kKeysCount; ++i) {
+    weights[i] = 1.0 / std::pow(static_cast<double>(i + 1), skew);
+  }
+
+  std::mt19937 rng(42);
+  std::discrete_distribution<unsigned> distribution(weights.begin(),
+                                                    weights.end());
+
+  std::vector<unsigned> trace(kTraceSize);
+  unsigned scan_key = kKeysCount;
+  for (std::size_t i = 0; i < kTraceSize; ++i) {
+    trace[i] = (scan_period && i % scan_period == 0) ? scan_key++
+                                                      : distribution(rng);
+  }
+  return trace;
+}
+
+const std::vector<unsigned>& GetTrace(bool with_scans) {
+  static const auto kTrace = MakeTrace(0.9, 0);
+  static const auto kScanTrace = MakeTrace(0.9, 3);
+  return with_scans ? kScanTrace : kTrace;
+}
+
+template <cache::EvictionPolicy Policy>
+void CacheZipf(benchmark::State& state) {
+  const auto& trace = GetTrace(state.range(1) != 0);
+
+  std::size_t requests = 0;
+  std::size_t hits = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    Cache<Policy> cache(state.range(0));
+    for (const auto key : trace) {
+      if (cache.Get(key)) {
+        ++hits;
+      } else {
+        cache.Put(key, key);
+      }
+    }
+    requests += trace.size();
+  }
+
+  state.SetItemsProcessed(requests);
+  state.counters["hit_rate"] =
+      static_cast<double>(hits) / static_cast<double>(requests);
+}
+
+}  // namespace
+
+void LruZipf(benchmark::State& state) {
+  CacheZipf<cache::EvictionPolicy::kLru>(state);
+}
+BENCHMARK(LruZipf)->ArgsProduct({{1000, 10'000}, {false, true}});
+
+void TinyLfuZipf(benchmark::State& state) {
+  CacheZipf<cache::EvictionPolicy::kTinyLfu>(state);
+}
+BENCHMARK(TinyLfuZipf)->ArgsProduct({{1000, 10'000}, {false, true}});
+
+USERVER_NAMESPACE_END
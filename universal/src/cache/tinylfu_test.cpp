@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <userver/cache/impl/tinylfu.hpp>
+#include <userver/cache/lru_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using TinyLfu = cache::impl::TinyLfuBase<int, int>;
+using Sketch = cache::impl::FrequencySketch<int>;
+
+}  // namespace
+
+TEST(FrequencySketch, Estimate) {
+  Sketch sketch(100);
+  EXPECT_EQ(sketch.Estimate(1), 0);
+
+  for (int i = 0; i < 5; ++i) sketch.Increment(1);
+  sketch.Increment(2);
+
+  EXPECT_EQ(sketch.Estimate(1), 5);
+  EXPECT_EQ(sketch.Estimate(2), 1);
+  EXPECT_EQ(sketch.Estimate(3), 0);
+
+  for (int i = 0; i < 100; ++i) sketch.Increment(1);
+  EXPECT_EQ(sketch.Estimate(1), Sketch::kMaxFrequency);
+
+  sketch.Clear();
+  EXPECT_EQ(sketch.Estimate(1), 0);
+}
+
+TEST(FrequencySketch, Aging) {
+  Sketch sketch(16);
+  for (int i = 0; i < 8; ++i) sketch.Increment(1);
+  EXPECT_EQ(sketch.Estimate(1), 8);
+
+  // Sample size is 10 * width, the increments of the other keys trigger aging
+  for (int i = 0; i < 200; ++i) sketch.Increment(1000 + i);
+  EXPECT_LT(sketch.Estimate(1), 8);
+}
+
+TEST(TinyLfu, SetGet) {
+  TinyLfu cache(100);
+  EXPECT_EQ(cache.Get(1), nullptr);
+
+  EXPECT_TRUE(cache.Put(1, 10));
+  ASSERT_NE(cache.Get(1), nullptr);
+  EXPECT_EQ(*cache.Get(1), 10);
+
+  EXPECT_FALSE(cache.Put(1, 20));
+  EXPECT_EQ(*cache.Get(1), 20);
+  EXPECT_EQ(cache.GetSize(), 1);
+
+  cache.Erase(1);
+  EXPECT_EQ(cache.Get(1), nullptr);
+  EXPECT_EQ(cache.GetSize(), 0);
+}
+
+TEST(TinyLfu, Emplace) {
+  TinyLfu cache(100);
+  EXPECT_EQ(*cache.Emplace(1, 10), 10);
+  EXPECT_EQ(*cache.Emplace(1, 20), 10);
+  EXPECT_EQ(cache.GetSize(), 1);
+}
+
+TEST(TinyLfu, Capacity) {
+  TinyLfu cache(100);
+  EXPECT_EQ(cache.GetCapacity(), 100);
+
+  for (int i = 0; i < 1000; ++i) cache.Put(i, i);
+  EXPECT_EQ(cache.GetSize(), 100);
+
+  cache.SetMaxSize(10);
+  EXPECT_EQ(cache.GetCapacity(), 10);
+  EXPECT_LE(cache.GetSize(), 10);
+
+  std::size_t visited = 0;
+  cache.VisitAll([&visited](int key, int value) {
+    EXPECT_EQ(key, value);
+    ++visited;
+  });
+  EXPECT_EQ(visited, cache.GetSize());
+
+  cache.Clear();
+  EXPECT_EQ(cache.GetSize(), 0);
+}
+
+TEST(TinyLfu, ScanResistance) {
+  constexpr int kHotKeys = 50;
+
+  const auto count_hits = [](auto& cache) {
+    for (int round = 0; round < 5; ++round) {
+      for (int key = 0; key < kHotKeys; ++key) {
+        if (!cache.Get(key)) cache.Put(key, key);
+      }
+    }
+
+    // A scan of keys that are never requested again
+    for (int key = 1000; key < 2000; ++key) {
+      if (!cache.Get(key)) cache.Put(key, key);
+    }
+
+    int hits = 0;
+    for (int key = 0; key < kHotKeys; ++key) {
+      if (cache.Get(key)) ++hits;
+    }
+    return hits;
+  };
+
+  cache::LruMap<int, int> lru(100);
+  EXPECT_EQ(count_hits(lru), 0);
+
+  // The estimates are approximate, a few hot keys may lose to the scan
+  TinyLfu tinylfu(100);
+  EXPECT_GE(count_hits(tinylfu), kHotKeys * 9 / 10);
+}
+
+TEST(TinyLfu, LruMap) {
+  cache::LruMap<int, int, std::hash<int>, std::equal_to<int>,
+                cache::EvictionPolicy::kTinyLfu>
+      cache(10);
+
+  cache.Put(1, 1);
+  EXPECT_EQ(cache.GetOr(1, -1), 1);
+  EXPECT_EQ(cache.GetOr(2, -1), -1);
+  ASSERT_NE(cache.GetLeastUsed(), nullptr);
+
+  for (int i = 0; i < 100; ++i) cache.Put(i, i);
+  EXPECT_EQ(cache.GetSize(), 10);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,68 @@
+#include <formats/json/impl/member_index.hpp>
+
+#include <cstdint>
+#include <memory>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+namespace {
+
+std::string_view GetName(const Value::Member& member) {
+  return {member.name.GetString(), member.name.GetStringLength()};
+}
+
+}  // namespace
+
+MemberIndex::MemberIndex(const Value& object)
+    : members_(&*object.MemberBegin()), size_(object.MemberCount()) {
+  positions_.reserve(size_);
+  for (std::size_t i = 0; i < size_; ++i) {
+    // emplace keeps the first of the duplicate keys, just like FindMember
+    positions_.emplace(GetName(members_[i]), i);
+  }
+}
+
+bool MemberIndex::IsBuiltFor(const Value& object) const noexcept {
+  return object.MemberCount() == size_ && &*object.MemberBegin() == members_;
+}
+
+const Value* MemberIndex::Find(const Value& object,
+                               std::string_view key) const {
+  UASSERT(IsBuiltFor(object));
+  const auto it = positions_.find(key);
+  if (it == positions_.end()) return nullptr;
+  return &object.MemberBegin()[it->second].value;
+}
+
+MemberIndexes::~MemberIndexes() {
+  for (auto& slot : slots_) delete slot.index.load();
+}
+
+const MemberIndex* MemberIndexes::GetOrBuild(const Value& object) {
+  // Values are 16 bytes, the low bits of their addresses are all the same
+  const auto start = reinterpret_cast<std::uintptr_t>(&object) >> 4;
+  for (std::size_t i = 0; i < kMaxProbes; ++i) {
+    auto& slot = slots_[(start + i) % kMaxIndexes];
+
+    const Value* expected = nullptr;
+    if (slot.object.compare_exchange_strong(expected, &object,
+                                            std::memory_order_acq_rel)) {
+      // The slot is ours, other threads search linearly until it is built
+      auto index = std::make_unique<MemberIndex>(object);
+      slot.index.store(index.get(), std::memory_order_release);
+      return index.release();
+    }
+    if (expected == &object) {
+      return slot.index.load(std::memory_order_acquire);
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string_view>
+#include <unordered_map>
+
+#include <rapidjson/document.h>
+
+#include <userver/formats/json/impl/types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+/// Objects with fewer members are faster to search linearly
+inline constexpr std::size_t kMinIndexedMembers = 32;
+
+/// Hash index of the members of a single object
+class MemberIndex final {
+ public:
+  explicit MemberIndex(const Value& object);
+
+  /// Returns false if the object members were reallocated after the index was
+  /// built, the index must not be used in that case
+  bool IsBuiltFor(const Value& object) const noexcept;
+
+  /// Returns nullptr if there is no such member
+  const Value* Find(const Value& object, std::string_view key) const;
+
+ private:
+  const Value::Member* members_;
+  std::size_t size_;
+  std::unordered_map<std::string_view, std::size_t> positions_;
+};
+
+/// Lazily built indexes of the large objects of an immutable JSON tree, safe
+/// for concurrent use.
+///
+/// The number of indexes is limited, the objects that do not fit are searched
+/// linearly.
+class MemberIndexes final {
+ public:
+  MemberIndexes() = default;
+  MemberIndexes(MemberIndexes&&) = delete;
+  MemberIndexes& operator=(MemberIndexes&&) = delete;
+  ~MemberIndexes();
+
+  /// Returns nullptr if the index is not available yet or cannot be built
+  const MemberIndex* GetOrBuild(const Value& object);
+
+ private:
+  static constexpr std::size_t kMaxIndexes = 256;
+  static constexpr std::size_t kMaxProbes = 8;
+
+  struct Slot final {
+    std::atomic<const Value*> object{nullptr};
+    std::atomic<const MemberIndex*> index{nullptr};
+  };
+
+  std::array<Slot, kMaxIndexes> slots_;
+};
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #include <formats/json/impl/types_impl.hpp>
 
+#include <rapidjson/document.h>
+
+#include <formats/json/impl/member_index.hpp>
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -15,6 +18,24 @@ VersionedValuePtr::Data::Data(Document&& doc)
       "Both Document and Value must use CrtAllocator for the fast move");
 }
 
+VersionedValuePtr::Data::Data(Document&& doc,
+                              std::unique_ptr<char[]>&& doc_arena)
+    : arena(std::move(doc_arena)), native(static_cast<Value&&>(doc)) {}
+
+VersionedValuePtr::Data::~Data() { delete member_indexes.load(); }
+
+MemberIndexes& VersionedValuePtr::Data::GetMemberIndexes() {
+  auto* indexes = member_indexes.load(std::memory_order_acquire);
+  if (indexes) return *indexes;
+
+  auto new_indexes = std::make_unique<MemberIndexes>();
+  if (member_indexes.compare_exchange_strong(indexes, new_indexes.get(),
+                                             std::memory_order_acq_rel)) {
+    return *new_indexes.release();
+  }
+  return *indexes;
+}
+
 VersionedValuePtr::VersionedValuePtr() noexcept = default;
 
 VersionedValuePtr::VersionedValuePtr(std::shared_ptr<Data>&& data) noexcept
@@ -52,6 +73,26 @@ size_t VersionedValuePtr::Version() const {
 
 void VersionedValuePtr::BumpVersion() { ++data_->version; }
 
+bool VersionedValuePtr::HasArena() const { return data_ && data_->arena; }
+
+void VersionedValuePtr::EnableMemberIndex() {
+  data_->is_member_index_enabled = true;
+}
+
+const Value* VersionedValuePtr::FindMember(const Value& object,
+                                           std::string_view key) const {
+  UASSERT(object.IsObject());
+  if (data_ && data_->is_member_index_enabled &&
+      object.MemberCount() >= kMinIndexedMembers) {
+    const auto* index = data_->GetMemberIndexes().GetOrBuild(object);
+    if (index && index->IsBuiltFor(object)) return index->Find(object, key);
+  }
+
+  const auto it =
+      object.FindMember(Value(::rapidjson::StringRef(key.data(), key.size())));
+  return it != object.MemberEnd() ? &it->value : nullptr;
+}
+
 }  // namespace formats::json::impl
 
 USERVER_NAMESPACE_END
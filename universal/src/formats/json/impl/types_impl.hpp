@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 
 #include <rapidjson/document.h>
 
@@ -10,6 +11,8 @@ USERVER_NAMESPACE_BEGIN
 
 namespace formats::json::impl {
 
+class MemberIndexes;
+
 struct VersionedValuePtr::Data {
   template <typename... Args>
   explicit Data(Args&&... args) : native(std::forward<Args>(args)...) {}
@@ -18,7 +21,15 @@ struct VersionedValuePtr::Data {
   // https://github.com/Tencent/rapidjson/issues/387
   explicit Data(Document&&);
 
-  ~Data() = default;
+  // The document strings are stored in the `arena`
+  Data(Document&&, std::unique_ptr<char[]>&& arena);
+
+  ~Data();
+
+  MemberIndexes& GetMemberIndexes();
+
+  // owns the strings of `native` if set, must outlive it
+  std::unique_ptr<char[]> arena;
 
   // native rapidjson value
   Value native;
@@ -26,6 +37,13 @@ struct VersionedValuePtr::Data {
   // version of internal rapidjson structures (member arrays)
   // used in ValueBuilder to avoid UAF, ignored in read-only Value
   std::atomic<size_t> version{0};
+
+  // set for the parsed documents that opted in for the member indexes, such
+  // documents are never modified
+  bool is_member_index_enabled{false};
+
+  // created on the first lookup in a large object
+  std::atomic<MemberIndexes*> member_indexes{nullptr};
 };
 
 template <typename... Args>
@@ -105,7 +105,9 @@ void InlineObjectBuilder::Append(std::string_view key,
 void InlineObjectBuilder::Append(std::string_view key,
                                  const formats::json::Value& value) {
   json_->AddMember(WrapStringView(key),
-                   impl::Value(value.GetNative(), g_allocator), g_allocator);
+                   impl::Value(value.GetNative(), g_allocator,
+                               /*copyConstStrings=*/true),
+                   g_allocator);
 }
 
 InlineArrayBuilder::InlineArrayBuilder()
@@ -168,7 +170,9 @@ void InlineArrayBuilder::Append(std::chrono::system_clock::time_point value) {
 }
 
 void InlineArrayBuilder::Append(const formats::json::Value& value) {
-  json_->PushBack(impl::Value(value.GetNative(), g_allocator), g_allocator);
+  json_->PushBack(
+      impl::Value(value.GetNative(), g_allocator, /*copyConstStrings=*/true),
+      g_allocator);
 }
 
 }  // namespace formats::json::impl
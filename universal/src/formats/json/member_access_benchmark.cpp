@@ -1,4 +1,6 @@
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -190,4 +192,90 @@ BENCHMARK(json_object_wide_object_operator_equals)
     ->Range(32, 8192)
     ->RangeMultiplier(2);
 
+formats::json::Value ParseWideObject(std::size_t size, bool member_index) {
+  const auto doc = formats::json::ToString(Build(size).ExtractValue());
+  return member_index ? formats::json::FromStringWithMemberIndex(doc)
+                      : formats::json::FromString(doc);
+}
+
+void WideObjectMemberAccess(benchmark::State& state, bool member_index) {
+  const std::size_t size = state.range(0);
+  const auto json = ParseWideObject(size, member_index);
+
+  std::vector<std::string> keys;
+  keys.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) keys.push_back(std::to_string(i));
+
+  std::size_t i = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(json[keys[i]]);
+    if (++i == size) i = 0;
+  }
+}
+
+void json_object_wide_object_member_access(benchmark::State& state) {
+  WideObjectMemberAccess(state, false);
+}
+BENCHMARK(json_object_wide_object_member_access)
+    ->RangeMultiplier(2)
+    ->Range(8, 16384);
+
+void json_object_wide_object_member_access_indexed(benchmark::State& state) {
+  WideObjectMemberAccess(state, true);
+}
+BENCHMARK(json_object_wide_object_member_access_indexed)
+    ->RangeMultiplier(2)
+    ->Range(8, 16384);
+
+void WideObjectMissingMember(benchmark::State& state, bool member_index) {
+  const auto json = ParseWideObject(state.range(0), member_index);
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(json.HasMember("missing"));
+  }
+}
+
+void json_object_wide_object_missing_member(benchmark::State& state) {
+  WideObjectMissingMember(state, false);
+}
+BENCHMARK(json_object_wide_object_missing_member)
+    ->RangeMultiplier(2)
+    ->Range(8, 16384);
+
+void json_object_wide_object_missing_member_indexed(benchmark::State& state) {
+  WideObjectMissingMember(state, true);
+}
+BENCHMARK(json_object_wide_object_missing_member_indexed)
+    ->RangeMultiplier(2)
+    ->Range(8, 16384);
+
+// Parsing and a single lookup, the index is built once per document
+void WideObjectParseAndAccess(benchmark::State& state, bool member_index) {
+  const std::size_t size = state.range(0);
+  const auto doc = formats::json::ToString(Build(size).ExtractValue());
+  const auto key = std::to_string(size / 2);
+
+  for ([[maybe_unused]] auto _ : state) {
+    const auto json = member_index
+                          ? formats::json::FromStringWithMemberIndex(doc)
+                          : formats::json::FromString(doc);
+    benchmark::DoNotOptimize(json[key]);
+  }
+}
+
+void json_object_wide_object_parse_and_access(benchmark::State& state) {
+  WideObjectParseAndAccess(state, false);
+}
+BENCHMARK(json_object_wide_object_parse_and_access)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096);
+
+void json_object_wide_object_parse_and_access_indexed(
+    benchmark::State& state) {
+  WideObjectParseAndAccess(state, true);
+}
+BENCHMARK(json_object_wide_object_parse_and_access_indexed)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096);
+
 USERVER_NAMESPACE_END
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <sstream>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include <userver/formats/json/exception.hpp>
 #include <userver/formats/json/inline.hpp>
@@ -122,4 +126,81 @@ TEST_F(FormatsJsonSpecificMemberAccess,
   }
 }
 
+namespace {
+
+std::string MakeWideObjectJson(std::size_t size) {
+  formats::json::ValueBuilder builder{formats::json::Type::kObject};
+  for (std::size_t i = 0; i < size; ++i) {
+    builder["key" + std::to_string(i)] = i;
+  }
+  return formats::json::ToString(builder.ExtractValue());
+}
+
+}  // namespace
+
+TEST(FormatsJsonWideObject, MemberAccess) {
+  constexpr std::size_t kSize = 1000;
+  const auto doc = MakeWideObjectJson(kSize);
+
+  // Lookups with and without the index find the same members
+  for (const auto& json : {formats::json::FromString(doc),
+                           formats::json::FromStringWithMemberIndex(doc)}) {
+    for (std::size_t i = 0; i < kSize; ++i) {
+      const auto key = "key" + std::to_string(i);
+      EXPECT_TRUE(json.HasMember(key));
+      EXPECT_EQ(json[key].As<std::size_t>(), i);
+      EXPECT_EQ(json[key].GetPath(), key);
+    }
+
+    EXPECT_FALSE(json.HasMember("key"));
+    EXPECT_FALSE(json.HasMember(std::string_view{"key1\0", 5}));
+    EXPECT_TRUE(json["missing"].IsMissing());
+    EXPECT_EQ(json["missing"].As<int>(42), 42);
+  }
+}
+
+TEST(FormatsJsonWideObject, NestedObjects) {
+  const auto wide = MakeWideObjectJson(100);
+  const auto json = formats::json::FromStringWithMemberIndex(
+      fmt::format(R"({{"a": {}, "b": {{"c": {}}}}})", wide, wide));
+
+  EXPECT_EQ(json["a"]["key99"].As<int>(), 99);
+  EXPECT_EQ(json["b"]["c"]["key42"].As<int>(), 42);
+  EXPECT_EQ(json["b"]["c"]["key42"].GetPath(), "b.c.key42");
+  EXPECT_FALSE(json["a"].HasMember("key100"));
+}
+
+TEST(FormatsJsonWideObject, ConcurrentMemberAccess) {
+  constexpr std::size_t kSize = 500;
+  constexpr std::size_t kThreads = 4;
+  const auto json =
+      formats::json::FromStringWithMemberIndex(MakeWideObjectJson(kSize));
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&json] {
+      for (std::size_t i = 0; i < kSize; ++i) {
+        EXPECT_EQ(json["key" + std::to_string(i)].As<std::size_t>(), i);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+TEST(FormatsJsonWideObject, ModifiedCopy) {
+  const auto json =
+      formats::json::FromStringWithMemberIndex(MakeWideObjectJson(100));
+  EXPECT_EQ(json["key1"].As<int>(), 1);
+
+  formats::json::ValueBuilder builder{json};
+  builder.Remove("key1");
+  builder["key100"] = 100;
+  const auto modified = builder.ExtractValue();
+
+  EXPECT_FALSE(modified.HasMember("key1"));
+  EXPECT_EQ(modified["key100"].As<int>(), 100);
+  EXPECT_EQ(json["key1"].As<int>(), 1);
+  EXPECT_FALSE(json.HasMember("key100"));
+}
+
 USERVER_NAMESPACE_END
@@ -216,6 +216,69 @@ BENCHMARK(JsonParseValueDomLotsOfMissingKeys)
     ->RangeMultiplier(2)
     ->Range(1 << 7, 1 << 14);
 
+struct Item final {
+  std::int64_t id{0};
+  std::string name;
+  std::vector<std::string> tags;
+  std::optional<double> price;
+};
+
+Item Parse(const formats::json::Value& value, formats::parse::To<Item>) {
+  return {value["id"].As<std::int64_t>(), value["name"].As<std::string>(),
+          value["tags"].As<std::vector<std::string>>(),
+          value["price"].As<std::optional<double>>()};
+}
+
+constexpr auto DescribeJsonStruct(formats::parse::To<Item>) {
+  using formats::json::parser::Field;
+  return std::make_tuple(Field("id", &Item::id), Field("name", &Item::name),
+                         Field("tags", &Item::tags),
+                         Field("price", &Item::price));
+}
+
+struct Items final {
+  std::vector<Item> items;
+};
+
+Items Parse(const formats::json::Value& value, formats::parse::To<Items>) {
+  return {value["items"].As<std::vector<Item>>()};
+}
+
+constexpr auto DescribeJsonStruct(formats::parse::To<Items>) {
+  return std::make_tuple(formats::json::parser::Field("items", &Items::items));
+}
+
+std::string BuildItems(std::size_t count) {
+  std::string result = R"({"items": [)";
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i > 0) result += ',';
+    result += fmt::format(
+        R"({{"id": {}, "name": "item {}", "tags": ["new", "sale"], )"
+        R"("price": 12.5, "description": "not in the struct"}})",
+        i, i);
+  }
+  result += "]}";
+  return result;
+}
+
+void JsonParseStructDom(benchmark::State& state) {
+  const auto input = BuildItems(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    auto res = formats::json::FromString(input).As<Items>();
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonParseStructDom)->RangeMultiplier(8)->Range(1, 4096);
+
+void JsonParseStructSax(benchmark::State& state) {
+  const auto input = BuildItems(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    auto res = formats::json::parser::ParseToType<Items>(input);
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonParseStructSax)->RangeMultiplier(8)->Range(1, 4096);
+
 }  // namespace
 
 USERVER_NAMESPACE_END
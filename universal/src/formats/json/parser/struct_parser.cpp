@@ -0,0 +1,53 @@
+#include <userver/formats/json/parser/struct_parser.hpp>
+
+#include <userver/formats/json/serialize.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser::impl {
+
+void SkipParser::Null() { MaybePopSelf(); }
+
+void SkipParser::Bool(bool) { MaybePopSelf(); }
+
+void SkipParser::Int64(int64_t) { MaybePopSelf(); }
+
+void SkipParser::Uint64(uint64_t) { MaybePopSelf(); }
+
+void SkipParser::Double(double) { MaybePopSelf(); }
+
+void SkipParser::String(std::string_view) { MaybePopSelf(); }
+
+void SkipParser::StartObject() {
+  if (level_++ > kDepthParseLimit)
+    throw InternalParseError("Exceeded maximum allowed JSON depth of: " +
+                             std::to_string(kDepthParseLimit));
+}
+
+void SkipParser::Key(std::string_view) {}
+
+void SkipParser::EndObject() {
+  level_--;
+  MaybePopSelf();
+}
+
+void SkipParser::StartArray() {
+  if (level_++ > kDepthParseLimit)
+    throw InternalParseError("Exceeded maximum allowed JSON depth of: " +
+                             std::to_string(kDepthParseLimit));
+}
+
+void SkipParser::EndArray() {
+  level_--;
+  MaybePopSelf();
+}
+
+std::string SkipParser::Expected() const { return "anything"; }
+
+void SkipParser::MaybePopSelf() {
+  if (level_ == 0) parser_state_->PopMe(*this);
+}
+
+}  // namespace formats::json::parser::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,166 @@
+#include <userver/formats/json/parser/struct_parser.hpp>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fjp = formats::json::parser;
+
+namespace {
+
+struct Address final {
+  std::string city;
+  std::optional<std::string> street;
+};
+
+constexpr auto DescribeJsonStruct(formats::parse::To<Address>) {
+  return std::make_tuple(fjp::Field("city", &Address::city),
+                         fjp::Field("street", &Address::street));
+}
+
+struct Person final {
+  std::string name;
+  std::int64_t age{0};
+  bool active{false};
+  double rating{0};
+  std::vector<std::string> tags;
+  std::optional<Address> address;
+  std::vector<Address> previous_addresses;
+  std::unordered_map<std::string, std::int32_t> scores;
+  std::map<std::string, std::vector<std::int64_t>> ids;
+  std::set<std::string> labels;  // no SAX parser, parsed via DOM
+  std::optional<std::uint32_t> level;  // no SAX parser, parsed via DOM
+  formats::json::Value extra;
+};
+
+constexpr auto DescribeJsonStruct(formats::parse::To<Person>) {
+  return std::make_tuple(
+      fjp::Field("name", &Person::name), fjp::Field("age", &Person::age),
+      fjp::Field("active", &Person::active),
+      fjp::Field("rating", &Person::rating), fjp::Field("tags", &Person::tags),
+      fjp::Field("address", &Person::address),
+      fjp::Field("previous_addresses", &Person::previous_addresses),
+      fjp::Field("scores", &Person::scores),
+      fjp::Field("ids", &Person::ids), fjp::Field("labels", &Person::labels),
+      fjp::Field("level", &Person::level),
+      fjp::Field("extra", &Person::extra));
+}
+
+constexpr std::string_view kPerson = R"({
+  "name": "John",
+  "age": 42,
+  "active": true,
+  "rating": 4.5,
+  "tags": ["a", "b"],
+  "address": {"city": "Moscow", "street": null},
+  "previous_addresses": [{"city": "Paris", "street": "Rivoli"}, {"city": "X"}],
+  "scores": {"math": 5, "art": 4},
+  "ids": {"a": [1, 2], "b": []},
+  "labels": ["x", "y", "x"],
+  "level": 7,
+  "extra": {"any": [1, {"thing": null}]},
+  "unknown": {"nested": [1, 2, {"a": []}], "other": "x"},
+  "unknown_scalar": null
+})";
+
+std::string ParseError(std::string_view input) {
+  try {
+    fjp::ParseToType<Person>(input);
+  } catch (const fjp::ParseError& e) {
+    return e.what();
+  }
+  ADD_FAILURE() << "no exception for " << input;
+  return {};
+}
+
+}  // namespace
+
+TEST(JsonStructParser, Basic) {
+  static_assert(fjp::kIsDescribedStruct<Person>);
+  static_assert(!fjp::kIsDescribedStruct<std::string>);
+
+  const auto person = fjp::ParseToType<Person>(kPerson);
+
+  EXPECT_EQ(person.name, "John");
+  EXPECT_EQ(person.age, 42);
+  EXPECT_TRUE(person.active);
+  EXPECT_DOUBLE_EQ(person.rating, 4.5);
+  EXPECT_EQ(person.tags, (std::vector<std::string>{"a", "b"}));
+
+  ASSERT_TRUE(person.address);
+  EXPECT_EQ(person.address->city, "Moscow");
+  EXPECT_EQ(person.address->street, std::nullopt);
+
+  ASSERT_EQ(person.previous_addresses.size(), 2);
+  EXPECT_EQ(person.previous_addresses[0].city, "Paris");
+  EXPECT_EQ(person.previous_addresses[0].street, "Rivoli");
+  EXPECT_EQ(person.previous_addresses[1].city, "X");
+  EXPECT_EQ(person.previous_addresses[1].street, std::nullopt);
+
+  EXPECT_EQ(person.scores,
+            (std::unordered_map<std::string, std::int32_t>{{"math", 5},
+                                                           {"art", 4}}));
+  EXPECT_EQ(person.ids, (std::map<std::string, std::vector<std::int64_t>>{
+                            {"a", {1, 2}}, {"b", {}}}));
+  EXPECT_EQ(person.labels, (std::set<std::string>{"x", "y"}));
+  EXPECT_EQ(person.level, 7u);
+  EXPECT_EQ(person.extra,
+            formats::json::FromString(R"({"any": [1, {"thing": null}]})"));
+}
+
+TEST(JsonStructParser, OptionalFields) {
+  const auto person = fjp::ParseToType<Person>(
+      R"({"name": "", "age": 0, "active": false, "rating": 0, "tags": [],
+          "previous_addresses": [], "scores": {}, "ids": {}, "labels": [],
+          "level": null,
+          "extra": null})");
+
+  EXPECT_EQ(person.address.has_value(), false);
+  EXPECT_EQ(person.level, std::nullopt);
+  EXPECT_TRUE(person.extra.IsNull());
+}
+
+TEST(JsonStructParser, Reuse) {
+  const auto addresses = fjp::ParseToType<std::vector<Address>>(
+      R"([{"city": "A", "street": "S"}, {"city": "B"}])");
+
+  ASSERT_EQ(addresses.size(), 2);
+  EXPECT_EQ(addresses[0].street, "S");
+  EXPECT_EQ(addresses[1].city, "B");
+  EXPECT_EQ(addresses[1].street, std::nullopt);
+}
+
+TEST(JsonStructParser, Errors) {
+  EXPECT_EQ(ParseError(R"({"name": "John"})"),
+            "Parse error at pos 15, path '': Field 'age' is missing");
+  EXPECT_EQ(ParseError("[]"),
+            "Parse error at pos 0, path '': object was expected, but array "
+            "found");
+  EXPECT_EQ(ParseError(R"({"name": 1})"),
+            "Parse error at pos 10, path 'name': string was expected, but "
+            "integer found, the latest token was : 1");
+  EXPECT_EQ(ParseError(R"({"name": null})"),
+            "Parse error at pos 13, path 'name': string was expected, but "
+            "null found, the latest token was : null");
+  EXPECT_EQ(ParseError(R"({"name": "a", "name": "b"})"),
+            "Parse error at pos 20, path 'name': Duplicate key: name, the "
+            "latest token was , \"name\"");
+  EXPECT_EQ(ParseError(R"({"address": {"city": 1}})"),
+            "Parse error at pos 22, path 'address.city': string was "
+            "expected, but integer found, the latest token was : 1");
+  EXPECT_EQ(ParseError(R"({"unknown": [1, }})"),
+            "Parse error at pos 16, path 'unknown': Invalid value.");
+}
+
+USERVER_NAMESPACE_END
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <fstream>
 #include <memory>
 #include <string_view>
@@ -95,24 +96,19 @@ void CheckKeyUniqueness(const impl::Value* root) {
   }
 }
 
-impl::VersionedValuePtr EnsureValid(impl::Document&& json) {
+// The arena is taken by reference to outlive `json` if the validation throws
+impl::VersionedValuePtr EnsureValid(
+    impl::Document&& json, std::unique_ptr<char[]>&& arena = nullptr) {
   CheckKeyUniqueness(&json);
 
-  return impl::VersionedValuePtr::Create(std::move(json));
+  return impl::VersionedValuePtr::Create(std::move(json), std::move(arena));
 }
 
-}  // namespace
-
-Value FromString(std::string_view doc) {
-  if (doc.empty()) {
-    throw ParseException("JSON document is empty");
-  }
+constexpr unsigned kParseFlags = rapidjson::kParseDefaultFlags |
+                                 rapidjson::kParseIterativeFlag |
+                                 rapidjson::kParseFullPrecisionFlag;
 
-  impl::Document json{&g_allocator};
-  rapidjson::ParseResult ok =
-      json.Parse<rapidjson::kParseDefaultFlags |
-                 rapidjson::kParseIterativeFlag |
-                 rapidjson::kParseFullPrecisionFlag>(doc.data(), doc.size());
+void CheckParseResult(std::string_view doc, rapidjson::ParseResult ok) {
   if (!ok) {
     const auto offset = ok.Offset();
     const auto line = 1 + std::count(doc.begin(), doc.begin() + offset, '\n');
@@ -125,10 +121,48 @@ Value FromString(std::string_view doc) {
         fmt::format("JSON parse error at line {} column {}: {}", line, column,
                     rapidjson::GetParseError_En(ok.Code())));
   }
+}
+
+void ParseString(std::string_view doc, impl::Document& json) {
+  if (doc.empty()) {
+    throw ParseException("JSON document is empty");
+  }
+
+  CheckParseResult(doc, json.Parse<kParseFlags>(doc.data(), doc.size()));
+}
 
+}  // namespace
+
+Value FromString(std::string_view doc) {
+  impl::Document json{&g_allocator};
+  ParseString(doc, json);
   return Value{EnsureValid(std::move(json))};
 }
 
+Value FromStringWithMemberIndex(std::string_view doc) {
+  impl::Document json{&g_allocator};
+  ParseString(doc, json);
+  auto value = EnsureValid(std::move(json));
+  value.EnableMemberIndex();
+  return Value{std::move(value)};
+}
+
+Value FromStringWithArena(std::string_view doc) {
+  if (doc.empty()) {
+    throw ParseException("JSON document is empty");
+  }
+
+  // The strings are unescaped in place and the nodes refer to them, so only
+  // the arrays and the objects are allocated one by one
+  auto arena = std::make_unique<char[]>(doc.size() + 1);
+  std::memcpy(arena.get(), doc.data(), doc.size());
+  arena[doc.size()] = '\0';
+
+  impl::Document json{&g_allocator};
+  CheckParseResult(doc, json.ParseInsitu<kParseFlags>(arena.get()));
+  return Value{EnsureValid(std::move(json), std::move(arena))};
+}
+
 Value FromStream(std::istream& is) {
   if (!is) {
     throw BadStreamException(is);
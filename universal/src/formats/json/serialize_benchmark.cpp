@@ -1187,6 +1187,71 @@ BENCHMARK(DeepWidthJson);
 
 namespace {
 
+// array of objects with long strings, about 200 bytes per item
+std::string MakeLargeJson(std::size_t items) {
+  formats::json::ValueBuilder builder{formats::json::Type::kArray};
+  for (std::size_t i = 0; i < items; ++i) {
+    formats::json::ValueBuilder item;
+    item["id"] = "item identifier number " + std::to_string(i);
+    item["description"] = "a description that is too long to be inlined";
+    item["tags"].PushBack("the first tag of the item");
+    item["tags"].PushBack("the second tag of the item");
+    item["count"] = i;
+    builder.PushBack(std::move(item));
+  }
+  return formats::json::ToString(builder.ExtractValue());
+}
+
+}  // namespace
+
+// parse and destroy a document, the argument is the number of items
+void LargeJsonParseAndDestroy(benchmark::State& state) {
+  const auto str = MakeLargeJson(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    auto json = formats::json::FromString(str);
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetBytesProcessed(state.iterations() * str.size());
+}
+BENCHMARK(LargeJsonParseAndDestroy)->Range(16, 8192);
+
+void LargeJsonParseAndDestroyWithArena(benchmark::State& state) {
+  const auto str = MakeLargeJson(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    auto json = formats::json::FromStringWithArena(str);
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetBytesProcessed(state.iterations() * str.size());
+}
+BENCHMARK(LargeJsonParseAndDestroyWithArena)->Range(16, 8192);
+
+// the same document with indentation, most of the input is whitespace
+void LargeJsonParsePretty(benchmark::State& state) {
+  const auto str = formats::json::ToPrettyString(
+      formats::json::FromString(MakeLargeJson(state.range(0))));
+  for ([[maybe_unused]] auto _ : state) {
+    auto json = formats::json::FromString(str);
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetBytesProcessed(state.iterations() * str.size());
+}
+BENCHMARK(LargeJsonParsePretty)->Range(16, 8192);
+
+// a single string value, the argument is its length
+void LongStringParse(benchmark::State& state) {
+  const auto str = formats::json::ToString(
+      formats::json::ValueBuilder{std::string(state.range(0), 'a')}
+          .ExtractValue());
+  for ([[maybe_unused]] auto _ : state) {
+    auto json = formats::json::FromString(str);
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetBytesProcessed(state.iterations() * str.size());
+}
+BENCHMARK(LongStringParse)->Range(64, 64 * 1024);
+
+namespace {
+
 struct InnerObject final {
   std::variant<int, bool, std::vector<std::string>, std::string> value;
 };
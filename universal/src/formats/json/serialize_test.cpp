@@ -9,6 +9,7 @@
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/formats/parse/common_containers.hpp>
+#include <userver/utest/assert_macros.hpp>
 #include <userver/utils/fmt_compat.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -341,4 +342,88 @@ TEST(JsonToPrettyStringCycle, DISABLED_SortsObjectKeys) {
   EXPECT_EQ(kPrettyJson, formats::json::ToPrettyString(json));
 }
 
+namespace {
+
+std::string MakeLargeJson(std::size_t size) {
+  formats::json::ValueBuilder builder{formats::json::Type::kObject};
+  for (std::size_t i = 0; i < size; ++i) {
+    auto item = builder["some long enough key " + std::to_string(i)];
+    item["string"] = "a string that is too long to be stored inline";
+    item["array"].PushBack(i);
+    item["array"].PushBack(std::to_string(i));
+  }
+  return formats::json::ToString(builder.ExtractValue());
+}
+
+}  // namespace
+
+TEST(JsonFromStringWithArena, SameAsFromString) {
+  const auto str = MakeLargeJson(1000);
+  const auto json = formats::json::FromStringWithArena(str);
+
+  EXPECT_EQ(json, formats::json::FromString(str));
+  EXPECT_EQ(formats::json::ToString(json), str);
+  EXPECT_EQ(json["some long enough key 42"]["array"][1].As<std::string>(),
+            "42");
+}
+
+TEST(JsonFromStringWithArena, SubValueKeepsArena) {
+  formats::json::Value item;
+  {
+    const auto json = formats::json::FromStringWithArena(MakeLargeJson(10));
+    item = json["some long enough key 7"];
+  }
+  EXPECT_EQ(item["string"].As<std::string>(),
+            "a string that is too long to be stored inline");
+  EXPECT_EQ(item["array"][0].As<int>(), 7);
+}
+
+TEST(JsonFromStringWithArena, ValueBuilderCopies) {
+  formats::json::ValueBuilder builder{
+      formats::json::FromStringWithArena(MakeLargeJson(10))};
+  builder["some long enough key 3"]["array"].PushBack(100);
+  builder["new"] = "a new string that is too long to be stored inline";
+  const auto json = builder.ExtractValue();
+
+  EXPECT_EQ(json["some long enough key 3"]["array"].GetSize(), 3);
+  EXPECT_EQ(json["some long enough key 9"]["array"][1].As<std::string>(), "9");
+  EXPECT_EQ(json["new"].As<std::string>(),
+            "a new string that is too long to be stored inline");
+}
+
+TEST(JsonFromStringWithArena, CopiesOutliveDocument) {
+  formats::json::Value clone;
+  formats::json::ValueBuilder builder;
+  {
+    const auto json = formats::json::FromStringWithArena(
+        R"({"key":"an \"escaped\" string that is not stored inline"})");
+    clone = json.Clone();
+    builder["copy"] = json["key"];
+  }
+  const auto copy = builder.ExtractValue();
+
+  EXPECT_EQ(clone["key"].As<std::string>(),
+            R"(an "escaped" string that is not stored inline)");
+  EXPECT_EQ(copy["copy"].As<std::string>(),
+            R"(an "escaped" string that is not stored inline)");
+}
+
+TEST(JsonFromStringWithArena, StableString) {
+  auto json = formats::json::FromStringWithArena(R"({"c":1,"b":[2],"a":"3"})");
+  EXPECT_EQ(formats::json::ToStableString(std::move(json)),
+            R"({"a":"3","b":[2],"c":1})");
+}
+
+TEST(JsonFromStringWithArena, Errors) {
+  EXPECT_THROW(formats::json::FromStringWithArena(""),
+               formats::json::ParseException);
+  EXPECT_THROW(formats::json::FromStringWithArena(R"({"a":)"),
+               formats::json::ParseException);
+  EXPECT_THROW(formats::json::FromStringWithArena(R"({"a":1,"a":2})"),
+               formats::json::ParseException);
+  UEXPECT_THROW_MSG(formats::json::FromStringWithArena("{\"a\":\n [1,}"),
+                    formats::json::ParseException,
+                    "JSON parse error at line 2 column 5");
+}
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
+#include <string>
+
 #include <benchmark/benchmark.h>
 
+#include <userver/formats/json/serialize.hpp>
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/json/value_builder.hpp>
 
@@ -74,4 +77,50 @@ void JsonStringBuilder(benchmark::State& state) {
 }
 BENCHMARK(JsonStringBuilder)->RangeMultiplier(4)->Range(1, 1024);
 
+// an array of strings, the argument is the length of each string
+void JsonStringBuilderLongStrings(benchmark::State& state) {
+  const std::string value(state.range(0), 'a');
+  for ([[maybe_unused]] auto _ : state) {
+    StringBuilder sw;
+    {
+      StringBuilder::ArrayGuard guard(sw);
+      for (int i = 0; i < 16; ++i) sw.WriteString(value);
+    }
+    auto str = sw.GetString();
+    benchmark::DoNotOptimize(str);
+  }
+  state.SetBytesProcessed(state.iterations() * 16 * value.size());
+}
+BENCHMARK(JsonStringBuilderLongStrings)->Range(8, 16 * 1024);
+
+// the same, but every 64th character has to be escaped
+void JsonStringBuilderLongStringsWithEscapes(benchmark::State& state) {
+  std::string value(state.range(0), 'a');
+  for (std::size_t i = 63; i < value.size(); i += 64) value[i] = '"';
+  for ([[maybe_unused]] auto _ : state) {
+    StringBuilder sw;
+    {
+      StringBuilder::ArrayGuard guard(sw);
+      for (int i = 0; i < 16; ++i) sw.WriteString(value);
+    }
+    auto str = sw.GetString();
+    benchmark::DoNotOptimize(str);
+  }
+  state.SetBytesProcessed(state.iterations() * 16 * value.size());
+}
+BENCHMARK(JsonStringBuilderLongStringsWithEscapes)->Range(8, 16 * 1024);
+
+void JsonToStringLongStrings(benchmark::State& state) {
+  const std::string value(state.range(0), 'a');
+  ValueBuilder builder{Type::kArray};
+  for (int i = 0; i < 16; ++i) builder.PushBack(value);
+  const auto json = builder.ExtractValue();
+  for ([[maybe_unused]] auto _ : state) {
+    auto str = ToString(json);
+    benchmark::DoNotOptimize(str);
+  }
+  state.SetBytesProcessed(state.iterations() * 16 * value.size());
+}
+BENCHMARK(JsonToStringLongStrings)->Range(8, 16 * 1024);
+
 USERVER_NAMESPACE_END
@@ -128,10 +128,9 @@ Value Value::operator[](std::string_view key) const {
   if (!IsMissing()) {
     CheckObjectOrNull();
     if (IsObject()) {
-      auto it = GetNative().FindMember(
-          impl::Value(::rapidjson::StringRef(key.data(), key.size())));
-      if (it != GetNative().MemberEnd()) {
-        return {EmplaceEnabler{}, holder_, root_ptr_for_path_, &it->value,
+      const auto* member = holder_.FindMember(GetNative(), key);
+      if (member) {
+        return {EmplaceEnabler{}, holder_, root_ptr_for_path_, member,
                 depth_ + 1};
       }
     }
@@ -379,8 +378,7 @@ std::string Value::ConvertTo<std::string>() const {
 bool Value::HasMember(std::string_view key) const {
   if (IsMissing()) return false;
   CheckObjectOrNull();
-  return IsObject() && GetNative().HasMember(impl::Value(
-                           ::rapidjson::StringRef(key.data(), key.size())));
+  return IsObject() && holder_.FindMember(GetNative(), key) != nullptr;
 }
 
 std::string Value::GetPath() const {
@@ -397,7 +395,10 @@ void Value::DropRootPath() {
 }
 
 Value Value::Clone() const {
-  return Value{impl::VersionedValuePtr::Create(GetNative(), g_allocator)};
+  // Strings of the documents parsed by FromStringWithArena are not owned by
+  // the nodes, the copy must not refer to them
+  return Value{impl::VersionedValuePtr::Create(GetNative(), g_allocator,
+                                               /*copyConstStrings=*/true)};
 }
 
 void Value::EnsureNotMissing() const {
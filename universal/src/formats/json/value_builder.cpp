@@ -112,17 +112,22 @@ ValueBuilder& ValueBuilder::operator=(ValueBuilder&& other) {
 ValueBuilder::ValueBuilder(const formats::json::Value& other) {
   // As we have new native object created,
   // we fill it with the copy from other's native object.
-  value_->GetNative().CopyFrom(other.GetNative(), g_allocator);
+  // Strings of the documents parsed by FromStringWithArena are not owned by
+  // the nodes, so they are copied too.
+  value_->GetNative().CopyFrom(other.GetNative(), g_allocator,
+                               /*copyConstStrings=*/true);
 }
 
 ValueBuilder::ValueBuilder(formats::json::Value&& other) {
   // As we have new native object created,
   // we fill it with the other's native object.
-  if (other.IsUniqueReference())
+  // Strings of an arena document cannot outlive the document, so it is copied
+  if (other.IsUniqueReference() && !other.holder_.HasArena())
     value_->GetNative() = std::move(other.GetNative());
   else
     // rapidjson uses move semantics in assignment
-    value_->GetNative().CopyFrom(other.GetNative(), g_allocator);
+    value_->GetNative().CopyFrom(other.GetNative(), g_allocator,
+                                 /*copyConstStrings=*/true);
 }
 
 ValueBuilder::ValueBuilder(EmplaceEnabler,
@@ -0,0 +1,255 @@
+#include <userver/logging/impl/binary_log.hpp>
+
+#include <chrono>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/chrono.h>
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <userver/logging/level.hpp>
+#include <userver/utils/encoding/tskv.hpp>
+#include <userver/utils/trivial_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl::binary {
+
+namespace {
+
+// Never change or reuse the ids, the logs written by the older versions must
+// remain decodable
+constexpr utils::TrivialBiMap kKnownKeys = [](auto selector) {
+  return selector()
+      .Case(1, "module")
+      .Case(2, "task_id")
+      .Case(3, "thread_id")
+      .Case(4, "text")
+      .Case(5, "trace_id")
+      .Case(6, "span_id")
+      .Case(7, "parent_id")
+      .Case(8, "link")
+      .Case(9, "stopwatch_name")
+      .Case(10, "total_time")
+      .Case(11, "stopwatch_units")
+      .Case(12, "start_timestamp")
+      .Case(13, "span_ref_type")
+      .Case(14, "_type")
+      .Case(15, "meta_type")
+      .Case(16, "meta_code")
+      .Case(17, "method")
+      .Case(18, "http.url")
+      .Case(19, "error")
+      .Case(20, "error_msg")
+      .Case(21, "attempts")
+      .Case(22, "max_attempts")
+      .Case(23, "timeout_ms")
+      .Case(24, "db.type")
+      .Case(25, "db.instance")
+      .Case(26, "db.statement")
+      .Case(27, "db.statement_name");
+};
+
+constexpr std::uint64_t kMaxKnownKeyId = 27;
+
+constexpr std::size_t kReadBufferSize = 1 << 16;
+
+[[noreturn]] void ThrowMalformed(std::string_view what) {
+  throw std::runtime_error(
+      fmt::format("Malformed binary log record: {}", what));
+}
+
+class Reader final {
+ public:
+  explicit Reader(std::string_view data) noexcept : data_(data) {}
+
+  bool IsEmpty() const noexcept { return data_.empty(); }
+
+  std::size_t GetConsumedSize(std::string_view original) const noexcept {
+    return original.size() - data_.size();
+  }
+
+  // Returns std::nullopt if the data ends in the middle of the varint
+  std::optional<std::uint64_t> TryReadVarint() noexcept {
+    std::uint64_t result = 0;
+    for (std::size_t i = 0; i < data_.size() && i < kMaxVarintSize; ++i) {
+      const auto byte = static_cast<std::uint8_t>(data_[i]);
+      result |= static_cast<std::uint64_t>(byte & 0x7f) << (7 * i);
+      if (!(byte & 0x80)) {
+        data_.remove_prefix(i + 1);
+        return result;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::uint64_t ReadVarint() {
+    const auto result = TryReadVarint();
+    if (!result) ThrowMalformed("truncated varint");
+    return *result;
+  }
+
+  std::string_view ReadBytes(std::uint64_t size) {
+    if (size > data_.size()) ThrowMalformed("truncated string");
+    const auto result = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return result;
+  }
+
+ private:
+  std::string_view data_;
+};
+
+void AppendTimestamp(std::string& tskv, std::uint64_t microseconds) {
+  const std::chrono::system_clock::time_point time{
+      std::chrono::microseconds{microseconds}};
+  fmt::format_to(std::back_inserter(tskv), FMT_COMPILE("{:%FT%T}.{:06}"),
+                 fmt::localtime(std::chrono::system_clock::to_time_t(time)),
+                 microseconds % 1'000'000);
+}
+
+}  // namespace
+
+std::uint64_t FindKnownKeyId(std::string_view key) noexcept {
+  return kKnownKeys.TryFindBySecond(key).value_or(0);
+}
+
+std::size_t DecodeRecordToTskv(std::string_view data, std::string& tskv) {
+  Reader header{data};
+  const auto body_size = header.TryReadVarint();
+  if (!body_size) return 0;
+  const auto header_size = header.GetConsumedSize(data);
+  if (data.size() - header_size < *body_size) return 0;
+
+  Reader body{data.substr(header_size, *body_size)};
+  const auto level = static_cast<std::uint8_t>(body.ReadBytes(1)[0]);
+  if (level > kLevelMax) ThrowMalformed("invalid level");
+  const auto timestamp = body.ReadVarint();
+
+  tskv.append("tskv\ttimestamp=");
+  AppendTimestamp(tskv, timestamp);
+  tskv.append("\tlevel=");
+  tskv.append(ToUpperCaseString(static_cast<Level>(level)));
+
+  while (!body.IsEmpty()) {
+    const auto header = body.ReadVarint();
+    const auto key_id = header >> kValueKindBits;
+    const auto kind =
+        static_cast<ValueKind>(header & ((1 << kValueKindBits) - 1));
+    std::string_view key;
+    if (key_id == 0) {
+      key = body.ReadBytes(body.ReadVarint());
+    } else {
+      const auto known_key =
+          key_id <= kMaxKnownKeyId
+              ? kKnownKeys.TryFindByFirst(static_cast<int>(key_id))
+              : std::nullopt;
+      if (!known_key) ThrowMalformed(fmt::format("unknown key id {}", key_id));
+      key = *known_key;
+    }
+
+    tskv.push_back(utils::encoding::kTskvPairsSeparator);
+    if (utils::encoding::ShouldKeyBeEscaped(key)) {
+      utils::encoding::EncodeTskv(
+          tskv, key, utils::encoding::EncodeTskvMode::kKeyReplacePeriod);
+    } else {
+      tskv.append(key);
+    }
+    tskv.push_back(utils::encoding::kTskvKeyValueSeparator);
+
+    switch (kind) {
+      case ValueKind::kString:
+        utils::encoding::EncodeTskv(tskv, body.ReadBytes(body.ReadVarint()),
+                                    utils::encoding::EncodeTskvMode::kValue);
+        break;
+      case ValueKind::kUnsigned:
+        fmt::format_to(std::back_inserter(tskv), FMT_COMPILE("{}"),
+                       body.ReadVarint());
+        break;
+      case ValueKind::kNegative: {
+        const auto magnitude = body.ReadVarint();
+        if (magnitude > std::numeric_limits<std::int64_t>::max()) {
+          ThrowMalformed("negative integer out of range");
+        }
+        fmt::format_to(std::back_inserter(tskv), FMT_COMPILE("-{}"),
+                       magnitude + 1);
+        break;
+      }
+      default:
+        ThrowMalformed("unknown value kind");
+    }
+  }
+
+  tskv.push_back('\n');
+  return header_size + *body_size;
+}
+
+bool DecodeStreamToTskv(std::istream& input, std::ostream& output) {
+  std::string data;
+  std::string tskv;
+  std::vector<char> buffer(kReadBufferSize);
+
+  while (input) {
+    input.read(buffer.data(), buffer.size());
+    data.append(buffer.data(), input.gcount());
+
+    std::string_view pending{data};
+    while (const auto consumed = DecodeRecordToTskv(pending, tskv)) {
+      pending.remove_prefix(consumed);
+    }
+    output << tskv;
+    tskv.clear();
+    data.erase(0, data.size() - pending.size());
+  }
+
+  return data.empty();
+}
+
+RecordBuilder::RecordBuilder(Level level,
+                             std::chrono::system_clock::time_point timestamp) {
+  body_.push_back(static_cast<char>(level));
+  AddVarint(std::chrono::duration_cast<std::chrono::microseconds>(
+                timestamp.time_since_epoch())
+                .count());
+}
+
+void RecordBuilder::AddTag(std::string_view key, std::string_view value) {
+  AddKey(key, ValueKind::kString);
+  AddVarint(value.size());
+  body_.append(value);
+}
+
+void RecordBuilder::AddIntegerTag(std::string_view key, IntegerValue value) {
+  AddKey(key, value.kind);
+  AddVarint(value.payload);
+}
+
+std::string RecordBuilder::Extract() && {
+  std::string record(GetVarintSize(body_.size()), '\0');
+  WriteVarint(body_.size(), record.data());
+  record.append(body_);
+  return record;
+}
+
+void RecordBuilder::AddKey(std::string_view key, ValueKind kind) {
+  const auto key_id = FindKnownKeyId(key);
+  AddVarint(MakeFieldHeader(key_id, kind));
+  if (key_id == 0) {
+    AddVarint(key.size());
+    body_.append(key);
+  }
+}
+
+void RecordBuilder::AddVarint(std::uint64_t value) {
+  char buffer[kMaxVarintSize];
+  body_.append(buffer, WriteVarint(value, buffer) - buffer);
+}
+
+}  // namespace logging::impl::binary
+
+USERVER_NAMESPACE_END
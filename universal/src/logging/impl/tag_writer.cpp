@@ -1,5 +1,7 @@
 #include <userver/logging/impl/tag_writer.hpp>
 
+#include <variant>
+
 #include <fmt/format.h>
 #include <boost/container/small_vector.hpp>
 
@@ -27,7 +29,11 @@ std::string_view RuntimeTagKey::GetUnescapedKey() const noexcept {
 
 void TagWriter::PutLogExtra(const LogExtra& extra) {
   for (const auto& item : *extra.extra_) {
-    PutTag(RuntimeTagKey{item.first}, item.second.GetValue());
+    std::visit(
+        [this, &item](const auto& value) {
+          PutTag(RuntimeTagKey{item.first}, value);
+        },
+        item.second.GetValue());
   }
 }
 
@@ -47,6 +53,19 @@ void TagWriter::PutKey(RuntimeTagKey key) {
 
 void TagWriter::MarkValueEnd() noexcept { lh_.pimpl_->MarkValueEnd(); }
 
+bool TagWriter::TryPutIntegerTag(std::string_view key, long long value) {
+  if (!lh_.pimpl_->IsBinary()) return false;
+  lh_.pimpl_->PutBinaryIntegerTag(key, binary::MakeIntegerValue(value));
+  return true;
+}
+
+bool TagWriter::TryPutIntegerTag(std::string_view key,
+                                 unsigned long long value) {
+  if (!lh_.pimpl_->IsBinary()) return false;
+  lh_.pimpl_->PutBinaryIntegerTag(key, binary::MakeIntegerValue(value));
+  return true;
+}
+
 }  // namespace logging::impl
 
 USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #include "log_helper_impl.hpp"
 
 #include <array>
+#include <cstring>
 
 #include <fmt/chrono.h>
 #include <fmt/compile.h>
@@ -8,6 +9,7 @@
 
 #include <userver/compiler/impl/constexpr.hpp>
 #include <userver/compiler/thread_local.hpp>
+#include <userver/logging/impl/binary_log.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/encoding/tskv.hpp>
@@ -25,11 +27,42 @@ char GetSeparatorFromLogger(LoggerRef logger) {
       return '=';
     case Format::kLtsv:
       return ':';
+    case Format::kBinary:
+      return '\0';
   }
 
   UINVARIANT(false, "Invalid logging::Format enum value");
 }
 
+// The sizes are written when the record or the value ends, the room for them
+// is reserved up front. Records of up to 2MB and values of up to 16KB do not
+// move, moving a longer value is cheap compared to writing it.
+constexpr std::size_t kBinaryRecordSizeReserve = 3;
+constexpr std::size_t kBinaryValueSizeReserve = 2;
+
+void AppendVarint(LogBuffer& buffer, std::uint64_t value) {
+  const auto old_size = buffer.size();
+  buffer.resize(old_size + impl::binary::GetVarintSize(value));
+  impl::binary::WriteVarint(value, buffer.data() + old_size);
+}
+
+// Writes the varint into the `reserved` bytes at `pos`, padding it if it is
+// shorter. Only a varint that does not fit moves the data after it.
+void PatchVarint(LogBuffer& buffer, std::size_t pos, std::size_t reserved,
+                 std::uint64_t value) {
+  const auto size = impl::binary::GetVarintSize(value);
+  if (size <= reserved) {
+    impl::binary::WritePaddedVarint(value, buffer.data() + pos, reserved);
+    return;
+  }
+
+  const auto tail_size = buffer.size() - pos - reserved;
+  buffer.resize(buffer.size() + size - reserved);
+  auto* const begin = buffer.data() + pos;
+  std::memmove(begin + size, begin + reserved, tail_size);
+  impl::binary::WriteVarint(value, begin);
+}
+
 using TimePoint = std::chrono::system_clock::time_point;
 
 auto FractionalMicroseconds(TimePoint time) noexcept {
@@ -88,7 +121,8 @@ std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s,
 LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
     : logger_(&logger),
       level_(std::max(level, logger_->GetLevel())),
-      key_value_separator_(GetSeparatorFromLogger(*logger_)) {
+      key_value_separator_(GetSeparatorFromLogger(*logger_)),
+      is_binary_(logger_->GetFormat() == Format::kBinary) {
   static_assert(sizeof(LogHelper::Impl) < 4096,
                 "Structures with size more than 4096 would consume at least "
                 "8KB memory in allocator.");
@@ -128,14 +162,32 @@ void LogHelper::Impl::PutMessageBegin() {
       msg_.append(std::string_view{"tskv"});
       return;
     }
+    case Format::kBinary: {
+      // The record size is written in PutMessageEnd
+      msg_.resize(kBinaryRecordSizeReserve);
+      msg_.push_back(static_cast<char>(level_));
+      AppendVarint(msg_, std::chrono::duration_cast<std::chrono::microseconds>(
+                             TimePoint::clock::now().time_since_epoch())
+                             .count());
+      return;
+    }
   }
   UASSERT_MSG(false, "Invalid value of Format enum");
 }
 
-void LogHelper::Impl::PutMessageEnd() { msg_.push_back('\n'); }
+void LogHelper::Impl::PutMessageEnd() {
+  if (is_binary_) {
+    PatchVarint(msg_, 0, kBinaryRecordSizeReserve,
+                msg_.size() - kBinaryRecordSizeReserve);
+    return;
+  }
+  msg_.push_back('\n');
+}
 
 void LogHelper::Impl::PutKey(std::string_view key) {
-  if (!utils::encoding::ShouldKeyBeEscaped(key)) {
+  if (is_binary_) {
+    PutBinaryKey(key);
+  } else if (!utils::encoding::ShouldKeyBeEscaped(key)) {
     PutRawKey(key);
   } else {
     UASSERT(!std::exchange(is_within_value_, true));
@@ -148,6 +200,11 @@ void LogHelper::Impl::PutKey(std::string_view key) {
 }
 
 void LogHelper::Impl::PutRawKey(std::string_view key) {
+  if (is_binary_) {
+    PutBinaryKey(key);
+    return;
+  }
+
   UASSERT(!std::exchange(is_within_value_, true));
   CheckRepeatedKeys(key);
   const auto old_size = msg_.size();
@@ -160,14 +217,51 @@ void LogHelper::Impl::PutRawKey(std::string_view key) {
   *(position++) = key_value_separator_;
 }
 
+void LogHelper::Impl::PutBinaryKey(std::string_view key) {
+  UASSERT(!std::exchange(is_within_value_, true));
+  PutBinaryFieldHeader(key, impl::binary::ValueKind::kString);
+
+  // The value size is written in MarkValueEnd
+  msg_.resize(msg_.size() + kBinaryValueSizeReserve);
+  value_begin_ = msg_.size();
+}
+
+void LogHelper::Impl::PutBinaryIntegerTag(std::string_view key,
+                                          impl::binary::IntegerValue value) {
+  UASSERT(is_binary_);
+  UASSERT(!is_within_value_);
+  PutBinaryFieldHeader(key, value.kind);
+  AppendVarint(msg_, value.payload);
+}
+
+void LogHelper::Impl::PutBinaryFieldHeader(std::string_view key,
+                                           impl::binary::ValueKind kind) {
+  CheckRepeatedKeys(key);
+
+  const auto key_id = impl::binary::FindKnownKeyId(key);
+  AppendVarint(msg_, impl::binary::MakeFieldHeader(key_id, kind));
+  if (key_id == 0) {
+    AppendVarint(msg_, key.size());
+    msg_.append(key);
+  }
+}
+
 void LogHelper::Impl::PutValuePart(std::string_view value) {
   UASSERT(is_within_value_);
+  if (is_binary_) {
+    msg_.append(value);
+    return;
+  }
   utils::encoding::EncodeTskv(msg_, value,
                               utils::encoding::EncodeTskvMode::kValue);
 }
 
 void LogHelper::Impl::PutValuePart(char text_part) {
   UASSERT(is_within_value_);
+  if (is_binary_) {
+    msg_.push_back(text_part);
+    return;
+  }
   utils::encoding::EncodeTskv(fmt::appender(msg_), text_part,
                               utils::encoding::EncodeTskvMode::kValue);
 }
@@ -179,6 +273,15 @@ LogBuffer& LogHelper::Impl::GetBufferForRawValuePart() noexcept {
 
 void LogHelper::Impl::MarkValueEnd() noexcept {
   UASSERT(std::exchange(is_within_value_, false));
+  if (!is_binary_) return;
+
+  try {
+    PatchVarint(msg_, value_begin_ - kBinaryValueSizeReserve,
+                kBinaryValueSizeReserve, msg_.size() - value_begin_);
+  } catch (const std::exception&) {
+    // Failed to grow the buffer for a long value, drop the record
+    MarkAsBroken();
+  }
 }
 
 void LogHelper::Impl::StartText() {
@@ -6,6 +6,7 @@
 
 #include <fmt/format.h>
 
+#include <userver/logging/impl/binary_log.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/log_extra.hpp>
@@ -40,6 +41,11 @@ class LogHelper::Impl final {
   bool IsWithinValue() const noexcept { return is_within_value_; }
   void MarkValueEnd() noexcept;
 
+  bool IsBinary() const noexcept { return is_binary_; }
+  // Puts a whole tag with an integer value, only for Format::kBinary
+  void PutBinaryIntegerTag(std::string_view key,
+                           impl::binary::IntegerValue value);
+
   LogExtra& GetLogExtra() { return extra_; }
 
   void StartText();
@@ -78,13 +84,20 @@ class LogHelper::Impl final {
 
   void CheckRepeatedKeys(std::string_view raw_key);
 
+  void PutBinaryKey(std::string_view key);
+  void PutBinaryFieldHeader(std::string_view key,
+                            impl::binary::ValueKind kind);
+
   impl::LoggerBase* logger_;
   const Level level_;
   const char key_value_separator_;
+  const bool is_binary_;
   LogBuffer msg_;
   std::optional<LazyInitedStream> lazy_stream_;
   LogExtra extra_;
   std::size_t initial_length_{0};
+  // Start of the current value for Format::kBinary
+  std::size_t value_begin_{0};
   bool is_within_value_{false};
   std::optional<std::unordered_set<std::string>> debug_tag_keys_;
 };
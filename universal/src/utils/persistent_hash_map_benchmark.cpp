@@ -0,0 +1,106 @@
+#include <userver/utils/persistent_hash_map.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include <benchmark/benchmark.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Percent of the keys changed by an incremental update
+constexpr int kChangedPercent = 1;
+
+template <typename Map>
+Map MakeMap(std::size_t size) {
+  Map map;
+  for (std::size_t i = 0; i < size; ++i) {
+    map.insert_or_assign(i, std::to_string(i));
+  }
+  return map;
+}
+
+// Mimics an incremental cache update: copy the current data and apply
+// the changes to the copy
+template <typename Map>
+void IncrementalUpdate(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto changed = std::max<std::int64_t>(size * kChangedPercent / 100, 1);
+  auto map = MakeMap<Map>(size);
+
+  std::int64_t offset = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    auto copy = map;
+    for (std::int64_t i = 0; i < changed; ++i) {
+      copy.insert_or_assign((offset + i * 97) % size, "updated");
+    }
+    offset = (offset + 1) % size;
+    map = std::move(copy);
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * changed);
+}
+
+template <typename Map>
+void Find(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto map = MakeMap<Map>(size);
+
+  std::int64_t key = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(map.find(key));
+    key = (key + 7) % size;
+  }
+}
+
+template <typename Map>
+void Iterate(benchmark::State& state) {
+  const auto map = MakeMap<Map>(state.range(0));
+
+  for ([[maybe_unused]] auto _ : state) {
+    std::size_t total = 0;
+    for (const auto& [key, value] : map) total += value.size();
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using StdMap = std::unordered_map<std::int64_t, std::string>;
+using PersistentMap = utils::PersistentHashMap<std::int64_t, std::string>;
+
+}  // namespace
+
+static void PersistentHashMap_IncrementalUpdateStd(benchmark::State& state) {
+  IncrementalUpdate<StdMap>(state);
+}
+BENCHMARK(PersistentHashMap_IncrementalUpdateStd)->Range(1 << 10, 1 << 18);
+
+static void PersistentHashMap_IncrementalUpdate(benchmark::State& state) {
+  IncrementalUpdate<PersistentMap>(state);
+}
+BENCHMARK(PersistentHashMap_IncrementalUpdate)->Range(1 << 10, 1 << 18);
+
+static void PersistentHashMap_FindStd(benchmark::State& state) {
+  Find<StdMap>(state);
+}
+BENCHMARK(PersistentHashMap_FindStd)->Range(1 << 10, 1 << 18);
+
+static void PersistentHashMap_Find(benchmark::State& state) {
+  Find<PersistentMap>(state);
+}
+BENCHMARK(PersistentHashMap_Find)->Range(1 << 10, 1 << 18);
+
+static void PersistentHashMap_IterateStd(benchmark::State& state) {
+  Iterate<StdMap>(state);
+}
+BENCHMARK(PersistentHashMap_IterateStd)->Range(1 << 10, 1 << 18);
+
+static void PersistentHashMap_Iterate(benchmark::State& state) {
+  Iterate<PersistentMap>(state);
+}
+BENCHMARK(PersistentHashMap_Iterate)->Range(1 << 10, 1 << 18);
+
+USERVER_NAMESPACE_END
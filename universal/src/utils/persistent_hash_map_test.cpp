@@ -0,0 +1,181 @@
+#include <userver/utils/persistent_hash_map.hpp>
+
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Forces hash collisions on all levels of the trie
+struct BadHash {
+  std::size_t operator()(int value) const noexcept { return value % 3; }
+};
+
+template <typename Map>
+std::map<typename Map::key_type, typename Map::mapped_type> ToStdMap(
+    const Map& map) {
+  std::map<typename Map::key_type, typename Map::mapped_type> result;
+  for (const auto& [key, value] : map) {
+    EXPECT_TRUE(result.emplace(key, value).second) << "duplicate key " << key;
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(PersistentHashMap, Sample) {
+  /// [Sample PersistentHashMap]
+  utils::PersistentHashMap<std::string, int> map{{"one", 1}, {"two", 2}};
+
+  // O(1), the nodes are shared
+  auto copy = map;
+  // Copies only the path to the key
+  copy.insert_or_assign("three", 3);
+  copy.erase("one");
+
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.at("one"), 1);
+  EXPECT_FALSE(map.contains("three"));
+
+  EXPECT_EQ(copy.size(), 2);
+  EXPECT_EQ(copy.at("three"), 3);
+  EXPECT_FALSE(copy.contains("one"));
+  /// [Sample PersistentHashMap]
+}
+
+TEST(PersistentHashMap, Basic) {
+  utils::PersistentHashMap<int, std::string> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_EQ(map.erase(1), 0);
+
+  EXPECT_TRUE(map.insert_or_assign(1, "a"));
+  EXPECT_FALSE(map.insert_or_assign(1, "b"));
+  EXPECT_FALSE(map.try_emplace(1, "c"));
+  EXPECT_TRUE(map.try_emplace(2, 3, 'c'));
+  EXPECT_TRUE(map.insert({3, "d"}));
+
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_EQ(map.at(1), "b");
+  EXPECT_EQ(map.at(2), "ccc");
+  EXPECT_EQ(map.count(3), 1);
+  EXPECT_THROW(map.at(4), std::out_of_range);
+
+  const auto it = map.find(2);
+  ASSERT_NE(it, map.end());
+  EXPECT_EQ(it->first, 2);
+  EXPECT_EQ(it->second, "ccc");
+
+  EXPECT_EQ(map.erase(2), 1);
+  EXPECT_EQ(map.erase(2), 0);
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_FALSE(map.contains(2));
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(PersistentHashMap, CopiesAreIndependent) {
+  utils::PersistentHashMap<int, int> map;
+  for (int i = 0; i < 1000; ++i) map.insert_or_assign(i, i);
+
+  auto copy = map;
+  for (int i = 0; i < 1000; i += 2) copy.erase(i);
+  for (int i = 1; i < 1000; i += 4) copy.insert_or_assign(i, -i);
+  for (int i = 1000; i < 1100; ++i) copy.insert_or_assign(i, i);
+
+  ASSERT_EQ(map.size(), 1000);
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(map.at(i), i);
+
+  ASSERT_EQ(copy.size(), 600);
+  for (int i = 0; i < 1100; ++i) {
+    if (i < 1000 && i % 2 == 0) {
+      EXPECT_FALSE(copy.contains(i));
+    } else if (i < 1000 && i % 4 == 1) {
+      EXPECT_EQ(copy.at(i), -i);
+    } else {
+      EXPECT_EQ(copy.at(i), i);
+    }
+  }
+}
+
+TEST(PersistentHashMap, Collisions) {
+  utils::PersistentHashMap<int, int, BadHash> map;
+  for (int i = 0; i < 30; ++i) map.insert_or_assign(i, i);
+  const auto snapshot = map;
+
+  EXPECT_EQ(map.size(), 30);
+  for (int i = 0; i < 30; ++i) EXPECT_EQ(map.at(i), i);
+  EXPECT_EQ(ToStdMap(map).size(), 30);
+
+  for (int i = 0; i < 30; i += 3) EXPECT_EQ(map.erase(i), 1);
+  EXPECT_EQ(map.size(), 20);
+  for (int i = 0; i < 30; ++i) EXPECT_EQ(map.contains(i), i % 3 != 0);
+  EXPECT_EQ(ToStdMap(map).size(), 20);
+
+  EXPECT_EQ(snapshot.size(), 30);
+  EXPECT_EQ(ToStdMap(snapshot).size(), 30);
+}
+
+TEST(PersistentHashMap, MatchesUnorderedMap) {
+  std::mt19937 rng{42};
+  std::uniform_int_distribution<int> keys{0, 5000};
+
+  utils::PersistentHashMap<int, int> map;
+  std::unordered_map<int, int> expected;
+  std::vector<utils::PersistentHashMap<int, int>> snapshots;
+  std::vector<std::map<int, int>> expected_snapshots;
+
+  for (int i = 0; i < 20000; ++i) {
+    const auto key = keys(rng);
+    if (i % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      EXPECT_EQ(map.insert_or_assign(key, i),
+                expected.insert_or_assign(key, i).second);
+    }
+    if (i % 2000 == 0) {
+      snapshots.push_back(map);
+      expected_snapshots.push_back(ToStdMap(map));
+    }
+  }
+
+  EXPECT_EQ(map.size(), expected.size());
+  EXPECT_EQ(ToStdMap(map), ToStdMap(expected));
+  for (const auto& [key, value] : expected) {
+    const auto it = map.find(key);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->second, value);
+  }
+
+  for (std::size_t i = 0; i < snapshots.size(); ++i) {
+    EXPECT_EQ(ToStdMap(snapshots[i]), expected_snapshots[i]);
+  }
+}
+
+TEST(PersistentHashMap, IterateFromFind) {
+  utils::PersistentHashMap<int, int, BadHash> map;
+  for (int i = 0; i < 100; ++i) map.insert_or_assign(i, i);
+
+  for (const auto& [key, value] : map) {
+    std::size_t rest = 0;
+    for (auto it = map.find(key); it != map.end(); ++it) ++rest;
+
+    std::size_t expected_rest = 0;
+    auto it = map.begin();
+    while (it->first != key) ++it;
+    for (; it != map.end(); ++it) ++expected_rest;
+
+    EXPECT_EQ(rest, expected_rest);
+  }
+}
+
+USERVER_NAMESPACE_END